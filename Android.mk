@@ -71,8 +71,9 @@ LIBFREESPACE_CONF_FILE := $(LIBFREESPACE_GEN_DIR)/include/freespace_config.h
 $(LIBFREESPACE_CONF_FILE) : $(LOCAL_PATH)/Android.mk $(LIBFREESPACE_MSG_GEN)
 	@echo "libfreespace <= Creating Config File"
 	@echo "#define LIBFREESPACE_VERSION \"0.7.1\"	" > $@
+	@echo "#define LIBFREESPACE_BACKEND_ORDER \"hidraw\"" >> $@
 
-LOCAL_SRC_FILES := linux/freespace_hidraw.c common/freespace_deviceTable.c
+LOCAL_SRC_FILES := linux/freespace_hidraw.c linux/freespace_backend.c linux/worker_pool.c linux/receive_thread.c common/freespace_deviceTable.c common/freespace_mailbox.c common/freespace_subscribe.c common/freespace_frs.c common/freespace_frsCache.c common/freespace_frsWrite.c common/freespace_request.c common/freespace_configure.c common/freespace_rate.c common/freespace_syncQueue.c common/freespace_buffer.c common/freespace_alloc.c common/freespace_log.c common/freespace_trace.c common/freespace_recorder.c common/freespace_pack.c common/freespace_schema.c common/freespace_publish.c
 
 ifndef NDK_ROOT
 LOCAL_GENERATED_SOURCES := $(LIBFREESPACE_CONF_FILE) $(LIBFREESPACE_MSG_GEN_SRCS)
@@ -92,10 +93,11 @@ $(addprefix $(LOCAL_PATH)/, $(LOCAL_SRC_FILES)) : $(LIBFREESPACE_MSG_GEN) $(LIBF
 
 endif
 
-LOCAL_CFLAGS += -DFREESPACE_LITTLE_ENDIAN
+LOCAL_CFLAGS += -DFREESPACE_LITTLE_ENDIAN -DLIBFREESPACE_BACKEND_HIDRAW
 
 LOCAL_C_INCLUDES += \
 	$(LOCAL_PATH)/include \
+	$(LOCAL_PATH)/common \
 	$(LIBFREESPACE_GEN_DIR)/include/ \
 	$(LIBFREESPACE_ADDITIONAL_INCLUDES)
 
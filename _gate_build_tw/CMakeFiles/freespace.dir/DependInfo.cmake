@@ -0,0 +1,55 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/common/freespace_alloc.c" "CMakeFiles/freespace.dir/common/freespace_alloc.c.o" "gcc" "CMakeFiles/freespace.dir/common/freespace_alloc.c.o.d"
+  "/root/repo/common/freespace_buffer.c" "CMakeFiles/freespace.dir/common/freespace_buffer.c.o" "gcc" "CMakeFiles/freespace.dir/common/freespace_buffer.c.o.d"
+  "/root/repo/common/freespace_configure.c" "CMakeFiles/freespace.dir/common/freespace_configure.c.o" "gcc" "CMakeFiles/freespace.dir/common/freespace_configure.c.o.d"
+  "/root/repo/common/freespace_deviceTable.c" "CMakeFiles/freespace.dir/common/freespace_deviceTable.c.o" "gcc" "CMakeFiles/freespace.dir/common/freespace_deviceTable.c.o.d"
+  "/root/repo/common/freespace_frs.c" "CMakeFiles/freespace.dir/common/freespace_frs.c.o" "gcc" "CMakeFiles/freespace.dir/common/freespace_frs.c.o.d"
+  "/root/repo/common/freespace_frsCache.c" "CMakeFiles/freespace.dir/common/freespace_frsCache.c.o" "gcc" "CMakeFiles/freespace.dir/common/freespace_frsCache.c.o.d"
+  "/root/repo/common/freespace_frsWrite.c" "CMakeFiles/freespace.dir/common/freespace_frsWrite.c.o" "gcc" "CMakeFiles/freespace.dir/common/freespace_frsWrite.c.o.d"
+  "/root/repo/common/freespace_log.c" "CMakeFiles/freespace.dir/common/freespace_log.c.o" "gcc" "CMakeFiles/freespace.dir/common/freespace_log.c.o.d"
+  "/root/repo/common/freespace_mailbox.c" "CMakeFiles/freespace.dir/common/freespace_mailbox.c.o" "gcc" "CMakeFiles/freespace.dir/common/freespace_mailbox.c.o.d"
+  "/root/repo/common/freespace_pack.c" "CMakeFiles/freespace.dir/common/freespace_pack.c.o" "gcc" "CMakeFiles/freespace.dir/common/freespace_pack.c.o.d"
+  "/root/repo/common/freespace_publish.c" "CMakeFiles/freespace.dir/common/freespace_publish.c.o" "gcc" "CMakeFiles/freespace.dir/common/freespace_publish.c.o.d"
+  "/root/repo/common/freespace_rate.c" "CMakeFiles/freespace.dir/common/freespace_rate.c.o" "gcc" "CMakeFiles/freespace.dir/common/freespace_rate.c.o.d"
+  "/root/repo/common/freespace_recorder.c" "CMakeFiles/freespace.dir/common/freespace_recorder.c.o" "gcc" "CMakeFiles/freespace.dir/common/freespace_recorder.c.o.d"
+  "/root/repo/common/freespace_request.c" "CMakeFiles/freespace.dir/common/freespace_request.c.o" "gcc" "CMakeFiles/freespace.dir/common/freespace_request.c.o.d"
+  "/root/repo/common/freespace_schema.c" "CMakeFiles/freespace.dir/common/freespace_schema.c.o" "gcc" "CMakeFiles/freespace.dir/common/freespace_schema.c.o.d"
+  "/root/repo/common/freespace_subscribe.c" "CMakeFiles/freespace.dir/common/freespace_subscribe.c.o" "gcc" "CMakeFiles/freespace.dir/common/freespace_subscribe.c.o.d"
+  "/root/repo/common/freespace_syncQueue.c" "CMakeFiles/freespace.dir/common/freespace_syncQueue.c.o" "gcc" "CMakeFiles/freespace.dir/common/freespace_syncQueue.c.o.d"
+  "/root/repo/common/freespace_trace.c" "CMakeFiles/freespace.dir/common/freespace_trace.c.o" "gcc" "CMakeFiles/freespace.dir/common/freespace_trace.c.o.d"
+  "/root/repo/common/freespace_util.c" "CMakeFiles/freespace.dir/common/freespace_util.c.o" "gcc" "CMakeFiles/freespace.dir/common/freespace_util.c.o.d"
+  "/root/repo/_gate_build_tw/gen_src/freespace_codecs.c" "CMakeFiles/freespace.dir/gen_src/freespace_codecs.c.o" "gcc" "CMakeFiles/freespace.dir/gen_src/freespace_codecs.c.o.d"
+  "/root/repo/_gate_build_tw/gen_src/freespace_printers.c" "CMakeFiles/freespace.dir/gen_src/freespace_printers.c.o" "gcc" "CMakeFiles/freespace.dir/gen_src/freespace_printers.c.o.d"
+  "/root/repo/linux/freespace_backend.c" "CMakeFiles/freespace.dir/linux/freespace_backend.c.o" "gcc" "CMakeFiles/freespace.dir/linux/freespace_backend.c.o.d"
+  "/root/repo/linux/freespace_hidraw.c" "CMakeFiles/freespace.dir/linux/freespace_hidraw.c.o" "gcc" "CMakeFiles/freespace.dir/linux/freespace_hidraw.c.o.d"
+  "/root/repo/linux/freespace_test.c" "CMakeFiles/freespace.dir/linux/freespace_test.c.o" "gcc" "CMakeFiles/freespace.dir/linux/freespace_test.c.o.d"
+  "/root/repo/linux/linux_hotplug.c" "CMakeFiles/freespace.dir/linux/linux_hotplug.c.o" "gcc" "CMakeFiles/freespace.dir/linux/linux_hotplug.c.o.d"
+  "/root/repo/linux/receive_thread.c" "CMakeFiles/freespace.dir/linux/receive_thread.c.o" "gcc" "CMakeFiles/freespace.dir/linux/receive_thread.c.o.d"
+  "/root/repo/linux/worker_pool.c" "CMakeFiles/freespace.dir/linux/worker_pool.c.o" "gcc" "CMakeFiles/freespace.dir/linux/worker_pool.c.o.d"
+  )
+
+# Pairs of files generated by the same build rule.
+set(CMAKE_MULTIPLE_OUTPUT_PAIRS
+  "/root/repo/_gate_build_tw/gen_src/freespace_printers.c" "/root/repo/_gate_build_tw/gen_src/freespace_codecs.c"
+  "/root/repo/_gate_build_tw/include/freespace/freespace_codecs.h" "/root/repo/_gate_build_tw/gen_src/freespace_codecs.c"
+  "/root/repo/_gate_build_tw/include/freespace/freespace_printers.h" "/root/repo/_gate_build_tw/gen_src/freespace_codecs.c"
+  "/root/repo/_gate_build_tw/libfreespace.so" "/root/repo/_gate_build_tw/libfreespace.so.0.7.1"
+  "/root/repo/_gate_build_tw/libfreespace.so.0" "/root/repo/_gate_build_tw/libfreespace.so.0.7.1"
+  )
+
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
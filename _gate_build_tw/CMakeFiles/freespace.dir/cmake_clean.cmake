@@ -0,0 +1,69 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/freespace.dir/common/freespace_alloc.c.o"
+  "CMakeFiles/freespace.dir/common/freespace_alloc.c.o.d"
+  "CMakeFiles/freespace.dir/common/freespace_buffer.c.o"
+  "CMakeFiles/freespace.dir/common/freespace_buffer.c.o.d"
+  "CMakeFiles/freespace.dir/common/freespace_configure.c.o"
+  "CMakeFiles/freespace.dir/common/freespace_configure.c.o.d"
+  "CMakeFiles/freespace.dir/common/freespace_deviceTable.c.o"
+  "CMakeFiles/freespace.dir/common/freespace_deviceTable.c.o.d"
+  "CMakeFiles/freespace.dir/common/freespace_frs.c.o"
+  "CMakeFiles/freespace.dir/common/freespace_frs.c.o.d"
+  "CMakeFiles/freespace.dir/common/freespace_frsCache.c.o"
+  "CMakeFiles/freespace.dir/common/freespace_frsCache.c.o.d"
+  "CMakeFiles/freespace.dir/common/freespace_frsWrite.c.o"
+  "CMakeFiles/freespace.dir/common/freespace_frsWrite.c.o.d"
+  "CMakeFiles/freespace.dir/common/freespace_log.c.o"
+  "CMakeFiles/freespace.dir/common/freespace_log.c.o.d"
+  "CMakeFiles/freespace.dir/common/freespace_mailbox.c.o"
+  "CMakeFiles/freespace.dir/common/freespace_mailbox.c.o.d"
+  "CMakeFiles/freespace.dir/common/freespace_pack.c.o"
+  "CMakeFiles/freespace.dir/common/freespace_pack.c.o.d"
+  "CMakeFiles/freespace.dir/common/freespace_publish.c.o"
+  "CMakeFiles/freespace.dir/common/freespace_publish.c.o.d"
+  "CMakeFiles/freespace.dir/common/freespace_rate.c.o"
+  "CMakeFiles/freespace.dir/common/freespace_rate.c.o.d"
+  "CMakeFiles/freespace.dir/common/freespace_recorder.c.o"
+  "CMakeFiles/freespace.dir/common/freespace_recorder.c.o.d"
+  "CMakeFiles/freespace.dir/common/freespace_request.c.o"
+  "CMakeFiles/freespace.dir/common/freespace_request.c.o.d"
+  "CMakeFiles/freespace.dir/common/freespace_schema.c.o"
+  "CMakeFiles/freespace.dir/common/freespace_schema.c.o.d"
+  "CMakeFiles/freespace.dir/common/freespace_subscribe.c.o"
+  "CMakeFiles/freespace.dir/common/freespace_subscribe.c.o.d"
+  "CMakeFiles/freespace.dir/common/freespace_syncQueue.c.o"
+  "CMakeFiles/freespace.dir/common/freespace_syncQueue.c.o.d"
+  "CMakeFiles/freespace.dir/common/freespace_trace.c.o"
+  "CMakeFiles/freespace.dir/common/freespace_trace.c.o.d"
+  "CMakeFiles/freespace.dir/common/freespace_util.c.o"
+  "CMakeFiles/freespace.dir/common/freespace_util.c.o.d"
+  "CMakeFiles/freespace.dir/gen_src/freespace_codecs.c.o"
+  "CMakeFiles/freespace.dir/gen_src/freespace_codecs.c.o.d"
+  "CMakeFiles/freespace.dir/gen_src/freespace_printers.c.o"
+  "CMakeFiles/freespace.dir/gen_src/freespace_printers.c.o.d"
+  "CMakeFiles/freespace.dir/linux/freespace_backend.c.o"
+  "CMakeFiles/freespace.dir/linux/freespace_backend.c.o.d"
+  "CMakeFiles/freespace.dir/linux/freespace_hidraw.c.o"
+  "CMakeFiles/freespace.dir/linux/freespace_hidraw.c.o.d"
+  "CMakeFiles/freespace.dir/linux/freespace_test.c.o"
+  "CMakeFiles/freespace.dir/linux/freespace_test.c.o.d"
+  "CMakeFiles/freespace.dir/linux/linux_hotplug.c.o"
+  "CMakeFiles/freespace.dir/linux/linux_hotplug.c.o.d"
+  "CMakeFiles/freespace.dir/linux/receive_thread.c.o"
+  "CMakeFiles/freespace.dir/linux/receive_thread.c.o.d"
+  "CMakeFiles/freespace.dir/linux/worker_pool.c.o"
+  "CMakeFiles/freespace.dir/linux/worker_pool.c.o.d"
+  "gen_src/freespace_codecs.c"
+  "gen_src/freespace_printers.c"
+  "include/freespace/freespace_codecs.h"
+  "include/freespace/freespace_printers.h"
+  "libfreespace.pdb"
+  "libfreespace.so"
+  "libfreespace.so.0"
+  "libfreespace.so.0.7.1"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/freespace.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
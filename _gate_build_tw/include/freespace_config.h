@@ -0,0 +1,6 @@
+// The config.h file is automatically generated by CMake from config.h.cmake.in
+
+#define LIBFREESPACE_VERSION "0.7.1"
+
+// Backends freespace_init() tries by default, in order
+#define LIBFREESPACE_BACKEND_ORDER "hidraw"
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_configure.dir/fake_device.c.o"
+  "CMakeFiles/test_configure.dir/fake_device.c.o.d"
+  "CMakeFiles/test_configure.dir/test_configure.c.o"
+  "CMakeFiles/test_configure.dir/test_configure.c.o.d"
+  "test_configure"
+  "test_configure.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test_configure.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_rate.dir/fake_device.c.o"
+  "CMakeFiles/test_rate.dir/fake_device.c.o.d"
+  "CMakeFiles/test_rate.dir/test_rate.c.o"
+  "CMakeFiles/test_rate.dir/test_rate.c.o.d"
+  "test_rate"
+  "test_rate.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test_rate.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
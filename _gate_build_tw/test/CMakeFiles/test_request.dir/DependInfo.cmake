@@ -0,0 +1,21 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/test/fake_device.c" "test/CMakeFiles/test_request.dir/fake_device.c.o" "gcc" "test/CMakeFiles/test_request.dir/fake_device.c.o.d"
+  "/root/repo/test/test_request.c" "test/CMakeFiles/test_request.dir/test_request.c.o" "gcc" "test/CMakeFiles/test_request.dir/test_request.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gate_build_tw/CMakeFiles/freespace.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_request.dir/fake_device.c.o"
+  "CMakeFiles/test_request.dir/fake_device.c.o.d"
+  "CMakeFiles/test_request.dir/test_request.c.o"
+  "CMakeFiles/test_request.dir/test_request.c.o.d"
+  "test_request"
+  "test_request.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test_request.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_subscribe.dir/fake_device.c.o"
+  "CMakeFiles/test_subscribe.dir/fake_device.c.o.d"
+  "CMakeFiles/test_subscribe.dir/test_subscribe.c.o"
+  "CMakeFiles/test_subscribe.dir/test_subscribe.c.o.d"
+  "test_subscribe"
+  "test_subscribe.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test_subscribe.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,14 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test
+# Build directory: /root/repo/_gate_build_tw/test
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(test_request "test_request")
+set_tests_properties(test_request PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;32;add_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(test_configure "test_configure")
+set_tests_properties(test_configure PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;32;add_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(test_subscribe "test_subscribe")
+set_tests_properties(test_subscribe PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;32;add_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(test_rate "test_rate")
+set_tests_properties(test_rate PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;32;add_test;/root/repo/test/CMakeLists.txt;0;")
@@ -0,0 +1,104 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "freespace_alloc.h"
+#include "freespace_atomic.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef LIBFREESPACE_ALLOCATION_ASSERTS
+#include <stdio.h>
+#endif
+
+static freespace_mallocFunction mallocFn_ = NULL;
+static freespace_freeFunction freeFn_ = NULL;
+static void* allocatorContext_ = NULL;
+
+// Allocations that have not been freed. The allocator can only be
+// changed when this is 0.
+static volatile long outstanding_ = 0;
+
+#ifdef LIBFREESPACE_ALLOCATION_ASSERTS
+static FREESPACE_THREAD_LOCAL int hotPathDepth_ = 0;
+
+void freespace_private_enterHotPath() {
+    hotPathDepth_++;
+}
+
+void freespace_private_leaveHotPath() {
+    hotPathDepth_--;
+}
+#endif
+
+LIBFREESPACE_API int freespace_setAllocator(freespace_mallocFunction mallocFn,
+                                            freespace_freeFunction freeFn,
+                                            void* context) {
+    if ((mallocFn == NULL) != (freeFn == NULL)) {
+        return FREESPACE_ERROR_UNEXPECTED;
+    }
+    if (outstanding_ != 0) {
+        // Memory from the old allocator is still in use
+        return FREESPACE_ERROR_BUSY;
+    }
+
+    mallocFn_ = mallocFn;
+    freeFn_ = freeFn;
+    allocatorContext_ = context;
+    return FREESPACE_SUCCESS;
+}
+
+void* freespace_private_malloc(size_t size) {
+    void* ptr;
+
+#ifdef LIBFREESPACE_ALLOCATION_ASSERTS
+    if (hotPathDepth_ > 0) {
+        fprintf(stderr, "libfreespace: allocation of %u bytes while servicing devices\n", (unsigned int) size);
+        abort();
+    }
+#endif
+
+    if (mallocFn_ != NULL) {
+        ptr = mallocFn_(size, allocatorContext_);
+    } else {
+        ptr = malloc(size);
+    }
+    if (ptr != NULL) {
+        FREESPACE_ATOMIC_INCREMENT(&outstanding_);
+    }
+    return ptr;
+}
+
+void* freespace_private_calloc(size_t size) {
+    void* ptr = freespace_private_malloc(size);
+    if (ptr != NULL) {
+        memset(ptr, 0, size);
+    }
+    return ptr;
+}
+
+void freespace_private_free(void* ptr) {
+    if (ptr == NULL) {
+        return;
+    }
+    FREESPACE_ATOMIC_DECREMENT(&outstanding_);
+    if (freeFn_ != NULL) {
+        freeFn_(ptr, allocatorContext_);
+    } else {
+        free(ptr);
+    }
+}
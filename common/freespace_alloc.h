@@ -0,0 +1,50 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _FREESPACE_ALLOC_H_
+#define _FREESPACE_ALLOC_H_
+
+#include "freespace/freespace.h"
+
+/**
+ * All heap allocations made by the library go through these so that they
+ * use the allocator given to freespace_setAllocator().
+ */
+void* freespace_private_malloc(size_t size);
+
+/**
+ * Like freespace_private_malloc() but the memory is zeroed.
+ */
+void* freespace_private_calloc(size_t size);
+
+void freespace_private_free(void* ptr);
+
+#ifdef LIBFREESPACE_ALLOCATION_ASSERTS
+/**
+ * Mark the code that services open devices (receives and sends). An
+ * allocation made by the library in between aborts the process.
+ */
+void freespace_private_enterHotPath();
+void freespace_private_leaveHotPath();
+#define FREESPACE_HOT_PATH_BEGIN() freespace_private_enterHotPath()
+#define FREESPACE_HOT_PATH_END() freespace_private_leaveHotPath()
+#else
+#define FREESPACE_HOT_PATH_BEGIN()
+#define FREESPACE_HOT_PATH_END()
+#endif
+
+#endif // _FREESPACE_ALLOC_H_
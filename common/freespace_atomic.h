@@ -0,0 +1,46 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _FREESPACE_ATOMIC_H_
+#define _FREESPACE_ATOMIC_H_
+
+/**
+ * Atomic operations shared by the lock-free parts of the library. The
+ * integer operations work on volatile long.
+ */
+#ifdef _WIN32
+#include <windows.h>
+#define FREESPACE_ATOMIC_CAS(ptr, oldValue, newValue) \
+    (InterlockedCompareExchange((ptr), (newValue), (oldValue)) == (oldValue))
+#define FREESPACE_ATOMIC_CAS_POINTER(ptr, oldValue, newValue) \
+    (InterlockedCompareExchangePointer((PVOID volatile*) (ptr), (newValue), (oldValue)) == (oldValue))
+#define FREESPACE_ATOMIC_INCREMENT(ptr) InterlockedIncrement(ptr)
+#define FREESPACE_ATOMIC_DECREMENT(ptr) InterlockedDecrement(ptr)
+#define FREESPACE_ATOMIC_BARRIER() MemoryBarrier()
+#define FREESPACE_THREAD_LOCAL __declspec(thread)
+#define FREESPACE_UNLIKELY(x) (x)
+#else
+#define FREESPACE_ATOMIC_CAS(ptr, oldValue, newValue) __sync_bool_compare_and_swap((ptr), (oldValue), (newValue))
+#define FREESPACE_ATOMIC_CAS_POINTER(ptr, oldValue, newValue) __sync_bool_compare_and_swap((ptr), (oldValue), (newValue))
+#define FREESPACE_ATOMIC_INCREMENT(ptr) __sync_add_and_fetch((ptr), 1)
+#define FREESPACE_ATOMIC_DECREMENT(ptr) __sync_sub_and_fetch((ptr), 1)
+#define FREESPACE_ATOMIC_BARRIER() __sync_synchronize()
+#define FREESPACE_THREAD_LOCAL __thread
+#define FREESPACE_UNLIKELY(x) __builtin_expect(!!(x), 0)
+#endif
+
+#endif // _FREESPACE_ATOMIC_H_
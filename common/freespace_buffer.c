@@ -0,0 +1,110 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "freespace_buffer.h"
+#include "freespace_alloc.h"
+#include "freespace_atomic.h"
+
+// Buffers are allocated this many at a time
+#define FREESPACE_BUFFER_CHUNK_SIZE 32
+
+struct FreespaceBufferChunk {
+    struct FreespaceBufferChunk* next_;
+    struct FreespaceBuffer buffers_[FREESPACE_BUFFER_CHUNK_SIZE];
+};
+
+// Chunks are only ever added, at the front, until freespace_exit. This
+// lets buffers be released from any thread without a lock: a release is
+// just the reference count dropping to 0.
+static struct FreespaceBufferChunk* volatile chunks_ = NULL;
+
+// Buffers in the pool and buffers promised to open devices. Only
+// changed by opens and closes, on the thread calling the library.
+static int capacity_ = 0;
+static int reserved_ = 0;
+
+struct FreespaceBuffer* freespace_private_bufferAcquire() {
+    struct FreespaceBufferChunk* chunk;
+    int i;
+
+    for (chunk = chunks_; chunk != NULL; chunk = chunk->next_) {
+        for (i = 0; i < FREESPACE_BUFFER_CHUNK_SIZE; i++) {
+            struct FreespaceBuffer* buffer = &chunk->buffers_[i];
+            if (buffer->refCount_ == 0 && FREESPACE_ATOMIC_CAS(&buffer->refCount_, 0, 1)) {
+                buffer->length_ = 0;
+                return buffer;
+            }
+        }
+    }
+
+    // Everything is lent out. This runs while receiving, so rather than
+    // grow the pool the report goes without a buffer.
+    return NULL;
+}
+
+int freespace_private_bufferReserve(int count) {
+    struct FreespaceBufferChunk* chunk;
+    struct FreespaceBufferChunk* head;
+
+    while (capacity_ < reserved_ + count) {
+        chunk = (struct FreespaceBufferChunk*) freespace_private_calloc(sizeof(struct FreespaceBufferChunk));
+        if (chunk == NULL) {
+            return FREESPACE_ERROR_OUT_OF_MEMORY;
+        }
+        do {
+            head = chunks_;
+            chunk->next_ = head;
+        } while (!FREESPACE_ATOMIC_CAS_POINTER(&chunks_, head, chunk));
+        capacity_ += FREESPACE_BUFFER_CHUNK_SIZE;
+    }
+    reserved_ += count;
+    return FREESPACE_SUCCESS;
+}
+
+void freespace_private_bufferUnreserve(int count) {
+    reserved_ -= count;
+}
+
+void freespace_private_bufferExit() {
+    struct FreespaceBufferChunk* chunk = chunks_;
+
+    chunks_ = NULL;
+    capacity_ = 0;
+    reserved_ = 0;
+    while (chunk != NULL) {
+        struct FreespaceBufferChunk* next = chunk->next_;
+        freespace_private_free(chunk);
+        chunk = next;
+    }
+}
+
+LIBFREESPACE_API const uint8_t* freespace_bufferData(const struct FreespaceBuffer* buffer) {
+    return buffer->data_;
+}
+
+LIBFREESPACE_API int freespace_bufferLength(const struct FreespaceBuffer* buffer) {
+    return buffer->length_;
+}
+
+LIBFREESPACE_API void freespace_bufferRetain(struct FreespaceBuffer* buffer) {
+    FREESPACE_ATOMIC_INCREMENT(&buffer->refCount_);
+}
+
+LIBFREESPACE_API void freespace_bufferRelease(struct FreespaceBuffer* buffer) {
+    // The buffer goes back to the pool when this reaches 0
+    FREESPACE_ATOMIC_DECREMENT(&buffer->refCount_);
+}
@@ -0,0 +1,69 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _FREESPACE_BUFFER_H_
+#define _FREESPACE_BUFFER_H_
+
+#include "freespace/freespace.h"
+
+/**
+ * A pooled receive buffer. The backends read reports straight into
+ * data_ and lend the buffer to the receive buffer callback, which may
+ * keep it after returning by retaining it.
+ */
+struct FreespaceBuffer {
+    // 0 while the buffer is free in the pool
+    volatile long refCount_;
+    int length_;
+    uint8_t data_[FREESPACE_MAX_INPUT_MESSAGE_SIZE];
+};
+
+// Buffers each open device may have lent out, and retained by the
+// application, on top of the ones it receives into
+#define FREESPACE_BUFFER_LEND_SLACK 8
+
+/**
+ * Take a free buffer from the pool. The pool is only grown by
+ * freespace_private_bufferReserve(), so this never allocates. The
+ * buffer is returned with one reference, which is given up with
+ * freespace_bufferRelease().
+ *
+ * @return the buffer or NULL if every buffer is in use
+ */
+struct FreespaceBuffer* freespace_private_bufferAcquire();
+
+/**
+ * Grow the pool so that it holds every buffer reserved so far plus
+ * count more. Called when a device is opened.
+ *
+ * @return FREESPACE_SUCCESS or FREESPACE_ERROR_OUT_OF_MEMORY
+ */
+int freespace_private_bufferReserve(int count);
+
+/**
+ * Give back a reservation when a device is closed. The pool does not
+ * shrink until freespace_private_bufferExit().
+ */
+void freespace_private_bufferUnreserve(int count);
+
+/**
+ * Free the pool. Buffers still retained by the application become
+ * invalid. Called from freespace_exit().
+ */
+void freespace_private_bufferExit();
+
+#endif // _FREESPACE_BUFFER_H_
@@ -0,0 +1,477 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "freespace_configure.h"
+#include "freespace_alloc.h"
+#include "freespace_log.h"
+
+#include <string.h>
+
+#define WARN(...) FREESPACE_LOG(FREESPACE_LOG_BACKEND, FREESPACE_LOG_LEVEL_WARN, __VA_ARGS__)
+
+/*
+ * Each device of a configuration works through the steps below on its
+ * own, one freespace_request at a time, so all the devices are
+ * configured at once. The data mode and sensor periods in effect are
+ * read back first. When a later step fails, every setting that was sent
+ * is put back to what was read before the device is reported. The
+ * reorientation and BMS requests have no response, so they go last and
+ * count as done once sent.
+ */
+#define CONFIG_SEND_TIMEOUT_MS 100
+
+enum ConfigStep {
+    CONFIG_SAVE_MODE,
+    CONFIG_SAVE_PERIODS,
+    CONFIG_SET_MODE,
+    CONFIG_SET_PERIODS,
+    CONFIG_SET_REORIENTATION,
+    CONFIG_SET_BMS,
+    CONFIG_DONE
+};
+
+struct ConfigTransaction;
+
+struct ConfigDevice {
+    struct ConfigTransaction* transaction_;
+    int index_;
+    FreespaceDeviceId id_;
+    enum ConfigStep step_;
+    // The sensor being read or set
+    int sensor_;
+    int result_;
+    // Set once a setting has been sent, whether or not it was confirmed
+    int modeSent_;
+    int periodsSent_;
+    struct freespace_DataModeControlV2Response savedMode_;
+    uint32_t savedPeriods_[FREESPACE_CONFIG_MAX_SENSORS];
+};
+
+struct ConfigTransaction {
+    struct FreespaceConfigProfile profile_;
+    unsigned int timeoutMs_;
+    int started_;
+    int count_;
+    int remaining_;
+    FreespaceDeviceId* ids_;
+    int* results_;
+    struct ConfigDevice* devices_;
+    freespace_configCallback callback_;
+    void* cookie_;
+    struct ConfigTransaction* next_;
+};
+
+static struct ConfigTransaction* transactions_ = NULL;
+
+static void advance(struct ConfigDevice* device);
+static void rollBack(struct ConfigDevice* device);
+
+static void freeTransaction(struct ConfigTransaction* transaction) {
+    freespace_private_free(transaction->devices_);
+    freespace_private_free(transaction->results_);
+    freespace_private_free(transaction->ids_);
+    freespace_private_free(transaction);
+}
+
+static void unlinkTransaction(struct ConfigTransaction* transaction) {
+    struct ConfigTransaction** link = &transactions_;
+
+    while (*link != transaction) {
+        link = &(*link)->next_;
+    }
+    *link = transaction->next_;
+}
+
+// Drop a device's hold on the transaction; the last one reports it
+static void release(struct ConfigTransaction* transaction) {
+    if (--transaction->remaining_ > 0) {
+        return;
+    }
+    unlinkTransaction(transaction);
+    if (transaction->callback_ != NULL) {
+        transaction->callback_(transaction->ids_, transaction->results_, transaction->count_,
+                               transaction->cookie_);
+    }
+    freeTransaction(transaction);
+}
+
+static void finishDevice(struct ConfigDevice* device, int result) {
+    device->step_ = CONFIG_DONE;
+    device->transaction_->results_[device->index_] = result;
+    release(device->transaction_);
+}
+
+static void fail(struct ConfigDevice* device, int result) {
+    device->result_ = result;
+    device->step_ = CONFIG_DONE;
+    if (result == FREESPACE_ERROR_NO_DEVICE) {
+        // Closed or gone, so there is nothing to restore
+        finishDevice(device, result);
+        return;
+    }
+    rollBack(device);
+}
+
+static void fillMode(struct freespace_message* m, int mode, uint8_t packetSelect,
+                     uint8_t formatSelect, uint8_t formatFlags) {
+    memset(m, 0, sizeof(*m));
+    m->messageType = FREESPACE_MESSAGE_DATAMODECONTROLV2REQUEST;
+    m->dataModeControlV2Request.mode = mode;
+    m->dataModeControlV2Request.packetSelect = packetSelect;
+    m->dataModeControlV2Request.formatSelect = formatSelect;
+    m->dataModeControlV2Request.ff0 = (formatFlags >> 0) & 1;
+    m->dataModeControlV2Request.ff1 = (formatFlags >> 1) & 1;
+    m->dataModeControlV2Request.ff2 = (formatFlags >> 2) & 1;
+    m->dataModeControlV2Request.ff3 = (formatFlags >> 3) & 1;
+    m->dataModeControlV2Request.ff4 = (formatFlags >> 4) & 1;
+    m->dataModeControlV2Request.ff5 = (formatFlags >> 5) & 1;
+    m->dataModeControlV2Request.ff6 = (formatFlags >> 6) & 1;
+    m->dataModeControlV2Request.ff7 = (formatFlags >> 7) & 1;
+}
+
+static uint8_t formatFlagsOf(const struct freespace_DataModeControlV2Response* r) {
+    return (uint8_t) ((r->ff0 & 1) | (r->ff1 & 1) << 1 | (r->ff2 & 1) << 2 | (r->ff3 & 1) << 3 |
+                      (r->ff4 & 1) << 4 | (r->ff5 & 1) << 5 | (r->ff6 & 1) << 6 | (r->ff7 & 1) << 7);
+}
+
+static void fillPeriod(struct freespace_message* m, int get, uint8_t sensor, uint32_t period) {
+    memset(m, 0, sizeof(*m));
+    m->messageType = FREESPACE_MESSAGE_SENSORPERIODREQUEST;
+    m->sensorPeriodRequest.commit = get ? 0 : 1;
+    m->sensorPeriodRequest.get = (uint8_t) get;
+    m->sensorPeriodRequest.sensor = sensor;
+    m->sensorPeriodRequest.period = period;
+}
+
+static void onRollBack(FreespaceDeviceId id, struct freespace_message* response, void* cookie, int result) {
+    struct ConfigDevice* device = (struct ConfigDevice*) cookie;
+
+    if (result == FREESPACE_ERROR_NO_DEVICE) {
+        // Closed while rolling back, so the rest cannot be restored
+        finishDevice(device, device->result_);
+        return;
+    }
+    if (result != FREESPACE_SUCCESS) {
+        WARN("config on device %d: could not restore a setting: %d", id, result);
+    }
+    rollBack(device);
+}
+
+// Undo the settings that were sent, latest first, then report the device
+static void rollBack(struct ConfigDevice* device) {
+    const struct FreespaceConfigProfile* profile = &device->transaction_->profile_;
+    unsigned int timeoutMs = device->transaction_->timeoutMs_;
+    struct freespace_message m;
+
+    while (device->periodsSent_ > 0 || device->modeSent_) {
+        int rc;
+        if (device->periodsSent_ > 0) {
+            int i = --device->periodsSent_;
+            fillPeriod(&m, 0, profile->sensors[i].sensor, device->savedPeriods_[i]);
+            rc = freespace_request(device->id_, &m, FREESPACE_MESSAGE_SENSORPERIODRESPONSE,
+                                   timeoutMs, onRollBack, device);
+        } else {
+            const struct freespace_DataModeControlV2Response* saved = &device->savedMode_;
+            device->modeSent_ = 0;
+            fillMode(&m, saved->mode, saved->packetSelect, saved->formatSelect, formatFlagsOf(saved));
+            rc = freespace_request(device->id_, &m, FREESPACE_MESSAGE_DATAMODECONTROLV2RESPONSE,
+                                   timeoutMs, onRollBack, device);
+        }
+        if (rc == FREESPACE_SUCCESS) {
+            return;
+        }
+        WARN("config on device %d: could not restore a setting: %d", device->id_, rc);
+        if (rc == FREESPACE_ERROR_NO_DEVICE) {
+            break;
+        }
+    }
+    finishDevice(device, device->result_);
+}
+
+static int modeTaken(const struct FreespaceConfigProfile* profile,
+                     const struct freespace_DataModeControlV2Response* r) {
+    return r->mode == profile->mode &&
+           r->packetSelect == profile->packetSelect &&
+           r->formatSelect == profile->formatSelect &&
+           formatFlagsOf(r) == profile->formatFlags;
+}
+
+static void onResponse(FreespaceDeviceId id, struct freespace_message* response, void* cookie, int result) {
+    struct ConfigDevice* device = (struct ConfigDevice*) cookie;
+    const struct FreespaceConfigProfile* profile = &device->transaction_->profile_;
+
+    if (result != FREESPACE_SUCCESS) {
+        fail(device, result);
+        return;
+    }
+    switch (device->step_) {
+        case CONFIG_SAVE_MODE:
+            device->savedMode_ = response->dataModeControlV2Response;
+            device->step_ = CONFIG_SAVE_PERIODS;
+            break;
+
+        case CONFIG_SAVE_PERIODS:
+            if (response->sensorPeriodResponse.sensor != profile->sensors[device->sensor_].sensor) {
+                fail(device, FREESPACE_ERROR_UNEXPECTED);
+                return;
+            }
+            device->savedPeriods_[device->sensor_++] = response->sensorPeriodResponse.period;
+            break;
+
+        case CONFIG_SET_MODE:
+            if (!modeTaken(profile, &response->dataModeControlV2Response)) {
+                WARN("config on device %d: data mode not taken", id);
+                fail(device, FREESPACE_ERROR_UNEXPECTED);
+                return;
+            }
+            device->step_ = CONFIG_SET_PERIODS;
+            break;
+
+        case CONFIG_SET_PERIODS:
+            if (response->sensorPeriodResponse.sensor != profile->sensors[device->sensor_].sensor ||
+                response->sensorPeriodResponse.period != profile->sensors[device->sensor_].period) {
+                WARN("config on device %d: period of sensor %d not taken",
+                     id, profile->sensors[device->sensor_].sensor);
+                fail(device, FREESPACE_ERROR_UNEXPECTED);
+                return;
+            }
+            device->sensor_++;
+            break;
+
+        default:
+            return;
+    }
+    advance(device);
+}
+
+static int sendReorientation(const struct ConfigDevice* device) {
+    const struct FreespaceConfigProfile* profile = &device->transaction_->profile_;
+    struct freespace_message m;
+    int rc;
+
+    memset(&m, 0, sizeof(m));
+    m.messageType = FREESPACE_MESSAGE_REORIENTATIONREQUEST;
+    m.reorientationRequest.select = 0;
+    m.reorientationRequest.quaternionParameter1 = profile->reorientation[0];
+    m.reorientationRequest.quaternionParameter2 = profile->reorientation[1];
+    rc = freespace_sendMessageAsync(device->id_, &m, CONFIG_SEND_TIMEOUT_MS, NULL, NULL);
+    if (rc != FREESPACE_SUCCESS) {
+        return rc;
+    }
+    m.reorientationRequest.select = 1;
+    m.reorientationRequest.commit = 1;
+    m.reorientationRequest.quaternionParameter1 = profile->reorientation[2];
+    m.reorientationRequest.quaternionParameter2 = profile->reorientation[3];
+    return freespace_sendMessageAsync(device->id_, &m, CONFIG_SEND_TIMEOUT_MS, NULL, NULL);
+}
+
+// Send the next request of the device's current step, skipping the
+// steps the profile leaves out
+static void advance(struct ConfigDevice* device) {
+    const struct FreespaceConfigProfile* profile = &device->transaction_->profile_;
+    unsigned int timeoutMs = device->transaction_->timeoutMs_;
+    int modes = (profile->parts & FREESPACE_CONFIG_DATA_MODE) != 0;
+    int periods = (profile->parts & FREESPACE_CONFIG_SENSOR_PERIODS) != 0 ? profile->sensorCount : 0;
+    struct freespace_message m;
+    int rc;
+
+    for (;;) {
+        switch (device->step_) {
+            case CONFIG_SAVE_MODE:
+                if (!modes) {
+                    device->step_ = CONFIG_SAVE_PERIODS;
+                    continue;
+                }
+                memset(&m, 0, sizeof(m));
+                m.messageType = FREESPACE_MESSAGE_DATAMODECONTROLV2REQUEST;
+                m.dataModeControlV2Request.operatingStatus = 1;
+                m.dataModeControlV2Request.outputStatus = 1;
+                rc = freespace_request(device->id_, &m, FREESPACE_MESSAGE_DATAMODECONTROLV2RESPONSE,
+                                       timeoutMs, onResponse, device);
+                break;
+
+            case CONFIG_SAVE_PERIODS:
+                if (device->sensor_ >= periods) {
+                    device->sensor_ = 0;
+                    device->step_ = CONFIG_SET_MODE;
+                    continue;
+                }
+                fillPeriod(&m, 1, profile->sensors[device->sensor_].sensor, 0);
+                rc = freespace_request(device->id_, &m, FREESPACE_MESSAGE_SENSORPERIODRESPONSE,
+                                       timeoutMs, onResponse, device);
+                break;
+
+            case CONFIG_SET_MODE:
+                if (!modes) {
+                    device->step_ = CONFIG_SET_PERIODS;
+                    continue;
+                }
+                fillMode(&m, profile->mode, profile->packetSelect, profile->formatSelect, profile->formatFlags);
+                rc = freespace_request(device->id_, &m, FREESPACE_MESSAGE_DATAMODECONTROLV2RESPONSE,
+                                       timeoutMs, onResponse, device);
+                device->modeSent_ = (rc == FREESPACE_SUCCESS);
+                break;
+
+            case CONFIG_SET_PERIODS:
+                if (device->sensor_ >= periods) {
+                    device->step_ = CONFIG_SET_REORIENTATION;
+                    continue;
+                }
+                fillPeriod(&m, 0, profile->sensors[device->sensor_].sensor,
+                           profile->sensors[device->sensor_].period);
+                rc = freespace_request(device->id_, &m, FREESPACE_MESSAGE_SENSORPERIODRESPONSE,
+                                       timeoutMs, onResponse, device);
+                if (rc == FREESPACE_SUCCESS) {
+                    device->periodsSent_ = device->sensor_ + 1;
+                }
+                break;
+
+            case CONFIG_SET_REORIENTATION:
+                device->step_ = CONFIG_SET_BMS;
+                if ((profile->parts & FREESPACE_CONFIG_REORIENTATION) == 0) {
+                    continue;
+                }
+                rc = sendReorientation(device);
+                if (rc == FREESPACE_SUCCESS) {
+                    continue;
+                }
+                break;
+
+            case CONFIG_SET_BMS:
+                device->step_ = CONFIG_DONE;
+                if ((profile->parts & FREESPACE_CONFIG_BMS) == 0) {
+                    continue;
+                }
+                memset(&m, 0, sizeof(m));
+                m.messageType = FREESPACE_MESSAGE_BMSREQUEST;
+                m.bmsRequest.bmsRequest = profile->bmsRequest;
+                rc = freespace_sendMessageAsync(device->id_, &m, CONFIG_SEND_TIMEOUT_MS, NULL, NULL);
+                if (rc == FREESPACE_SUCCESS) {
+                    continue;
+                }
+                break;
+
+            default:
+                finishDevice(device, FREESPACE_SUCCESS);
+                return;
+        }
+        if (rc != FREESPACE_SUCCESS) {
+            fail(device, rc);
+        }
+        return;
+    }
+}
+
+LIBFREESPACE_API int freespace_configureAsync(const FreespaceDeviceId* ids,
+                                              int count,
+                                              const struct FreespaceConfigProfile* profile,
+                                              unsigned int timeoutMs,
+                                              freespace_configCallback callback,
+                                              void* cookie) {
+    struct ConfigTransaction* transaction;
+    struct FreespaceDeviceInfo info;
+    int i;
+    int rc;
+
+    if (ids == NULL || count <= 0 || profile == NULL || profile->parts == 0 ||
+        (profile->parts & ~(FREESPACE_CONFIG_DATA_MODE | FREESPACE_CONFIG_SENSOR_PERIODS |
+                            FREESPACE_CONFIG_REORIENTATION | FREESPACE_CONFIG_BMS)) != 0 ||
+        ((profile->parts & FREESPACE_CONFIG_SENSOR_PERIODS) != 0 &&
+         (profile->sensorCount <= 0 || profile->sensorCount > FREESPACE_CONFIG_MAX_SENSORS))) {
+        return FREESPACE_ERROR_UNEXPECTED;
+    }
+    for (i = 0; i < count; i++) {
+        rc = freespace_getDeviceInfo(ids[i], &info);
+        if (rc != FREESPACE_SUCCESS) {
+            return rc;
+        }
+    }
+
+    transaction = (struct ConfigTransaction*) freespace_private_calloc(sizeof(struct ConfigTransaction));
+    if (transaction == NULL) {
+        return FREESPACE_ERROR_OUT_OF_MEMORY;
+    }
+    transaction->ids_ = (FreespaceDeviceId*) freespace_private_calloc(count * sizeof(FreespaceDeviceId));
+    transaction->results_ = (int*) freespace_private_calloc(count * sizeof(int));
+    transaction->devices_ = (struct ConfigDevice*) freespace_private_calloc(count * sizeof(struct ConfigDevice));
+    if (transaction->ids_ == NULL || transaction->results_ == NULL || transaction->devices_ == NULL) {
+        freeTransaction(transaction);
+        return FREESPACE_ERROR_OUT_OF_MEMORY;
+    }
+    transaction->profile_ = *profile;
+    transaction->timeoutMs_ = timeoutMs;
+    transaction->count_ = count;
+    transaction->remaining_ = count;
+    transaction->callback_ = callback;
+    transaction->cookie_ = cookie;
+    for (i = 0; i < count; i++) {
+        struct ConfigDevice* device = &transaction->devices_[i];
+        transaction->ids_[i] = ids[i];
+        device->transaction_ = transaction;
+        device->index_ = i;
+        device->id_ = ids[i];
+        device->step_ = CONFIG_SAVE_MODE;
+    }
+
+    // Started from freespace_perform, so the callback never runs before
+    // this returns
+    transaction->next_ = transactions_;
+    transactions_ = transaction;
+    return FREESPACE_SUCCESS;
+}
+
+void freespace_private_configNextTimeout(int* timeoutMs) {
+    struct ConfigTransaction* transaction;
+
+    for (transaction = transactions_; transaction != NULL; transaction = transaction->next_) {
+        if (!transaction->started_) {
+            *timeoutMs = 0;
+            return;
+        }
+    }
+}
+
+void freespace_private_configPerform() {
+    struct ConfigTransaction* transaction = transactions_;
+
+    while (transaction != NULL) {
+        int i;
+        if (transaction->started_) {
+            transaction = transaction->next_;
+            continue;
+        }
+        // Devices can finish as they are started, so hold the transaction
+        // until the last one is under way.
+        transaction->started_ = 1;
+        transaction->remaining_++;
+        for (i = 0; i < transaction->count_; i++) {
+            advance(&transaction->devices_[i]);
+        }
+        release(transaction);
+        // The callback may have changed the list
+        transaction = transactions_;
+    }
+}
+
+void freespace_private_configExit() {
+    while (transactions_ != NULL) {
+        struct ConfigTransaction* next = transactions_->next_;
+        freeTransaction(transactions_);
+        transactions_ = next;
+    }
+}
@@ -0,0 +1,43 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _FREESPACE_CONFIGURE_H_
+#define _FREESPACE_CONFIGURE_H_
+
+#include "freespace/freespace.h"
+
+/**
+ * Lower timeoutMs to 0 if a configuration is waiting to be started.
+ * A negative timeoutMs means no timeout yet.
+ */
+void freespace_private_configNextTimeout(int* timeoutMs);
+
+/**
+ * Start the configurations queued by freespace_configureAsync(). Called
+ * from freespace_perform() ahead of freespace_private_requestPerform(),
+ * so the first requests go out in the same call.
+ */
+void freespace_private_configPerform();
+
+/**
+ * Free all configurations without calling their callbacks. Called from
+ * freespace_exit().
+ */
+void freespace_private_configExit();
+
+#endif // _FREESPACE_CONFIGURE_H_
@@ -0,0 +1,941 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "freespace_frs.h"
+#include "freespace_frsCache.h"
+#include "freespace_frsWrite.h"
+#include "freespace_alloc.h"
+#include "freespace_log.h"
+
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#define WARN(...) FREESPACE_LOG(FREESPACE_LOG_BACKEND, FREESPACE_LOG_LEVEL_WARN, __VA_ARGS__)
+#define DEBUG(...) FREESPACE_LOG(FREESPACE_LOG_BACKEND, FREESPACE_LOG_LEVEL_DEBUG, __VA_ARGS__)
+
+/*
+ * A record is read as a series of block requests. Each response carries
+ * the word offset of its data, so words are stored where they belong
+ * whatever order the responses come in, and a bitmap tracks which have
+ * arrived. When a block completes the next one is requested from the
+ * receive path without waiting for freespace_perform. Words that went
+ * missing are asked for again when their block completes or times out.
+ *
+ * The word buffer only grows from freespace_perform, never while a
+ * report is being delivered; a block is not requested until there is
+ * room for it.
+ *
+ * With a cache directory set, the device is first asked for its
+ * product ID, once per open. A record cached for that identity is
+ * handed to the callback straight from its mapped file; otherwise the
+ * record read from the device is stored for next time.
+ */
+#define FRS_MAX_WORDS 65536
+#define FRS_MAX_WINDOW 8
+#define FRS_DEFAULT_BLOCK_WORDS 32
+#define FRS_DEFAULT_WINDOW 1
+#define FRS_INITIAL_CAPACITY 256
+#define FRS_SEND_TIMEOUT_MS 100
+#define FRS_RESPONSE_TIMEOUT_MS 500
+#define FRS_BUSY_RETRY_MS 20
+#define FRS_MAX_RETRIES 5
+
+// Words a response of the given type has room for
+#define FRS_DATA_WORDS(response) ((int) (sizeof((response).data) / sizeof(uint32_t)))
+
+#define FRS_TARGET_MASK (FREESPACE_FRS_DONGLE | FREESPACE_FRS_EFLASH)
+
+// Response status codes
+#define FRS_STATUS_OK 0
+#define FRS_STATUS_UNRECOGNIZED 1
+#define FRS_STATUS_BUSY 2
+#define FRS_STATUS_RECORD_DONE 3
+#define FRS_STATUS_OUT_OF_RANGE 4
+#define FRS_STATUS_EMPTY 5
+#define FRS_STATUS_BLOCK_DONE 6
+#define FRS_STATUS_BOTH_DONE 7
+
+enum FrsPhase {
+    // Waiting for the product ID that keys the cache
+    FRS_PHASE_IDENTIFY = 0,
+    // Found in the cache; completed by the next freespace_perform
+    FRS_PHASE_CACHED,
+    // Reading from the device
+    FRS_PHASE_READ,
+    // Identified; the next freespace_perform looks in the cache. The
+    // cache is never touched from the receive path.
+    FRS_PHASE_LOOKUP,
+    // Read in full; stored and completed by the next freespace_perform
+    FRS_PHASE_STORE
+};
+
+enum FrsIdentity {
+    FRS_IDENTITY_UNKNOWN = 0,
+    FRS_IDENTITY_KNOWN,
+    // The device did not say; read it without the cache until reopened
+    FRS_IDENTITY_NONE
+};
+
+enum FrsBlockState {
+    FRS_BLOCK_FREE = 0,
+    // Waiting for its deadline to be (re)sent
+    FRS_BLOCK_DUE,
+    // Sent; the deadline is when to give up waiting for a response
+    FRS_BLOCK_SENT
+};
+
+struct FrsBlock {
+    int state_;
+    int offset_;
+    int size_;
+    int retries_;
+    int64_t deadline_;
+};
+
+struct FrsRead {
+    int active_;
+    int phase_;
+    int frsType_;
+    int target_;
+    int hVer_;
+    freespace_frsReadCallback callback_;
+    void* cookie_;
+
+    uint32_t* words_;
+    uint32_t* received_;
+    int capacity_;
+    int receivedCount_;
+
+    // The record is known to end at or before limit_ once a response
+    // says so; length_ is set when the last word has been seen.
+    int limit_;
+    int length_;
+    // The first word not yet covered by a block request
+    int nextOffset_;
+
+    // While identifying, blocks_[0] stands for the product ID request
+    struct FrsBlock blocks_[FRS_MAX_WINDOW];
+
+    struct FreespaceFRSCacheEntry cached_;
+
+    // Kept from read to read until the device is closed
+    int identity_;
+    struct FreespaceFRSCacheKey key_;
+};
+
+static int blockWords_ = FRS_DEFAULT_BLOCK_WORDS;
+static int window_ = FRS_DEFAULT_WINDOW;
+
+// Indexed by device id like the mailboxes
+static struct FrsRead* reads_[FREESPACE_MAILBOX_MAX_ID];
+
+static int64_t nowMillis() {
+#ifdef _WIN32
+    LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (int64_t) (counter.QuadPart / frequency.QuadPart) * 1000 +
+           (int64_t) (counter.QuadPart % frequency.QuadPart) * 1000 / frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t) ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+#endif
+}
+
+static struct FrsRead* getRead(FreespaceDeviceId id) {
+    if (id < 0 || id >= FREESPACE_MAILBOX_MAX_ID || reads_[id] == NULL || !reads_[id]->active_) {
+        return NULL;
+    }
+    return reads_[id];
+}
+
+static int hasWord(const struct FrsRead* read, int offset) {
+    return (read->received_[offset / 32] & (1u << (offset % 32))) != 0;
+}
+
+// The response type the device answers a read with. Version 2 devices
+// answer with FRSReadResponseBLE over Bluetooth.
+static int responseType(const struct FrsRead* read) {
+    if (read->hVer_ >= 2) {
+        return FREESPACE_MESSAGE_FRSREADRESPONSE;
+    }
+    switch (read->target_) {
+        case FREESPACE_FRS_DONGLE:
+            return FREESPACE_MESSAGE_FRSDONGLEREADRESPONSE;
+        case FREESPACE_FRS_EFLASH:
+            return FREESPACE_MESSAGE_FRSEFLASHREADRESPONSE;
+        default:
+            return FREESPACE_MESSAGE_FRSHANDHELDREADRESPONSE;
+    }
+}
+
+static int sendRequest(FreespaceDeviceId id, const struct FrsRead* read, const struct FrsBlock* block) {
+    struct freespace_message m;
+
+    memset(&m, 0, sizeof(m));
+    if (read->phase_ == FRS_PHASE_IDENTIFY) {
+        m.messageType = FREESPACE_MESSAGE_PRODUCTIDREQUEST;
+    } else if (read->hVer_ >= 2) {
+        m.messageType = FREESPACE_MESSAGE_FRSREADREQUEST;
+        m.fRSReadRequest.readOffset = (uint16_t) block->offset_;
+        m.fRSReadRequest.FRStype = (uint16_t) read->frsType_;
+        m.fRSReadRequest.BlockSize = (uint16_t) block->size_;
+    } else if (read->target_ == FREESPACE_FRS_DONGLE) {
+        m.messageType = FREESPACE_MESSAGE_FRSDONGLEREADREQUEST;
+        m.fRSDongleReadRequest.wordOffset = (uint16_t) block->offset_;
+        m.fRSDongleReadRequest.FRStype = (uint16_t) read->frsType_;
+        m.fRSDongleReadRequest.BlockSize = (uint16_t) block->size_;
+    } else if (read->target_ == FREESPACE_FRS_EFLASH) {
+        m.messageType = FREESPACE_MESSAGE_FRSEFLASHREADREQUEST;
+        m.fRSEFlashReadRequest.wordOffset = (uint16_t) block->offset_;
+        m.fRSEFlashReadRequest.FRStype = (uint16_t) read->frsType_;
+        m.fRSEFlashReadRequest.BlockSize = (uint16_t) block->size_;
+    } else {
+        m.messageType = FREESPACE_MESSAGE_FRSHANDHELDREADREQUEST;
+        m.fRSHandheldReadRequest.wordOffset = (uint16_t) block->offset_;
+        m.fRSHandheldReadRequest.FRStype = (uint16_t) read->frsType_;
+        m.fRSHandheldReadRequest.BlockSize = (uint16_t) block->size_;
+    }
+    return freespace_sendMessageAsync(id, &m, FRS_SEND_TIMEOUT_MS, NULL, NULL);
+}
+
+// End the read and hand the record to the callback. The callback may
+// start another read on the device, so the buffers are detached first.
+// A record that goes in the cache is left for freespace_perform to store
+// and complete, as this may be running on the receive path.
+static void finish(FreespaceDeviceId id, struct FrsRead* read, int result) {
+    uint32_t* owned = read->words_;
+    const uint32_t* words = owned;
+    struct FreespaceFRSCacheEntry cached = read->cached_;
+    int fromCache = read->phase_ == FRS_PHASE_CACHED;
+    freespace_frsReadCallback callback = read->callback_;
+    void* cookie = read->cookie_;
+    int frsType = read->frsType_ | read->target_;
+    int length = result == FREESPACE_SUCCESS ? read->length_ : 0;
+
+    if (fromCache) {
+        words = result == FREESPACE_SUCCESS ? cached.words_ : NULL;
+        length = result == FREESPACE_SUCCESS ? cached.wordCount_ : 0;
+    } else if (result == FREESPACE_SUCCESS && read->identity_ == FRS_IDENTITY_KNOWN &&
+               freespace_private_frsCacheEnabled()) {
+        if (read->phase_ != FRS_PHASE_STORE) {
+            read->phase_ = FRS_PHASE_STORE;
+            return;
+        }
+        read->key_.frsType_ = (uint32_t) frsType;
+        freespace_private_frsCacheStore(&read->key_, words, length);
+    }
+
+    freespace_private_free(read->received_);
+    read->active_ = 0;
+    read->phase_ = FRS_PHASE_READ;
+    read->words_ = NULL;
+    read->received_ = NULL;
+
+    DEBUG("FRS read of type 0x%x on device %d done: %d words%s, result %d",
+          frsType, id, length, fromCache ? " from the cache" : "", result);
+    callback(id, frsType, words, length, cookie, result);
+    freespace_private_free(owned);
+    if (fromCache) {
+        freespace_private_frsCacheRelease(&cached);
+    }
+}
+
+// Give the block a fresh deadline and send it now, or later if it could
+// not be sent. Returns 0 if the read was ended.
+static int issueBlock(FreespaceDeviceId id, struct FrsRead* read, struct FrsBlock* block) {
+    int rc = sendRequest(id, read, block);
+
+    if (rc == FREESPACE_SUCCESS) {
+        block->state_ = FRS_BLOCK_SENT;
+        block->deadline_ = nowMillis() + FRS_RESPONSE_TIMEOUT_MS;
+        return 1;
+    }
+    if (rc == FREESPACE_ERROR_NO_DEVICE || rc == FREESPACE_ERROR_INVALID_DEVICE) {
+        finish(id, read, rc);
+        return 0;
+    }
+    if (++block->retries_ > FRS_MAX_RETRIES) {
+        finish(id, read, rc);
+        return 0;
+    }
+    block->state_ = FRS_BLOCK_DUE;
+    block->deadline_ = nowMillis() + FRS_BUSY_RETRY_MS;
+    return 1;
+}
+
+// Narrow the block down to the words in it that are still missing.
+// Returns 0 if there are none.
+static int trimBlock(const struct FrsRead* read, struct FrsBlock* block) {
+    int start = block->offset_;
+    int end = block->offset_ + block->size_;
+
+    if (end > read->limit_) {
+        end = read->limit_;
+    }
+    while (start < end && hasWord(read, start)) {
+        start++;
+    }
+    while (end > start && hasWord(read, end - 1)) {
+        end--;
+    }
+    block->offset_ = start;
+    block->size_ = end - start;
+    return block->size_ > 0;
+}
+
+// Done once every word up to the end of the record is in and nothing is
+// outstanding.
+static int complete(const struct FrsRead* read) {
+    int i;
+
+    if (read->nextOffset_ < read->limit_) {
+        return 0;
+    }
+    for (i = 0; i < window_; i++) {
+        if (read->blocks_[i].state_ != FRS_BLOCK_FREE) {
+            return 0;
+        }
+    }
+    // Only scan once enough words have arrived
+    if (read->receivedCount_ < read->limit_) {
+        return 0;
+    }
+    for (i = 0; i < read->limit_; i++) {
+        if (!hasWord(read, i)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Fill the free slots of the window with the next blocks of the record.
+// Returns 0 if the read was ended.
+static int pump(FreespaceDeviceId id, struct FrsRead* read) {
+    int i;
+
+    if (read->phase_ != FRS_PHASE_READ) {
+        return 1;
+    }
+    for (i = 0; i < window_ && read->nextOffset_ < read->limit_; i++) {
+        struct FrsBlock* block = &read->blocks_[i];
+        int size = blockWords_;
+
+        if (block->state_ != FRS_BLOCK_FREE) {
+            continue;
+        }
+        if (read->nextOffset_ + size > read->limit_) {
+            size = read->limit_ - read->nextOffset_;
+        }
+        if (read->nextOffset_ + size > read->capacity_) {
+            // freespace_private_frsPerform makes room
+            break;
+        }
+        block->offset_ = read->nextOffset_;
+        block->size_ = size;
+        block->retries_ = 0;
+        read->nextOffset_ += size;
+        if (!issueBlock(id, read, block)) {
+            return 0;
+        }
+    }
+
+    if (complete(read)) {
+        read->length_ = read->limit_;
+        finish(id, read, FREESPACE_SUCCESS);
+        return 0;
+    }
+    return 1;
+}
+
+// A block is done, or the device says it will not send more of it. Ask
+// again for whatever is missing from it.
+static int endBlock(FreespaceDeviceId id, struct FrsRead* read, struct FrsBlock* block) {
+    if (!trimBlock(read, block)) {
+        block->state_ = FRS_BLOCK_FREE;
+        return 1;
+    }
+    if (++block->retries_ > FRS_MAX_RETRIES) {
+        WARN("FRS read of type 0x%x on device %d is missing words %d to %d",
+             read->frsType_, id, block->offset_, block->offset_ + block->size_ - 1);
+        finish(id, read, FREESPACE_ERROR_TIMEOUT);
+        return 0;
+    }
+    return issueBlock(id, read, block);
+}
+
+static struct FrsBlock* findBlock(struct FrsRead* read, int offset) {
+    int i;
+
+    for (i = 0; i < window_; i++) {
+        struct FrsBlock* block = &read->blocks_[i];
+        if (block->state_ != FRS_BLOCK_FREE &&
+            offset >= block->offset_ && offset < block->offset_ + block->size_) {
+            return block;
+        }
+    }
+    return NULL;
+}
+
+static void handleResponse(FreespaceDeviceId id,
+                           struct FrsRead* read,
+                           int status,
+                           int wordOffset,
+                           const uint32_t* data,
+                           int dataLength,
+                           int maxLength) {
+    struct FrsBlock* block = findBlock(read, wordOffset);
+    int i;
+
+    if (dataLength > maxLength) {
+        dataLength = maxLength;
+    }
+
+    switch (status) {
+        case FRS_STATUS_UNRECOGNIZED:
+            finish(id, read, FREESPACE_ERROR_NOT_FOUND);
+            return;
+
+        case FRS_STATUS_EMPTY:
+            read->length_ = 0;
+            finish(id, read, FREESPACE_SUCCESS);
+            return;
+
+        case FRS_STATUS_BUSY:
+            if (block != NULL) {
+                block->state_ = FRS_BLOCK_DUE;
+                block->deadline_ = nowMillis() + FRS_BUSY_RETRY_MS;
+            }
+            return;
+
+        case FRS_STATUS_OUT_OF_RANGE:
+            // The record ends before this block
+            if (block == NULL) {
+                return;
+            }
+            if (block->offset_ < read->limit_) {
+                read->limit_ = block->offset_;
+            }
+            block->state_ = FRS_BLOCK_FREE;
+            for (i = 0; i < window_; i++) {
+                if (read->blocks_[i].state_ != FRS_BLOCK_FREE && !trimBlock(read, &read->blocks_[i])) {
+                    read->blocks_[i].state_ = FRS_BLOCK_FREE;
+                }
+            }
+            pump(id, read);
+            return;
+
+        case FRS_STATUS_OK:
+        case FRS_STATUS_RECORD_DONE:
+        case FRS_STATUS_BLOCK_DONE:
+        case FRS_STATUS_BOTH_DONE:
+            break;
+
+        default:
+            WARN("FRS read of type 0x%x on device %d: unknown status %d", read->frsType_, id, status);
+            return;
+    }
+
+    for (i = 0; i < dataLength; i++) {
+        int offset = wordOffset + i;
+        if (offset >= read->capacity_) {
+            // Asked for again once there is room
+            break;
+        }
+        read->words_[offset] = data[i];
+        if (!hasWord(read, offset)) {
+            read->received_[offset / 32] |= 1u << (offset % 32);
+            read->receivedCount_++;
+        }
+    }
+
+    if (status == FRS_STATUS_RECORD_DONE || status == FRS_STATUS_BOTH_DONE) {
+        read->limit_ = wordOffset + dataLength;
+        for (i = 0; i < window_; i++) {
+            if (read->blocks_[i].state_ != FRS_BLOCK_FREE && !trimBlock(read, &read->blocks_[i])) {
+                read->blocks_[i].state_ = FRS_BLOCK_FREE;
+            }
+        }
+        if (read->nextOffset_ > read->limit_) {
+            read->nextOffset_ = read->limit_;
+        }
+    }
+
+    if (block != NULL) {
+        if (status != FRS_STATUS_OK) {
+            if (!endBlock(id, read, block)) {
+                return;
+            }
+        } else if (block->state_ == FRS_BLOCK_SENT) {
+            block->deadline_ = nowMillis() + FRS_RESPONSE_TIMEOUT_MS;
+        }
+    }
+    pump(id, read);
+}
+
+// Queue the first block of the record for the device
+static void scheduleReading(struct FrsRead* read) {
+    memset(read->blocks_, 0, sizeof(read->blocks_));
+    read->phase_ = FRS_PHASE_READ;
+    read->blocks_[0].state_ = FRS_BLOCK_DUE;
+    read->blocks_[0].offset_ = 0;
+    read->blocks_[0].size_ = blockWords_;
+    read->blocks_[0].deadline_ = nowMillis();
+    read->nextOffset_ = blockWords_;
+}
+
+static void scheduleIdentify(struct FrsRead* read) {
+    memset(read->blocks_, 0, sizeof(read->blocks_));
+    read->phase_ = FRS_PHASE_IDENTIFY;
+    read->blocks_[0].state_ = FRS_BLOCK_DUE;
+    read->blocks_[0].deadline_ = nowMillis();
+}
+
+// Returns 1 and maps the record if it is in the cache
+static int lookupCache(struct FrsRead* read) {
+    read->key_.frsType_ = (uint32_t) (read->frsType_ | read->target_);
+    if (freespace_private_frsCacheLookup(&read->key_, &read->cached_) == FREESPACE_SUCCESS) {
+        read->phase_ = FRS_PHASE_CACHED;
+        return 1;
+    }
+    freespace_private_frsCacheRelease(&read->cached_);
+    return 0;
+}
+
+// The device stopped answering product ID requests, or never gave a
+// valid serial number
+static void giveUpIdentify(struct FrsRead* read) {
+    read->identity_ = FRS_IDENTITY_NONE;
+    scheduleReading(read);
+}
+
+static void handleIdentity(FreespaceDeviceId id,
+                           struct FrsRead* read,
+                           int invalidSerial,
+                           uint32_t swPartNumber,
+                           uint32_t swBuildNumber,
+                           uint32_t serialNumber,
+                           uint8_t swVersionMajor,
+                           uint8_t swVersionMinor,
+                           uint16_t swVersionPatch) {
+    struct FrsBlock* block = &read->blocks_[0];
+
+    if (invalidSerial) {
+        // The device asks to be asked again
+        if (++block->retries_ > FRS_MAX_RETRIES) {
+            giveUpIdentify(read);
+        } else {
+            block->state_ = FRS_BLOCK_DUE;
+            block->deadline_ = nowMillis() + FRS_BUSY_RETRY_MS;
+            return;
+        }
+    } else {
+        read->identity_ = FRS_IDENTITY_KNOWN;
+        read->key_.swPartNumber_ = swPartNumber;
+        read->key_.swBuildNumber_ = swBuildNumber;
+        read->key_.serialNumber_ = serialNumber;
+        read->key_.swVersionMajor_ = swVersionMajor;
+        read->key_.swVersionMinor_ = swVersionMinor;
+        read->key_.swVersionPatch_ = swVersionPatch;
+        read->phase_ = FRS_PHASE_LOOKUP;
+        block->state_ = FRS_BLOCK_FREE;
+        return;
+    }
+    issueBlock(id, read, block);
+}
+
+LIBFREESPACE_API int freespace_frsReadAsync(FreespaceDeviceId id,
+                                            int frsType,
+                                            freespace_frsReadCallback callback,
+                                            void* cookie) {
+    struct FreespaceDeviceInfo info;
+    struct FrsRead* read;
+    struct FreespaceFRSCacheKey key;
+    int target = frsType & FRS_TARGET_MASK;
+    int identity;
+    int capacity;
+    int rc;
+
+    if (callback == NULL || (frsType & ~(FRS_TARGET_MASK | 0xffff)) != 0 || target == FRS_TARGET_MASK) {
+        return FREESPACE_ERROR_UNEXPECTED;
+    }
+    if (id < 0 || id >= FREESPACE_MAILBOX_MAX_ID) {
+        return FREESPACE_ERROR_INVALID_DEVICE;
+    }
+    rc = freespace_getDeviceInfo(id, &info);
+    if (rc != FREESPACE_SUCCESS) {
+        return rc;
+    }
+
+    read = reads_[id];
+    if (read == NULL) {
+        read = (struct FrsRead*) freespace_private_calloc(sizeof(struct FrsRead));
+        if (read == NULL) {
+            return FREESPACE_ERROR_OUT_OF_MEMORY;
+        }
+        reads_[id] = read;
+    } else if (read->active_) {
+        return FREESPACE_ERROR_BUSY;
+    }
+
+    identity = read->identity_;
+    key = read->key_;
+    memset(read, 0, sizeof(struct FrsRead));
+    read->identity_ = identity;
+    read->key_ = key;
+
+    // Room for the first window, so that it can be requested from the
+    // receive path
+    capacity = FRS_INITIAL_CAPACITY;
+    while (capacity < blockWords_ * window_ && capacity < FRS_MAX_WORDS) {
+        capacity *= 2;
+    }
+    read->words_ = (uint32_t*) freespace_private_malloc(capacity * sizeof(uint32_t));
+    read->received_ = (uint32_t*) freespace_private_calloc(FRS_MAX_WORDS / 32 * sizeof(uint32_t));
+    if (read->words_ == NULL || read->received_ == NULL) {
+        freespace_private_free(read->words_);
+        freespace_private_free(read->received_);
+        read->words_ = NULL;
+        read->received_ = NULL;
+        return FREESPACE_ERROR_OUT_OF_MEMORY;
+    }
+    read->capacity_ = capacity;
+    read->frsType_ = frsType & 0xffff;
+    read->target_ = target;
+    read->hVer_ = info.hVer;
+    read->callback_ = callback;
+    read->cookie_ = cookie;
+    read->limit_ = FRS_MAX_WORDS;
+    read->length_ = 0;
+    read->active_ = 1;
+
+    // The first request goes out from freespace_perform, once the
+    // backend knows to pass the responses on. So does a cached record,
+    // as the callback is never run from here.
+    if (!freespace_private_frsCacheEnabled() || read->identity_ == FRS_IDENTITY_NONE) {
+        scheduleReading(read);
+    } else if (read->identity_ == FRS_IDENTITY_KNOWN) {
+        if (!lookupCache(read)) {
+            scheduleReading(read);
+        }
+    } else {
+        memset(&read->key_, 0, sizeof(read->key_));
+        read->key_.vendor_ = info.vendor;
+        read->key_.product_ = info.product;
+        scheduleIdentify(read);
+    }
+    return FREESPACE_SUCCESS;
+}
+
+LIBFREESPACE_API int freespace_frsSetReadWindow(int blockWords, int blocksInFlight) {
+    int i;
+
+    if (blockWords <= 0 || blockWords > 0xffff || blocksInFlight <= 0 || blocksInFlight > FRS_MAX_WINDOW) {
+        return FREESPACE_ERROR_UNEXPECTED;
+    }
+    for (i = 0; i < FREESPACE_MAILBOX_MAX_ID; i++) {
+        if (getRead(i) != NULL) {
+            return FREESPACE_ERROR_BUSY;
+        }
+    }
+    blockWords_ = blockWords;
+    window_ = blocksInFlight;
+    return FREESPACE_SUCCESS;
+}
+
+int freespace_private_frsDeliver(FreespaceDeviceId id,
+                                 const uint8_t* report,
+                                 int length,
+                                 uint8_t hVer) {
+    struct FrsRead* read = getRead(id);
+    struct freespace_message m;
+    int type;
+
+    if (freespace_private_frsWriteDeliver(id, report, length, hVer)) {
+        return 1;
+    }
+    if (read == NULL || read->phase_ == FRS_PHASE_CACHED ||
+        read->phase_ == FRS_PHASE_LOOKUP || read->phase_ == FRS_PHASE_STORE) {
+        return 0;
+    }
+    type = freespace_peek_message_type(report, length, hVer);
+    if (read->phase_ == FRS_PHASE_IDENTIFY) {
+        if (type != FREESPACE_MESSAGE_PRODUCTIDRESPONSE && type != FREESPACE_MESSAGE_PRODUCTIDRESPONSEBLE) {
+            return 0;
+        }
+        if (freespace_decode_message(report, length, &m, hVer) != FREESPACE_SUCCESS) {
+            return 0;
+        }
+        if (type == FREESPACE_MESSAGE_PRODUCTIDRESPONSE) {
+            handleIdentity(id, read, m.productIDResponse.invalidNS,
+                           m.productIDResponse.swPartNumber, m.productIDResponse.swBuildNumber,
+                           m.productIDResponse.serialNumber, m.productIDResponse.swVersionMajor,
+                           m.productIDResponse.swVersionMinor, m.productIDResponse.swVersionPatch);
+        } else {
+            handleIdentity(id, read, m.productIDResponseBLE.invalidNS,
+                           m.productIDResponseBLE.swPartNumber, m.productIDResponseBLE.swBuildNumber,
+                           m.productIDResponseBLE.serialNumber, m.productIDResponseBLE.swVersionMajor,
+                           m.productIDResponseBLE.swVersionMinor, m.productIDResponseBLE.swVersionPatch);
+        }
+        return 1;
+    }
+    if (type != responseType(read) && !(read->hVer_ >= 2 && type == FREESPACE_MESSAGE_FRSREADRESPONSEBLE)) {
+        return 0;
+    }
+    if (freespace_decode_message(report, length, &m, hVer) != FREESPACE_SUCCESS) {
+        return 0;
+    }
+
+    // Responses for other record types are not ours
+    switch (type) {
+        case FREESPACE_MESSAGE_FRSREADRESPONSE:
+            if (m.fRSReadResponse.FRStype != read->frsType_) {
+                return 0;
+            }
+            handleResponse(id, read, m.fRSReadResponse.status, m.fRSReadResponse.wordOffset,
+                           m.fRSReadResponse.data, m.fRSReadResponse.dataLength,
+                           FRS_DATA_WORDS(m.fRSReadResponse));
+            break;
+        case FREESPACE_MESSAGE_FRSREADRESPONSEBLE:
+            if (m.fRSReadResponseBLE.FRStype != read->frsType_) {
+                return 0;
+            }
+            handleResponse(id, read, m.fRSReadResponseBLE.status, m.fRSReadResponseBLE.wordOffset,
+                           m.fRSReadResponseBLE.data, m.fRSReadResponseBLE.dataLength,
+                           FRS_DATA_WORDS(m.fRSReadResponseBLE));
+            break;
+        case FREESPACE_MESSAGE_FRSHANDHELDREADRESPONSE:
+            if (m.fRSHandheldReadResponse.FRStype != read->frsType_) {
+                return 0;
+            }
+            handleResponse(id, read, m.fRSHandheldReadResponse.status, m.fRSHandheldReadResponse.wordOffset,
+                           m.fRSHandheldReadResponse.data, m.fRSHandheldReadResponse.dataLength,
+                           FRS_DATA_WORDS(m.fRSHandheldReadResponse));
+            break;
+        case FREESPACE_MESSAGE_FRSDONGLEREADRESPONSE:
+            if (m.fRSDongleReadResponse.FRStype != read->frsType_) {
+                return 0;
+            }
+            handleResponse(id, read, m.fRSDongleReadResponse.status, m.fRSDongleReadResponse.wordOffset,
+                           m.fRSDongleReadResponse.data, m.fRSDongleReadResponse.dataLength,
+                           FRS_DATA_WORDS(m.fRSDongleReadResponse));
+            break;
+        case FREESPACE_MESSAGE_FRSEFLASHREADRESPONSE:
+            if (m.fRSEFlashReadResponse.FRStype != read->frsType_) {
+                return 0;
+            }
+            handleResponse(id, read, m.fRSEFlashReadResponse.status, m.fRSEFlashReadResponse.wordOffset,
+                           m.fRSEFlashReadResponse.data, m.fRSEFlashReadResponse.dataLength,
+                           FRS_DATA_WORDS(m.fRSEFlashReadResponse));
+            break;
+        default:
+            return 0;
+    }
+    return 1;
+}
+
+int freespace_private_frsActive(FreespaceDeviceId id) {
+    return getRead(id) != NULL || freespace_private_frsWriteActive(id);
+}
+
+void freespace_private_frsTypes(FreespaceDeviceId id, uint32_t* mask) {
+    struct FrsRead* read = getRead(id);
+    int type;
+
+    freespace_private_frsWriteTypes(id, mask);
+    if (read == NULL) {
+        return;
+    }
+    // Both sets while identifying, as the read follows straight from
+    // the receive path
+    if (read->phase_ == FRS_PHASE_IDENTIFY) {
+        type = FREESPACE_MESSAGE_PRODUCTIDRESPONSE;
+        mask[type / 32] |= 1u << (type % 32);
+        type = FREESPACE_MESSAGE_PRODUCTIDRESPONSEBLE;
+        mask[type / 32] |= 1u << (type % 32);
+    }
+    type = responseType(read);
+    mask[type / 32] |= 1u << (type % 32);
+    if (read->hVer_ >= 2) {
+        type = FREESPACE_MESSAGE_FRSREADRESPONSEBLE;
+        mask[type / 32] |= 1u << (type % 32);
+    }
+}
+
+void freespace_private_frsNextTimeout(int* timeoutMs) {
+    int64_t now = 0;
+    int id;
+    int i;
+
+    freespace_private_frsWriteNextTimeout(timeoutMs);
+    for (id = 0; id < FREESPACE_MAILBOX_MAX_ID; id++) {
+        struct FrsRead* read = getRead(id);
+        if (read == NULL) {
+            continue;
+        }
+        if (read->phase_ == FRS_PHASE_CACHED || read->phase_ == FRS_PHASE_LOOKUP ||
+            read->phase_ == FRS_PHASE_STORE) {
+            *timeoutMs = 0;
+            return;
+        }
+        if (now == 0) {
+            now = nowMillis();
+        }
+        for (i = 0; i < window_; i++) {
+            const struct FrsBlock* block = &read->blocks_[i];
+            int remaining;
+            if (block->state_ == FRS_BLOCK_FREE) {
+                continue;
+            }
+            remaining = block->deadline_ > now ? (int) (block->deadline_ - now) : 0;
+            if (*timeoutMs < 0 || remaining < *timeoutMs) {
+                *timeoutMs = remaining;
+            }
+        }
+    }
+}
+
+// Make room for the whole window past the next block, up to the largest
+// record there can be.
+static int grow(struct FrsRead* read) {
+    int needed = read->nextOffset_ + blockWords_ * window_;
+    int capacity = read->capacity_;
+    uint32_t* words;
+
+    if (needed > read->limit_) {
+        needed = read->limit_;
+    }
+    if (needed <= capacity) {
+        return FREESPACE_SUCCESS;
+    }
+    while (capacity < needed) {
+        capacity *= 2;
+    }
+    if (capacity > FRS_MAX_WORDS) {
+        capacity = FRS_MAX_WORDS;
+    }
+    words = (uint32_t*) freespace_private_malloc(capacity * sizeof(uint32_t));
+    if (words == NULL) {
+        return FREESPACE_ERROR_OUT_OF_MEMORY;
+    }
+    memcpy(words, read->words_, read->capacity_ * sizeof(uint32_t));
+    freespace_private_free(read->words_);
+    read->words_ = words;
+    read->capacity_ = capacity;
+    return FREESPACE_SUCCESS;
+}
+
+void freespace_private_frsPerform() {
+    int64_t now = 0;
+    int id;
+    int i;
+
+    freespace_private_frsWritePerform();
+    for (id = 0; id < FREESPACE_MAILBOX_MAX_ID; id++) {
+        struct FrsRead* read = getRead(id);
+        int rc;
+        if (read == NULL) {
+            continue;
+        }
+        if (read->phase_ == FRS_PHASE_CACHED || read->phase_ == FRS_PHASE_STORE) {
+            finish(id, read, FREESPACE_SUCCESS);
+            continue;
+        }
+        if (read->phase_ == FRS_PHASE_LOOKUP) {
+            if (lookupCache(read)) {
+                finish(id, read, FREESPACE_SUCCESS);
+                continue;
+            }
+            scheduleReading(read);
+            // The first block is due now
+            now = nowMillis();
+        }
+        if (now == 0) {
+            now = nowMillis();
+        }
+
+        rc = grow(read);
+        if (rc != FREESPACE_SUCCESS) {
+            finish(id, read, rc);
+            continue;
+        }
+
+        for (i = 0; i < window_ && read->active_; i++) {
+            struct FrsBlock* block = &read->blocks_[i];
+            if (block->state_ == FRS_BLOCK_FREE || block->deadline_ > now) {
+                continue;
+            }
+            if (block->state_ == FRS_BLOCK_DUE) {
+                issueBlock(id, read, block);
+            } else if (read->phase_ == FRS_PHASE_IDENTIFY) {
+                if (++block->retries_ > FRS_MAX_RETRIES) {
+                    DEBUG("Device %d did not send its product ID; not using the FRS cache", id);
+                    giveUpIdentify(read);
+                } else {
+                    issueBlock(id, read, block);
+                }
+            } else {
+                DEBUG("FRS read of type 0x%x on device %d: no response at word %d",
+                      read->frsType_, id, block->offset_);
+                endBlock(id, read, block);
+            }
+        }
+        if (read->active_) {
+            pump(id, read);
+        }
+    }
+}
+
+void freespace_private_frsReset(FreespaceDeviceId id) {
+    struct FrsRead* read;
+
+    freespace_private_frsWriteReset(id);
+    if (id < 0 || id >= FREESPACE_MAILBOX_MAX_ID || reads_[id] == NULL) {
+        return;
+    }
+    read = reads_[id];
+    // The next device given this id may be another one
+    read->identity_ = FRS_IDENTITY_UNKNOWN;
+    if (read->active_) {
+        finish(id, read, FREESPACE_ERROR_NO_DEVICE);
+    }
+}
+
+void freespace_private_frsExit() {
+    int i;
+
+    freespace_private_frsWriteExit();
+    for (i = 0; i < FREESPACE_MAILBOX_MAX_ID; i++) {
+        if (reads_[i] != NULL) {
+            if (reads_[i]->active_ && reads_[i]->phase_ == FRS_PHASE_CACHED) {
+                freespace_private_frsCacheRelease(&reads_[i]->cached_);
+            }
+            freespace_private_free(reads_[i]->words_);
+            freespace_private_free(reads_[i]->received_);
+            freespace_private_free(reads_[i]);
+            reads_[i] = NULL;
+        }
+    }
+}
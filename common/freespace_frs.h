@@ -0,0 +1,74 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _FREESPACE_FRS_H_
+#define _FREESPACE_FRS_H_
+
+#include "freespace_mailbox.h"
+
+/**
+ * Offer a received report to the flash record read or write in progress
+ * on the device, if any. Called by the backends ahead of the mailboxes
+ * and subscriptions.
+ *
+ * @return 1 if the report was a response to the read or write and must
+ *         not be delivered to the callbacks, 0 otherwise
+ */
+int freespace_private_frsDeliver(FreespaceDeviceId id,
+                                 const uint8_t* report,
+                                 int length,
+                                 uint8_t hVer);
+
+/**
+ * @return nonzero if a flash record read or write is in progress on the
+ *         device
+ */
+int freespace_private_frsActive(FreespaceDeviceId id);
+
+/**
+ * Set the bit of each message type that the reads and writes in
+ * progress on the device wait for in mask, which has (FREESPACE_MESSAGE_TYPE_COUNT + 31)
+ * / 32 words.
+ */
+void freespace_private_frsTypes(FreespaceDeviceId id, uint32_t* mask);
+
+/**
+ * Lower *timeoutMs to the time until the next request must be sent
+ * again or given up on. Called from freespace_getNextTimeout().
+ */
+void freespace_private_frsNextTimeout(int* timeoutMs);
+
+/**
+ * Send the requests that are due and fail the reads and writes that ran
+ * out of retries. Called from freespace_perform().
+ */
+void freespace_private_frsPerform();
+
+/**
+ * Fail the read and write in progress on a device with
+ * FREESPACE_ERROR_NO_DEVICE. Called by the backends when a device is
+ * closed.
+ */
+void freespace_private_frsReset(FreespaceDeviceId id);
+
+/**
+ * Free all reads and detach the writes. Called from freespace_exit().
+ */
+void freespace_private_frsExit();
+
+#endif // _FREESPACE_FRS_H_
@@ -0,0 +1,339 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "freespace_frsCache.h"
+#include "freespace_log.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(_MSC_VER) && _MSC_VER < 1900
+#define snprintf _snprintf
+#endif
+
+#define WARN(...) FREESPACE_LOG(FREESPACE_LOG_BACKEND, FREESPACE_LOG_LEVEL_WARN, __VA_ARGS__)
+#define DEBUG(...) FREESPACE_LOG(FREESPACE_LOG_BACKEND, FREESPACE_LOG_LEVEL_DEBUG, __VA_ARGS__)
+
+/*
+ * One file per record, named after its key:
+ *
+ *   FrsCacheHeader, then wordCount_ words
+ *
+ * Everything is in the byte order of the machine that wrote it; version_
+ * doubles as the byte order check. The header repeats the key, so a
+ * renamed or mixed up file is never served for another device, and a
+ * checksum of the words catches a file cut short or damaged. Files are
+ * written under a temporary name and renamed into place, so readers
+ * only ever see whole records.
+ */
+#define FRS_CACHE_MAGIC "FSFRSREC"
+#define FRS_CACHE_VERSION 1
+#define FRS_CACHE_PATH_SIZE 512
+
+struct FrsCacheHeader {
+    char magic_[8];
+    uint32_t version_;
+    uint32_t headerSize_;
+    struct FreespaceFRSCacheKey key_;
+    uint32_t wordCount_;
+    uint32_t checksum_;
+};
+
+static char directory_[FRS_CACHE_PATH_SIZE];
+
+// FNV-1a
+static uint32_t checksum(const uint32_t* words, int wordCount) {
+    const uint8_t* p = (const uint8_t*) words;
+    size_t n = (size_t) wordCount * sizeof(uint32_t);
+    uint32_t hash = 2166136261u;
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+        hash = (hash ^ p[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static int cachePath(char* buf, size_t size, const struct FreespaceFRSCacheKey* key) {
+    int n = snprintf(buf, size, "%s/%04x%04x-%08x-%08x-%u.%u.%u-%u-%05x.frs",
+                     directory_, key->vendor_, key->product_,
+                     key->serialNumber_, key->swPartNumber_,
+                     key->swVersionMajor_, key->swVersionMinor_, key->swVersionPatch_,
+                     key->swBuildNumber_, key->frsType_);
+    if (n < 0 || (size_t) n >= size) {
+        return FREESPACE_ERROR_BUFFER_TOO_SMALL;
+    }
+    return FREESPACE_SUCCESS;
+}
+
+LIBFREESPACE_API int freespace_frsSetCacheDirectory(const char* path) {
+    size_t length;
+
+    if (path == NULL) {
+        directory_[0] = '\0';
+        return FREESPACE_SUCCESS;
+    }
+    length = strlen(path);
+    // Leave room for the file name
+    if (length == 0 || length + 64 >= sizeof(directory_)) {
+        return FREESPACE_ERROR_UNEXPECTED;
+    }
+    memcpy(directory_, path, length + 1);
+    return FREESPACE_SUCCESS;
+}
+
+int freespace_private_frsCacheEnabled() {
+    return directory_[0] != '\0';
+}
+
+static int mapEntry(struct FreespaceFRSCacheEntry* entry, const char* path) {
+#ifdef _WIN32
+    LARGE_INTEGER size;
+
+    entry->file_ = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL,
+                               OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (entry->file_ == INVALID_HANDLE_VALUE) {
+        return FREESPACE_ERROR_NOT_FOUND;
+    }
+    if (!GetFileSizeEx(entry->file_, &size) || size.QuadPart < (LONGLONG) sizeof(struct FrsCacheHeader)) {
+        return FREESPACE_ERROR_MALFORMED_MESSAGE;
+    }
+    entry->mapping_ = CreateFileMapping(entry->file_, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (entry->mapping_ == NULL) {
+        return FREESPACE_ERROR_IO;
+    }
+    entry->base_ = (const uint8_t*) MapViewOfFile(entry->mapping_, FILE_MAP_READ, 0, 0, 0);
+    if (entry->base_ == NULL) {
+        return FREESPACE_ERROR_IO;
+    }
+    entry->size_ = (size_t) size.QuadPart;
+#else
+    struct stat st;
+    void* base;
+
+    entry->fd_ = open(path, O_RDONLY);
+    if (entry->fd_ < 0) {
+        return FREESPACE_ERROR_NOT_FOUND;
+    }
+    if (fstat(entry->fd_, &st) != 0 || st.st_size < (off_t) sizeof(struct FrsCacheHeader)) {
+        return FREESPACE_ERROR_MALFORMED_MESSAGE;
+    }
+    base = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, entry->fd_, 0);
+    if (base == MAP_FAILED) {
+        return FREESPACE_ERROR_IO;
+    }
+    entry->base_ = (const uint8_t*) base;
+    entry->size_ = (size_t) st.st_size;
+#endif
+    return FREESPACE_SUCCESS;
+}
+
+int freespace_private_frsCacheLookup(const struct FreespaceFRSCacheKey* key,
+                                     struct FreespaceFRSCacheEntry* entry) {
+    char path[FRS_CACHE_PATH_SIZE];
+    const struct FrsCacheHeader* header;
+    const uint32_t* words;
+    int rc;
+
+    memset(entry, 0, sizeof(*entry));
+#ifdef _WIN32
+    entry->file_ = INVALID_HANDLE_VALUE;
+#else
+    entry->fd_ = -1;
+#endif
+    rc = cachePath(path, sizeof(path), key);
+    if (rc != FREESPACE_SUCCESS) {
+        return rc;
+    }
+    rc = mapEntry(entry, path);
+    if (rc != FREESPACE_SUCCESS) {
+        return rc;
+    }
+
+    header = (const struct FrsCacheHeader*) entry->base_;
+    if (memcmp(header->magic_, FRS_CACHE_MAGIC, sizeof(header->magic_)) != 0 ||
+        header->version_ != FRS_CACHE_VERSION ||
+        header->headerSize_ != sizeof(struct FrsCacheHeader) ||
+        memcmp(&header->key_, key, sizeof(*key)) != 0 ||
+        entry->size_ != sizeof(struct FrsCacheHeader) + (size_t) header->wordCount_ * sizeof(uint32_t)) {
+        WARN("Ignoring FRS cache file %s", path);
+        return FREESPACE_ERROR_MALFORMED_MESSAGE;
+    }
+    words = (const uint32_t*) (entry->base_ + sizeof(struct FrsCacheHeader));
+    if (checksum(words, (int) header->wordCount_) != header->checksum_) {
+        WARN("Ignoring FRS cache file %s: bad checksum", path);
+        return FREESPACE_ERROR_MALFORMED_MESSAGE;
+    }
+
+    entry->words_ = words;
+    entry->wordCount_ = (int) header->wordCount_;
+    DEBUG("FRS cache hit: %s", path);
+    return FREESPACE_SUCCESS;
+}
+
+void freespace_private_frsCacheRelease(struct FreespaceFRSCacheEntry* entry) {
+#ifdef _WIN32
+    if (entry->base_ != NULL) {
+        UnmapViewOfFile(entry->base_);
+    }
+    if (entry->mapping_ != NULL) {
+        CloseHandle(entry->mapping_);
+    }
+    if (entry->file_ != INVALID_HANDLE_VALUE) {
+        CloseHandle(entry->file_);
+    }
+    entry->file_ = INVALID_HANDLE_VALUE;
+    entry->mapping_ = NULL;
+#else
+    if (entry->base_ != NULL) {
+        munmap((void*) entry->base_, entry->size_);
+    }
+    if (entry->fd_ >= 0) {
+        close(entry->fd_);
+    }
+    entry->fd_ = -1;
+#endif
+    entry->base_ = NULL;
+    entry->words_ = NULL;
+}
+
+int freespace_private_frsCacheStore(const struct FreespaceFRSCacheKey* key,
+                                    const uint32_t* words,
+                                    int wordCount) {
+    char path[FRS_CACHE_PATH_SIZE];
+    char temp[FRS_CACHE_PATH_SIZE + 16];
+    struct FrsCacheHeader header;
+    FILE* file;
+    int ok;
+    int rc;
+    int n;
+
+    rc = cachePath(path, sizeof(path), key);
+    if (rc != FREESPACE_SUCCESS) {
+        return rc;
+    }
+#ifdef _WIN32
+    n = snprintf(temp, sizeof(temp), "%s.%lu", path, (unsigned long) GetCurrentProcessId());
+#else
+    n = snprintf(temp, sizeof(temp), "%s.%ld", path, (long) getpid());
+#endif
+    if (n < 0 || (size_t) n >= sizeof(temp)) {
+        return FREESPACE_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic_, FRS_CACHE_MAGIC, sizeof(header.magic_));
+    header.version_ = FRS_CACHE_VERSION;
+    header.headerSize_ = sizeof(header);
+    header.key_ = *key;
+    header.wordCount_ = (uint32_t) wordCount;
+    header.checksum_ = checksum(words, wordCount);
+
+    file = fopen(temp, "wb");
+    if (file == NULL) {
+        WARN("Could not write FRS cache file %s", temp);
+        return FREESPACE_ERROR_IO;
+    }
+    ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+         (wordCount == 0 || fwrite(words, sizeof(uint32_t), (size_t) wordCount, file) == (size_t) wordCount);
+    ok = (fclose(file) == 0) && ok;
+#ifdef _WIN32
+    ok = ok && MoveFileExA(temp, path, MOVEFILE_REPLACE_EXISTING);
+#else
+    ok = ok && rename(temp, path) == 0;
+#endif
+    if (!ok) {
+        WARN("Could not write FRS cache file %s", path);
+        remove(temp);
+        return FREESPACE_ERROR_IO;
+    }
+    return FREESPACE_SUCCESS;
+}
+
+void freespace_private_frsCacheRemoveType(uint16_t vendor, uint16_t product, uint32_t frsType) {
+    char prefix[16];
+    char suffix[16];
+    char path[FRS_CACHE_PATH_SIZE];
+    int n;
+#ifdef _WIN32
+    WIN32_FIND_DATAA found;
+    HANDLE find;
+#else
+    size_t prefixLength;
+    size_t suffixLength;
+    DIR* dir;
+    struct dirent* entry;
+#endif
+
+    if (!freespace_private_frsCacheEnabled()) {
+        return;
+    }
+    snprintf(prefix, sizeof(prefix), "%04x%04x-", vendor, product);
+    snprintf(suffix, sizeof(suffix), "-%05x.frs", frsType);
+
+#ifdef _WIN32
+    n = snprintf(path, sizeof(path), "%s/%s*%s", directory_, prefix, suffix);
+    if (n < 0 || (size_t) n >= sizeof(path)) {
+        return;
+    }
+    find = FindFirstFileA(path, &found);
+    if (find == INVALID_HANDLE_VALUE) {
+        return;
+    }
+    do {
+        n = snprintf(path, sizeof(path), "%s/%s", directory_, found.cFileName);
+        if (n < 0 || (size_t) n >= sizeof(path)) {
+            continue;
+        }
+        DEBUG("Removing FRS cache file %s", path);
+        remove(path);
+    } while (FindNextFileA(find, &found));
+    FindClose(find);
+#else
+    prefixLength = strlen(prefix);
+    suffixLength = strlen(suffix);
+    dir = opendir(directory_);
+    if (dir == NULL) {
+        return;
+    }
+    while ((entry = readdir(dir)) != NULL) {
+        size_t length = strlen(entry->d_name);
+        if (length <= prefixLength + suffixLength ||
+            strncmp(entry->d_name, prefix, prefixLength) != 0 ||
+            strcmp(entry->d_name + length - suffixLength, suffix) != 0) {
+            continue;
+        }
+        n = snprintf(path, sizeof(path), "%s/%s", directory_, entry->d_name);
+        if (n < 0 || (size_t) n >= sizeof(path)) {
+            // Not a name cachePath() could have made
+            continue;
+        }
+        DEBUG("Removing FRS cache file %s", path);
+        remove(path);
+    }
+    closedir(dir);
+#endif
+}
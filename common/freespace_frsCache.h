@@ -0,0 +1,93 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _FREESPACE_FRS_CACHE_H_
+#define _FREESPACE_FRS_CACHE_H_
+
+#include "freespace/freespace.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+/**
+ * What a cached record belongs to. A record is only served from the
+ * cache to a device that reports the same identity.
+ */
+struct FreespaceFRSCacheKey {
+    uint16_t vendor_;
+    uint16_t product_;
+    uint32_t swPartNumber_;
+    uint32_t swBuildNumber_;
+    uint32_t serialNumber_;
+    uint16_t swVersionPatch_;
+    uint8_t swVersionMajor_;
+    uint8_t swVersionMinor_;
+    // The record type ORed with its FreespaceFRSTarget
+    uint32_t frsType_;
+};
+
+/**
+ * A record mapped from the cache.
+ */
+struct FreespaceFRSCacheEntry {
+    const uint32_t* words_;
+    int wordCount_;
+#ifdef _WIN32
+    HANDLE file_;
+    HANDLE mapping_;
+#else
+    int fd_;
+#endif
+    const uint8_t* base_;
+    size_t size_;
+};
+
+/**
+ * @return nonzero if freespace_frsSetCacheDirectory() has set a directory
+ */
+int freespace_private_frsCacheEnabled();
+
+/**
+ * Map the record stored for key. The entry must be released with
+ * freespace_private_frsCacheRelease() whatever the result.
+ *
+ * @return FREESPACE_SUCCESS, FREESPACE_ERROR_NOT_FOUND if nothing is
+ *         stored, or FREESPACE_ERROR_MALFORMED_MESSAGE if the file does
+ *         not hold a whole record for key
+ */
+int freespace_private_frsCacheLookup(const struct FreespaceFRSCacheKey* key,
+                                     struct FreespaceFRSCacheEntry* entry);
+
+void freespace_private_frsCacheRelease(struct FreespaceFRSCacheEntry* entry);
+
+/**
+ * Store a record read from a device, replacing any stored for key.
+ */
+int freespace_private_frsCacheStore(const struct FreespaceFRSCacheKey* key,
+                                    const uint32_t* words,
+                                    int wordCount);
+
+/**
+ * Remove the records of a type stored for every device with the given
+ * USB vendor and product. Called before the record is written, when the
+ * identity of the device may not be known.
+ */
+void freespace_private_frsCacheRemoveType(uint16_t vendor, uint16_t product, uint32_t frsType);
+
+#endif // _FREESPACE_FRS_CACHE_H_
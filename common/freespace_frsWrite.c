@@ -0,0 +1,651 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "freespace_frsWrite.h"
+#include "freespace_frsCache.h"
+#include "freespace_alloc.h"
+#include "freespace_log.h"
+
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#define WARN(...) FREESPACE_LOG(FREESPACE_LOG_BACKEND, FREESPACE_LOG_LEVEL_WARN, __VA_ARGS__)
+#define DEBUG(...) FREESPACE_LOG(FREESPACE_LOG_BACKEND, FREESPACE_LOG_LEVEL_DEBUG, __VA_ARGS__)
+
+/*
+ * A write puts the device in write mode with a write request, then sends
+ * the record one word per data message. Up to window_ words are sent
+ * ahead of the last acknowledgement, and the next word goes out from the
+ * receive path as each one is acknowledged. When a word is not
+ * acknowledged in time, or the device reports an error, everything from
+ * the first unacknowledged word is sent again (after a new write request
+ * if the device left write mode). The acknowledged prefix survives the
+ * device going away, so a later freespace_frsWriteAsync carries on from
+ * there instead of from the start.
+ */
+#define FRS_WRITE_MAX_WORDS 65535
+#define FRS_WRITE_MAX_WINDOW 64
+#define FRS_WRITE_DEFAULT_WINDOW 8
+#define FRS_WRITE_SEND_TIMEOUT_MS 100
+#define FRS_WRITE_RESPONSE_TIMEOUT_MS 500
+#define FRS_WRITE_BUSY_RETRY_MS 20
+#define FRS_WRITE_MAX_RETRIES 5
+
+#define FRS_TARGET_MASK (FREESPACE_FRS_DONGLE | FREESPACE_FRS_EFLASH)
+
+// Response status codes
+#define FRS_WRITE_STATUS_RECEIVED 0
+#define FRS_WRITE_STATUS_UNRECOGNIZED 1
+#define FRS_WRITE_STATUS_BUSY 2
+#define FRS_WRITE_STATUS_COMPLETED 3
+#define FRS_WRITE_STATUS_READY 4
+#define FRS_WRITE_STATUS_FAILED 5
+#define FRS_WRITE_STATUS_NOT_WRITING 6
+#define FRS_WRITE_STATUS_BAD_LENGTH 7
+#define FRS_WRITE_STATUS_VALID 8
+#define FRS_WRITE_STATUS_INVALID 9
+
+enum FrsWriteState {
+    FRS_WRITE_IDLE = 0,
+    // The write request is due at deadline_
+    FRS_WRITE_REQUEST_DUE,
+    // Waiting for the device to enter write mode
+    FRS_WRITE_REQUESTED,
+    // Sending words; resent from acked_ if none is acknowledged by deadline_
+    FRS_WRITE_DATA,
+    // Words are due again at deadline_
+    FRS_WRITE_DATA_DUE
+};
+
+struct FreespaceFRSWrite {
+    int frsType_;
+    int target_;
+    const uint32_t* words_;
+    int wordCount_;
+
+#ifdef _WIN32
+    HANDLE file_;
+    HANDLE mapping_;
+#else
+    int fd_;
+#endif
+    const uint8_t* base_;
+    size_t size_;
+
+    // Words [0, acked_) have been acknowledged, and [acked_, sent_) are
+    // in flight
+    int acked_;
+    int sent_;
+
+    // Set between freespace_frsWriteAsync and the callback
+    FreespaceDeviceId id_;
+    int state_;
+    int hVer_;
+    int retries_;
+    int64_t deadline_;
+    freespace_frsWriteCallback callback_;
+    void* cookie_;
+};
+
+static int window_ = FRS_WRITE_DEFAULT_WINDOW;
+
+// The write in progress on each device, indexed by device id like the
+// mailboxes
+static struct FreespaceFRSWrite* writes_[FREESPACE_MAILBOX_MAX_ID];
+
+static int64_t nowMillis() {
+#ifdef _WIN32
+    LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (int64_t) (counter.QuadPart / frequency.QuadPart) * 1000 +
+           (int64_t) (counter.QuadPart % frequency.QuadPart) * 1000 / frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t) ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+#endif
+}
+
+static struct FreespaceFRSWrite* getWrite(FreespaceDeviceId id) {
+    if (id < 0 || id >= FREESPACE_MAILBOX_MAX_ID) {
+        return NULL;
+    }
+    return writes_[id];
+}
+
+static int responseType(const struct FreespaceFRSWrite* write) {
+    if (write->hVer_ >= 2) {
+        return FREESPACE_MESSAGE_FRSWRITERESPONSE;
+    }
+    switch (write->target_) {
+        case FREESPACE_FRS_DONGLE:
+            return FREESPACE_MESSAGE_FRSDONGLEWRITERESPONSE;
+        case FREESPACE_FRS_EFLASH:
+            return FREESPACE_MESSAGE_FRSEFLASHWRITERESPONSE;
+        default:
+            return FREESPACE_MESSAGE_FRSHANDHELDWRITERESPONSE;
+    }
+}
+
+static int sendWriteRequest(const struct FreespaceFRSWrite* write) {
+    struct freespace_message m;
+
+    memset(&m, 0, sizeof(m));
+    if (write->hVer_ >= 2) {
+        m.messageType = FREESPACE_MESSAGE_FRSWRITEREQUEST;
+        m.fRSWriteRequest.length = (uint16_t) write->wordCount_;
+        m.fRSWriteRequest.FRStype = (uint16_t) write->frsType_;
+    } else if (write->target_ == FREESPACE_FRS_DONGLE) {
+        m.messageType = FREESPACE_MESSAGE_FRSDONGLEWRITEREQUEST;
+        m.fRSDongleWriteRequest.length = (uint16_t) write->wordCount_;
+        m.fRSDongleWriteRequest.FRStype = (uint16_t) write->frsType_;
+    } else if (write->target_ == FREESPACE_FRS_EFLASH) {
+        m.messageType = FREESPACE_MESSAGE_FRSEFLASHWRITEREQUEST;
+        m.fRSEFlashWriteRequest.length = (uint16_t) write->wordCount_;
+        m.fRSEFlashWriteRequest.FRStype = (uint16_t) write->frsType_;
+    } else {
+        m.messageType = FREESPACE_MESSAGE_FRSHANDHELDWRITEREQUEST;
+        m.fRSHandheldWriteRequest.length = (uint16_t) write->wordCount_;
+        m.fRSHandheldWriteRequest.FRStype = (uint16_t) write->frsType_;
+    }
+    return freespace_sendMessageAsync(write->id_, &m, FRS_WRITE_SEND_TIMEOUT_MS, NULL, NULL);
+}
+
+static int sendWord(const struct FreespaceFRSWrite* write, int offset) {
+    struct freespace_message m;
+
+    memset(&m, 0, sizeof(m));
+    if (write->hVer_ >= 2) {
+        m.messageType = FREESPACE_MESSAGE_FRSWRITEDATA;
+        m.fRSWriteData.wordOffset = (uint16_t) offset;
+        m.fRSWriteData.data = write->words_[offset];
+    } else if (write->target_ == FREESPACE_FRS_DONGLE) {
+        m.messageType = FREESPACE_MESSAGE_FRSDONGLEWRITEDATA;
+        m.fRSDongleWriteData.wordOffset = (uint16_t) offset;
+        m.fRSDongleWriteData.data = write->words_[offset];
+    } else if (write->target_ == FREESPACE_FRS_EFLASH) {
+        m.messageType = FREESPACE_MESSAGE_FRSEFLASHWRITEDATA;
+        m.fRSEFlashWriteData.wordOffset = (uint16_t) offset;
+        m.fRSEFlashWriteData.data = write->words_[offset];
+    } else {
+        m.messageType = FREESPACE_MESSAGE_FRSHANDHELDWRITEDATA;
+        m.fRSHandheldWriteData.wordOffset = (uint16_t) offset;
+        m.fRSHandheldWriteData.data = write->words_[offset];
+    }
+    return freespace_sendMessageAsync(write->id_, &m, FRS_WRITE_SEND_TIMEOUT_MS, NULL, NULL);
+}
+
+// Detach the write from its device and report the result. The write
+// may be started again from the callback.
+static void finish(struct FreespaceFRSWrite* write, int result) {
+    FreespaceDeviceId id = write->id_;
+    freespace_frsWriteCallback callback = write->callback_;
+    void* cookie = write->cookie_;
+
+    writes_[id] = NULL;
+    write->state_ = FRS_WRITE_IDLE;
+    write->id_ = -1;
+    // Whatever was in flight has to be sent again
+    write->sent_ = write->acked_;
+
+    DEBUG("FRS write of type 0x%x on device %d stopped at word %d of %d: %d",
+          write->frsType_ | write->target_, id, write->acked_, write->wordCount_, result);
+    if (callback != NULL) {
+        callback(id, write, cookie, result);
+    }
+}
+
+// Count a retry and try again after delayMs from state. Returns 0 if the
+// write was ended.
+static int retry(struct FreespaceFRSWrite* write, int state, int delayMs, int result) {
+    if (++write->retries_ > FRS_WRITE_MAX_RETRIES) {
+        finish(write, result);
+        return 0;
+    }
+    write->state_ = state;
+    write->sent_ = write->acked_;
+    write->deadline_ = nowMillis() + delayMs;
+    return 1;
+}
+
+static void issueRequest(struct FreespaceFRSWrite* write) {
+    int rc = sendWriteRequest(write);
+
+    if (rc == FREESPACE_SUCCESS) {
+        write->state_ = FRS_WRITE_REQUESTED;
+        write->deadline_ = nowMillis() + FRS_WRITE_RESPONSE_TIMEOUT_MS;
+    } else if (rc == FREESPACE_ERROR_NO_DEVICE || rc == FREESPACE_ERROR_INVALID_DEVICE) {
+        finish(write, rc);
+    } else {
+        retry(write, FRS_WRITE_REQUEST_DUE, FRS_WRITE_BUSY_RETRY_MS, rc);
+    }
+}
+
+// Send words until window_ are in flight
+static void pump(struct FreespaceFRSWrite* write) {
+    int rc;
+
+    write->state_ = FRS_WRITE_DATA;
+    while (write->sent_ < write->wordCount_ && write->sent_ - write->acked_ < window_) {
+        rc = sendWord(write, write->sent_);
+        if (rc == FREESPACE_ERROR_NO_DEVICE || rc == FREESPACE_ERROR_INVALID_DEVICE) {
+            finish(write, rc);
+            return;
+        }
+        if (rc != FREESPACE_SUCCESS) {
+            // Try the rest once the queue has drained
+            if (write->sent_ == write->acked_) {
+                retry(write, FRS_WRITE_DATA_DUE, FRS_WRITE_BUSY_RETRY_MS, rc);
+            }
+            return;
+        }
+        write->sent_++;
+    }
+}
+
+static void handleResponse(struct FreespaceFRSWrite* write, int status, int wordOffset) {
+    switch (status) {
+        case FRS_WRITE_STATUS_READY:
+            if (write->state_ == FRS_WRITE_REQUESTED) {
+                write->retries_ = 0;
+                write->sent_ = write->acked_;
+                write->deadline_ = nowMillis() + FRS_WRITE_RESPONSE_TIMEOUT_MS;
+                pump(write);
+            }
+            return;
+
+        case FRS_WRITE_STATUS_RECEIVED:
+            if (write->state_ != FRS_WRITE_DATA || wordOffset < write->acked_ || wordOffset >= write->sent_) {
+                return;
+            }
+            // Acknowledgements come in order, so this covers the ones
+            // before it too.
+            write->acked_ = wordOffset + 1;
+            write->retries_ = 0;
+            write->deadline_ = nowMillis() + FRS_WRITE_RESPONSE_TIMEOUT_MS;
+            pump(write);
+            return;
+
+        case FRS_WRITE_STATUS_COMPLETED:
+        case FRS_WRITE_STATUS_VALID:
+            // A zero length write invalidates the record and completes
+            // straight from write mode.
+            if (write->state_ == FRS_WRITE_DATA || write->wordCount_ == 0) {
+                write->acked_ = write->wordCount_;
+                finish(write, FREESPACE_SUCCESS);
+            }
+            return;
+
+        case FRS_WRITE_STATUS_INVALID:
+            finish(write, FREESPACE_ERROR_MALFORMED_MESSAGE);
+            return;
+
+        case FRS_WRITE_STATUS_UNRECOGNIZED:
+            finish(write, FREESPACE_ERROR_NOT_FOUND);
+            return;
+
+        case FRS_WRITE_STATUS_BAD_LENGTH:
+            finish(write, FREESPACE_ERROR_SEND_TOO_LARGE);
+            return;
+
+        case FRS_WRITE_STATUS_BUSY:
+            if (write->state_ == FRS_WRITE_REQUESTED) {
+                retry(write, FRS_WRITE_REQUEST_DUE, FRS_WRITE_BUSY_RETRY_MS, FREESPACE_ERROR_BUSY);
+            } else if (write->state_ == FRS_WRITE_DATA) {
+                retry(write, FRS_WRITE_DATA_DUE, FRS_WRITE_BUSY_RETRY_MS, FREESPACE_ERROR_BUSY);
+            }
+            return;
+
+        case FRS_WRITE_STATUS_FAILED:
+        case FRS_WRITE_STATUS_NOT_WRITING:
+            // Start over in write mode from the first word not taken
+            if (write->state_ == FRS_WRITE_DATA || write->state_ == FRS_WRITE_REQUESTED) {
+                WARN("FRS write of type 0x%x on device %d: status %d at word %d",
+                     write->frsType_, write->id_, status, wordOffset);
+                retry(write, FRS_WRITE_REQUEST_DUE, FRS_WRITE_BUSY_RETRY_MS, FREESPACE_ERROR_IO);
+            }
+            return;
+
+        default:
+            WARN("FRS write of type 0x%x on device %d: unknown status %d", write->frsType_, write->id_, status);
+            return;
+    }
+}
+
+static void unmap(struct FreespaceFRSWrite* write) {
+#ifdef _WIN32
+    if (write->base_ != NULL) {
+        UnmapViewOfFile(write->base_);
+    }
+    if (write->mapping_ != NULL) {
+        CloseHandle(write->mapping_);
+    }
+    if (write->file_ != INVALID_HANDLE_VALUE) {
+        CloseHandle(write->file_);
+    }
+#else
+    if (write->base_ != NULL) {
+        munmap((void*) write->base_, write->size_);
+    }
+    if (write->fd_ >= 0) {
+        close(write->fd_);
+    }
+#endif
+}
+
+static int mapFile(struct FreespaceFRSWrite* write, const char* path) {
+#ifdef _WIN32
+    LARGE_INTEGER size;
+
+    write->file_ = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL,
+                               OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (write->file_ == INVALID_HANDLE_VALUE) {
+        return FREESPACE_ERROR_NOT_FOUND;
+    }
+    if (!GetFileSizeEx(write->file_, &size)) {
+        return FREESPACE_ERROR_IO;
+    }
+    write->size_ = (size_t) size.QuadPart;
+    if (write->size_ == 0) {
+        return FREESPACE_SUCCESS;
+    }
+    write->mapping_ = CreateFileMapping(write->file_, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (write->mapping_ == NULL) {
+        return FREESPACE_ERROR_IO;
+    }
+    write->base_ = (const uint8_t*) MapViewOfFile(write->mapping_, FILE_MAP_READ, 0, 0, 0);
+    if (write->base_ == NULL) {
+        return FREESPACE_ERROR_IO;
+    }
+#else
+    struct stat st;
+    void* base;
+
+    write->fd_ = open(path, O_RDONLY);
+    if (write->fd_ < 0) {
+        return FREESPACE_ERROR_NOT_FOUND;
+    }
+    if (fstat(write->fd_, &st) != 0) {
+        return FREESPACE_ERROR_IO;
+    }
+    write->size_ = (size_t) st.st_size;
+    if (write->size_ == 0) {
+        return FREESPACE_SUCCESS;
+    }
+    base = mmap(NULL, write->size_, PROT_READ, MAP_PRIVATE, write->fd_, 0);
+    if (base == MAP_FAILED) {
+        return FREESPACE_ERROR_IO;
+    }
+    write->base_ = (const uint8_t*) base;
+#endif
+    return FREESPACE_SUCCESS;
+}
+
+LIBFREESPACE_API int freespace_frsWriteOpen(const char* path,
+                                            int frsType,
+                                            struct FreespaceFRSWrite** write) {
+    struct FreespaceFRSWrite* w;
+    int target = frsType & FRS_TARGET_MASK;
+    int rc;
+
+    *write = NULL;
+    if ((frsType & ~(FRS_TARGET_MASK | 0xffff)) != 0 || target == FRS_TARGET_MASK) {
+        return FREESPACE_ERROR_UNEXPECTED;
+    }
+    w = (struct FreespaceFRSWrite*) freespace_private_calloc(sizeof(struct FreespaceFRSWrite));
+    if (w == NULL) {
+        return FREESPACE_ERROR_OUT_OF_MEMORY;
+    }
+#ifdef _WIN32
+    w->file_ = INVALID_HANDLE_VALUE;
+#else
+    w->fd_ = -1;
+#endif
+    w->id_ = -1;
+    w->frsType_ = frsType & 0xffff;
+    w->target_ = target;
+
+    rc = mapFile(w, path);
+    if (rc == FREESPACE_SUCCESS &&
+        (w->size_ % sizeof(uint32_t) != 0 || w->size_ / sizeof(uint32_t) > FRS_WRITE_MAX_WORDS)) {
+        rc = FREESPACE_ERROR_MALFORMED_MESSAGE;
+    }
+    if (rc != FREESPACE_SUCCESS) {
+        unmap(w);
+        freespace_private_free(w);
+        return rc;
+    }
+    w->words_ = (const uint32_t*) w->base_;
+    w->wordCount_ = (int) (w->size_ / sizeof(uint32_t));
+    *write = w;
+    return FREESPACE_SUCCESS;
+}
+
+LIBFREESPACE_API int freespace_frsWriteAsync(FreespaceDeviceId id,
+                                             struct FreespaceFRSWrite* write,
+                                             freespace_frsWriteCallback callback,
+                                             void* cookie) {
+    struct FreespaceDeviceInfo info;
+    int rc;
+
+    if (write == NULL || write->state_ != FRS_WRITE_IDLE) {
+        return write == NULL ? FREESPACE_ERROR_UNEXPECTED : FREESPACE_ERROR_BUSY;
+    }
+    if (id < 0 || id >= FREESPACE_MAILBOX_MAX_ID) {
+        return FREESPACE_ERROR_INVALID_DEVICE;
+    }
+    rc = freespace_getDeviceInfo(id, &info);
+    if (rc != FREESPACE_SUCCESS) {
+        return rc;
+    }
+    if (writes_[id] != NULL) {
+        return FREESPACE_ERROR_BUSY;
+    }
+    if (write->acked_ == write->wordCount_ && write->wordCount_ > 0) {
+        // Everything was taken; write it all again
+        write->acked_ = 0;
+    }
+
+    // Whatever the device had cached is about to change
+    freespace_private_frsCacheRemoveType(info.vendor, info.product,
+                                         (uint32_t) (write->frsType_ | write->target_));
+
+    writes_[id] = write;
+    write->id_ = id;
+    write->hVer_ = info.hVer;
+    write->callback_ = callback;
+    write->cookie_ = cookie;
+    write->sent_ = write->acked_;
+    write->retries_ = 0;
+    // Sent from freespace_perform, once the backend knows to pass the
+    // responses on
+    write->state_ = FRS_WRITE_REQUEST_DUE;
+    write->deadline_ = nowMillis();
+    return FREESPACE_SUCCESS;
+}
+
+LIBFREESPACE_API int freespace_frsWriteProgress(const struct FreespaceFRSWrite* write) {
+    return write->acked_;
+}
+
+LIBFREESPACE_API int freespace_frsWriteLength(const struct FreespaceFRSWrite* write) {
+    return write->wordCount_;
+}
+
+LIBFREESPACE_API void freespace_frsWriteClose(struct FreespaceFRSWrite* write) {
+    if (write == NULL) {
+        return;
+    }
+    if (write->state_ != FRS_WRITE_IDLE) {
+        // Abandon it without a callback
+        writes_[write->id_] = NULL;
+    }
+    unmap(write);
+    freespace_private_free(write);
+}
+
+LIBFREESPACE_API int freespace_frsSetWriteWindow(int wordsInFlight) {
+    if (wordsInFlight <= 0 || wordsInFlight > FRS_WRITE_MAX_WINDOW) {
+        return FREESPACE_ERROR_UNEXPECTED;
+    }
+    window_ = wordsInFlight;
+    return FREESPACE_SUCCESS;
+}
+
+int freespace_private_frsWriteDeliver(FreespaceDeviceId id,
+                                      const uint8_t* report,
+                                      int length,
+                                      uint8_t hVer) {
+    struct FreespaceFRSWrite* write = getWrite(id);
+    struct freespace_message m;
+    int type;
+
+    if (write == NULL) {
+        return 0;
+    }
+    type = freespace_peek_message_type(report, length, hVer);
+    if (type != responseType(write) || freespace_decode_message(report, length, &m, hVer) != FREESPACE_SUCCESS) {
+        return 0;
+    }
+    switch (type) {
+        case FREESPACE_MESSAGE_FRSWRITERESPONSE:
+            handleResponse(write, m.fRSWriteResponse.status, m.fRSWriteResponse.wordOffset);
+            break;
+        case FREESPACE_MESSAGE_FRSHANDHELDWRITERESPONSE:
+            handleResponse(write, m.fRSHandheldWriteResponse.status, m.fRSHandheldWriteResponse.wordOffset);
+            break;
+        case FREESPACE_MESSAGE_FRSDONGLEWRITERESPONSE:
+            handleResponse(write, m.fRSDongleWriteResponse.status, m.fRSDongleWriteResponse.wordOffset);
+            break;
+        case FREESPACE_MESSAGE_FRSEFLASHWRITERESPONSE:
+            handleResponse(write, m.fRSEFlashWriteResponse.status, m.fRSEFlashWriteResponse.wordOffset);
+            break;
+    }
+    return 1;
+}
+
+int freespace_private_frsWriteActive(FreespaceDeviceId id) {
+    return getWrite(id) != NULL;
+}
+
+void freespace_private_frsWriteTypes(FreespaceDeviceId id, uint32_t* mask) {
+    struct FreespaceFRSWrite* write = getWrite(id);
+    int type;
+
+    if (write != NULL) {
+        type = responseType(write);
+        mask[type / 32] |= 1u << (type % 32);
+    }
+}
+
+void freespace_private_frsWriteNextTimeout(int* timeoutMs) {
+    int64_t now = 0;
+    int id;
+
+    for (id = 0; id < FREESPACE_MAILBOX_MAX_ID; id++) {
+        struct FreespaceFRSWrite* write = writes_[id];
+        int remaining;
+        if (write == NULL) {
+            continue;
+        }
+        if (now == 0) {
+            now = nowMillis();
+        }
+        remaining = write->deadline_ > now ? (int) (write->deadline_ - now) : 0;
+        if (*timeoutMs < 0 || remaining < *timeoutMs) {
+            *timeoutMs = remaining;
+        }
+    }
+}
+
+void freespace_private_frsWritePerform() {
+    int64_t now = 0;
+    int id;
+
+    for (id = 0; id < FREESPACE_MAILBOX_MAX_ID; id++) {
+        struct FreespaceFRSWrite* write = writes_[id];
+        if (write == NULL) {
+            continue;
+        }
+        if (now == 0) {
+            now = nowMillis();
+        }
+        if (write->deadline_ > now) {
+            continue;
+        }
+        switch (write->state_) {
+            case FRS_WRITE_REQUEST_DUE:
+                issueRequest(write);
+                break;
+            case FRS_WRITE_REQUESTED:
+                DEBUG("FRS write of type 0x%x on device %d: write mode not entered", write->frsType_, id);
+                retry(write, FRS_WRITE_REQUEST_DUE, 0, FREESPACE_ERROR_TIMEOUT);
+                break;
+            case FRS_WRITE_DATA:
+                if (write->acked_ == write->wordCount_) {
+                    // Every word was taken but the write never completed;
+                    // the next attempt starts over.
+                    finish(write, FREESPACE_ERROR_TIMEOUT);
+                    break;
+                }
+                DEBUG("FRS write of type 0x%x on device %d: no acknowledgement after word %d",
+                      write->frsType_, id, write->acked_);
+                if (retry(write, FRS_WRITE_DATA, 0, FREESPACE_ERROR_TIMEOUT)) {
+                    write->deadline_ = now + FRS_WRITE_RESPONSE_TIMEOUT_MS;
+                    pump(write);
+                }
+                break;
+            case FRS_WRITE_DATA_DUE:
+                write->deadline_ = now + FRS_WRITE_RESPONSE_TIMEOUT_MS;
+                pump(write);
+                break;
+        }
+    }
+}
+
+void freespace_private_frsWriteReset(FreespaceDeviceId id) {
+    struct FreespaceFRSWrite* write = getWrite(id);
+
+    if (write != NULL) {
+        finish(write, FREESPACE_ERROR_NO_DEVICE);
+    }
+}
+
+void freespace_private_frsWriteExit() {
+    int i;
+
+    for (i = 0; i < FREESPACE_MAILBOX_MAX_ID; i++) {
+        if (writes_[i] != NULL) {
+            writes_[i]->state_ = FRS_WRITE_IDLE;
+            writes_[i]->id_ = -1;
+            writes_[i]->sent_ = writes_[i]->acked_;
+            writes_[i] = NULL;
+        }
+    }
+}
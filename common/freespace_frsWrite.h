@@ -0,0 +1,55 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _FREESPACE_FRS_WRITE_H_
+#define _FREESPACE_FRS_WRITE_H_
+
+#include "freespace_mailbox.h"
+
+/*
+ * The write engine's share of the hooks in freespace_frs.h, which call
+ * these alongside the read engine's.
+ */
+
+int freespace_private_frsWriteDeliver(FreespaceDeviceId id,
+                                      const uint8_t* report,
+                                      int length,
+                                      uint8_t hVer);
+
+int freespace_private_frsWriteActive(FreespaceDeviceId id);
+
+void freespace_private_frsWriteTypes(FreespaceDeviceId id, uint32_t* mask);
+
+void freespace_private_frsWriteNextTimeout(int* timeoutMs);
+
+void freespace_private_frsWritePerform();
+
+/**
+ * Stop the write in progress on a device with FREESPACE_ERROR_NO_DEVICE.
+ * It can be resumed with freespace_frsWriteAsync() once the device is
+ * back.
+ */
+void freespace_private_frsWriteReset(FreespaceDeviceId id);
+
+/**
+ * Detach the writes from their devices. Called from freespace_exit();
+ * the writes themselves belong to the application.
+ */
+void freespace_private_frsWriteExit();
+
+#endif // _FREESPACE_FRS_WRITE_H_
@@ -0,0 +1,195 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "freespace_log.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(_MSC_VER) && _MSC_VER < 1900
+#define snprintf _snprintf
+#define vsnprintf _vsnprintf
+#endif
+
+// Longest message passed to the callback, including the location
+#define FREESPACE_LOG_MESSAGE_SIZE 192
+
+// Messages held by the async ring. Must be a power of 2.
+#define FREESPACE_LOG_RING_SIZE 256
+
+volatile int freespace_private_logLevels[FREESPACE_LOG_SUBSYSTEM_COUNT];
+
+static freespace_logCallback callback_ = NULL;
+static void* callbackCookie_ = NULL;
+
+/**
+ * An entry of the async ring. The ring is a bounded multi-producer queue
+ * drained by one consumer: sequence_ equals the write position when the
+ * entry is free and the write position + 1 once its message is ready.
+ */
+struct FreespaceLogEntry {
+    volatile long sequence_;
+    int subsystem_;
+    int level_;
+    char message_[FREESPACE_LOG_MESSAGE_SIZE];
+};
+
+static struct FreespaceLogEntry ring_[FREESPACE_LOG_RING_SIZE];
+static volatile long ringHead_ = 0;
+static long ringTail_ = 0;
+static volatile long dropped_ = 0;
+static volatile int async_ = 0;
+
+static const char* const levelNames_[] = { "OFF", "WARN", "DEBUG", "TRACE" };
+
+static void deliver(int subsystem, int level, const char* message) {
+    if (callback_ != NULL) {
+        callback_(subsystem, level, message, callbackCookie_);
+    } else {
+        fprintf(stderr, "libfreespace %s %s\n", levelNames_[level], message);
+    }
+}
+
+static void enqueue(int subsystem, int level, const char* message) {
+    struct FreespaceLogEntry* entry;
+    long pos;
+    long diff;
+
+    pos = ringHead_;
+    for (;;) {
+        entry = &ring_[pos & (FREESPACE_LOG_RING_SIZE - 1)];
+        diff = (long) ((unsigned long) entry->sequence_ - (unsigned long) pos);
+        if (diff == 0) {
+            if (FREESPACE_ATOMIC_CAS(&ringHead_, pos, pos + 1)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // Full. Never block the thread that is logging.
+            FREESPACE_ATOMIC_INCREMENT(&dropped_);
+            return;
+        }
+        pos = ringHead_;
+    }
+
+    entry->subsystem_ = subsystem;
+    entry->level_ = level;
+    strncpy(entry->message_, message, FREESPACE_LOG_MESSAGE_SIZE - 1);
+    entry->message_[FREESPACE_LOG_MESSAGE_SIZE - 1] = '\0';
+    FREESPACE_ATOMIC_BARRIER();
+    entry->sequence_ = pos + 1;
+}
+
+void freespace_private_log(int subsystem, int level, const char* function, int line, const char* fmt, ...) {
+    char message[FREESPACE_LOG_MESSAGE_SIZE];
+    va_list args;
+    int length;
+
+    length = snprintf(message, sizeof(message), "%s:%d: ", function, line);
+    if (length < 0 || length >= (int) sizeof(message)) {
+        length = 0;
+    }
+    va_start(args, fmt);
+    vsnprintf(message + length, sizeof(message) - length, fmt, args);
+    va_end(args);
+    message[sizeof(message) - 1] = '\0';
+
+    // The codecs end their messages with a newline
+    length = (int) strlen(message);
+    if (length > 0 && message[length - 1] == '\n') {
+        message[length - 1] = '\0';
+    }
+
+    if (async_) {
+        enqueue(subsystem, level, message);
+    } else {
+        deliver(subsystem, level, message);
+    }
+}
+
+LIBFREESPACE_API int freespace_setLogCallback(freespace_logCallback callback, void* cookie) {
+    callback_ = callback;
+    callbackCookie_ = cookie;
+    return FREESPACE_SUCCESS;
+}
+
+LIBFREESPACE_API int freespace_setLogLevel(int subsystem, int level) {
+    int i;
+
+    if (level < FREESPACE_LOG_LEVEL_OFF || level > FREESPACE_LOG_LEVEL_TRACE) {
+        return FREESPACE_ERROR_UNEXPECTED;
+    }
+    if (subsystem == FREESPACE_LOG_ALL) {
+        for (i = 0; i < FREESPACE_LOG_SUBSYSTEM_COUNT; i++) {
+            freespace_private_logLevels[i] = level;
+        }
+        return FREESPACE_SUCCESS;
+    }
+    if (subsystem < 0 || subsystem >= FREESPACE_LOG_SUBSYSTEM_COUNT) {
+        return FREESPACE_ERROR_UNEXPECTED;
+    }
+    freespace_private_logLevels[subsystem] = level;
+    return FREESPACE_SUCCESS;
+}
+
+LIBFREESPACE_API int freespace_setLogAsync(int enable) {
+    long i;
+
+    if (enable && !async_) {
+        ringHead_ = 0;
+        ringTail_ = 0;
+        for (i = 0; i < FREESPACE_LOG_RING_SIZE; i++) {
+            ring_[i].sequence_ = i;
+        }
+        FREESPACE_ATOMIC_BARRIER();
+        async_ = 1;
+    } else if (!enable && async_) {
+        async_ = 0;
+        freespace_drainLog();
+    }
+    return FREESPACE_SUCCESS;
+}
+
+LIBFREESPACE_API int freespace_drainLog() {
+    struct FreespaceLogEntry* entry;
+    char message[64];
+    long dropped;
+    int count = 0;
+
+    for (;;) {
+        entry = &ring_[ringTail_ & (FREESPACE_LOG_RING_SIZE - 1)];
+        if (entry->sequence_ != ringTail_ + 1) {
+            break;
+        }
+        FREESPACE_ATOMIC_BARRIER();
+        deliver(entry->subsystem_, entry->level_, entry->message_);
+        FREESPACE_ATOMIC_BARRIER();
+        entry->sequence_ = ringTail_ + FREESPACE_LOG_RING_SIZE;
+        ringTail_++;
+        count++;
+    }
+
+    dropped = dropped_;
+    if (dropped != 0) {
+        while (!FREESPACE_ATOMIC_CAS(&dropped_, dropped, 0)) {
+            dropped = dropped_;
+        }
+        snprintf(message, sizeof(message), "%ld log messages dropped", dropped);
+        deliver(FREESPACE_LOG_BACKEND, FREESPACE_LOG_LEVEL_WARN, message);
+    }
+    return count;
+}
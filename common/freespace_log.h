@@ -0,0 +1,43 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _FREESPACE_LOG_H_
+#define _FREESPACE_LOG_H_
+
+#include "freespace/freespace.h"
+#include "freespace_atomic.h"
+
+/**
+ * Current level of each FreespaceLogSubsystem. Checked inline by
+ * FREESPACE_LOG so that disabled messages cost a load and a branch.
+ */
+extern volatile int freespace_private_logLevels[FREESPACE_LOG_SUBSYSTEM_COUNT];
+
+/**
+ * Format a message and pass it to the log callback or the async ring.
+ * Use FREESPACE_LOG rather than calling this directly.
+ */
+void freespace_private_log(int subsystem, int level, const char* function, int line, const char* fmt, ...);
+
+#define FREESPACE_LOG(subsystem, level, ...) \
+    do { \
+        if (FREESPACE_UNLIKELY(freespace_private_logLevels[(subsystem)] >= (level))) { \
+            freespace_private_log((subsystem), (level), __FUNCTION__, __LINE__, __VA_ARGS__); \
+        } \
+    } while (0)
+
+#endif // _FREESPACE_LOG_H_
@@ -0,0 +1,218 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "freespace_mailbox.h"
+#include "freespace_alloc.h"
+#include "freespace_atomic.h"
+#include "freespace_rate.h"
+
+#include <string.h>
+
+#define MAILBOX_MASK_WORDS ((FREESPACE_MESSAGE_TYPE_COUNT + 31) / 32)
+
+/**
+ * The newest report of one type. The report is stored undecoded so
+ * that only the reports that are actually read get decoded.
+ *
+ * sequence_ is a seqlock: it is odd while the single writer (the thread
+ * running freespace_perform) updates the report. Readers retry until
+ * they see the same even value before and after copying. read_ is the
+ * sequence of the last report read, so the writer can tell when it
+ * replaces one nobody has read.
+ */
+struct FreespaceMailbox {
+    volatile uint32_t sequence_;
+    volatile uint32_t read_;
+    int length_;
+    uint8_t hVer_;
+    uint8_t report_[FREESPACE_MAX_INPUT_MESSAGE_SIZE];
+};
+
+struct FreespaceMailboxSet {
+    uint32_t conflate_[MAILBOX_MASK_WORDS];
+    struct FreespaceMailbox boxes_[FREESPACE_MESSAGE_TYPE_COUNT];
+};
+
+// Allocated when conflation is first enabled for an id and kept until
+// freespace_exit so that readers on other threads never see it freed.
+static struct FreespaceMailboxSet* volatile mailboxes_[FREESPACE_MAILBOX_MAX_ID];
+
+static struct FreespaceMailboxSet* getSet(FreespaceDeviceId id) {
+    if (id < 0 || id >= FREESPACE_MAILBOX_MAX_ID) {
+        return NULL;
+    }
+    return mailboxes_[id];
+}
+
+LIBFREESPACE_API int freespace_setConflation(FreespaceDeviceId id, int messageType, int enable) {
+    struct FreespaceDeviceInfo info;
+    struct FreespaceMailboxSet* set;
+    int rc;
+
+    if (messageType < 0 || messageType >= FREESPACE_MESSAGE_TYPE_COUNT) {
+        return FREESPACE_ERROR_UNEXPECTED;
+    }
+    if (id < 0 || id >= FREESPACE_MAILBOX_MAX_ID) {
+        return FREESPACE_ERROR_INVALID_DEVICE;
+    }
+    rc = freespace_getDeviceInfo(id, &info);
+    if (rc != FREESPACE_SUCCESS) {
+        return rc;
+    }
+
+    set = mailboxes_[id];
+    if (set == NULL) {
+        if (!enable) {
+            return FREESPACE_SUCCESS;
+        }
+        set = (struct FreespaceMailboxSet*) freespace_private_calloc(sizeof(struct FreespaceMailboxSet));
+        if (set == NULL) {
+            return FREESPACE_ERROR_OUT_OF_MEMORY;
+        }
+        // Publish only once it is initialized
+        FREESPACE_ATOMIC_BARRIER();
+        mailboxes_[id] = set;
+    }
+
+    if (enable) {
+        set->conflate_[messageType / 32] |= (1u << (messageType % 32));
+    } else {
+        set->conflate_[messageType / 32] &= ~(1u << (messageType % 32));
+    }
+    return FREESPACE_SUCCESS;
+}
+
+LIBFREESPACE_API int freespace_getLatest(FreespaceDeviceId id, int messageType, struct freespace_message* message) {
+    struct FreespaceMailboxSet* set = getSet(id);
+    struct FreespaceMailbox* box;
+    uint8_t report[FREESPACE_MAX_INPUT_MESSAGE_SIZE];
+    uint32_t before;
+    uint32_t after;
+    int length;
+    uint8_t hVer;
+
+    if (messageType < 0 || messageType >= FREESPACE_MESSAGE_TYPE_COUNT) {
+        return FREESPACE_ERROR_UNEXPECTED;
+    }
+    if (set == NULL) {
+        return FREESPACE_ERROR_NO_DATA;
+    }
+
+    box = &set->boxes_[messageType];
+    do {
+        before = box->sequence_;
+        FREESPACE_ATOMIC_BARRIER();
+        length = box->length_;
+        hVer = box->hVer_;
+        if (length > 0 && length <= (int) sizeof(report)) {
+            memcpy(report, box->report_, length);
+        }
+        FREESPACE_ATOMIC_BARRIER();
+        after = box->sequence_;
+    } while ((before & 1) || before != after);
+
+    if (length <= 0) {
+        return FREESPACE_ERROR_NO_DATA;
+    }
+    box->read_ = after;
+    return freespace_decode_message(report, length, message, hVer);
+}
+
+int freespace_private_mailboxDeliver(FreespaceDeviceId id,
+                                     const uint8_t* report,
+                                     int length,
+                                     uint8_t hVer) {
+    struct FreespaceMailboxSet* set = getSet(id);
+    struct FreespaceMailbox* box;
+    int type;
+
+    if (set == NULL || length <= 0 || length > FREESPACE_MAX_INPUT_MESSAGE_SIZE) {
+        return 0;
+    }
+
+    type = freespace_peek_message_type(report, length, hVer);
+    if (type < 0 || (set->conflate_[type / 32] & (1u << (type % 32))) == 0) {
+        return 0;
+    }
+
+    box = &set->boxes_[type];
+    if (box->length_ > 0 && box->read_ != box->sequence_) {
+        FREESPACE_RATE_OVERWRITTEN(id);
+    }
+    box->sequence_++;
+    FREESPACE_ATOMIC_BARRIER();
+    memcpy(box->report_, report, length);
+    box->length_ = length;
+    box->hVer_ = hVer;
+    FREESPACE_ATOMIC_BARRIER();
+    box->sequence_++;
+    return 1;
+}
+
+int freespace_private_mailboxActive(FreespaceDeviceId id) {
+    struct FreespaceMailboxSet* set = getSet(id);
+    int i;
+
+    if (set == NULL) {
+        return 0;
+    }
+    for (i = 0; i < MAILBOX_MASK_WORDS; i++) {
+        if (set->conflate_[i] != 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+void freespace_private_mailboxTypes(FreespaceDeviceId id, uint32_t* mask) {
+    struct FreespaceMailboxSet* set = getSet(id);
+    int i;
+
+    if (set == NULL) {
+        return;
+    }
+    for (i = 0; i < MAILBOX_MASK_WORDS; i++) {
+        mask[i] |= set->conflate_[i];
+    }
+}
+
+void freespace_private_mailboxReset(FreespaceDeviceId id) {
+    struct FreespaceMailboxSet* set = getSet(id);
+    int i;
+
+    if (set == NULL) {
+        return;
+    }
+
+    memset(set->conflate_, 0, sizeof(set->conflate_));
+    for (i = 0; i < FREESPACE_MESSAGE_TYPE_COUNT; i++) {
+        struct FreespaceMailbox* box = &set->boxes_[i];
+        box->sequence_++;
+        FREESPACE_ATOMIC_BARRIER();
+        box->length_ = 0;
+        FREESPACE_ATOMIC_BARRIER();
+        box->sequence_++;
+    }
+}
+
+void freespace_private_mailboxExit() {
+    int i;
+    for (i = 0; i < FREESPACE_MAILBOX_MAX_ID; i++) {
+        freespace_private_free(mailboxes_[i]);
+        mailboxes_[i] = NULL;
+    }
+}
@@ -0,0 +1,63 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _FREESPACE_MAILBOX_H_
+#define _FREESPACE_MAILBOX_H_
+
+#include "freespace/freespace.h"
+
+/**
+ * Device ids are used to index the mailboxes. This covers every
+ * backend, including libusb where the id is the USB device address.
+ */
+#define FREESPACE_MAILBOX_MAX_ID 128
+
+/**
+ * Offer a received report to the latest value mailboxes. Called by the
+ * backends before running the receive callbacks.
+ *
+ * @return 1 if the report was conflated and must not be delivered to
+ *         the callbacks, 0 otherwise
+ */
+int freespace_private_mailboxDeliver(FreespaceDeviceId id,
+                                     const uint8_t* report,
+                                     int length,
+                                     uint8_t hVer);
+
+/**
+ * @return nonzero if any message type is being conflated for the device
+ */
+int freespace_private_mailboxActive(FreespaceDeviceId id);
+
+/**
+ * Set the bit of each conflated message type in mask, which has
+ * (FREESPACE_MESSAGE_TYPE_COUNT + 31) / 32 words.
+ */
+void freespace_private_mailboxTypes(FreespaceDeviceId id, uint32_t* mask);
+
+/**
+ * Turn conflation off and forget the stored values for a device. Called
+ * by the backends when a device is closed.
+ */
+void freespace_private_mailboxReset(FreespaceDeviceId id);
+
+/**
+ * Free all mailboxes. Called from freespace_exit().
+ */
+void freespace_private_mailboxExit();
+
+#endif // _FREESPACE_MAILBOX_H_
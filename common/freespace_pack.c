@@ -0,0 +1,494 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "freespace_pack.h"
+#include "freespace_schema.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * A packed report is
+ *
+ *   varint  nanoseconds since the previous report in the chunk
+ *   varint  stream: 0 for a new stream, else its context index + 1
+ *   for a new stream only:
+ *     varint id, byte hVer, byte direction, varint length,
+ *     varint schema message index + 1 (0 if unknown), byte report id
+ *   the values of the report against the previous one of its stream:
+ *     bitmap of the values that are not 0, one bit each
+ *     byte    bit width of the largest value (if any are set)
+ *     the set values, packed at that width
+ *
+ * The values come from walking the report after its id. Fields the
+ * message layout marks as 16 bit give the zigzagged difference from the
+ * previous value; quaternions give a smallest-three tag followed by the
+ * differences of the three smaller components; every other byte gives
+ * its zigzagged difference. A new stream is packed against zeros.
+ */
+
+// Quaternion components are Q14, so the squares sum to 16384^2
+#define QUATERNION_ONE_SQUARED (1u << 28)
+
+static int putVarint(uint8_t* out, uint64_t value) {
+    int n = 0;
+    while (value >= 0x80) {
+        out[n++] = (uint8_t) (value | 0x80);
+        value >>= 7;
+    }
+    out[n++] = (uint8_t) value;
+    return n;
+}
+
+static int getVarint(const uint8_t* in, int available, uint64_t* value) {
+    int n = 0;
+    int shift = 0;
+
+    *value = 0;
+    while (n < available && shift < 64) {
+        uint8_t b = in[n++];
+        *value |= (uint64_t) (b & 0x7f) << shift;
+        if ((b & 0x80) == 0) {
+            return n;
+        }
+        shift += 7;
+    }
+    return 0;
+}
+
+static uint32_t zigzag(int32_t value) {
+    return ((uint32_t) value << 1) ^ (uint32_t) (value >> 31);
+}
+
+static int32_t unzigzag(uint32_t value) {
+    return (int32_t) (value >> 1) ^ -(int32_t) (value & 1);
+}
+
+static int16_t getInt16(const uint8_t* p) {
+    return (int16_t) (p[0] | (p[1] << 8));
+}
+
+static void putInt16(uint8_t* p, int16_t value) {
+    p[0] = (uint8_t) value;
+    p[1] = (uint8_t) ((uint16_t) value >> 8);
+}
+
+static uint32_t isqrt(uint32_t n) {
+    uint32_t root = 0;
+    uint32_t bit = 1u << 30;
+
+    while (bit > n) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (n >= root + bit) {
+            n -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+
+// The largest component rebuilt from the other three, before its sign
+// and the rounding residual are applied.
+static int32_t largestComponent(const int16_t* q, int largest) {
+    uint32_t sum = 0;
+    int i;
+
+    for (i = 0; i < 4; i++) {
+        if (i != largest) {
+            sum += (uint32_t) ((int32_t) q[i] * q[i]);
+        }
+    }
+    return sum >= QUATERNION_ONE_SQUARED ? 0 : (int32_t) isqrt(QUATERNION_ONE_SQUARED - sum);
+}
+
+// The field of the layout starting at offset, or 0 for a plain byte.
+static int packingAt(const struct FreespacePackContext* context, int* field, int offset) {
+    while (*field < context->fieldCount_ && context->fields_[*field].offset < offset) {
+        (*field)++;
+    }
+    if (*field < context->fieldCount_ && context->fields_[*field].offset == offset) {
+        int packing = context->fields_[*field].packing;
+        if (packing == FREESPACE_PACK_QUATERNION && offset + 8 <= context->length_) {
+            return FREESPACE_PACK_QUATERNION;
+        }
+        if (packing == FREESPACE_PACK_INT16 && offset + 2 <= context->length_) {
+            return FREESPACE_PACK_INT16;
+        }
+    }
+    return 0;
+}
+
+static int valueCount(const struct FreespacePackContext* context) {
+    int offset = 1;
+    int field = 0;
+    int count = 0;
+
+    while (offset < context->length_) {
+        switch (packingAt(context, &field, offset)) {
+            case FREESPACE_PACK_QUATERNION:
+                offset += 8;
+                count += 4;
+                break;
+            case FREESPACE_PACK_INT16:
+                offset += 2;
+                count++;
+                break;
+            default:
+                offset++;
+                count++;
+                break;
+        }
+    }
+    return count;
+}
+
+static int toValues(const struct FreespacePackContext* context, const uint8_t* report, uint32_t* values) {
+    const uint8_t* previous = context->report_;
+    int offset = 1;
+    int field = 0;
+    int count = 0;
+    int i;
+
+    while (offset < context->length_) {
+        switch (packingAt(context, &field, offset)) {
+            case FREESPACE_PACK_QUATERNION: {
+                int16_t q[4];
+                int32_t rebuilt;
+                int largest = 0;
+                int negative;
+
+                for (i = 0; i < 4; i++) {
+                    q[i] = getInt16(report + offset + 2 * i);
+                    if (abs(q[i]) > abs(q[largest])) {
+                        largest = i;
+                    }
+                }
+                negative = q[largest] < 0;
+                rebuilt = largestComponent(q, largest);
+                if (negative) {
+                    rebuilt = -rebuilt;
+                }
+                values[count++] = (zigzag(q[largest] - rebuilt) << 3) | (negative << 2) | largest;
+                for (i = 0; i < 4; i++) {
+                    if (i != largest) {
+                        values[count++] = zigzag((int16_t) (q[i] - getInt16(previous + offset + 2 * i)));
+                    }
+                }
+                offset += 8;
+                break;
+            }
+            case FREESPACE_PACK_INT16:
+                values[count++] = zigzag((int16_t) (getInt16(report + offset) - getInt16(previous + offset)));
+                offset += 2;
+                break;
+            default:
+                values[count++] = zigzag((int8_t) (report[offset] - previous[offset]));
+                offset++;
+                break;
+        }
+    }
+    return count;
+}
+
+// Apply the values to the previous report of the stream, in place.
+static void fromValues(struct FreespacePackContext* context, const uint32_t* values) {
+    uint8_t* report = context->report_;
+    int offset = 1;
+    int field = 0;
+    int count = 0;
+    int i;
+
+    while (offset < context->length_) {
+        switch (packingAt(context, &field, offset)) {
+            case FREESPACE_PACK_QUATERNION: {
+                int16_t q[4];
+                uint32_t tag = values[count++];
+                int largest = tag & 3;
+                int32_t rebuilt;
+
+                for (i = 0; i < 4; i++) {
+                    q[i] = 0;
+                    if (i != largest) {
+                        q[i] = (int16_t) (getInt16(report + offset + 2 * i) + unzigzag(values[count++]));
+                    }
+                }
+                rebuilt = largestComponent(q, largest);
+                if (tag & 4) {
+                    rebuilt = -rebuilt;
+                }
+                q[largest] = (int16_t) (rebuilt + unzigzag(tag >> 3));
+                for (i = 0; i < 4; i++) {
+                    putInt16(report + offset + 2 * i, q[i]);
+                }
+                offset += 8;
+                break;
+            }
+            case FREESPACE_PACK_INT16:
+                putInt16(report + offset, (int16_t) (getInt16(report + offset) + unzigzag(values[count++])));
+                offset += 2;
+                break;
+            default:
+                report[offset] = (uint8_t) (report[offset] + unzigzag(values[count++]));
+                offset++;
+                break;
+        }
+    }
+}
+
+static void startContext(const struct FreespacePackState* state, struct FreespacePackContext* context,
+                         FreespaceDeviceId id, int hVer, int direction, int length, int type, uint8_t reportId) {
+    context->id_ = id;
+    context->hVer_ = (uint8_t) hVer;
+    context->direction_ = (uint8_t) direction;
+    context->length_ = length;
+    context->type_ = type;
+    context->fieldCount_ = 0;
+    context->fields_ = NULL;
+    if (type >= 0) {
+        context->fieldCount_ = freespace_private_schemaLayout(state->schema_, type, &context->fields_);
+    }
+    memset(context->report_, 0, sizeof(context->report_));
+    context->report_[0] = reportId;
+}
+
+void freespace_private_packReset(struct FreespacePackState* state, uint64_t timestampNs) {
+    state->timestampNs_ = timestampNs;
+    state->used_ = 0;
+    state->next_ = 0;
+}
+
+// Take the next context, reusing the oldest once they are all in use.
+static int newContext(struct FreespacePackState* state) {
+    int index = state->next_;
+    state->next_ = (state->next_ + 1) % FREESPACE_PACK_CONTEXTS;
+    if (state->used_ < FREESPACE_PACK_CONTEXTS) {
+        state->used_++;
+    }
+    return index;
+}
+
+int freespace_private_packReport(struct FreespacePackState* state,
+                                 uint64_t timestampNs,
+                                 FreespaceDeviceId id,
+                                 int hVer,
+                                 int direction,
+                                 const uint8_t* report,
+                                 int length,
+                                 uint8_t* out) {
+    struct FreespacePackContext* context = NULL;
+    uint32_t values[FREESPACE_PACK_MAX_REPORT];
+    uint64_t bits;
+    uint32_t largest;
+    int count;
+    int type;
+    int width;
+    int held;
+    int n = 0;
+    int i;
+
+    if (length < 1 || length > FREESPACE_PACK_MAX_REPORT) {
+        return FREESPACE_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    n += putVarint(out + n, timestampNs - state->timestampNs_);
+    state->timestampNs_ = timestampNs;
+
+    type = freespace_private_schemaFind(state->schema_, report, length, hVer, direction);
+    for (i = 0; i < state->used_; i++) {
+        struct FreespacePackContext* c = &state->contexts_[i];
+        if (c->id_ == id && c->hVer_ == hVer && c->direction_ == direction &&
+            c->length_ == length && c->type_ == type && c->report_[0] == report[0]) {
+            context = c;
+            break;
+        }
+    }
+    if (context != NULL) {
+        n += putVarint(out + n, (uint64_t) (context - state->contexts_) + 1);
+    } else {
+        context = &state->contexts_[newContext(state)];
+        startContext(state, context, id, hVer, direction, length, type, report[0]);
+        n += putVarint(out + n, 0);
+        n += putVarint(out + n, (uint32_t) id);
+        out[n++] = (uint8_t) hVer;
+        out[n++] = (uint8_t) direction;
+        n += putVarint(out + n, (uint64_t) length);
+        n += putVarint(out + n, (uint64_t) (type + 1));
+        out[n++] = report[0];
+    }
+
+    count = toValues(context, report, values);
+    memcpy(context->report_, report, length);
+
+    memset(out + n, 0, (count + 7) / 8);
+    largest = 0;
+    for (i = 0; i < count; i++) {
+        if (values[i] != 0) {
+            out[n + i / 8] |= (uint8_t) (1 << (i % 8));
+            if (values[i] > largest) {
+                largest = values[i];
+            }
+        }
+    }
+    n += (count + 7) / 8;
+    if (largest == 0) {
+        return n;
+    }
+
+    width = 0;
+    while (width < 32 && (largest >> width) != 0) {
+        width++;
+    }
+    out[n++] = (uint8_t) width;
+
+    bits = 0;
+    held = 0;
+    for (i = 0; i < count; i++) {
+        if (values[i] == 0) {
+            continue;
+        }
+        bits |= (uint64_t) values[i] << held;
+        held += width;
+        while (held >= 8) {
+            out[n++] = (uint8_t) bits;
+            bits >>= 8;
+            held -= 8;
+        }
+    }
+    if (held > 0) {
+        out[n++] = (uint8_t) bits;
+    }
+    return n;
+}
+
+int freespace_private_unpackReport(struct FreespacePackState* state,
+                                   const uint8_t* in,
+                                   int available,
+                                   struct FreespacePackedReport* report) {
+    struct FreespacePackContext* context;
+    uint32_t values[FREESPACE_PACK_MAX_REPORT];
+    const uint8_t* bitmap;
+    uint64_t value;
+    uint64_t bits;
+    int count;
+    int width;
+    int held;
+    int used;
+    int n = 0;
+    int i;
+
+    used = getVarint(in, available, &value);
+    if (used == 0) {
+        return FREESPACE_ERROR_MALFORMED_MESSAGE;
+    }
+    n += used;
+    state->timestampNs_ += value;
+
+    used = getVarint(in + n, available - n, &value);
+    if (used == 0 || value > (uint64_t) state->used_) {
+        return FREESPACE_ERROR_MALFORMED_MESSAGE;
+    }
+    n += used;
+
+    if (value > 0) {
+        context = &state->contexts_[value - 1];
+    } else {
+        uint64_t id;
+        uint64_t length;
+        uint64_t type;
+        uint8_t hVer;
+        uint8_t direction;
+
+        used = getVarint(in + n, available - n, &id);
+        if (used == 0 || n + used + 2 > available) {
+            return FREESPACE_ERROR_MALFORMED_MESSAGE;
+        }
+        n += used;
+        hVer = in[n++];
+        direction = in[n++];
+        used = getVarint(in + n, available - n, &length);
+        if (used == 0 || length < 1 || length > FREESPACE_PACK_MAX_REPORT) {
+            return FREESPACE_ERROR_MALFORMED_MESSAGE;
+        }
+        n += used;
+        used = getVarint(in + n, available - n, &type);
+        if (used == 0 || type > (uint64_t) freespace_private_schemaCount(state->schema_) || n + used >= available) {
+            return FREESPACE_ERROR_MALFORMED_MESSAGE;
+        }
+        n += used;
+        context = &state->contexts_[newContext(state)];
+        startContext(state, context, (FreespaceDeviceId) (int32_t) id, hVer, direction,
+                     (int) length, (int) type - 1, in[n++]);
+    }
+
+    count = valueCount(context);
+    if (n + (count + 7) / 8 > available) {
+        return FREESPACE_ERROR_MALFORMED_MESSAGE;
+    }
+    bitmap = in + n;
+    n += (count + 7) / 8;
+
+    width = 0;
+    for (i = 0; i < count; i++) {
+        if (bitmap[i / 8] & (1 << (i % 8))) {
+            width = -1;
+            break;
+        }
+    }
+    if (width < 0) {
+        if (n >= available) {
+            return FREESPACE_ERROR_MALFORMED_MESSAGE;
+        }
+        width = in[n++];
+        if (width < 1 || width > 32) {
+            return FREESPACE_ERROR_MALFORMED_MESSAGE;
+        }
+    }
+
+    bits = 0;
+    held = 0;
+    for (i = 0; i < count; i++) {
+        values[i] = 0;
+        if ((bitmap[i / 8] & (1 << (i % 8))) == 0) {
+            continue;
+        }
+        while (held < width) {
+            if (n >= available) {
+                return FREESPACE_ERROR_MALFORMED_MESSAGE;
+            }
+            bits |= (uint64_t) in[n++] << held;
+            held += 8;
+        }
+        values[i] = (uint32_t) (bits & ((((uint64_t) 1) << width) - 1));
+        bits >>= width;
+        held -= width;
+    }
+
+    fromValues(context, values);
+
+    report->timestampNs_ = state->timestampNs_;
+    report->id_ = context->id_;
+    report->hVer_ = context->hVer_;
+    report->direction_ = context->direction_;
+    report->length_ = context->length_;
+    report->report_ = context->report_;
+    return n;
+}
@@ -0,0 +1,104 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _FREESPACE_PACK_H_
+#define _FREESPACE_PACK_H_
+
+#include "freespace/freespace.h"
+
+/**
+ * Number of report streams (device, direction, message type) that a
+ * packed chunk tracks at once. More than this just pack less well.
+ */
+#define FREESPACE_PACK_CONTEXTS 16
+
+/** Largest report that can be packed */
+#define FREESPACE_PACK_MAX_REPORT 96
+
+/** Upper bound on the packed size of a report of length bytes */
+#define FREESPACE_PACK_MAX_SIZE(length) (48 + 6 * (length))
+
+struct FreespacePackContext {
+    int32_t id_;
+    uint8_t hVer_;
+    uint8_t direction_;
+    int length_;
+    // Index of the message definition in the schema, or -1
+    int type_;
+    const struct freespace_field_layout* fields_;
+    int fieldCount_;
+
+    // The previous report of this stream, which the next is packed against
+    uint8_t report_[FREESPACE_PACK_MAX_REPORT];
+};
+
+/**
+ * State shared by the packer and unpacker of one chunk. Both start
+ * from freespace_private_packReset() at the start of the chunk so that
+ * every chunk can be unpacked on its own.
+ */
+struct FreespacePackState {
+    // Message definitions that give the field layouts. The packer and
+    // unpacker of a capture must use the same ones.
+    const struct FreespaceSchema* schema_;
+    uint64_t timestampNs_;
+    int used_;
+    int next_;
+    struct FreespacePackContext contexts_[FREESPACE_PACK_CONTEXTS];
+};
+
+/**
+ * An unpacked report. report points into the state and is valid until
+ * the next report is unpacked.
+ */
+struct FreespacePackedReport {
+    uint64_t timestampNs_;
+    int32_t id_;
+    uint8_t hVer_;
+    uint8_t direction_;
+    int length_;
+    const uint8_t* report_;
+};
+
+void freespace_private_packReset(struct FreespacePackState* state, uint64_t timestampNs);
+
+/**
+ * Pack a report. out must hold FREESPACE_PACK_MAX_SIZE(length) bytes.
+ *
+ * @return the number of bytes written or an error if the report is
+ *         longer than FREESPACE_PACK_MAX_REPORT
+ */
+int freespace_private_packReport(struct FreespacePackState* state,
+                                 uint64_t timestampNs,
+                                 FreespaceDeviceId id,
+                                 int hVer,
+                                 int direction,
+                                 const uint8_t* report,
+                                 int length,
+                                 uint8_t* out);
+
+/**
+ * Unpack the report at in.
+ *
+ * @return the number of bytes used or FREESPACE_ERROR_MALFORMED_MESSAGE
+ */
+int freespace_private_unpackReport(struct FreespacePackState* state,
+                                   const uint8_t* in,
+                                   int available,
+                                   struct FreespacePackedReport* report);
+
+#endif // _FREESPACE_PACK_H_
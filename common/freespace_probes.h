@@ -0,0 +1,49 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _FREESPACE_PROBES_H_
+#define _FREESPACE_PROBES_H_
+
+/**
+ * USDT (SystemTap/DTrace style) static probes for bpftrace, perf or
+ * stap. Each one is a nop instruction plus an ELF note until a tracer
+ * attaches, so they stay compiled in. The provider is "libfreespace":
+ *
+ *   report__received   (device id, length, report id)
+ *   decode__done       (device id, message type or -1, result)
+ *   callback__entry    (device id)
+ *   callback__return   (device id)
+ *   write__submitted   (device id, length)
+ *   write__completed   (device id, result)
+ *   hotplug__insert    (device id)
+ *   hotplug__remove    (device id)
+ *
+ * The hidraw writes only know the descriptor, so their device id is -1.
+ */
+#ifdef LIBFREESPACE_USDT_PROBES
+#include <sys/sdt.h>
+
+#define FREESPACE_PROBE1(name, a) STAP_PROBE1(libfreespace, name, a)
+#define FREESPACE_PROBE2(name, a, b) STAP_PROBE2(libfreespace, name, a, b)
+#define FREESPACE_PROBE3(name, a, b, c) STAP_PROBE3(libfreespace, name, a, b, c)
+#else
+#define FREESPACE_PROBE1(name, a) do { } while (0)
+#define FREESPACE_PROBE2(name, a, b) do { } while (0)
+#define FREESPACE_PROBE3(name, a, b, c) do { } while (0)
+#endif
+
+#endif // _FREESPACE_PROBES_H_
@@ -0,0 +1,501 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "freespace_publish.h"
+#include "freespace_alloc.h"
+#include "freespace_mailbox.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+/*
+ * Each device gets a shared memory segment named after the publisher
+ * and the device id:
+ *
+ *   SharedHeader, then the schema of the publishing library
+ *   slotCount_ SharedSlots, each slotSize_ bytes
+ *
+ * Only the process that owns the device writes. A slot is guarded by a
+ * seqlock: version_ is odd while the slot is being written, so a reader
+ * that sees the same even version before and after using a slot knows
+ * that it was not overwritten in between. Readers never write to the
+ * segment and never make a system call to read.
+ */
+#define SHARED_MAGIC "FSSHARED"
+#define SHARED_VERSION 1
+#define SHARED_ALIGN 64
+#define SHARED_DEFAULT_SLOTS 1024
+#define SHARED_NAME_SIZE 96
+
+struct SharedHeader {
+    char magic_[8];
+    uint32_t version_;
+    uint32_t headerSize_;
+    uint32_t slotCount_;
+    uint32_t slotSize_;
+    uint32_t schemaSize_;
+    // sizeof(struct freespace_message) in the publisher. Readers built
+    // with a different size only get the raw reports.
+    uint32_t messageSize_;
+    int32_t id_;
+    int32_t hVer_;
+    // Set when the publisher stops; nothing more will be written
+    volatile uint32_t stopped_;
+    uint8_t reserved_[SHARED_ALIGN - 44];
+
+    // Number of reports published, on a cache line of its own
+    volatile uint32_t head_;
+};
+
+struct SharedSlot {
+    volatile uint32_t version_;
+    uint32_t sequence_;
+    uint64_t timestampNs_;
+    int32_t length_;
+    int32_t decoded_;
+    uint8_t report_[FREESPACE_MAX_INPUT_MESSAGE_SIZE];
+    struct freespace_message message_;
+};
+
+#define SLOT_SIZE ((sizeof(struct SharedSlot) + SHARED_ALIGN - 1) & ~((size_t) SHARED_ALIGN - 1))
+
+struct SharedMapping {
+    uint8_t* base_;
+    size_t size_;
+#ifdef _WIN32
+    HANDLE mapping_;
+#endif
+};
+
+struct PublisherRing {
+    // Held while writing a report and while the ring is created or unmapped
+    volatile long lock_;
+    struct SharedMapping mapping_;
+    struct SharedHeader* header_;
+    // Set if the segment could not be made, so that it is not retried
+    // for every report.
+    int failed_;
+};
+
+struct FreespaceSharedStream {
+    struct SharedMapping mapping_;
+    const struct SharedHeader* header_;
+    const uint8_t* slots_;
+    uint32_t mask_;
+    struct FreespaceSchema* schema_;
+
+    // The next report to read, and the slot and version of the last one
+    uint32_t next_;
+    const struct SharedSlot* slot_;
+    uint32_t slotVersion_;
+};
+
+volatile int freespace_private_publisherEnabled = 0;
+
+static char name_[SHARED_NAME_SIZE];
+static uint32_t slotCount_ = SHARED_DEFAULT_SLOTS;
+static struct PublisherRing rings_[FREESPACE_MAILBOX_MAX_ID];
+
+static uint64_t monotonicNanos() {
+#ifdef _WIN32
+    LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (uint64_t) (counter.QuadPart / frequency.QuadPart) * 1000000000 +
+           (uint64_t) (counter.QuadPart % frequency.QuadPart) * 1000000000 / frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+#endif
+}
+
+static void segmentName(char* buf, size_t size, const char* name, FreespaceDeviceId id) {
+#ifdef _WIN32
+    _snprintf(buf, size, "Local\\freespace.%s.%d", name, id);
+    buf[size - 1] = '\0';
+#else
+    snprintf(buf, size, "/freespace.%s.%d", name, id);
+#endif
+}
+
+static int createSegment(const char* name, size_t size, struct SharedMapping* mapping) {
+#ifdef _WIN32
+    mapping->mapping_ = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE,
+                                           (DWORD) ((uint64_t) size >> 32), (DWORD) size, name);
+    if (mapping->mapping_ == NULL) {
+        return FREESPACE_ERROR_IO;
+    }
+    mapping->base_ = (uint8_t*) MapViewOfFile(mapping->mapping_, FILE_MAP_WRITE, 0, 0, size);
+    if (mapping->base_ == NULL) {
+        CloseHandle(mapping->mapping_);
+        return FREESPACE_ERROR_IO;
+    }
+#elif defined(__ANDROID__)
+    // Bionic has no named shared memory
+    return FREESPACE_ERROR_UINIMPLEMENTED;
+#else
+    void* base;
+    int fd;
+
+    // Replace anything left behind by a publisher that did not stop;
+    // its readers keep the old segment until they reopen.
+    shm_unlink(name);
+    fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0644);
+    if (fd < 0) {
+        return FREESPACE_ERROR_ACCESS;
+    }
+    if (ftruncate(fd, (off_t) size) != 0) {
+        close(fd);
+        shm_unlink(name);
+        return FREESPACE_ERROR_IO;
+    }
+    base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        shm_unlink(name);
+        return FREESPACE_ERROR_IO;
+    }
+    mapping->base_ = (uint8_t*) base;
+#endif
+    mapping->size_ = size;
+    return FREESPACE_SUCCESS;
+}
+
+static int openSegment(const char* name, struct SharedMapping* mapping) {
+#ifdef _WIN32
+    MEMORY_BASIC_INFORMATION info;
+
+    mapping->mapping_ = OpenFileMappingA(FILE_MAP_READ, FALSE, name);
+    if (mapping->mapping_ == NULL) {
+        return FREESPACE_ERROR_NOT_FOUND;
+    }
+    mapping->base_ = (uint8_t*) MapViewOfFile(mapping->mapping_, FILE_MAP_READ, 0, 0, 0);
+    if (mapping->base_ == NULL || VirtualQuery(mapping->base_, &info, sizeof(info)) == 0) {
+        return FREESPACE_ERROR_IO;
+    }
+    mapping->size_ = info.RegionSize;
+#elif defined(__ANDROID__)
+    return FREESPACE_ERROR_UINIMPLEMENTED;
+#else
+    struct stat st;
+    void* base;
+    int fd;
+
+    fd = shm_open(name, O_RDONLY, 0);
+    if (fd < 0) {
+        return FREESPACE_ERROR_NOT_FOUND;
+    }
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        close(fd);
+        return FREESPACE_ERROR_IO;
+    }
+    base = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        return FREESPACE_ERROR_IO;
+    }
+    mapping->base_ = (uint8_t*) base;
+    mapping->size_ = (size_t) st.st_size;
+#endif
+    return FREESPACE_SUCCESS;
+}
+
+static void closeSegment(struct SharedMapping* mapping) {
+    if (mapping->base_ == NULL) {
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(mapping->base_);
+    CloseHandle(mapping->mapping_);
+#else
+    munmap(mapping->base_, mapping->size_);
+#endif
+    mapping->base_ = NULL;
+}
+
+static void lockRing(struct PublisherRing* ring) {
+    while (!FREESPACE_ATOMIC_CAS(&ring->lock_, 0, 1)) {
+        // Only held while a report is written
+    }
+}
+
+static void unlockRing(struct PublisherRing* ring) {
+    FREESPACE_ATOMIC_BARRIER();
+    ring->lock_ = 0;
+}
+
+static void createRing(struct PublisherRing* ring, FreespaceDeviceId id, int hVer) {
+    struct SharedHeader* header;
+    char name[SHARED_NAME_SIZE + 32];
+    const uint8_t* schema;
+    uint32_t schemaSize;
+    size_t headerSize;
+
+    schemaSize = (uint32_t) freespace_message_schema(&schema);
+    headerSize = (sizeof(struct SharedHeader) + schemaSize + SHARED_ALIGN - 1) & ~((size_t) SHARED_ALIGN - 1);
+
+    segmentName(name, sizeof(name), name_, id);
+    if (createSegment(name, headerSize + slotCount_ * SLOT_SIZE, &ring->mapping_) != FREESPACE_SUCCESS) {
+        ring->failed_ = 1;
+        return;
+    }
+
+    // The segment starts zeroed, so every slot is at version 0
+    header = (struct SharedHeader*) ring->mapping_.base_;
+    memcpy(header->magic_, SHARED_MAGIC, sizeof(header->magic_));
+    header->version_ = SHARED_VERSION;
+    header->headerSize_ = (uint32_t) headerSize;
+    header->slotCount_ = slotCount_;
+    header->slotSize_ = (uint32_t) SLOT_SIZE;
+    header->schemaSize_ = schemaSize;
+    header->messageSize_ = (uint32_t) sizeof(struct freespace_message);
+    header->id_ = id;
+    header->hVer_ = hVer;
+    memcpy(header + 1, schema, schemaSize);
+    ring->header_ = header;
+}
+
+void freespace_private_publish(FreespaceDeviceId id, int hVer, const uint8_t* report, int length) {
+    struct PublisherRing* ring;
+    struct SharedHeader* header;
+    struct SharedSlot* slot;
+    uint32_t sequence;
+
+    if (id < 0 || id >= FREESPACE_MAILBOX_MAX_ID ||
+        length < 1 || length > FREESPACE_MAX_INPUT_MESSAGE_SIZE) {
+        return;
+    }
+    ring = &rings_[id];
+
+    lockRing(ring);
+    if (!freespace_private_publisherEnabled) {
+        // Stopped since the caller checked
+        unlockRing(ring);
+        return;
+    }
+    if (ring->header_ == NULL && !ring->failed_) {
+        createRing(ring, id, hVer);
+    }
+    header = ring->header_;
+    if (header == NULL) {
+        unlockRing(ring);
+        return;
+    }
+
+    sequence = header->head_;
+    slot = (struct SharedSlot*) (ring->mapping_.base_ + header->headerSize_ +
+                                 (size_t) (sequence & (header->slotCount_ - 1)) * SLOT_SIZE);
+
+    slot->version_++;
+    FREESPACE_ATOMIC_BARRIER();
+    slot->sequence_ = sequence;
+    slot->timestampNs_ = monotonicNanos();
+    slot->length_ = length;
+    memcpy(slot->report_, report, length);
+    // Decoded straight into shared memory
+    slot->decoded_ = freespace_decode_message(report, length, &slot->message_, (uint8_t) hVer) == FREESPACE_SUCCESS;
+    FREESPACE_ATOMIC_BARRIER();
+    slot->version_++;
+    FREESPACE_ATOMIC_BARRIER();
+    header->head_ = sequence + 1;
+
+    unlockRing(ring);
+}
+
+LIBFREESPACE_API int freespace_publisherStart(const char* name, int slotCount) {
+#ifdef __ANDROID__
+    return FREESPACE_ERROR_UINIMPLEMENTED;
+#endif
+    if (freespace_private_publisherEnabled) {
+        return FREESPACE_ERROR_BUSY;
+    }
+    if (name == NULL || name[0] == '\0' || strlen(name) >= SHARED_NAME_SIZE ||
+        strchr(name, '/') != NULL || strchr(name, '\\') != NULL) {
+        return FREESPACE_ERROR_UNEXPECTED;
+    }
+    if (slotCount == 0) {
+        slotCount = SHARED_DEFAULT_SLOTS;
+    }
+    if (slotCount < 2 || (slotCount & (slotCount - 1)) != 0) {
+        return FREESPACE_ERROR_UNEXPECTED;
+    }
+
+    strcpy(name_, name);
+    slotCount_ = (uint32_t) slotCount;
+    FREESPACE_ATOMIC_BARRIER();
+    freespace_private_publisherEnabled = 1;
+    return FREESPACE_SUCCESS;
+}
+
+LIBFREESPACE_API int freespace_publisherStop() {
+    int i;
+
+    if (!freespace_private_publisherEnabled) {
+        return FREESPACE_ERROR_NO_DATA;
+    }
+    freespace_private_publisherEnabled = 0;
+
+    for (i = 0; i < FREESPACE_MAILBOX_MAX_ID; i++) {
+        struct PublisherRing* ring = &rings_[i];
+        lockRing(ring);
+        if (ring->header_ != NULL) {
+            ring->header_->stopped_ = 1;
+            closeSegment(&ring->mapping_);
+#if !defined(_WIN32) && !defined(__ANDROID__)
+            {
+                // Readers keep their mappings; new ones will not find it
+                char name[SHARED_NAME_SIZE + 32];
+                segmentName(name, sizeof(name), name_, i);
+                shm_unlink(name);
+            }
+#endif
+            ring->header_ = NULL;
+        }
+        ring->failed_ = 0;
+        unlockRing(ring);
+    }
+    return FREESPACE_SUCCESS;
+}
+
+LIBFREESPACE_API int freespace_sharedOpen(const char* name, FreespaceDeviceId id, struct FreespaceSharedStream** stream) {
+    struct FreespaceSharedStream* s;
+    const struct SharedHeader* header;
+    char segment[SHARED_NAME_SIZE + 32];
+    int rc;
+
+    *stream = NULL;
+    if (name == NULL || strlen(name) >= SHARED_NAME_SIZE) {
+        return FREESPACE_ERROR_NOT_FOUND;
+    }
+    s = (struct FreespaceSharedStream*) freespace_private_calloc(sizeof(struct FreespaceSharedStream));
+    if (s == NULL) {
+        return FREESPACE_ERROR_OUT_OF_MEMORY;
+    }
+
+    segmentName(segment, sizeof(segment), name, id);
+    rc = openSegment(segment, &s->mapping_);
+    if (rc != FREESPACE_SUCCESS) {
+        freespace_sharedClose(s);
+        return rc;
+    }
+
+    header = (const struct SharedHeader*) s->mapping_.base_;
+    if (s->mapping_.size_ < sizeof(struct SharedHeader) ||
+        memcmp(header->magic_, SHARED_MAGIC, sizeof(header->magic_)) != 0 ||
+        header->version_ != SHARED_VERSION ||
+        header->slotCount_ < 2 || (header->slotCount_ & (header->slotCount_ - 1)) != 0 ||
+        header->slotSize_ < sizeof(struct SharedSlot) - sizeof(struct freespace_message) ||
+        header->headerSize_ < sizeof(struct SharedHeader) + header->schemaSize_ ||
+        (uint64_t) header->headerSize_ + (uint64_t) header->slotCount_ * header->slotSize_ > s->mapping_.size_) {
+        freespace_sharedClose(s);
+        return FREESPACE_ERROR_MALFORMED_MESSAGE;
+    }
+    rc = freespace_schemaOpen((const uint8_t*) (header + 1), (int) header->schemaSize_, &s->schema_);
+    if (rc != FREESPACE_SUCCESS) {
+        freespace_sharedClose(s);
+        return rc;
+    }
+
+    s->header_ = header;
+    s->slots_ = s->mapping_.base_ + header->headerSize_;
+    s->mask_ = header->slotCount_ - 1;
+    // Start with the next report to be published
+    s->next_ = header->head_;
+    *stream = s;
+    return FREESPACE_SUCCESS;
+}
+
+LIBFREESPACE_API void freespace_sharedClose(struct FreespaceSharedStream* stream) {
+    if (stream == NULL) {
+        return;
+    }
+    closeSegment(&stream->mapping_);
+    freespace_schemaClose(stream->schema_);
+    freespace_private_free(stream);
+}
+
+LIBFREESPACE_API const struct FreespaceSchema* freespace_sharedSchema(struct FreespaceSharedStream* stream) {
+    return stream->schema_;
+}
+
+LIBFREESPACE_API int freespace_sharedNext(struct FreespaceSharedStream* stream, struct FreespaceSharedReport* report) {
+    const struct SharedHeader* header = stream->header_;
+    const struct SharedSlot* slot;
+    uint32_t dropped = 0;
+    uint32_t version;
+    uint32_t head;
+
+    for (;;) {
+        head = header->head_;
+        FREESPACE_ATOMIC_BARRIER();
+        if (head == stream->next_) {
+            return header->stopped_ ? FREESPACE_ERROR_NO_DEVICE : FREESPACE_ERROR_NO_DATA;
+        }
+        if (head - stream->next_ > stream->mask_) {
+            // Lapped by the publisher. Skip to the oldest report that
+            // is still there.
+            dropped += head - stream->next_ - stream->mask_;
+            stream->next_ = head - stream->mask_;
+        }
+
+        slot = (const struct SharedSlot*) (stream->slots_ + (size_t) (stream->next_ & stream->mask_) * header->slotSize_);
+        version = slot->version_;
+        FREESPACE_ATOMIC_BARRIER();
+        if ((version & 1) == 0 && slot->sequence_ == stream->next_) {
+            break;
+        }
+        // Overwritten while looking at it; look at the head again
+    }
+
+    stream->slot_ = slot;
+    stream->slotVersion_ = version;
+    stream->next_++;
+
+    report->sequence = slot->sequence_;
+    report->dropped = dropped;
+    report->timestampNs = slot->timestampNs_;
+    report->id = header->id_;
+    report->hVer = header->hVer_;
+    report->length = slot->length_ < 0 || slot->length_ > FREESPACE_MAX_INPUT_MESSAGE_SIZE ? 0 : slot->length_;
+    report->data = slot->report_;
+    report->message = NULL;
+    if (slot->decoded_ && header->messageSize_ == sizeof(struct freespace_message)) {
+        report->message = &slot->message_;
+    }
+    return FREESPACE_SUCCESS;
+}
+
+LIBFREESPACE_API int freespace_sharedValid(struct FreespaceSharedStream* stream) {
+    FREESPACE_ATOMIC_BARRIER();
+    if (stream->slot_ == NULL || stream->slot_->version_ != stream->slotVersion_) {
+        return FREESPACE_ERROR_NO_DATA;
+    }
+    return FREESPACE_SUCCESS;
+}
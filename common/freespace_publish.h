@@ -0,0 +1,45 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _FREESPACE_PUBLISH_H_
+#define _FREESPACE_PUBLISH_H_
+
+#include "freespace/freespace.h"
+#include "freespace_atomic.h"
+
+/**
+ * Set while freespace_publisherStart() is publishing. Checked inline by
+ * FREESPACE_PUBLISH so that publishing costs a load and a branch when
+ * off.
+ */
+extern volatile int freespace_private_publisherEnabled;
+
+/**
+ * Decode a received report into the shared ring of its device,
+ * creating the ring on the first report.
+ */
+void freespace_private_publish(FreespaceDeviceId id, int hVer, const uint8_t* report, int length);
+
+#define FREESPACE_PUBLISH(id, hVer, report, length) \
+    do { \
+        if (FREESPACE_UNLIKELY(freespace_private_publisherEnabled)) { \
+            freespace_private_publish((id), (hVer), (report), (length)); \
+        } \
+    } while (0)
+
+#endif // _FREESPACE_PUBLISH_H_
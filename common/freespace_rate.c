@@ -0,0 +1,332 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "freespace_rate.h"
+#include "freespace_request.h"
+#include "freespace_alloc.h"
+#include "freespace_log.h"
+
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#define DEBUG(...) FREESPACE_LOG(FREESPACE_LOG_BACKEND, FREESPACE_LOG_LEVEL_DEBUG, __VA_ARGS__)
+#define WARN(...) FREESPACE_LOG(FREESPACE_LOG_BACKEND, FREESPACE_LOG_LEVEL_WARN, __VA_ARGS__)
+
+/*
+ * The host is behind when, over a window, a device had many reports
+ * queued by the time they were read, conflated reports were replaced
+ * before being read, or the application spent most of the window in
+ * the callbacks reports are dispatched to. The backlog is the most
+ * reports read from a device in one freespace_perform, against the
+ * reports the backend's queue holds: behind at half of it and calm at
+ * an eighth. A device the backend left reports unread on counts as a
+ * full queue.
+ *
+ * A device is slowed down by doubling its sensor period after
+ * RATE_BEHIND_WINDOWS windows in a row of being behind, and sped up by
+ * halving it after RATE_CALM_WINDOWS calm ones, within its bounds. The
+ * thresholds for calm are well below those for behind, and the period
+ * is held in between, so the rate does not flap.
+ */
+#define RATE_WINDOW_US 250000
+#define RATE_BEHIND_BACKLOG_DIVISOR 2
+#define RATE_CALM_BACKLOG_DIVISOR 8
+#define RATE_BEHIND_BUSY_PERCENT 80
+#define RATE_CALM_BUSY_PERCENT 50
+#define RATE_BEHIND_WINDOWS 2
+#define RATE_CALM_WINDOWS 8
+#define RATE_RESPONSE_TIMEOUT_MS 500
+
+struct RateControl {
+    int enabled_;
+    uint8_t sensor_;
+    uint32_t minPeriod_;
+    uint32_t maxPeriod_;
+    // The period the device was last confirmed to run at
+    uint32_t period_;
+    int inFlight_;
+
+    // This freespace_perform
+    int drained_;
+    int backlogged_;
+    // This window
+    int reports_;
+    int backlog_;
+    int overwrites_;
+
+    int behindWindows_;
+    int calmWindows_;
+};
+
+volatile int freespace_private_rateEnabled = 0;
+
+static struct RateControl* rates_[FREESPACE_MAILBOX_MAX_ID];
+static int64_t windowStart_ = 0;
+// Time spent dispatching reports this window
+static int64_t busy_ = 0;
+
+static int64_t nowMicros() {
+#ifdef _WIN32
+    LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (int64_t) (counter.QuadPart / frequency.QuadPart) * 1000000 +
+           (int64_t) (counter.QuadPart % frequency.QuadPart) * 1000000 / frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+#endif
+}
+
+static void updateEnabled() {
+    int enabled = 0;
+    int i;
+
+    for (i = 0; i < FREESPACE_MAILBOX_MAX_ID; i++) {
+        if (rates_[i] != NULL && rates_[i]->enabled_) {
+            enabled = 1;
+            break;
+        }
+    }
+    if (!enabled) {
+        windowStart_ = 0;
+        busy_ = 0;
+    }
+    freespace_private_rateEnabled = enabled;
+}
+
+static void onPeriod(FreespaceDeviceId id, struct freespace_message* response, void* cookie, int result) {
+    struct RateControl* rate = rates_[id];
+
+    if (rate == NULL) {
+        return;
+    }
+    rate->inFlight_ = 0;
+    if (result != FREESPACE_SUCCESS || response->sensorPeriodResponse.sensor != rate->sensor_) {
+        WARN("rate control on device %d: sensor period not changed: %d", id, result);
+        return;
+    }
+    // The device may round it
+    rate->period_ = response->sensorPeriodResponse.period;
+    DEBUG("rate control on device %d: sensor %d period now %u us", id, rate->sensor_, rate->period_);
+}
+
+static void sendPeriod(FreespaceDeviceId id, struct RateControl* rate, uint32_t period) {
+    struct freespace_message m;
+
+    memset(&m, 0, sizeof(m));
+    m.messageType = FREESPACE_MESSAGE_SENSORPERIODREQUEST;
+    m.sensorPeriodRequest.commit = 1;
+    m.sensorPeriodRequest.sensor = rate->sensor_;
+    m.sensorPeriodRequest.period = period;
+    if (freespace_request(id, &m, FREESPACE_MESSAGE_SENSORPERIODRESPONSE,
+                          RATE_RESPONSE_TIMEOUT_MS, onPeriod, NULL) == FREESPACE_SUCCESS) {
+        rate->inFlight_ = 1;
+    }
+}
+
+LIBFREESPACE_API int freespace_setRateControl(FreespaceDeviceId id,
+                                              int sensor,
+                                              uint32_t minPeriodUs,
+                                              uint32_t maxPeriodUs) {
+    struct FreespaceDeviceInfo info;
+    struct RateControl* rate;
+    int rc;
+
+    if (minPeriodUs != 0 && (sensor < 0 || sensor > 0xff || maxPeriodUs < minPeriodUs)) {
+        return FREESPACE_ERROR_UNEXPECTED;
+    }
+    if (id < 0 || id >= FREESPACE_MAILBOX_MAX_ID) {
+        return FREESPACE_ERROR_INVALID_DEVICE;
+    }
+    rc = freespace_getDeviceInfo(id, &info);
+    if (rc != FREESPACE_SUCCESS) {
+        return rc;
+    }
+
+    rate = rates_[id];
+    if (minPeriodUs == 0) {
+        if (rate != NULL && rate->enabled_) {
+            rate->enabled_ = 0;
+            // Put the device back to its full rate, also after a change
+            // still waiting for its response
+            if (rate->period_ != rate->minPeriod_ || rate->inFlight_) {
+                sendPeriod(id, rate, rate->minPeriod_);
+            }
+            updateEnabled();
+        }
+        return FREESPACE_SUCCESS;
+    }
+    if (info.hVer < 2) {
+        return FREESPACE_ERROR_INVALID_HID_PROTOCOL_VERSION;
+    }
+    if (rate == NULL) {
+        rate = (struct RateControl*) freespace_private_calloc(sizeof(struct RateControl));
+        if (rate == NULL) {
+            return FREESPACE_ERROR_OUT_OF_MEMORY;
+        }
+        rates_[id] = rate;
+    }
+    if (!rate->enabled_ || rate->sensor_ != (uint8_t) sensor) {
+        // Taken to be running at the full rate until told otherwise
+        rate->period_ = minPeriodUs;
+    }
+    rate->enabled_ = 1;
+    rate->sensor_ = (uint8_t) sensor;
+    rate->minPeriod_ = minPeriodUs;
+    rate->maxPeriod_ = maxPeriodUs;
+    rate->behindWindows_ = 0;
+    rate->calmWindows_ = 0;
+    if (rate->period_ < minPeriodUs || rate->period_ > maxPeriodUs) {
+        sendPeriod(id, rate, rate->period_ < minPeriodUs ? minPeriodUs : maxPeriodUs);
+    }
+    updateEnabled();
+    return FREESPACE_SUCCESS;
+}
+
+void freespace_private_rateReceived(FreespaceDeviceId id) {
+    if (id >= 0 && id < FREESPACE_MAILBOX_MAX_ID && rates_[id] != NULL) {
+        rates_[id]->drained_++;
+        rates_[id]->reports_++;
+    }
+}
+
+void freespace_private_rateOverwritten(FreespaceDeviceId id) {
+    if (id >= 0 && id < FREESPACE_MAILBOX_MAX_ID && rates_[id] != NULL) {
+        rates_[id]->overwrites_++;
+    }
+}
+
+void freespace_private_rateBacklogged(FreespaceDeviceId id) {
+    if (id >= 0 && id < FREESPACE_MAILBOX_MAX_ID && rates_[id] != NULL) {
+        rates_[id]->backlogged_ = 1;
+    }
+}
+
+int64_t freespace_private_rateNow() {
+    return nowMicros();
+}
+
+void freespace_private_rateDispatched(int64_t start) {
+    busy_ += nowMicros() - start;
+}
+
+static void adjust(FreespaceDeviceId id, struct RateControl* rate, int queue, int busyPercent) {
+    int behind = rate->backlog_ >= queue / RATE_BEHIND_BACKLOG_DIVISOR ||
+                 busyPercent >= RATE_BEHIND_BUSY_PERCENT ||
+                 (rate->overwrites_ > 0 && rate->overwrites_ * 10 >= rate->reports_);
+    int calm = rate->backlog_ <= queue / RATE_CALM_BACKLOG_DIVISOR &&
+               busyPercent <= RATE_CALM_BUSY_PERCENT &&
+               rate->overwrites_ == 0;
+    uint32_t period = rate->period_;
+
+    if (behind) {
+        rate->calmWindows_ = 0;
+        if (++rate->behindWindows_ >= RATE_BEHIND_WINDOWS && period < rate->maxPeriod_) {
+            period = period > rate->maxPeriod_ / 2 ? rate->maxPeriod_ : period * 2;
+        }
+    } else if (calm) {
+        rate->behindWindows_ = 0;
+        if (++rate->calmWindows_ >= RATE_CALM_WINDOWS && period > rate->minPeriod_) {
+            period = period / 2 < rate->minPeriod_ ? rate->minPeriod_ : period / 2;
+        }
+    } else {
+        rate->behindWindows_ = 0;
+        rate->calmWindows_ = 0;
+    }
+
+    if (period != rate->period_ && !rate->inFlight_) {
+        DEBUG("rate control on device %d: backlog %d, %d of %d overwritten, %d%% busy",
+             id, rate->backlog_, rate->overwrites_, rate->reports_, busyPercent);
+        rate->behindWindows_ = 0;
+        rate->calmWindows_ = 0;
+        sendPeriod(id, rate, period);
+    }
+}
+
+void freespace_private_ratePerform() {
+    int64_t now;
+    int busyPercent;
+    int queue;
+    int id;
+
+    if (!freespace_private_rateEnabled) {
+        return;
+    }
+    now = nowMicros();
+    queue = freespace_private_queueReports();
+    for (id = 0; id < FREESPACE_MAILBOX_MAX_ID; id++) {
+        struct RateControl* rate = rates_[id];
+        int backlog;
+        if (rate == NULL || !rate->enabled_) {
+            continue;
+        }
+        backlog = rate->backlogged_ ? queue : rate->drained_;
+        if (backlog > rate->backlog_) {
+            rate->backlog_ = backlog;
+        }
+        rate->drained_ = 0;
+        rate->backlogged_ = 0;
+    }
+
+    if (windowStart_ == 0) {
+        windowStart_ = now;
+        busy_ = 0;
+        return;
+    }
+    if (now - windowStart_ < RATE_WINDOW_US) {
+        return;
+    }
+    busyPercent = (int) (busy_ * 100 / (now - windowStart_));
+    windowStart_ = now;
+    busy_ = 0;
+    for (id = 0; id < FREESPACE_MAILBOX_MAX_ID; id++) {
+        struct RateControl* rate = rates_[id];
+        if (rate == NULL || !rate->enabled_) {
+            continue;
+        }
+        adjust(id, rate, queue, busyPercent);
+        rate->reports_ = 0;
+        rate->backlog_ = 0;
+        rate->overwrites_ = 0;
+    }
+}
+
+void freespace_private_rateReset(FreespaceDeviceId id) {
+    if (id >= 0 && id < FREESPACE_MAILBOX_MAX_ID && rates_[id] != NULL) {
+        memset(rates_[id], 0, sizeof(struct RateControl));
+        updateEnabled();
+    }
+}
+
+void freespace_private_rateExit() {
+    int i;
+
+    for (i = 0; i < FREESPACE_MAILBOX_MAX_ID; i++) {
+        freespace_private_free(rates_[i]);
+        rates_[i] = NULL;
+    }
+    updateEnabled();
+}
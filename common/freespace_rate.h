@@ -0,0 +1,121 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _FREESPACE_RATE_H_
+#define _FREESPACE_RATE_H_
+
+#include "freespace_mailbox.h"
+#include "freespace_atomic.h"
+
+/**
+ * Set while any device has rate control on. Checked inline by the
+ * FREESPACE_RATE_* macros so that the accounting costs a load and a
+ * branch when it is off.
+ */
+extern volatile int freespace_private_rateEnabled;
+
+/**
+ * Count a report taken from a device. Called by the backends from
+ * freespace_perform().
+ */
+void freespace_private_rateReceived(FreespaceDeviceId id);
+
+/**
+ * Count a conflated report replaced before anyone read it. Called by
+ * the mailboxes.
+ */
+void freespace_private_rateOverwritten(FreespaceDeviceId id);
+
+/**
+ * Note that freespace_performBudget() ran out of budget with reports
+ * still waiting on a device. Called by the backends.
+ */
+void freespace_private_rateBacklogged(FreespaceDeviceId id);
+
+#define FREESPACE_RATE_RECEIVED(id) \
+    do { \
+        if (FREESPACE_UNLIKELY(freespace_private_rateEnabled)) { \
+            freespace_private_rateReceived(id); \
+        } \
+    } while (0)
+
+#define FREESPACE_RATE_OVERWRITTEN(id) \
+    do { \
+        if (FREESPACE_UNLIKELY(freespace_private_rateEnabled)) { \
+            freespace_private_rateOverwritten(id); \
+        } \
+    } while (0)
+
+#define FREESPACE_RATE_BACKLOGGED(id) \
+    do { \
+        if (FREESPACE_UNLIKELY(freespace_private_rateEnabled)) { \
+            freespace_private_rateBacklogged(id); \
+        } \
+    } while (0)
+
+/**
+ * @return the time to pass to freespace_private_rateDispatched()
+ */
+int64_t freespace_private_rateNow();
+
+/**
+ * Count the time since start as spent handing a report to the
+ * application: requests, subscriptions and the receive callbacks.
+ */
+void freespace_private_rateDispatched(int64_t start);
+
+/**
+ * Time the dispatch of one report. start is an int64_t of the caller's,
+ * left 0 when rate control is off.
+ */
+#define FREESPACE_RATE_DISPATCH_BEGIN(start) \
+    do { \
+        (start) = FREESPACE_UNLIKELY(freespace_private_rateEnabled) ? freespace_private_rateNow() : 0; \
+    } while (0)
+
+#define FREESPACE_RATE_DISPATCH_END(start) \
+    do { \
+        if (FREESPACE_UNLIKELY((start) != 0)) { \
+            freespace_private_rateDispatched(start); \
+        } \
+    } while (0)
+
+/**
+ * The most reports a device holds for the host before those not read
+ * yet are dropped. Provided by the backend.
+ */
+int freespace_private_queueReports();
+
+/**
+ * Adjust the report rates once per window. Called from
+ * freespace_perform() after the backend has run.
+ */
+void freespace_private_ratePerform();
+
+/**
+ * Turn rate control off for a device. Called by the backends when a
+ * device is closed.
+ */
+void freespace_private_rateReset(FreespaceDeviceId id);
+
+/**
+ * Free all rate controllers. Called from freespace_exit().
+ */
+void freespace_private_rateExit();
+
+#endif // _FREESPACE_RATE_H_
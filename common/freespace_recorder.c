@@ -0,0 +1,772 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "freespace_recorder.h"
+#include "freespace_alloc.h"
+#include "freespace_pack.h"
+#include "freespace_schema.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+/*
+ * Capture file layout. Everything is in the byte order of the machine
+ * that recorded it; version_ doubles as the byte order check.
+ *
+ *   RecordingHeader
+ *   the message schema of the recording library, padded to 8 bytes
+ *   chunk: RecordingChunk, then count_ records of RecordingRecord
+ *          followed by the report padded to 8 bytes
+ *   ...more chunks...
+ *   RecordingIndexEntry for every chunk
+ *   RecordingTrailer
+ *
+ * Chunks are only written whole, and each one starts with a sync word,
+ * so a file cut off before the index was written can still be read by
+ * hopping from chunk header to chunk header.
+ *
+ * In a packed capture the chunks hold records packed by freespace_pack.c
+ * instead of RecordingRecords. The packing starts over in every chunk,
+ * so any chunk can be unpacked on its own. It takes the field layouts
+ * from the schema in the file, never from the reading library.
+ *
+ * headerSize_ covers the schema; a file with none is read with the
+ * schema of this library.
+ */
+#define RECORDING_MAGIC "FSRECORD"
+#define RECORDING_INDEX_MAGIC "FSRINDEX"
+#define RECORDING_VERSION 1
+#define RECORDING_SYNC 0x434e5953
+#define RECORDING_CHUNK_SIZE (64 * 1024)
+#define RECORDING_FORMAT_RAW 0
+#define RECORDING_FORMAT_PACKED 1
+
+struct RecordingHeader {
+    char magic_[8];
+    uint32_t version_;
+    uint32_t headerSize_;
+    uint64_t startWallNs_;
+    uint64_t startMonotonicNs_;
+};
+
+struct RecordingChunk {
+    uint32_t sync_;
+    uint32_t length_;
+    uint64_t firstSequence_;
+    uint64_t firstTimestampNs_;
+    uint32_t count_;
+    uint32_t format_;
+};
+
+struct RecordingRecord {
+    uint64_t timestampNs_;
+    int32_t id_;
+    uint8_t hVer_;
+    uint8_t direction_;
+    uint16_t length_;
+};
+
+struct RecordingIndexEntry {
+    uint64_t timestampNs_;
+    uint64_t sequence_;
+    uint64_t offset_;
+};
+
+struct RecordingTrailer {
+    uint64_t indexOffset_;
+    uint64_t indexCount_;
+    uint64_t recordCount_;
+    char magic_[8];
+};
+
+#define RECORD_SIZE(length) ((sizeof(struct RecordingRecord) + (length) + 7) & ~((size_t) 7))
+
+struct FreespaceRecording {
+    const uint8_t* base_;
+    uint64_t size_;
+#ifdef _WIN32
+    HANDLE file_;
+    HANDLE mapping_;
+#else
+    int fd_;
+#endif
+    const struct RecordingHeader* header_;
+    const struct RecordingIndexEntry* index_;
+    uint64_t indexCount_;
+    uint64_t recordCount_;
+
+    // Index rebuilt from the chunk headers when the file has none
+    struct RecordingIndexEntry* ownedIndex_;
+
+    struct FreespaceSchema* schema_;
+
+    // Where the record after the last one read is, so that reading in
+    // order does not search the index each time.
+    uint64_t cursorSequence_;
+    uint64_t cursorOffset_;
+    uint64_t cursorEnd_;
+    uint32_t cursorFormat_;
+    struct FreespacePackState unpack_;
+};
+
+// A record read from either format. The timestamp is the recorded clock.
+struct RecordingEntry {
+    uint64_t timestampNs_;
+    int32_t id_;
+    int hVer_;
+    int direction_;
+    int length_;
+    const uint8_t* report_;
+};
+
+volatile int freespace_private_recorderEnabled = 0;
+
+// Writer state. All of it is guarded by lock_. The chunk is built in
+// chunk_ and written whole; the index entries go to a scratch file so
+// that hours of capture never allocate while receiving.
+static volatile long lock_ = 0;
+static FILE* file_ = NULL;
+static FILE* indexFile_ = NULL;
+static uint8_t* chunk_ = NULL;
+static size_t used_ = 0;
+static uint32_t chunkCount_ = 0;
+static uint64_t sequence_ = 0;
+static uint64_t offset_ = 0;
+static uint64_t indexCount_ = 0;
+static int error_ = FREESPACE_SUCCESS;
+static uint32_t format_ = RECORDING_FORMAT_RAW;
+static struct FreespacePackState pack_;
+static struct FreespaceSchema* schema_ = NULL;
+
+static uint64_t monotonicNanos() {
+#ifdef _WIN32
+    LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (uint64_t) (counter.QuadPart / frequency.QuadPart) * 1000000000 +
+           (uint64_t) (counter.QuadPart % frequency.QuadPart) * 1000000000 / frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+#endif
+}
+
+static uint64_t wallNanos() {
+#ifdef _WIN32
+    FILETIME ft;
+    ULARGE_INTEGER t;
+    GetSystemTimeAsFileTime(&ft);
+    t.LowPart = ft.dwLowDateTime;
+    t.HighPart = ft.dwHighDateTime;
+    // 100ns ticks since 1601
+    return (t.QuadPart - 116444736000000000ULL) * 100;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+#endif
+}
+
+static void lockRecorder() {
+    while (!FREESPACE_ATOMIC_CAS(&lock_, 0, 1)) {
+        // Only held while a record is copied or a chunk written
+    }
+}
+
+static void unlockRecorder() {
+    FREESPACE_ATOMIC_BARRIER();
+    lock_ = 0;
+}
+
+// Write out the chunk being built and note it in the index.
+static void flushChunkLocked() {
+    struct RecordingChunk* chunk = (struct RecordingChunk*) chunk_;
+    struct RecordingIndexEntry entry;
+
+    if (chunkCount_ == 0) {
+        return;
+    }
+
+    chunk->sync_ = RECORDING_SYNC;
+    chunk->length_ = (uint32_t) (used_ - sizeof(struct RecordingChunk));
+    chunk->count_ = chunkCount_;
+    chunk->format_ = format_;
+
+    entry.timestampNs_ = chunk->firstTimestampNs_;
+    entry.sequence_ = chunk->firstSequence_;
+    entry.offset_ = offset_;
+
+    if (fwrite(chunk_, used_, 1, file_) != 1 ||
+        fwrite(&entry, sizeof(entry), 1, indexFile_) != 1) {
+        error_ = FREESPACE_ERROR_IO;
+    }
+    offset_ += used_;
+    indexCount_++;
+    used_ = sizeof(struct RecordingChunk);
+    chunkCount_ = 0;
+}
+
+void freespace_private_record(FreespaceDeviceId id, int hVer, int direction,
+                              const uint8_t* report, int length) {
+    struct RecordingChunk* chunk;
+    uint64_t timestampNs;
+    size_t size;
+
+    if (length < 1 || length > FREESPACE_PACK_MAX_REPORT) {
+        return;
+    }
+
+    lockRecorder();
+    if (file_ == NULL) {
+        // Stopped since the caller checked
+        unlockRecorder();
+        return;
+    }
+
+    chunk = (struct RecordingChunk*) chunk_;
+    if (format_ == RECORDING_FORMAT_PACKED) {
+        size = FREESPACE_PACK_MAX_SIZE(length);
+    } else {
+        size = RECORD_SIZE(length);
+    }
+
+    if (used_ + size > RECORDING_CHUNK_SIZE) {
+        flushChunkLocked();
+    }
+
+    // Stamp under the lock so that the file is in time order
+    timestampNs = monotonicNanos();
+    if (chunkCount_ == 0) {
+        chunk->firstSequence_ = sequence_;
+        chunk->firstTimestampNs_ = timestampNs;
+        freespace_private_packReset(&pack_, timestampNs);
+    }
+
+    if (format_ == RECORDING_FORMAT_PACKED) {
+        size = freespace_private_packReport(&pack_, timestampNs, id, hVer, direction,
+                                            report, length, chunk_ + used_);
+    } else {
+        struct RecordingRecord* record = (struct RecordingRecord*) (chunk_ + used_);
+        record->timestampNs_ = timestampNs;
+        record->id_ = id;
+        record->hVer_ = (uint8_t) hVer;
+        record->direction_ = (uint8_t) direction;
+        record->length_ = (uint16_t) length;
+        memcpy(record + 1, report, length);
+        memset((uint8_t*) (record + 1) + length, 0, size - sizeof(struct RecordingRecord) - length);
+    }
+
+    chunkCount_++;
+    sequence_++;
+    used_ += size;
+    unlockRecorder();
+}
+
+static int startRecorder(const char* path, uint32_t format) {
+    static const uint8_t padding[8] = { 0 };
+    struct RecordingHeader header;
+    const uint8_t* schema;
+    int schemaSize;
+    int rc;
+
+    if (freespace_private_recorderEnabled) {
+        return FREESPACE_ERROR_BUSY;
+    }
+
+    schemaSize = freespace_message_schema(&schema);
+    rc = freespace_schemaOpen(schema, schemaSize, &schema_);
+    if (rc != FREESPACE_SUCCESS) {
+        return rc;
+    }
+    chunk_ = (uint8_t*) freespace_private_malloc(RECORDING_CHUNK_SIZE);
+    if (chunk_ == NULL) {
+        freespace_schemaClose(schema_);
+        schema_ = NULL;
+        return FREESPACE_ERROR_OUT_OF_MEMORY;
+    }
+    file_ = fopen(path, "wb");
+    indexFile_ = tmpfile();
+    if (file_ == NULL || indexFile_ == NULL) {
+        if (file_ != NULL) {
+            fclose(file_);
+            file_ = NULL;
+        }
+        if (indexFile_ != NULL) {
+            fclose(indexFile_);
+            indexFile_ = NULL;
+        }
+        freespace_private_free(chunk_);
+        chunk_ = NULL;
+        freespace_schemaClose(schema_);
+        schema_ = NULL;
+        return FREESPACE_ERROR_IO;
+    }
+    // Writes are already a chunk at a time; stdio buffering would only
+    // add a copy and an allocation on the first write.
+    setvbuf(file_, NULL, _IONBF, 0);
+    setvbuf(indexFile_, NULL, _IONBF, 0);
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic_, RECORDING_MAGIC, sizeof(header.magic_));
+    header.version_ = RECORDING_VERSION;
+    // Keep the chunks 8 byte aligned for reading in place
+    header.headerSize_ = (uint32_t) ((sizeof(header) + schemaSize + 7) & ~((size_t) 7));
+    header.startMonotonicNs_ = monotonicNanos();
+    header.startWallNs_ = wallNanos();
+    error_ = FREESPACE_SUCCESS;
+    if (fwrite(&header, sizeof(header), 1, file_) != 1 ||
+        fwrite(schema, schemaSize, 1, file_) != 1 ||
+        fwrite(padding, 1, header.headerSize_ - sizeof(header) - schemaSize, file_) !=
+            header.headerSize_ - sizeof(header) - schemaSize) {
+        error_ = FREESPACE_ERROR_IO;
+    }
+
+    used_ = sizeof(struct RecordingChunk);
+    chunkCount_ = 0;
+    sequence_ = 0;
+    offset_ = header.headerSize_;
+    indexCount_ = 0;
+    format_ = format;
+    pack_.schema_ = schema_;
+
+    FREESPACE_ATOMIC_BARRIER();
+    freespace_private_recorderEnabled = 1;
+    return FREESPACE_SUCCESS;
+}
+
+LIBFREESPACE_API int freespace_recorderStart(const char* path) {
+    return startRecorder(path, RECORDING_FORMAT_RAW);
+}
+
+LIBFREESPACE_API int freespace_recorderStartPacked(const char* path) {
+    return startRecorder(path, RECORDING_FORMAT_PACKED);
+}
+
+LIBFREESPACE_API int freespace_recorderStop() {
+    struct RecordingTrailer trailer;
+    struct RecordingIndexEntry entries[64];
+    size_t n;
+    FILE* file;
+    int rc;
+
+    lockRecorder();
+    if (file_ == NULL) {
+        unlockRecorder();
+        return FREESPACE_ERROR_NO_DATA;
+    }
+    freespace_private_recorderEnabled = 0;
+    flushChunkLocked();
+    file = file_;
+    file_ = NULL;
+    unlockRecorder();
+
+    // Nothing can be recorded now, so finish the file without the lock.
+    trailer.indexOffset_ = offset_;
+    trailer.indexCount_ = indexCount_;
+    trailer.recordCount_ = sequence_;
+    memcpy(trailer.magic_, RECORDING_INDEX_MAGIC, sizeof(trailer.magic_));
+
+    rewind(indexFile_);
+    while ((n = fread(entries, sizeof(entries[0]), sizeof(entries) / sizeof(entries[0]), indexFile_)) > 0) {
+        if (fwrite(entries, sizeof(entries[0]), n, file) != n) {
+            error_ = FREESPACE_ERROR_IO;
+        }
+    }
+    if (fwrite(&trailer, sizeof(trailer), 1, file) != 1) {
+        error_ = FREESPACE_ERROR_IO;
+    }
+    if (fclose(file) != 0) {
+        error_ = FREESPACE_ERROR_IO;
+    }
+    fclose(indexFile_);
+    indexFile_ = NULL;
+    freespace_private_free(chunk_);
+    chunk_ = NULL;
+    freespace_schemaClose(schema_);
+    schema_ = NULL;
+
+    rc = error_;
+    error_ = FREESPACE_SUCCESS;
+    return rc;
+}
+
+// Build an index by walking the chunk headers, for a capture that was
+// never stopped cleanly.
+static int rebuildIndex(struct FreespaceRecording* recording) {
+    uint64_t offset;
+    uint64_t count = 0;
+    int pass;
+
+    for (pass = 0; pass < 2; pass++) {
+        offset = recording->header_->headerSize_;
+        count = 0;
+        recording->recordCount_ = 0;
+        while (offset + sizeof(struct RecordingChunk) <= recording->size_) {
+            const struct RecordingChunk* chunk = (const struct RecordingChunk*) (recording->base_ + offset);
+            if (chunk->sync_ != RECORDING_SYNC ||
+                offset + sizeof(struct RecordingChunk) + chunk->length_ > recording->size_) {
+                // The end of the data, or a chunk that was cut off
+                break;
+            }
+            if (pass == 1) {
+                recording->ownedIndex_[count].timestampNs_ = chunk->firstTimestampNs_;
+                recording->ownedIndex_[count].sequence_ = chunk->firstSequence_;
+                recording->ownedIndex_[count].offset_ = offset;
+            }
+            recording->recordCount_ = chunk->firstSequence_ + chunk->count_;
+            offset += sizeof(struct RecordingChunk) + chunk->length_;
+            count++;
+        }
+
+        if (pass == 0 && count > 0) {
+            recording->ownedIndex_ = (struct RecordingIndexEntry*)
+                    freespace_private_malloc(sizeof(struct RecordingIndexEntry) * count);
+            if (recording->ownedIndex_ == NULL) {
+                return FREESPACE_ERROR_OUT_OF_MEMORY;
+            }
+        }
+    }
+    recording->index_ = recording->ownedIndex_;
+    recording->indexCount_ = count;
+    return FREESPACE_SUCCESS;
+}
+
+static int mapFile(struct FreespaceRecording* recording, const char* path) {
+#ifdef _WIN32
+    LARGE_INTEGER size;
+
+    recording->file_ = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL,
+                                   OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (recording->file_ == INVALID_HANDLE_VALUE) {
+        return FREESPACE_ERROR_NOT_FOUND;
+    }
+    if (!GetFileSizeEx(recording->file_, &size) || size.QuadPart == 0) {
+        return FREESPACE_ERROR_MALFORMED_MESSAGE;
+    }
+    recording->mapping_ = CreateFileMapping(recording->file_, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (recording->mapping_ == NULL) {
+        return FREESPACE_ERROR_IO;
+    }
+    recording->base_ = (const uint8_t*) MapViewOfFile(recording->mapping_, FILE_MAP_READ, 0, 0, 0);
+    if (recording->base_ == NULL) {
+        return FREESPACE_ERROR_IO;
+    }
+    recording->size_ = (uint64_t) size.QuadPart;
+#else
+    struct stat st;
+    void* base;
+
+    recording->fd_ = open(path, O_RDONLY);
+    if (recording->fd_ < 0) {
+        return FREESPACE_ERROR_NOT_FOUND;
+    }
+    if (fstat(recording->fd_, &st) != 0 || st.st_size == 0) {
+        return FREESPACE_ERROR_MALFORMED_MESSAGE;
+    }
+    base = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, recording->fd_, 0);
+    if (base == MAP_FAILED) {
+        return FREESPACE_ERROR_IO;
+    }
+    recording->base_ = (const uint8_t*) base;
+    recording->size_ = (uint64_t) st.st_size;
+#endif
+    return FREESPACE_SUCCESS;
+}
+
+LIBFREESPACE_API void freespace_recordingClose(struct FreespaceRecording* recording) {
+    if (recording == NULL) {
+        return;
+    }
+#ifdef _WIN32
+    if (recording->base_ != NULL) {
+        UnmapViewOfFile(recording->base_);
+    }
+    if (recording->mapping_ != NULL) {
+        CloseHandle(recording->mapping_);
+    }
+    if (recording->file_ != INVALID_HANDLE_VALUE) {
+        CloseHandle(recording->file_);
+    }
+#else
+    if (recording->base_ != NULL) {
+        munmap((void*) recording->base_, (size_t) recording->size_);
+    }
+    if (recording->fd_ >= 0) {
+        close(recording->fd_);
+    }
+#endif
+    freespace_private_free(recording->ownedIndex_);
+    freespace_schemaClose(recording->schema_);
+    freespace_private_free(recording);
+}
+
+LIBFREESPACE_API int freespace_recordingOpen(const char* path, struct FreespaceRecording** recording) {
+    struct FreespaceRecording* r;
+    const struct RecordingTrailer* trailer = NULL;
+    int rc;
+
+    *recording = NULL;
+    r = (struct FreespaceRecording*) freespace_private_calloc(sizeof(struct FreespaceRecording));
+    if (r == NULL) {
+        return FREESPACE_ERROR_OUT_OF_MEMORY;
+    }
+#ifdef _WIN32
+    r->file_ = INVALID_HANDLE_VALUE;
+#else
+    r->fd_ = -1;
+#endif
+
+    rc = mapFile(r, path);
+    if (rc != FREESPACE_SUCCESS) {
+        freespace_recordingClose(r);
+        return rc;
+    }
+
+    r->header_ = (const struct RecordingHeader*) r->base_;
+    if (r->size_ < sizeof(struct RecordingHeader) ||
+        memcmp(r->header_->magic_, RECORDING_MAGIC, sizeof(r->header_->magic_)) != 0 ||
+        r->header_->version_ != RECORDING_VERSION ||
+        r->header_->headerSize_ < sizeof(struct RecordingHeader) ||
+        r->header_->headerSize_ > r->size_) {
+        freespace_recordingClose(r);
+        return FREESPACE_ERROR_MALFORMED_MESSAGE;
+    }
+
+    if (r->header_->headerSize_ > sizeof(struct RecordingHeader)) {
+        // The padding after the schema is not part of it, but the
+        // interpreter only looks as far as the schema says.
+        rc = freespace_schemaOpen(r->base_ + sizeof(struct RecordingHeader),
+                                  (int) (r->header_->headerSize_ - sizeof(struct RecordingHeader)),
+                                  &r->schema_);
+    } else {
+        const uint8_t* schema;
+        int schemaSize = freespace_message_schema(&schema);
+        rc = freespace_schemaOpen(schema, schemaSize, &r->schema_);
+    }
+    if (rc != FREESPACE_SUCCESS) {
+        freespace_recordingClose(r);
+        return rc;
+    }
+    r->unpack_.schema_ = r->schema_;
+
+    if (r->size_ >= r->header_->headerSize_ + sizeof(struct RecordingTrailer)) {
+        trailer = (const struct RecordingTrailer*) (r->base_ + r->size_ - sizeof(struct RecordingTrailer));
+        if (memcmp(trailer->magic_, RECORDING_INDEX_MAGIC, sizeof(trailer->magic_)) != 0 ||
+            trailer->indexOffset_ + trailer->indexCount_ * sizeof(struct RecordingIndexEntry) !=
+                r->size_ - sizeof(struct RecordingTrailer)) {
+            trailer = NULL;
+        }
+    }
+
+    if (trailer != NULL) {
+        r->index_ = (const struct RecordingIndexEntry*) (r->base_ + trailer->indexOffset_);
+        r->indexCount_ = trailer->indexCount_;
+        r->recordCount_ = trailer->recordCount_;
+    } else {
+        rc = rebuildIndex(r);
+        if (rc != FREESPACE_SUCCESS) {
+            freespace_recordingClose(r);
+            return rc;
+        }
+    }
+
+    *recording = r;
+    return FREESPACE_SUCCESS;
+}
+
+LIBFREESPACE_API const struct FreespaceSchema* freespace_recordingSchema(struct FreespaceRecording* recording) {
+    return recording->schema_;
+}
+
+LIBFREESPACE_API uint64_t freespace_recordingCount(struct FreespaceRecording* recording) {
+    return recording->recordCount_;
+}
+
+// Find the chunk holding sequence, or for a timestamp the last chunk
+// starting at or before it.
+static uint64_t findChunk(struct FreespaceRecording* recording, uint64_t sequence, uint64_t timestampNs, int byTime) {
+    uint64_t low = 0;
+    uint64_t high = recording->indexCount_;
+
+    while (high - low > 1) {
+        uint64_t mid = low + (high - low) / 2;
+        const struct RecordingIndexEntry* entry = &recording->index_[mid];
+        if (byTime ? entry->timestampNs_ <= timestampNs : entry->sequence_ <= sequence) {
+            low = mid;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+// Point the cursor at the first record of a chunk.
+static int startChunk(struct FreespaceRecording* recording, uint64_t chunkIndex) {
+    const struct RecordingIndexEntry* entry = &recording->index_[chunkIndex];
+    const struct RecordingChunk* chunk;
+
+    if (entry->offset_ + sizeof(struct RecordingChunk) > recording->size_) {
+        return FREESPACE_ERROR_MALFORMED_MESSAGE;
+    }
+    chunk = (const struct RecordingChunk*) (recording->base_ + entry->offset_);
+    if (chunk->sync_ != RECORDING_SYNC ||
+        entry->offset_ + sizeof(struct RecordingChunk) + chunk->length_ > recording->size_) {
+        return FREESPACE_ERROR_MALFORMED_MESSAGE;
+    }
+    recording->cursorSequence_ = chunk->firstSequence_;
+    recording->cursorOffset_ = entry->offset_ + sizeof(struct RecordingChunk);
+    recording->cursorEnd_ = recording->cursorOffset_ + chunk->length_;
+    recording->cursorFormat_ = chunk->format_;
+    freespace_private_packReset(&recording->unpack_, chunk->firstTimestampNs_);
+    return FREESPACE_SUCCESS;
+}
+
+// Read the record at the cursor and move past it.
+//
+// @return FREESPACE_ERROR_NO_DATA at the end of the chunk
+static int readCursor(struct FreespaceRecording* recording, struct RecordingEntry* entry) {
+    const uint8_t* at = recording->base_ + recording->cursorOffset_;
+    uint64_t available = recording->cursorEnd_ - recording->cursorOffset_;
+
+    if (recording->cursorOffset_ >= recording->cursorEnd_) {
+        return FREESPACE_ERROR_NO_DATA;
+    }
+
+    if (recording->cursorFormat_ == RECORDING_FORMAT_PACKED) {
+        struct FreespacePackedReport packed;
+        int used = freespace_private_unpackReport(&recording->unpack_, at,
+                                                  available > RECORDING_CHUNK_SIZE ? RECORDING_CHUNK_SIZE : (int) available,
+                                                  &packed);
+        if (used < 0) {
+            return used;
+        }
+        entry->timestampNs_ = packed.timestampNs_;
+        entry->id_ = packed.id_;
+        entry->hVer_ = packed.hVer_;
+        entry->direction_ = packed.direction_;
+        entry->length_ = packed.length_;
+        entry->report_ = packed.report_;
+        recording->cursorOffset_ += used;
+    } else if (recording->cursorFormat_ == RECORDING_FORMAT_RAW) {
+        const struct RecordingRecord* record = (const struct RecordingRecord*) at;
+        if (available < sizeof(struct RecordingRecord) || available < RECORD_SIZE(record->length_)) {
+            return FREESPACE_ERROR_MALFORMED_MESSAGE;
+        }
+        entry->timestampNs_ = record->timestampNs_;
+        entry->id_ = record->id_;
+        entry->hVer_ = record->hVer_;
+        entry->direction_ = record->direction_;
+        entry->length_ = record->length_;
+        entry->report_ = (const uint8_t*) (record + 1);
+        recording->cursorOffset_ += RECORD_SIZE(record->length_);
+    } else {
+        return FREESPACE_ERROR_MALFORMED_MESSAGE;
+    }
+    recording->cursorSequence_++;
+    return FREESPACE_SUCCESS;
+}
+
+LIBFREESPACE_API int freespace_recordingRead(struct FreespaceRecording* recording,
+                                             uint64_t sequence,
+                                             struct FreespaceRecordedReport* report) {
+    struct RecordingEntry entry;
+    int rc;
+
+    if (sequence >= recording->recordCount_ || recording->indexCount_ == 0) {
+        return FREESPACE_ERROR_NO_DATA;
+    }
+
+    if (sequence != recording->cursorSequence_ ||
+        recording->cursorOffset_ >= recording->cursorEnd_) {
+        rc = startChunk(recording, findChunk(recording, sequence, 0, 0));
+        if (rc != FREESPACE_SUCCESS) {
+            return rc;
+        }
+    }
+    do {
+        if (recording->cursorSequence_ > sequence) {
+            return FREESPACE_ERROR_MALFORMED_MESSAGE;
+        }
+        rc = readCursor(recording, &entry);
+        if (rc != FREESPACE_SUCCESS) {
+            // The index says that the record is in this chunk
+            return FREESPACE_ERROR_MALFORMED_MESSAGE;
+        }
+    } while (recording->cursorSequence_ <= sequence);
+
+    report->sequence = sequence;
+    report->timestampNs = recording->header_->startWallNs_ +
+                          (entry.timestampNs_ - recording->header_->startMonotonicNs_);
+    report->id = entry.id_;
+    report->hVer = entry.hVer_;
+    report->direction = entry.direction_;
+    report->length = entry.length_;
+    report->data = entry.report_;
+    return FREESPACE_SUCCESS;
+}
+
+LIBFREESPACE_API int freespace_recordingSeek(struct FreespaceRecording* recording,
+                                             uint64_t timestampNs,
+                                             uint64_t* sequence) {
+    struct RecordingEntry entry;
+    uint64_t chunkIndex;
+    uint64_t monotonicNs;
+    int rc;
+
+    if (recording->indexCount_ == 0) {
+        return FREESPACE_ERROR_NO_DATA;
+    }
+
+    // Work in the recorded clock
+    if (timestampNs < recording->header_->startWallNs_) {
+        monotonicNs = 0;
+    } else {
+        monotonicNs = recording->header_->startMonotonicNs_ +
+                      (timestampNs - recording->header_->startWallNs_);
+    }
+
+    chunkIndex = findChunk(recording, 0, monotonicNs, 1);
+    rc = startChunk(recording, chunkIndex);
+    for (;;) {
+        if (rc != FREESPACE_SUCCESS) {
+            return rc;
+        }
+        rc = readCursor(recording, &entry);
+        if (rc == FREESPACE_ERROR_NO_DATA) {
+            // Everything in that chunk was earlier, so it is the next chunk's first
+            if (++chunkIndex >= recording->indexCount_) {
+                return FREESPACE_ERROR_NO_DATA;
+            }
+            rc = startChunk(recording, chunkIndex);
+        } else if (rc == FREESPACE_SUCCESS && entry.timestampNs_ >= monotonicNs) {
+            *sequence = recording->cursorSequence_ - 1;
+            return FREESPACE_SUCCESS;
+        }
+    }
+}
@@ -0,0 +1,45 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _FREESPACE_RECORDER_H_
+#define _FREESPACE_RECORDER_H_
+
+#include "freespace/freespace.h"
+#include "freespace_atomic.h"
+
+/**
+ * Set while freespace_recorderStart() is capturing. Checked inline by
+ * FREESPACE_RECORD so that capture costs a load and a branch when off.
+ */
+extern volatile int freespace_private_recorderEnabled;
+
+/**
+ * Append a raw report to the capture file.
+ *
+ * @param direction FREESPACE_RECORD_INBOUND or FREESPACE_RECORD_OUTBOUND
+ */
+void freespace_private_record(FreespaceDeviceId id, int hVer, int direction,
+                              const uint8_t* report, int length);
+
+#define FREESPACE_RECORD(id, hVer, direction, report, length) \
+    do { \
+        if (FREESPACE_UNLIKELY(freespace_private_recorderEnabled)) { \
+            freespace_private_record((id), (hVer), (direction), (report), (length)); \
+        } \
+    } while (0)
+
+#endif // _FREESPACE_RECORDER_H_
@@ -0,0 +1,451 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "freespace_request.h"
+#include "freespace_alloc.h"
+#include "freespace_log.h"
+
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#define DEBUG(...) FREESPACE_LOG(FREESPACE_LOG_BACKEND, FREESPACE_LOG_LEVEL_DEBUG, __VA_ARGS__)
+
+/*
+ * Each device keeps its requests in the order they were made, so a
+ * response completes the oldest request waiting for its type. Every
+ * request also sits in a hashed timer wheel under the tick it expires
+ * on. A slot holds each request whose tick is the slot number modulo
+ * REQUEST_WHEEL_SLOTS, so one more than a revolution away stays in its
+ * slot until the wheel comes round to its tick. Expiring requests and
+ * finding the next timeout only look at the slots between the last tick
+ * handled and now, however many requests are waiting.
+ */
+#define REQUEST_WHEEL_SLOTS 64
+#define REQUEST_WHEEL_TICK_MS 16
+#define REQUEST_SEND_TIMEOUT_MS 100
+
+struct FreespaceRequest {
+    FreespaceDeviceId id_;
+    struct freespace_message message_;
+    int responseType_;
+    int sent_;
+    int64_t tick_;
+    freespace_requestCallback callback_;
+    void* cookie_;
+    // The device's requests, oldest first
+    struct FreespaceRequest* next_;
+    struct FreespaceRequest* prev_;
+    // The requests in the same wheel slot
+    struct FreespaceRequest* wheelNext_;
+    struct FreespaceRequest* wheelPrev_;
+};
+
+// A device's requests come from its own pool, set aside when it is
+// first opened and kept until freespace_exit, so making a request never
+// allocates, even from a callback while receiving.
+struct RequestQueue {
+    struct FreespaceRequest* head_;
+    struct FreespaceRequest* tail_;
+    int count_;
+    int unsent_;
+    // The number of requests waiting for each response type
+    uint16_t waiting_[FREESPACE_MESSAGE_TYPE_COUNT];
+    // The unused requests, linked through next_
+    struct FreespaceRequest* free_;
+    struct FreespaceRequest pool_[FREESPACE_REQUEST_POOL_SIZE];
+};
+
+static struct RequestQueue* queues_[FREESPACE_MAILBOX_MAX_ID];
+static struct FreespaceRequest* wheel_[REQUEST_WHEEL_SLOTS];
+// The last tick whose slot was expired
+static int64_t wheelTick_ = 0;
+static int count_ = 0;
+static int unsent_ = 0;
+
+static int64_t nowMillis() {
+#ifdef _WIN32
+    LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (int64_t) (counter.QuadPart / frequency.QuadPart) * 1000 +
+           (int64_t) (counter.QuadPart % frequency.QuadPart) * 1000 / frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t) ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+#endif
+}
+
+static void wheelInsert(struct FreespaceRequest* request) {
+    struct FreespaceRequest** slot = &wheel_[request->tick_ % REQUEST_WHEEL_SLOTS];
+
+    request->wheelPrev_ = NULL;
+    request->wheelNext_ = *slot;
+    if (*slot != NULL) {
+        (*slot)->wheelPrev_ = request;
+    }
+    *slot = request;
+}
+
+static void wheelRemove(struct FreespaceRequest* request) {
+    if (request->wheelPrev_ != NULL) {
+        request->wheelPrev_->wheelNext_ = request->wheelNext_;
+    } else {
+        wheel_[request->tick_ % REQUEST_WHEEL_SLOTS] = request->wheelNext_;
+    }
+    if (request->wheelNext_ != NULL) {
+        request->wheelNext_->wheelPrev_ = request->wheelPrev_;
+    }
+}
+
+// Take a request out of both lists
+static void detach(struct FreespaceRequest* request) {
+    struct RequestQueue* queue = queues_[request->id_];
+
+    wheelRemove(request);
+    if (request->prev_ != NULL) {
+        request->prev_->next_ = request->next_;
+    } else {
+        queue->head_ = request->next_;
+    }
+    if (request->next_ != NULL) {
+        request->next_->prev_ = request->prev_;
+    } else {
+        queue->tail_ = request->prev_;
+    }
+    queue->waiting_[request->responseType_]--;
+    queue->count_--;
+    count_--;
+    if (!request->sent_) {
+        queue->unsent_--;
+        unsent_--;
+    }
+}
+
+// Return a detached request to its pool and report how it ended. The
+// callback may make new requests or close the device.
+static void complete(struct FreespaceRequest* request, struct freespace_message* response, int result) {
+    struct RequestQueue* queue = queues_[request->id_];
+    FreespaceDeviceId id = request->id_;
+    freespace_requestCallback callback = request->callback_;
+    void* cookie = request->cookie_;
+
+    request->next_ = queue->free_;
+    queue->free_ = request;
+    if (callback != NULL) {
+        callback(id, response, cookie, result);
+    }
+}
+
+LIBFREESPACE_API int freespace_request(FreespaceDeviceId id,
+                                       struct freespace_message* request,
+                                       int expectedResponseType,
+                                       unsigned int timeoutMs,
+                                       freespace_requestCallback callback,
+                                       void* cookie) {
+    struct FreespaceDeviceInfo info;
+    struct RequestQueue* queue;
+    struct FreespaceRequest* r;
+    int64_t now;
+    int64_t tick;
+    int rc;
+
+    if (request == NULL || expectedResponseType < 0 || expectedResponseType >= FREESPACE_MESSAGE_TYPE_COUNT) {
+        return FREESPACE_ERROR_UNEXPECTED;
+    }
+    if (id < 0 || id >= FREESPACE_MAILBOX_MAX_ID) {
+        return FREESPACE_ERROR_INVALID_DEVICE;
+    }
+    rc = freespace_getDeviceInfo(id, &info);
+    if (rc != FREESPACE_SUCCESS) {
+        return rc;
+    }
+    // Nothing would ever send it or fail it before the timeout
+    rc = freespace_private_checkOpen(id);
+    if (rc != FREESPACE_SUCCESS) {
+        return rc;
+    }
+
+    // The backend reserves the pool when it opens the device
+    queue = queues_[id];
+    if (queue == NULL || queue->free_ == NULL) {
+        return FREESPACE_ERROR_BUSY;
+    }
+    r = queue->free_;
+    queue->free_ = r->next_;
+    memset(r, 0, sizeof(*r));
+    r->id_ = id;
+    r->message_ = *request;
+    r->responseType_ = expectedResponseType;
+    r->callback_ = callback;
+    r->cookie_ = cookie;
+
+    // Round the deadline up to a tick still to come, so the request never
+    // expires early and its slot is not one that was already passed over.
+    now = nowMillis();
+    if (count_ == 0) {
+        wheelTick_ = now / REQUEST_WHEEL_TICK_MS;
+    }
+    tick = (now + timeoutMs + REQUEST_WHEEL_TICK_MS - 1) / REQUEST_WHEEL_TICK_MS;
+    if (tick <= now / REQUEST_WHEEL_TICK_MS) {
+        tick = now / REQUEST_WHEEL_TICK_MS + 1;
+    }
+    r->tick_ = tick;
+    wheelInsert(r);
+
+    r->prev_ = queue->tail_;
+    if (queue->tail_ != NULL) {
+        queue->tail_->next_ = r;
+    } else {
+        queue->head_ = r;
+    }
+    queue->tail_ = r;
+    queue->waiting_[expectedResponseType]++;
+    queue->count_++;
+    queue->unsent_++;
+    count_++;
+    unsent_++;
+
+    // Sent from freespace_perform, once the backend knows to pass the
+    // response on
+    return FREESPACE_SUCCESS;
+}
+
+int freespace_private_requestDeliver(FreespaceDeviceId id,
+                                     const uint8_t* report,
+                                     int length,
+                                     uint8_t hVer) {
+    struct RequestQueue* queue;
+    struct FreespaceRequest* r;
+    struct freespace_message m;
+    int type;
+
+    if (id < 0 || id >= FREESPACE_MAILBOX_MAX_ID || queues_[id] == NULL || queues_[id]->count_ == 0) {
+        return 0;
+    }
+    queue = queues_[id];
+    type = freespace_peek_message_type(report, length, hVer);
+    if (type < 0 || type >= FREESPACE_MESSAGE_TYPE_COUNT || queue->waiting_[type] == 0) {
+        return 0;
+    }
+    for (r = queue->head_; r != NULL; r = r->next_) {
+        if (r->sent_ && r->responseType_ == type) {
+            break;
+        }
+    }
+    if (r == NULL || freespace_decode_message(report, length, &m, hVer) != FREESPACE_SUCCESS) {
+        return 0;
+    }
+    detach(r);
+    complete(r, &m, FREESPACE_SUCCESS);
+    return 1;
+}
+
+int freespace_private_requestActive(FreespaceDeviceId id) {
+    return id >= 0 && id < FREESPACE_MAILBOX_MAX_ID && queues_[id] != NULL && queues_[id]->count_ > 0;
+}
+
+void freespace_private_requestTypes(FreespaceDeviceId id, uint32_t* mask) {
+    int type;
+
+    if (!freespace_private_requestActive(id)) {
+        return;
+    }
+    for (type = 0; type < FREESPACE_MESSAGE_TYPE_COUNT; type++) {
+        if (queues_[id]->waiting_[type] != 0) {
+            mask[type / 32] |= 1u << (type % 32);
+        }
+    }
+}
+
+void freespace_private_requestNextTimeout(int* timeoutMs) {
+    int64_t now;
+    int64_t due;
+    int64_t t;
+    int remaining;
+
+    if (count_ == 0) {
+        return;
+    }
+    if (unsent_ > 0) {
+        *timeoutMs = 0;
+        return;
+    }
+    // The first slot holding a request for that very tick. Past a whole
+    // revolution, wake up at its end and look again.
+    due = (wheelTick_ + REQUEST_WHEEL_SLOTS) * REQUEST_WHEEL_TICK_MS;
+    for (t = wheelTick_ + 1; t <= wheelTick_ + REQUEST_WHEEL_SLOTS; t++) {
+        struct FreespaceRequest* r;
+        for (r = wheel_[t % REQUEST_WHEEL_SLOTS]; r != NULL; r = r->wheelNext_) {
+            if (r->tick_ <= t) {
+                break;
+            }
+        }
+        if (r != NULL) {
+            due = t * REQUEST_WHEEL_TICK_MS;
+            break;
+        }
+    }
+    now = nowMillis();
+    remaining = due > now ? (int) (due - now) : 0;
+    if (*timeoutMs < 0 || remaining < *timeoutMs) {
+        *timeoutMs = remaining;
+    }
+}
+
+void freespace_private_requestPerform() {
+    int64_t nowTick;
+    int64_t from;
+    int64_t to;
+    int64_t t;
+    int id;
+
+    if (count_ == 0) {
+        return;
+    }
+
+    // Send in order, stopping at the first request a device will not take
+    for (id = 0; id < FREESPACE_MAILBOX_MAX_ID && unsent_ > 0; id++) {
+        struct RequestQueue* queue = queues_[id];
+        struct FreespaceRequest* r = queue != NULL && queue->unsent_ > 0 ? queue->head_ : NULL;
+        while (r != NULL && queue->unsent_ > 0) {
+            int rc;
+            if (r->sent_) {
+                r = r->next_;
+                continue;
+            }
+            rc = freespace_sendMessageAsync(id, &r->message_, REQUEST_SEND_TIMEOUT_MS, NULL, NULL);
+            if (rc == FREESPACE_SUCCESS) {
+                r->sent_ = 1;
+                queue->unsent_--;
+                unsent_--;
+                r = r->next_;
+            } else if (rc == FREESPACE_ERROR_NO_DEVICE || rc == FREESPACE_ERROR_INVALID_DEVICE ||
+                       rc == FREESPACE_ERROR_NOT_FOUND || rc == FREESPACE_ERROR_SEND_TOO_LARGE ||
+                       rc == FREESPACE_ERROR_MALFORMED_MESSAGE ||
+                       freespace_private_checkOpen(id) != FREESPACE_SUCCESS) {
+                // Retrying would not help, and would spin until the timeout
+                detach(r);
+                complete(r, NULL, rc);
+                r = queue->head_;
+            } else {
+                DEBUG("request on device %d: send failed with %d, will retry", id, rc);
+                break;
+            }
+        }
+    }
+
+    // Expire the slots from the last tick handled up to now, but each slot
+    // only once
+    nowTick = nowMillis() / REQUEST_WHEEL_TICK_MS;
+    from = wheelTick_ + 1;
+    to = nowTick;
+    if (to - from >= REQUEST_WHEEL_SLOTS) {
+        to = from + REQUEST_WHEEL_SLOTS - 1;
+    }
+    // Requests made from the callbacks land after the current tick
+    wheelTick_ = nowTick;
+    for (t = from; t <= to; t++) {
+        for (;;) {
+            struct FreespaceRequest* r;
+            for (r = wheel_[t % REQUEST_WHEEL_SLOTS]; r != NULL; r = r->wheelNext_) {
+                if (r->tick_ <= nowTick) {
+                    break;
+                }
+            }
+            if (r == NULL) {
+                break;
+            }
+            DEBUG("request on device %d: no response of type %d", r->id_, r->responseType_);
+            detach(r);
+            complete(r, NULL, FREESPACE_ERROR_TIMEOUT);
+        }
+    }
+}
+
+void freespace_private_requestReset(FreespaceDeviceId id) {
+    struct RequestQueue* queue;
+    struct FreespaceRequest* r;
+    struct FreespaceRequest* next;
+
+    if (id < 0 || id >= FREESPACE_MAILBOX_MAX_ID || queues_[id] == NULL) {
+        return;
+    }
+    queue = queues_[id];
+    // Detach them all first, so requests made from the callbacks are kept
+    r = queue->head_;
+    for (next = r; next != NULL; next = next->next_) {
+        wheelRemove(next);
+        count_--;
+        if (!next->sent_) {
+            unsent_--;
+        }
+    }
+    queue->head_ = NULL;
+    queue->tail_ = NULL;
+    queue->count_ = 0;
+    queue->unsent_ = 0;
+    memset(queue->waiting_, 0, sizeof(queue->waiting_));
+    while (r != NULL) {
+        next = r->next_;
+        complete(r, NULL, FREESPACE_ERROR_NO_DEVICE);
+        r = next;
+    }
+}
+
+int freespace_private_requestReserve(FreespaceDeviceId id) {
+    struct RequestQueue* queue;
+    int i;
+
+    if (id < 0 || id >= FREESPACE_MAILBOX_MAX_ID) {
+        return FREESPACE_ERROR_INVALID_DEVICE;
+    }
+    if (queues_[id] != NULL) {
+        return FREESPACE_SUCCESS;
+    }
+    queue = (struct RequestQueue*) freespace_private_calloc(sizeof(struct RequestQueue));
+    if (queue == NULL) {
+        return FREESPACE_ERROR_OUT_OF_MEMORY;
+    }
+    for (i = FREESPACE_REQUEST_POOL_SIZE - 1; i >= 0; i--) {
+        queue->pool_[i].next_ = queue->free_;
+        queue->free_ = &queue->pool_[i];
+    }
+    queues_[id] = queue;
+    return FREESPACE_SUCCESS;
+}
+
+void freespace_private_requestExit() {
+    int i;
+
+    for (i = 0; i < FREESPACE_MAILBOX_MAX_ID; i++) {
+        if (queues_[i] != NULL) {
+            freespace_private_free(queues_[i]);
+            queues_[i] = NULL;
+        }
+    }
+    memset(wheel_, 0, sizeof(wheel_));
+    count_ = 0;
+    unsent_ = 0;
+}
@@ -0,0 +1,89 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _FREESPACE_REQUEST_H_
+#define _FREESPACE_REQUEST_H_
+
+#include "freespace_mailbox.h"
+
+/**
+ * Offer a received report to the requests waiting on the device. Called
+ * by the backends ahead of the flash record engine, the mailboxes and
+ * subscriptions.
+ *
+ * @return 1 if the report answered a request and must not be delivered
+ *         to the callbacks, 0 otherwise
+ */
+int freespace_private_requestDeliver(FreespaceDeviceId id,
+                                     const uint8_t* report,
+                                     int length,
+                                     uint8_t hVer);
+
+/**
+ * @return nonzero if any request is waiting on the device
+ */
+int freespace_private_requestActive(FreespaceDeviceId id);
+
+/**
+ * Set the bit of each message type that the requests on the device wait
+ * for in mask, which has (FREESPACE_MESSAGE_TYPE_COUNT + 31) / 32 words.
+ */
+void freespace_private_requestTypes(FreespaceDeviceId id, uint32_t* mask);
+
+/**
+ * Lower timeoutMs to the time until the next request is due to be sent
+ * or to expire. A negative timeoutMs means no timeout yet.
+ */
+void freespace_private_requestNextTimeout(int* timeoutMs);
+
+/**
+ * Send the queued requests and expire the ones that were not answered
+ * in time. Called from freespace_perform().
+ */
+void freespace_private_requestPerform();
+
+/**
+ * Check that a device is open. Provided by the backend.
+ *
+ * @return FREESPACE_SUCCESS if it is, or the error that sending to it
+ *         fails with
+ */
+int freespace_private_checkOpen(FreespaceDeviceId id);
+
+/**
+ * Set aside the device's pool of FREESPACE_REQUEST_POOL_SIZE requests,
+ * unless it already has one. Called by the backends when they open a
+ * device; the pool is kept until freespace_exit().
+ *
+ * @return FREESPACE_SUCCESS, or FREESPACE_ERROR_OUT_OF_MEMORY
+ */
+int freespace_private_requestReserve(FreespaceDeviceId id);
+
+/**
+ * Fail the requests on a device with FREESPACE_ERROR_NO_DEVICE. Called
+ * by the backends when a device is closed.
+ */
+void freespace_private_requestReset(FreespaceDeviceId id);
+
+/**
+ * Free all requests and pools without calling the callbacks. Called from
+ * freespace_exit().
+ */
+void freespace_private_requestExit();
+
+#endif // _FREESPACE_REQUEST_H_
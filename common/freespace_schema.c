@@ -0,0 +1,318 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "freespace_schema.h"
+#include "freespace_alloc.h"
+
+#include <string.h>
+
+/*
+ * Interpreter for the binary schema that messageCodeGenerator.py
+ * builds from the message definitions; see messageSchema() there for
+ * the layout. Opening a schema checks the whole blob once and builds
+ * tables so that decoding a report is a table lookup followed by one
+ * load per field.
+ */
+#define SCHEMA_MAGIC "FSSCHEMA"
+#define SCHEMA_VERSION 1
+#define SCHEMA_HEADER_SIZE 13
+#define SCHEMA_ENTRY_SIZE 10
+#define SCHEMA_FIELD_SIZE 7
+#define SCHEMA_SIGNED 0x08
+#define SCHEMA_FLAG_DECODE 1
+#define SCHEMA_FLAG_ENCODE 2
+
+struct SchemaField {
+    const char* name_;
+    uint8_t index_;
+    uint8_t offset_;
+    uint8_t type_;
+    uint8_t shift_;
+    uint8_t bits_;
+};
+
+struct SchemaEntry {
+    const char* name_;
+    uint8_t flags_;
+    uint8_t hVer_;
+    uint8_t reportId_;
+    uint8_t subIdOffset_;
+    uint8_t subId_;
+    uint8_t size_;
+    int fieldCount_;
+    const struct SchemaField* fields_;
+    int layoutCount_;
+    const struct freespace_field_layout* layout_;
+
+    // Next definition with the same version and report id, or -1
+    int next_;
+};
+
+struct FreespaceSchema {
+    int count_;
+    struct SchemaEntry* entries_;
+
+    // First definition for each HID version and report id, or -1
+    int16_t first_[3][256];
+
+    // Copy of the blob. The names point into its string pool.
+    uint8_t* blob_;
+};
+
+static int getU16(const uint8_t* p) {
+    return p[0] | (p[1] << 8);
+}
+
+// Walk the blob. With schema NULL only check it and count what the
+// tables need; otherwise fill the tables in.
+static int parseSchema(const uint8_t* blob, int length, struct FreespaceSchema* schema,
+                       int* fieldCount, int* layoutCount) {
+    struct SchemaField* fields = NULL;
+    struct freespace_field_layout* layout = NULL;
+    int count;
+    int poolSize;
+    int at;
+    int i;
+    int j;
+
+    if (length < SCHEMA_HEADER_SIZE ||
+        memcmp(blob, SCHEMA_MAGIC, 8) != 0 ||
+        blob[8] != SCHEMA_VERSION) {
+        return FREESPACE_ERROR_MALFORMED_MESSAGE;
+    }
+    count = getU16(blob + 9);
+    poolSize = getU16(blob + 11);
+    at = SCHEMA_HEADER_SIZE + poolSize;
+    if (at > length || (poolSize > 0 && blob[at - 1] != 0)) {
+        return FREESPACE_ERROR_MALFORMED_MESSAGE;
+    }
+
+    if (schema != NULL) {
+        fields = (struct SchemaField*) (schema->entries_ + count);
+        layout = (struct freespace_field_layout*) (fields + *fieldCount);
+        schema->count_ = count;
+        memset(schema->first_, 0xff, sizeof(schema->first_));
+    }
+    *fieldCount = 0;
+    *layoutCount = 0;
+
+    for (i = 0; i < count; i++) {
+        const uint8_t* e = blob + at;
+        int nFields;
+        int nLayout;
+
+        if (at + SCHEMA_ENTRY_SIZE > length) {
+            return FREESPACE_ERROR_MALFORMED_MESSAGE;
+        }
+        nFields = e[8];
+        nLayout = e[9];
+        if (getU16(e) >= poolSize || e[3] > 2 ||
+            at + SCHEMA_ENTRY_SIZE + nFields * SCHEMA_FIELD_SIZE + nLayout * 2 > length) {
+            return FREESPACE_ERROR_MALFORMED_MESSAGE;
+        }
+        for (j = 0; j < nFields; j++) {
+            const uint8_t* f = e + SCHEMA_ENTRY_SIZE + j * SCHEMA_FIELD_SIZE;
+            int width = f[4] & 7;
+            if (getU16(f) >= poolSize ||
+                (width != 1 && width != 2 && width != 4) ||
+                f[3] + width > e[7] ||
+                f[5] >= 32 || f[6] > 8 * width) {
+                return FREESPACE_ERROR_MALFORMED_MESSAGE;
+            }
+        }
+
+        if (schema != NULL) {
+            struct SchemaEntry* entry = &schema->entries_[i];
+            const uint8_t* pool = schema->blob_ + SCHEMA_HEADER_SIZE;
+
+            entry->name_ = (const char*) pool + getU16(e);
+            entry->flags_ = e[2];
+            entry->hVer_ = e[3];
+            entry->reportId_ = e[4];
+            entry->subIdOffset_ = e[5];
+            entry->subId_ = e[6];
+            entry->size_ = e[7];
+            entry->fieldCount_ = nFields;
+            entry->fields_ = fields;
+            entry->layoutCount_ = nLayout;
+            entry->layout_ = layout;
+            for (j = 0; j < nFields; j++) {
+                const uint8_t* f = e + SCHEMA_ENTRY_SIZE + j * SCHEMA_FIELD_SIZE;
+                fields->name_ = (const char*) pool + getU16(f);
+                fields->index_ = f[2];
+                fields->offset_ = f[3];
+                fields->type_ = f[4];
+                fields->shift_ = f[5];
+                fields->bits_ = f[6];
+                fields++;
+            }
+            for (j = 0; j < nLayout; j++) {
+                const uint8_t* l = e + SCHEMA_ENTRY_SIZE + nFields * SCHEMA_FIELD_SIZE + j * 2;
+                layout->offset = l[0];
+                layout->packing = l[1];
+                layout++;
+            }
+
+            // Keep the definitions in blob order in each chain
+            entry->next_ = -1;
+            if (schema->first_[entry->hVer_][entry->reportId_] < 0) {
+                schema->first_[entry->hVer_][entry->reportId_] = (int16_t) i;
+            } else {
+                struct SchemaEntry* last = &schema->entries_[schema->first_[entry->hVer_][entry->reportId_]];
+                while (last->next_ >= 0) {
+                    last = &schema->entries_[last->next_];
+                }
+                last->next_ = i;
+            }
+        }
+
+        *fieldCount += nFields;
+        *layoutCount += nLayout;
+        at += SCHEMA_ENTRY_SIZE + nFields * SCHEMA_FIELD_SIZE + nLayout * 2;
+    }
+    return FREESPACE_SUCCESS;
+}
+
+LIBFREESPACE_API int freespace_schemaOpen(const uint8_t* blob, int length, struct FreespaceSchema** schema) {
+    struct FreespaceSchema* s;
+    int fieldCount;
+    int layoutCount;
+    int count;
+    size_t tables;
+    int rc;
+
+    *schema = NULL;
+    rc = parseSchema(blob, length, NULL, &fieldCount, &layoutCount);
+    if (rc != FREESPACE_SUCCESS) {
+        return rc;
+    }
+    count = getU16(blob + 9);
+
+    // One allocation: the schema, its tables, then the copy of the blob
+    tables = sizeof(struct SchemaEntry) * count +
+             sizeof(struct SchemaField) * fieldCount +
+             sizeof(struct freespace_field_layout) * layoutCount;
+    s = (struct FreespaceSchema*) freespace_private_malloc(sizeof(struct FreespaceSchema) + tables + length);
+    if (s == NULL) {
+        return FREESPACE_ERROR_OUT_OF_MEMORY;
+    }
+    s->entries_ = (struct SchemaEntry*) (s + 1);
+    s->blob_ = (uint8_t*) s->entries_ + tables;
+    memcpy(s->blob_, blob, length);
+
+    parseSchema(s->blob_, length, s, &fieldCount, &layoutCount);
+    *schema = s;
+    return FREESPACE_SUCCESS;
+}
+
+LIBFREESPACE_API void freespace_schemaClose(struct FreespaceSchema* schema) {
+    freespace_private_free(schema);
+}
+
+int freespace_private_schemaFind(const struct FreespaceSchema* schema,
+                                 const uint8_t* report,
+                                 int length,
+                                 int hVer,
+                                 int direction) {
+    int flag = direction == FREESPACE_RECORD_OUTBOUND ? SCHEMA_FLAG_ENCODE : SCHEMA_FLAG_DECODE;
+    int i;
+
+    if (length < 1 || hVer < 0 || hVer > 2) {
+        return -1;
+    }
+    for (i = schema->first_[hVer][report[0]]; i >= 0; i = schema->entries_[i].next_) {
+        const struct SchemaEntry* entry = &schema->entries_[i];
+        if ((entry->flags_ & flag) == 0) {
+            continue;
+        }
+        if (entry->subIdOffset_ != 0 &&
+            (entry->subIdOffset_ >= length || report[entry->subIdOffset_] != entry->subId_)) {
+            continue;
+        }
+        return i;
+    }
+    return -1;
+}
+
+int freespace_private_schemaCount(const struct FreespaceSchema* schema) {
+    return schema->count_;
+}
+
+int freespace_private_schemaLayout(const struct FreespaceSchema* schema,
+                                   int index,
+                                   const struct freespace_field_layout** fields) {
+    *fields = schema->entries_[index].layout_;
+    return schema->entries_[index].layoutCount_;
+}
+
+LIBFREESPACE_API int freespace_schemaDecode(const struct FreespaceSchema* schema,
+                                            const uint8_t* report,
+                                            int length,
+                                            int hVer,
+                                            int direction,
+                                            const char** messageName,
+                                            struct FreespaceSchemaField* fields,
+                                            int maxFields) {
+    const struct SchemaEntry* entry;
+    int index;
+    int i;
+
+    index = freespace_private_schemaFind(schema, report, length, hVer, direction);
+    if (index < 0) {
+        return FREESPACE_ERROR_MALFORMED_MESSAGE;
+    }
+    entry = &schema->entries_[index];
+    if (length < entry->size_) {
+        return FREESPACE_ERROR_BUFFER_TOO_SMALL;
+    }
+    if (messageName != NULL) {
+        *messageName = entry->name_;
+    }
+
+    for (i = 0; i < entry->fieldCount_ && i < maxFields; i++) {
+        const struct SchemaField* field = &entry->fields_[i];
+        const uint8_t* p = report + field->offset_;
+        uint32_t value;
+
+        switch (field->type_ & 7) {
+            case 1:
+                value = p[0];
+                break;
+            case 2:
+                value = p[0] | (p[1] << 8);
+                break;
+            default:
+                value = p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t) p[3] << 24);
+                break;
+        }
+
+        fields[i].name = field->name_;
+        fields[i].index = field->index_;
+        if (field->bits_ != 0) {
+            // A bit past the end of its byte reads as 0, as in the codecs
+            uint32_t mask = field->bits_ >= 32 ? 0xffffffffu : (1u << field->bits_) - 1;
+            fields[i].value = (value >> field->shift_) & mask;
+        } else if (field->type_ & SCHEMA_SIGNED) {
+            int unused = 32 - 8 * (field->type_ & 7);
+            fields[i].value = (int32_t) (value << unused) >> unused;
+        } else {
+            fields[i].value = value;
+        }
+    }
+    return entry->fieldCount_;
+}
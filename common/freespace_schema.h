@@ -0,0 +1,52 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _FREESPACE_SCHEMA_H_
+#define _FREESPACE_SCHEMA_H_
+
+#include "freespace/freespace.h"
+
+/**
+ * Find the message definition of a report.
+ *
+ * @param direction a FreespaceRecordDirection
+ * @return the index of the definition or -1 if there is none
+ */
+int freespace_private_schemaFind(const struct FreespaceSchema* schema,
+                                 const uint8_t* report,
+                                 int length,
+                                 int hVer,
+                                 int direction);
+
+/**
+ * @return the number of message definitions, one for each message and
+ *         HID version
+ */
+int freespace_private_schemaCount(const struct FreespaceSchema* schema);
+
+/**
+ * Get the sensor fields of a message definition, as
+ * freespace_message_layout() does for the compiled in messages.
+ *
+ * @return the number of fields
+ */
+int freespace_private_schemaLayout(const struct FreespaceSchema* schema,
+                                   int index,
+                                   const struct freespace_field_layout** fields);
+
+#endif // _FREESPACE_SCHEMA_H_
@@ -0,0 +1,301 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "freespace_subscribe.h"
+#include "freespace_alloc.h"
+#include "freespace_log.h"
+#include "freespace_trace.h"
+#include "freespace_probes.h"
+#include "freespace/freespace_util.h"
+
+#include <string.h>
+
+#define WARN(...) FREESPACE_LOG(FREESPACE_LOG_BACKEND, FREESPACE_LOG_LEVEL_WARN, __VA_ARGS__)
+
+#define SUBSCRIBE_MASK_WORDS ((FREESPACE_MESSAGE_TYPE_COUNT + 31) / 32)
+
+// The DataModeControlV2 packet select for MotionEngine Output
+#define ME_PACKET_SELECT 8
+#define ME_RESPONSE_TIMEOUT_MS 500
+#define ME_MAX_RETRIES 3
+
+struct FreespaceSubscription {
+    freespace_receiveMessageCallback callback_;
+    void* cookie_;
+};
+
+struct FreespaceSubscriptionSet {
+    // Checked against the report type before anything is decoded
+    uint32_t subscribed_[SUBSCRIBE_MASK_WORDS];
+    struct FreespaceSubscription subscriptions_[FREESPACE_MESSAGE_TYPE_COUNT];
+
+    // The MotionEngine Output fields subscribed to, the format and flags
+    // the device was last confirmed to send, and those waiting on a
+    // DataModeControlV2Response
+    int meFields_;
+    int meConfirmed_;
+    uint8_t meFormat_;
+    uint8_t meFlags_;
+    int meInFlight_;
+    uint8_t meSentFormat_;
+    uint8_t meSentFlags_;
+    int meRetries_;
+};
+
+// Indexed by device id like the mailboxes. Allocated on the first
+// subscription and kept until freespace_exit.
+static struct FreespaceSubscriptionSet* subscriptions_[FREESPACE_MAILBOX_MAX_ID];
+
+static struct FreespaceSubscriptionSet* getSet(FreespaceDeviceId id) {
+    if (id < 0 || id >= FREESPACE_MAILBOX_MAX_ID) {
+        return NULL;
+    }
+    return subscriptions_[id];
+}
+
+LIBFREESPACE_API int freespace_subscribe(FreespaceDeviceId id,
+                                         int messageType,
+                                         freespace_receiveMessageCallback callback,
+                                         void* cookie) {
+    struct FreespaceDeviceInfo info;
+    struct FreespaceSubscriptionSet* set;
+    int rc;
+
+    if (messageType < 0 || messageType >= FREESPACE_MESSAGE_TYPE_COUNT) {
+        return FREESPACE_ERROR_UNEXPECTED;
+    }
+    if (id < 0 || id >= FREESPACE_MAILBOX_MAX_ID) {
+        return FREESPACE_ERROR_INVALID_DEVICE;
+    }
+    rc = freespace_getDeviceInfo(id, &info);
+    if (rc != FREESPACE_SUCCESS) {
+        return rc;
+    }
+
+    set = subscriptions_[id];
+    if (set == NULL) {
+        if (callback == NULL) {
+            return FREESPACE_SUCCESS;
+        }
+        set = (struct FreespaceSubscriptionSet*) freespace_private_calloc(sizeof(struct FreespaceSubscriptionSet));
+        if (set == NULL) {
+            return FREESPACE_ERROR_OUT_OF_MEMORY;
+        }
+        subscriptions_[id] = set;
+    }
+
+    set->subscriptions_[messageType].callback_ = callback;
+    set->subscriptions_[messageType].cookie_ = cookie;
+    if (callback != NULL) {
+        set->subscribed_[messageType / 32] |= (1u << (messageType % 32));
+    } else {
+        set->subscribed_[messageType / 32] &= ~(1u << (messageType % 32));
+    }
+    return FREESPACE_SUCCESS;
+}
+
+static void negotiate(FreespaceDeviceId id, struct FreespaceSubscriptionSet* set);
+
+static void onNegotiated(FreespaceDeviceId id, struct freespace_message* response, void* cookie, int result) {
+    struct FreespaceSubscriptionSet* set = getSet(id);
+    const struct freespace_DataModeControlV2Response* r;
+
+    if (set == NULL || !set->meInFlight_) {
+        return;
+    }
+    set->meInFlight_ = 0;
+    r = result == FREESPACE_SUCCESS ? &response->dataModeControlV2Response : NULL;
+    if (r != NULL && r->packetSelect == ME_PACKET_SELECT && r->formatSelect == set->meSentFormat_ &&
+        ((r->ff0 & 1) | (r->ff1 & 1) << 1 | (r->ff2 & 1) << 2 | (r->ff3 & 1) << 3 |
+         (r->ff4 & 1) << 4 | (r->ff5 & 1) << 5 | (r->ff6 & 1) << 6 | (r->ff7 & 1) << 7) == set->meSentFlags_) {
+        set->meConfirmed_ = 1;
+        set->meFormat_ = set->meSentFormat_;
+        set->meFlags_ = set->meSentFlags_;
+        set->meRetries_ = 0;
+    } else {
+        WARN("device %d did not take MEOut format %d flags 0x%02x: %d",
+             id, set->meSentFormat_, set->meSentFlags_, result);
+        set->meConfirmed_ = 0;
+        if (result == FREESPACE_ERROR_NO_DEVICE || result == FREESPACE_ERROR_INVALID_DEVICE ||
+            ++set->meRetries_ > ME_MAX_RETRIES) {
+            set->meRetries_ = 0;
+            return;
+        }
+    }
+    // The subscription may have changed while this was in flight
+    negotiate(id, set);
+}
+
+// Ask the device for the smallest MEOut format carrying the subscribed
+// fields, unless it already sends it. With nothing subscribed, the
+// sections enabled here are turned off again.
+static void negotiate(FreespaceDeviceId id, struct FreespaceSubscriptionSet* set) {
+    struct freespace_message m;
+    uint8_t format;
+    uint8_t flags;
+
+    if (set->meInFlight_) {
+        return;
+    }
+    if (set->meFields_ == 0) {
+        if (!set->meConfirmed_ || set->meFlags_ == 0) {
+            return;
+        }
+        format = set->meFormat_;
+        flags = 0;
+    } else if (freespace_util_chooseFormat(set->meFields_, &format, &flags) != 0) {
+        return;
+    }
+    if (set->meConfirmed_ && format == set->meFormat_ && flags == set->meFlags_) {
+        return;
+    }
+
+    memset(&m, 0, sizeof(m));
+    m.messageType = FREESPACE_MESSAGE_DATAMODECONTROLV2REQUEST;
+    // Leave the operating mode alone
+    m.dataModeControlV2Request.operatingStatus = 1;
+    m.dataModeControlV2Request.packetSelect = ME_PACKET_SELECT;
+    m.dataModeControlV2Request.formatSelect = format;
+    m.dataModeControlV2Request.ff0 = (flags >> 0) & 1;
+    m.dataModeControlV2Request.ff1 = (flags >> 1) & 1;
+    m.dataModeControlV2Request.ff2 = (flags >> 2) & 1;
+    m.dataModeControlV2Request.ff3 = (flags >> 3) & 1;
+    m.dataModeControlV2Request.ff4 = (flags >> 4) & 1;
+    m.dataModeControlV2Request.ff5 = (flags >> 5) & 1;
+    m.dataModeControlV2Request.ff6 = (flags >> 6) & 1;
+    m.dataModeControlV2Request.ff7 = (flags >> 7) & 1;
+    if (freespace_request(id, &m, FREESPACE_MESSAGE_DATAMODECONTROLV2RESPONSE,
+                          ME_RESPONSE_TIMEOUT_MS, onNegotiated, NULL) == FREESPACE_SUCCESS) {
+        set->meInFlight_ = 1;
+        set->meSentFormat_ = format;
+        set->meSentFlags_ = flags;
+    }
+}
+
+LIBFREESPACE_API int freespace_subscribeMotionEngine(FreespaceDeviceId id,
+                                                     int fields,
+                                                     freespace_receiveMessageCallback callback,
+                                                     void* cookie) {
+    struct FreespaceDeviceInfo info;
+    struct FreespaceSubscriptionSet* set;
+    uint8_t format;
+    uint8_t flags;
+    int rc;
+
+    if (callback == NULL) {
+        fields = 0;
+    } else if (fields == 0 || freespace_util_chooseFormat(fields, &format, &flags) != 0) {
+        return FREESPACE_ERROR_UNEXPECTED;
+    }
+    rc = freespace_getDeviceInfo(id, &info);
+    if (rc != FREESPACE_SUCCESS) {
+        return rc;
+    }
+    if (info.hVer < 2) {
+        return FREESPACE_ERROR_INVALID_HID_PROTOCOL_VERSION;
+    }
+    rc = freespace_subscribe(id, FREESPACE_MESSAGE_MOTIONENGINEOUTPUT, callback, cookie);
+    set = getSet(id);
+    if (rc != FREESPACE_SUCCESS || set == NULL) {
+        return rc;
+    }
+    set->meFields_ = fields;
+    set->meRetries_ = 0;
+    negotiate(id, set);
+    return FREESPACE_SUCCESS;
+}
+
+int freespace_private_subscriptionDeliver(FreespaceDeviceId id,
+                                          const uint8_t* report,
+                                          int length,
+                                          uint8_t hVer) {
+    struct FreespaceSubscriptionSet* set = getSet(id);
+    struct FreespaceSubscription subscription;
+    struct freespace_message m;
+    int type;
+    int rc;
+
+    if (set == NULL) {
+        return 0;
+    }
+
+    type = freespace_peek_message_type(report, length, hVer);
+    if (type < 0 || (set->subscribed_[type / 32] & (1u << (type % 32))) == 0) {
+        return 0;
+    }
+
+    // Copy it; the callback may change its own subscription.
+    subscription = set->subscriptions_[type];
+    FREESPACE_TRACE_BEGIN("decode", id);
+    rc = freespace_decode_message(report, length, &m, hVer);
+    FREESPACE_TRACE_END("decode", id);
+    FREESPACE_PROBE3(decode__done, id, rc == FREESPACE_SUCCESS ? m.messageType : -1, rc);
+
+    FREESPACE_TRACE_BEGIN("callback", id);
+    FREESPACE_PROBE1(callback__entry, id);
+    if (rc == FREESPACE_SUCCESS) {
+        subscription.callback_(id, &m, subscription.cookie_, FREESPACE_SUCCESS);
+    } else {
+        subscription.callback_(id, NULL, subscription.cookie_, rc);
+    }
+    FREESPACE_PROBE1(callback__return, id);
+    FREESPACE_TRACE_END("callback", id);
+    return 1;
+}
+
+int freespace_private_subscriptionActive(FreespaceDeviceId id) {
+    struct FreespaceSubscriptionSet* set = getSet(id);
+    int i;
+
+    if (set == NULL) {
+        return 0;
+    }
+    for (i = 0; i < SUBSCRIBE_MASK_WORDS; i++) {
+        if (set->subscribed_[i] != 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+void freespace_private_subscriptionTypes(FreespaceDeviceId id, uint32_t* mask) {
+    struct FreespaceSubscriptionSet* set = getSet(id);
+    int i;
+
+    if (set == NULL) {
+        return;
+    }
+    for (i = 0; i < SUBSCRIBE_MASK_WORDS; i++) {
+        mask[i] |= set->subscribed_[i];
+    }
+}
+
+void freespace_private_subscriptionReset(FreespaceDeviceId id) {
+    struct FreespaceSubscriptionSet* set = getSet(id);
+
+    if (set != NULL) {
+        memset(set, 0, sizeof(struct FreespaceSubscriptionSet));
+    }
+}
+
+void freespace_private_subscriptionExit() {
+    int i;
+    for (i = 0; i < FREESPACE_MAILBOX_MAX_ID; i++) {
+        freespace_private_free(subscriptions_[i]);
+        subscriptions_[i] = NULL;
+    }
+}
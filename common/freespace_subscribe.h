@@ -0,0 +1,58 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _FREESPACE_SUBSCRIBE_H_
+#define _FREESPACE_SUBSCRIBE_H_
+
+#include "freespace_mailbox.h"
+
+/**
+ * Offer a received report to the per message type subscriptions. Called
+ * by the backends before running the receive callbacks. Only reports of
+ * a subscribed type are decoded.
+ *
+ * @return 1 if the report was passed to a subscriber and must not be
+ *         delivered to the callbacks, 0 otherwise
+ */
+int freespace_private_subscriptionDeliver(FreespaceDeviceId id,
+                                          const uint8_t* report,
+                                          int length,
+                                          uint8_t hVer);
+
+/**
+ * @return nonzero if the device has any subscriptions
+ */
+int freespace_private_subscriptionActive(FreespaceDeviceId id);
+
+/**
+ * Set the bit of each subscribed message type in mask, which has
+ * (FREESPACE_MESSAGE_TYPE_COUNT + 31) / 32 words.
+ */
+void freespace_private_subscriptionTypes(FreespaceDeviceId id, uint32_t* mask);
+
+/**
+ * Remove all subscriptions of a device. Called by the backends when a
+ * device is closed.
+ */
+void freespace_private_subscriptionReset(FreespaceDeviceId id);
+
+/**
+ * Free all subscriptions. Called from freespace_exit().
+ */
+void freespace_private_subscriptionExit();
+
+#endif // _FREESPACE_SUBSCRIBE_H_
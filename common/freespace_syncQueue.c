@@ -0,0 +1,77 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "freespace_syncQueue.h"
+
+#include <string.h>
+
+int freespace_private_syncQueuePush(struct FreespaceSyncQueue* queue,
+                                    const uint8_t* report,
+                                    int length,
+                                    int status) {
+    int dropped = 0;
+    int slot;
+
+    if (length < 0) {
+        length = 0;
+    } else if (length > FREESPACE_MAX_INPUT_MESSAGE_SIZE) {
+        length = FREESPACE_MAX_INPUT_MESSAGE_SIZE;
+    }
+    if (queue->count_ == FREESPACE_SYNC_QUEUE_SIZE) {
+        queue->head_ = (queue->head_ + 1) % FREESPACE_SYNC_QUEUE_SIZE;
+        queue->count_--;
+        dropped = 1;
+    }
+
+    slot = (queue->head_ + queue->count_) % FREESPACE_SYNC_QUEUE_SIZE;
+    if (length > 0) {
+        memcpy(queue->data_[slot], report, length);
+    }
+    queue->length_[slot] = length;
+    queue->status_[slot] = status;
+    queue->count_++;
+    return dropped;
+}
+
+int freespace_private_syncQueuePop(struct FreespaceSyncQueue* queue,
+                                   uint8_t* report,
+                                   int maxLength,
+                                   int* actualLength) {
+    int slot = queue->head_;
+    int length;
+
+    if (queue->count_ == 0) {
+        return FREESPACE_ERROR_NO_DATA;
+    }
+
+    length = queue->length_[slot];
+    if (length > maxLength) {
+        length = maxLength;
+    }
+    memcpy(report, queue->data_[slot], length);
+    *actualLength = length;
+
+    queue->head_ = (queue->head_ + 1) % FREESPACE_SYNC_QUEUE_SIZE;
+    queue->count_--;
+    return queue->status_[slot];
+}
+
+void freespace_private_syncQueueClear(struct FreespaceSyncQueue* queue) {
+    queue->head_ = 0;
+    queue->count_ = 0;
+}
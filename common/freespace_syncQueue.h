@@ -0,0 +1,68 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _FREESPACE_SYNCQUEUE_H_
+#define _FREESPACE_SYNCQUEUE_H_
+
+#include "freespace/freespace.h"
+
+#define FREESPACE_SYNC_QUEUE_SIZE 8
+
+/**
+ * Reports kept for freespace_read(). A backend that has to take reports
+ * off the device in freespace_perform, so that responses reach requests,
+ * flash record reads, subscriptions and mailboxes, puts the rest here
+ * when there is no receive callback for them. Only touched by the thread
+ * that calls freespace_perform and freespace_read.
+ */
+struct FreespaceSyncQueue {
+    int head_;
+    int count_;
+    int length_[FREESPACE_SYNC_QUEUE_SIZE];
+    int status_[FREESPACE_SYNC_QUEUE_SIZE];
+    uint8_t data_[FREESPACE_SYNC_QUEUE_SIZE][FREESPACE_MAX_INPUT_MESSAGE_SIZE];
+};
+
+/**
+ * Keep a report, dropping the oldest one if the queue is full.
+ *
+ * @param status the FreespaceErrorCodes result of the read
+ * @return 1 if a report was dropped to make room, 0 otherwise
+ */
+int freespace_private_syncQueuePush(struct FreespaceSyncQueue* queue,
+                                    const uint8_t* report,
+                                    int length,
+                                    int status);
+
+/**
+ * Take the oldest report.
+ *
+ * @return the status it was kept with, or FREESPACE_ERROR_NO_DATA if the
+ *         queue is empty
+ */
+int freespace_private_syncQueuePop(struct FreespaceSyncQueue* queue,
+                                   uint8_t* report,
+                                   int maxLength,
+                                   int* actualLength);
+
+/**
+ * Drop every report. Called on flush and close.
+ */
+void freespace_private_syncQueueClear(struct FreespaceSyncQueue* queue);
+
+#endif // _FREESPACE_SYNCQUEUE_H_
@@ -0,0 +1,228 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "freespace_trace.h"
+#include "freespace_alloc.h"
+
+#include <stdio.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <process.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
+/**
+ * One recorded event. sequence_ is the ring position + 1 once the
+ * event is complete, so that the dump can skip events being written.
+ */
+struct FreespaceTraceEvent {
+    volatile long sequence_;
+    const char* name_;
+    char phase_;
+    FreespaceDeviceId id_;
+    unsigned long threadId_;
+    uint64_t timestamp_;
+};
+
+volatile int freespace_private_traceEnabled = 0;
+
+// The ring keeps the newest capacity_ events. It is allocated by
+// freespace_traceStart() and only freed by freespace_traceStart() or
+// freespace_traceClear() once recording has stopped and writers_, the
+// number of threads inside freespace_private_trace(), has drained.
+static struct FreespaceTraceEvent* ring_ = NULL;
+static long capacity_ = 0;
+static volatile long next_ = 0;
+static volatile long writers_ = 0;
+
+static uint64_t nowMicros() {
+#ifdef _WIN32
+    LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (uint64_t) (counter.QuadPart / frequency.QuadPart) * 1000000 +
+           (uint64_t) (counter.QuadPart % frequency.QuadPart) * 1000000 / frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+#endif
+}
+
+static unsigned long currentThreadId() {
+#if defined(_WIN32)
+    return (unsigned long) GetCurrentThreadId();
+#elif defined(__linux__)
+    // Cached, since the tid is a system call each time
+    static FREESPACE_THREAD_LOCAL unsigned long tid = 0;
+    if (tid == 0) {
+        tid = (unsigned long) syscall(SYS_gettid);
+    }
+    return tid;
+#else
+    return (unsigned long) pthread_self();
+#endif
+}
+
+static unsigned long currentProcessId() {
+#ifdef _WIN32
+    return (unsigned long) _getpid();
+#else
+    return (unsigned long) getpid();
+#endif
+}
+
+static void yieldThread() {
+#ifdef _WIN32
+    SwitchToThread();
+#else
+    sched_yield();
+#endif
+}
+
+// Wait out any thread that saw tracing enabled and may still be
+// writing to the ring. freespace_private_traceEnabled must be clear.
+static void waitForWriters() {
+    FREESPACE_ATOMIC_BARRIER();
+    while (writers_ != 0) {
+        yieldThread();
+    }
+}
+
+void freespace_private_trace(const char* name, char phase, FreespaceDeviceId id) {
+    struct FreespaceTraceEvent* event;
+    long position;
+
+    // The macro's check may be stale by now. Count this thread as a
+    // writer before checking again, so that once freespace_traceStop()
+    // has seen writers_ drain no thread can still touch the ring.
+    FREESPACE_ATOMIC_INCREMENT(&writers_);
+    if (!freespace_private_traceEnabled) {
+        FREESPACE_ATOMIC_DECREMENT(&writers_);
+        return;
+    }
+
+    position = FREESPACE_ATOMIC_INCREMENT(&next_) - 1;
+
+    event = &ring_[position % capacity_];
+    event->sequence_ = 0;
+    FREESPACE_ATOMIC_BARRIER();
+    event->name_ = name;
+    event->phase_ = phase;
+    event->id_ = id;
+    event->threadId_ = currentThreadId();
+    event->timestamp_ = nowMicros();
+    FREESPACE_ATOMIC_BARRIER();
+    event->sequence_ = position + 1;
+    FREESPACE_ATOMIC_DECREMENT(&writers_);
+}
+
+LIBFREESPACE_API int freespace_traceStart(int capacity) {
+    if (capacity <= 0) {
+        return FREESPACE_ERROR_UNEXPECTED;
+    }
+    if (freespace_private_traceEnabled) {
+        return FREESPACE_ERROR_BUSY;
+    }
+
+    freespace_traceClear();
+    ring_ = (struct FreespaceTraceEvent*) freespace_private_calloc(sizeof(struct FreespaceTraceEvent) * capacity);
+    if (ring_ == NULL) {
+        return FREESPACE_ERROR_OUT_OF_MEMORY;
+    }
+    capacity_ = capacity;
+    next_ = 0;
+    FREESPACE_ATOMIC_BARRIER();
+    freespace_private_traceEnabled = 1;
+    return FREESPACE_SUCCESS;
+}
+
+LIBFREESPACE_API void freespace_traceStop() {
+    freespace_private_traceEnabled = 0;
+    waitForWriters();
+}
+
+LIBFREESPACE_API void freespace_traceClear() {
+    if (freespace_private_traceEnabled) {
+        return;
+    }
+    waitForWriters();
+    freespace_private_free(ring_);
+    ring_ = NULL;
+    capacity_ = 0;
+    next_ = 0;
+}
+
+LIBFREESPACE_API int freespace_traceWrite(const char* path) {
+    FILE* file;
+    long first;
+    long last;
+    long position;
+    unsigned long pid = currentProcessId();
+    int separator = 0;
+
+    if (ring_ == NULL) {
+        return FREESPACE_ERROR_NO_DATA;
+    }
+    file = fopen(path, "w");
+    if (file == NULL) {
+        return FREESPACE_ERROR_IO;
+    }
+
+    // Oldest to newest. Anything overwritten or half written while
+    // this runs is skipped.
+    last = next_;
+    first = (last > capacity_) ? last - capacity_ : 0;
+
+    fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    for (position = first; position < last; position++) {
+        struct FreespaceTraceEvent event = ring_[position % capacity_];
+        if (event.sequence_ != position + 1 || event.name_ == NULL) {
+            continue;
+        }
+        fprintf(file, "%s{\"name\":\"%s\",\"cat\":\"libfreespace\",\"ph\":\"%c\",\"ts\":%llu,\"pid\":%lu,\"tid\":%lu",
+                separator ? ",\n" : "",
+                event.name_,
+                event.phase_,
+                (unsigned long long) event.timestamp_,
+                pid,
+                event.threadId_);
+        if (event.phase_ == 'i') {
+            fprintf(file, ",\"s\":\"t\"");
+        }
+        if (event.id_ >= 0) {
+            fprintf(file, ",\"args\":{\"device\":%d}", (int) event.id_);
+        }
+        fprintf(file, "}");
+        separator = 1;
+    }
+    fprintf(file, "\n]}\n");
+
+    if (fclose(file) != 0) {
+        return FREESPACE_ERROR_IO;
+    }
+    return FREESPACE_SUCCESS;
+}
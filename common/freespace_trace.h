@@ -0,0 +1,49 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _FREESPACE_TRACE_H_
+#define _FREESPACE_TRACE_H_
+
+#include "freespace/freespace.h"
+#include "freespace_atomic.h"
+
+/**
+ * Set while freespace_traceStart() is recording. Checked inline by the
+ * FREESPACE_TRACE_* macros so that tracing costs a load and a branch
+ * when it is off.
+ */
+extern volatile int freespace_private_traceEnabled;
+
+/**
+ * Record an event. phase is the Chrome trace event phase: 'B' to begin
+ * a span, 'E' to end it or 'i' for an instant. name must be a string
+ * literal since only the pointer is stored.
+ */
+void freespace_private_trace(const char* name, char phase, FreespaceDeviceId id);
+
+#define FREESPACE_TRACE_EVENT(name, phase, id) \
+    do { \
+        if (FREESPACE_UNLIKELY(freespace_private_traceEnabled)) { \
+            freespace_private_trace((name), (phase), (id)); \
+        } \
+    } while (0)
+
+#define FREESPACE_TRACE_BEGIN(name, id) FREESPACE_TRACE_EVENT(name, 'B', id)
+#define FREESPACE_TRACE_END(name, id) FREESPACE_TRACE_EVENT(name, 'E', id)
+#define FREESPACE_TRACE_INSTANT(name, id) FREESPACE_TRACE_EVENT(name, 'i', id)
+
+#endif // _FREESPACE_TRACE_H_
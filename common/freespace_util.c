@@ -493,3 +493,68 @@ LIBFREESPACE_API int freespace_util_getActClass(struct freespace_MotionEngineOut
     return 0;
 }
 
+/******************************************************************************
+ * freespace_util_chooseFormat
+ */
+
+#define ME_ALL_FIELDS 0x3ff
+
+// The field in each section of formats 0 to 3, and its size in bytes.
+// Format 2 is reserved.
+static const struct {
+    int field;
+    int size;
+} meSections[4][8] = {
+    { { FREESPACE_ME_POINTER, 6 }, { FREESPACE_ME_ACCELERATION, 6 },
+      { FREESPACE_ME_ACC_NO_GRAVITY, 6 }, { FREESPACE_ME_ANGULAR_VELOCITY, 6 },
+      { FREESPACE_ME_MAGNETOMETER, 6 }, { FREESPACE_ME_TEMPERATURE, 2 },
+      { FREESPACE_ME_ANGULAR_POSITION, 8 }, { 0, 0 } },
+    { { FREESPACE_ME_ACCELERATION, 6 }, { FREESPACE_ME_ACC_NO_GRAVITY, 6 },
+      { FREESPACE_ME_ANGULAR_VELOCITY, 6 }, { FREESPACE_ME_MAGNETOMETER, 6 },
+      { FREESPACE_ME_INCLINATION, 6 }, { FREESPACE_ME_COMPASS_HEADING, 2 },
+      { FREESPACE_ME_ANGULAR_POSITION, 8 }, { FREESPACE_ME_ACT_CLASS, 2 } },
+    { { 0, 0 } },
+    { { FREESPACE_ME_POINTER, 6 }, { FREESPACE_ME_ACCELERATION, 6 },
+      { FREESPACE_ME_ACC_NO_GRAVITY, 6 }, { FREESPACE_ME_ANGULAR_VELOCITY, 6 },
+      { FREESPACE_ME_MAGNETOMETER, 6 }, { FREESPACE_ME_TEMPERATURE, 2 },
+      { FREESPACE_ME_ANGULAR_POSITION, 8 }, { 0, 0 } }
+};
+
+LIBFREESPACE_API int freespace_util_chooseFormat(int fields,
+                                                 uint8_t * formatSelect,
+                                                 uint8_t * formatFlags) {
+
+    int bestSize = -1;
+    int format;
+    int ff;
+
+    if ((fields & ~ME_ALL_FIELDS) != 0) {
+        return -3; // Unrecognized field
+    }
+
+    for (format = 0; format < 4; format++) {
+        int covered = 0;
+        int size = 0;
+        uint8_t flags = 0;
+        for (ff = 0; ff < 8; ff++) {
+            if ((meSections[format][ff].field & fields) != 0) {
+                flags |= (uint8_t) (1 << ff);
+                size += meSections[format][ff].size;
+                covered |= meSections[format][ff].field;
+            }
+        }
+        if (format == 2 || covered != fields) {
+            continue; // Reserved, or something is missing
+        }
+        if (bestSize < 0 || size < bestSize) {
+            bestSize = size;
+            *formatSelect = (uint8_t) format;
+            *formatFlags = flags;
+        }
+    }
+
+    if (bestSize < 0) {
+        return -1; // No one format has them all
+    }
+    return 0;
+}
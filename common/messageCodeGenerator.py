@@ -89,13 +89,9 @@ class MessageCodeGenerator:
         codecsCFile.write('#else\n')
         codecsCFile.write('#define STRICT_DECODE_LENGTH 0\n')
         codecsCFile.write('#endif\n\n')
+        codecsCFile.write('#include "freespace_log.h"\n\n')
         codecsCFile.write('#undef CODECS_PRINTF\n')
-        codecsCFile.write('//#define CODECS_DEBUG\n')
-        codecsCFile.write('#ifdef CODECS_DEBUG\n')
-        codecsCFile.write('#define CODECS_PRINTF printf\n')
-        codecsCFile.write('#else\n')
-        codecsCFile.write('#define CODECS_PRINTF(...)\n')
-        codecsCFile.write('#endif\n\n')
+        codecsCFile.write('#define CODECS_PRINTF(...) FREESPACE_LOG(FREESPACE_LOG_CODECS, FREESPACE_LOG_LEVEL_DEBUG, __VA_ARGS__)\n\n')
         self.writeBitHelper(codecsCFile)
         
         printersCFile = open(printersSrcPath, "w")
@@ -108,12 +104,16 @@ class MessageCodeGenerator:
             writeStruct(message, fields, codecsHFile)
 
         self.writeUnionStruct(codecsHFile, messages)
+        self.writeLayoutDecl(codecsHFile)
+        self.writeSchemaDecl(codecsHFile)
 
         for message in messages:
             writeCodecs(message, codecsHFile, codecsCFile)
             writePrinter(message, printersHFile, printersCFile)
 
         self.writeUnionDecodeEncodeBodies(codecsCFile, messages)
+        self.writeLayoutBodies(codecsCFile, messages)
+        self.writeSchemaBody(codecsCFile, messages)
             
         self.writeHFileTrailer(codecsHFile, codecsFileName)
         self.writeHFileTrailer(printersHFile, printersFileName)
@@ -289,7 +289,12 @@ enum MessageTypes {''')
             i = i+1
         file.write('''
 };
-''')
+
+/** @ingroup messages
+ * The number of message types in enum MessageTypes.
+ */
+#define FREESPACE_MESSAGE_TYPE_COUNT %d
+''' % i)
     
         file.write('''
 /** @ingroup messages
@@ -322,6 +327,16 @@ struct freespace_message {
  */
 LIBFREESPACE_API int freespace_decode_message(const uint8_t* message, int length, struct freespace_message* s, uint8_t ver);
 
+/** @ingroup messages
+ * Find the type of a received message without decoding it.
+ *
+ * @param message the message that was received from the Freespace device
+ * @param length the length of the received message
+ * @param ver the HID protocol version to use to interpret the message
+ * @return the MessageTypes value or an error code
+ */
+LIBFREESPACE_API int freespace_peek_message_type(const uint8_t* message, int length, uint8_t ver);
+
 /** @ingroup messages
  * Encode an arbitrary message.
  *
@@ -390,6 +405,59 @@ LIBFREESPACE_API int freespace_decode_message(const uint8_t* message, int length
 }
 ''')
         
+        file.write('''
+LIBFREESPACE_API int freespace_peek_message_type(const uint8_t* message, int length, uint8_t ver) {
+    if (length == 0) {
+        return -1;
+    }
+
+    switch (ver) {\n''')
+        for v in range(3):
+            usedIDs = []
+            file.write("\t\tcase %d:\n" % v)
+            file.write("\t\t\tswitch(message[0]) {\n")
+            for message in messages:
+                if (not message.decode) or len(message.ID[v]) == 0:
+                    continue
+                if message.ID[v]['constID'] in usedIDs:
+                    continue
+                file.write("\t\t\t\tcase %d:"%message.ID[v]['constID'])
+                if message.ID[v].has_key('subId'):
+                    file.write('''
+                    if (length <= %d) {
+                        return FREESPACE_ERROR_MALFORMED_MESSAGE;
+                    }
+                    switch (message[%d]) {''' % (subIdMap[v], subIdMap[v]))
+                    for subMessage in messages:
+                        if (not subMessage.decode) or len(subMessage.ID[v]) == 0:
+                            continue
+                        if subMessage.ID[v]['constID'] == message.ID[v]['constID']:
+                            file.write('''
+                        case %(subId)d:
+                            return %(messageType)s;'''
+                            %{'subId':subMessage.ID[v]['subId']['id'],
+                              'messageType':subMessage.enumName})
+
+                    file.write('''
+                        default:
+                            return FREESPACE_ERROR_MALFORMED_MESSAGE;
+                    }\n''')
+                else:
+                    file.write('''
+                    return %s;
+''' % message.enumName)
+
+                usedIDs.append(message.ID[v]['constID'])
+            file.write('''                default:
+                    return FREESPACE_ERROR_MALFORMED_MESSAGE;
+            }\n''')
+        file.write('''
+    default:
+        return FREESPACE_ERROR_INVALID_HID_PROTOCOL_VERSION;
+    }
+}
+''')
+
         file.write('''
 LIBFREESPACE_API int freespace_encode_message(struct freespace_message* message, uint8_t* msgBuf, int maxlength) {
     message->src = 0; // Force source to 0, since this is coming from the system host.
@@ -408,8 +476,236 @@ LIBFREESPACE_API int freespace_encode_message(struct freespace_message* message,
 }''')
 
 
+    def writeLayoutDecl(self, file):
+        file.write('''
+/** @ingroup messages
+ * How a field of a received message is packed in compressed captures.
+ */
+enum freespace_field_packing {
+    FREESPACE_PACK_INT16 = 1,      /**< A 16 bit little endian value */
+    FREESPACE_PACK_QUATERNION = 2  /**< Four 16 bit quaternion components */
+};
+
+/** @ingroup messages
+ * A field of a received message that packs better than its bytes.
+ */
+struct freespace_field_layout {
+    uint8_t offset;  /**< Offset in the raw message */
+    uint8_t packing; /**< An enum freespace_field_packing */
+};
+
+/** @ingroup messages
+ * Get the fields of a received message that are sensor values, sorted
+ * by offset. The other bytes are flags, sequence numbers and headers.
+ *
+ * @param messageType the MessageTypes value
+ * @param ver the HID protocol version
+ * @param fields set to the fields or NULL if there are none
+ * @return the number of fields
+ */
+LIBFREESPACE_API int freespace_message_layout(int messageType, uint8_t ver, const struct freespace_field_layout** fields);
+
+''')
+
+    def writeLayoutBodies(self, file, messages):
+        layouts = []
+        for message in messages:
+            if not message.decode:
+                continue
+            for v in range(3):
+                if len(message.ID[v]) == 0:
+                    continue
+                fields = messageLayout(message, v)
+                if len(fields) == 0:
+                    continue
+                arrayName = "layout%sVer%d" % (message.name, v)
+                file.write("\nstatic const struct freespace_field_layout %s[] = {\n" % arrayName)
+                for (offset, packing) in fields:
+                    file.write("    { %d, %s },\n" % (offset, packing))
+                file.write("};\n")
+                layouts.append((message, v, arrayName, len(fields)))
+
+        file.write('''
+LIBFREESPACE_API int freespace_message_layout(int messageType, uint8_t ver, const struct freespace_field_layout** fields) {
+    *fields = NULL;
+    switch (messageType) {''')
+        for message in messages:
+            versions = [l for l in layouts if l[0] is message]
+            if len(versions) == 0:
+                continue
+            file.write('''
+        case %s:
+            switch (ver) {''' % message.enumName)
+            for (m, v, arrayName, count) in versions:
+                file.write('''
+                case %(v)d:
+                    *fields = %(array)s;
+                    return %(count)d;''' % {'v':v, 'array':arrayName, 'count':count})
+            file.write('''
+                default:
+                    return 0;
+            }''')
+        file.write('''
+        default:
+            return 0;
+    }
+}
+''')
+
+    def writeSchemaDecl(self, file):
+        file.write('''
+/** @ingroup messages
+ * Get the message definitions compiled into this library as a binary
+ * schema. Captures embed it so that they can be decoded by a library
+ * built from different definitions.
+ *
+ * @param schema set to the schema
+ * @return the size of the schema in bytes
+ */
+LIBFREESPACE_API int freespace_message_schema(const uint8_t** schema);
+
+''')
+
+    def writeSchemaBody(self, file, messages):
+        schema = messageSchema(messages)
+        file.write("\nstatic const uint8_t messageSchema[%d] = {" % len(schema))
+        for i in range(len(schema)):
+            if i % 16 == 0:
+                file.write("\n   ")
+            file.write(" 0x%02x," % schema[i])
+        file.write('''
+};
+
+LIBFREESPACE_API int freespace_message_schema(const uint8_t** schema) {
+    *schema = messageSchema;
+    return (int) sizeof(messageSchema);
+}
+''')
+
 
 # --------------------------  Individual Message ------------------------------------
+
+# Find the sensor fields of one version of a message for the recorder.
+# Quaternions are marked on their first component and take the next
+# three fields with them; other 16 bit fields, and byte arrays marked
+# as 'int16', pack as 16 bit values.
+def messageLayout(message, v):
+    layout = []
+    offset = 1
+    if v == 2:
+        offset += 3
+    if message.ID[v].has_key('subId'):
+        offset += message.ID[v]['subId']['size']
+    quaternionLeft = 0
+    for field in message.Fields[v]:
+        if field.has_key('synthesized'):
+            continue
+        packing = field.get('packing', '')
+        if quaternionLeft > 0:
+            quaternionLeft -= 1
+        elif packing == 'quaternion':
+            layout.append((offset, 'FREESPACE_PACK_QUATERNION'))
+            quaternionLeft = 3
+        elif packing == 'int16' or field.get('cType', '') in ('int16_t', 'uint16_t'):
+            for i in range(field['size'] / 2):
+                layout.append((offset + 2 * i, 'FREESPACE_PACK_INT16'))
+        offset += field['size']
+    return layout
+
+# The binary schema read by freespace_schema.c. All numbers are little
+# endian. Names are kept once in a pool of NUL terminated strings.
+#
+#   "FSSCHEMA", byte format version, u16 entry count, u16 pool size, pool
+#   for each message and HID version:
+#     u16 name, byte flags (1 decoded from the device, 2 encoded to it),
+#     byte version, byte report id, byte sub id offset (0 if none),
+#     byte sub id, byte size, byte field count, byte layout count
+#     for each field (array elements one by one):
+#       u16 name, byte element index, byte offset,
+#       byte type (width in bytes, 0x08 if signed), byte shift, byte bits (0 for all)
+#     for each messageLayout() entry: byte offset, byte packing
+SCHEMA_VERSION = 1
+SCHEMA_PACKING = {'FREESPACE_PACK_INT16':1, 'FREESPACE_PACK_QUATERNION':2}
+
+def messageSchema(messages):
+    pool = bytearray()
+    names = {}
+    def nameRef(name):
+        if not names.has_key(name):
+            names[name] = len(pool)
+            pool.extend(name)
+            pool.append(0)
+        return [names[name] & 0xff, names[name] >> 8]
+
+    entries = bytearray()
+    count = 0
+    for message in messages:
+        flags = 0
+        if message.decode:
+            flags |= 1
+        if message.encode:
+            flags |= 2
+        for v in range(3):
+            if len(message.ID[v]) == 0:
+                continue
+            entries.extend(schemaEntry(message, v, flags, nameRef))
+            count += 1
+
+    blob = bytearray("FSSCHEMA")
+    blob.extend([SCHEMA_VERSION, count & 0xff, count >> 8, len(pool) & 0xff, len(pool) >> 8])
+    blob.extend(pool)
+    blob.extend(entries)
+    return blob
+
+def schemaEntry(message, v, flags, nameRef):
+    offset = 1
+    if v == 2:
+        offset += 3
+    subIdOffset = 0
+    subId = 0
+    if message.ID[v].has_key('subId'):
+        subIdOffset = offset
+        subId = message.ID[v]['subId']['id']
+        offset += message.ID[v]['subId']['size']
+
+    fields = []
+    for field in message.Fields[v]:
+        if field.has_key('synthesized'):
+            continue
+        if field['name'] != 'RESERVED':
+            if field.has_key('cType'):
+                info = cTypeToTypeInfo(field['cType'], field['size'])
+                fieldType = info['width']
+                if info['signed']:
+                    fieldType |= 0x08
+                for i in range(info['count']):
+                    fields.append((field['name'], i, offset + i * info['width'], fieldType, 0, 0))
+            elif field.has_key('bits'):
+                # Same bit positions as writeDecodeBody()
+                bitCounter = 0
+                for bit in field['bits']:
+                    if bit['name'] != 'RESERVED':
+                        fields.append((bit['name'], 0, offset, 1, bitCounter, bit.get('size', 1)))
+                        bitCounter += bit.get('size', 1) - 1
+                    bitCounter += 1
+            elif field.has_key('nibbles'):
+                nibbleCounter = 0
+                for nibble in field['nibbles']:
+                    if nibble['name'] != 'RESERVED':
+                        fields.append((nibble['name'], 0, offset, 1, nibbleCounter * 4, 4))
+                    nibbleCounter += 1
+        offset += field['size']
+
+    layout = messageLayout(message, v)
+    entry = bytearray(nameRef(message.name))
+    entry.extend([flags, v, message.ID[v]['constID'], subIdOffset, subId,
+                  message.getMessageSize(v), len(fields), len(layout)])
+    for (name, index, fieldOffset, fieldType, shift, bits) in fields:
+        entry.extend(nameRef(name))
+        entry.extend([index, fieldOffset, fieldType, shift, bits])
+    for (fieldOffset, packing) in layout:
+        entry.extend([fieldOffset, SCHEMA_PACKING[packing]])
+    return entry
     
 def writeCodecs(message, outHFile, outCFile):
     fields = extractFields(message)
@@ -28,6 +28,7 @@ RESERVED = 'RESERVED'
 ConstantID = 'constID'
 SubMessageID = 'subId'
 Documentation = 'comment'
+packing = 'packing'     # How the recorder packs a field: 'int16' words or a 'quaternion' of this and the next 3 fields
 
 # ---------------------------------------------------------------------------------------
 # -------------------------------- Message Class ----------------------------------------
@@ -195,7 +196,7 @@ UserFrameMessage.Fields[1] = [
     {name:"linearPosX",     size:2, cType:'int16_t', Documentation:"Linear Offset is in units of meters. X positive is right. Y positive is near. Z positive is down wrt the user frame of reference."},
     {name:"linearPosY",     size:2, cType:'int16_t'},
     {name:"linearPosZ",     size:2, cType:'int16_t'},
-    {name:"angularPosA",    size:2, cType:'int16_t', Documentation:"Angular Position is in dimensionless units. The axes are given in quaternion form where A, B, C, D represent the real, i, j, and k coefficients."},
+    {name:"angularPosA",    size:2, cType:'int16_t', packing:'quaternion', Documentation:"Angular Position is in dimensionless units. The axes are given in quaternion form where A, B, C, D represent the real, i, j, and k coefficients."},
     {name:"angularPosB",    size:2, cType:'int16_t'},
     {name:"angularPosC",    size:2, cType:'int16_t'},
     {name:"angularPosD",    size:2, cType:'int16_t'}
@@ -243,7 +244,7 @@ BodyUserFrameMessage.Fields[2] = [
     {name:"linearPosX",     size:2, cType:'int16_t', Documentation:"Linear Offset is in units of meters. X positive is right. Y positive is near. Z positive is down wrt the user frame of reference."},
     {name:"linearPosY",     size:2, cType:'int16_t'},
     {name:"linearPosZ",     size:2, cType:'int16_t'},
-    {name:"angularPosB",    size:2, cType:'int16_t', Documentation:"Angular Position is in dimensionless units. The axes are given in quaternion form where A, B, C, D represent the real, i, j, and k coefficients."},
+    {name:"angularPosB",    size:2, cType:'int16_t', packing:'quaternion', Documentation:"Angular Position is in dimensionless units. The axes are given in quaternion form where A, B, C, D represent the real, i, j, and k coefficients."},
     {name:"angularPosC",    size:2, cType:'int16_t'},
     {name:"angularPosD",    size:2, cType:'int16_t'},
     {name:"angularPosA",    size:2, cType:'int16_t'}
@@ -274,7 +275,7 @@ MotionEngineOutput.Fields[2] = [
         {name:'ff6', Documentation:"Format flag 6. " + MEFORMATFLAG_BLURB}, \
         {name:'ff7', Documentation:"Format flag 7. " + MEFORMATFLAG_BLURB} ]},
     {name:"sequenceNumber", size:4, cType:'uint32_t', Documentation:"Report sequence number. Increments monotonically."},
-    {name:"meData",         size:44, cType:'uint8_t', Documentation:"MotionEngine Output data."}
+    {name:"meData",         size:44, cType:'uint8_t', packing:'int16', Documentation:"MotionEngine Output data."}
 
 ]
 
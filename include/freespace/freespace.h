@@ -21,6 +21,8 @@
 #include "freespace/freespace_common.h"
 #include "freespace/freespace_codecs.h"
 
+#include <stddef.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -148,6 +150,26 @@ typedef void (*freespace_receiveMessageCallback)(FreespaceDeviceId id,
                                                  void* cookie,
                                                  int result);
 
+/** @ingroup async
+ * A received report held in one of the library's receive buffers.
+ */
+struct FreespaceBuffer;
+
+/** @ingroup async
+ * Callback for received Freespace events lent in the library's buffer.
+ * The buffer stays valid until the callback returns unless it is
+ * retained with freespace_bufferRetain().
+ *
+ * @param id The device that generated the message
+ * @param buffer the buffer holding the HID message or NULL on error
+ * @param cookie the data passed to freespace_setReceiveBufferCallback().
+ * @param result FREESPACE_SUCCESS if a packet was received; else error code
+ */
+typedef void (*freespace_receiveBufferCallback)(FreespaceDeviceId id,
+                                                struct FreespaceBuffer* buffer,
+                                                void* cookie,
+                                                int result);
+
 /** @ingroup async
  * Callback for when file descriptors should be added to the
  * poll or select fd sets
@@ -166,14 +188,577 @@ typedef void (*freespace_pollfdAddedCallback)(FreespaceFileHandleType fd, short
  */
 typedef void (*freespace_pollfdRemovedCallback)(FreespaceFileHandleType fd);
 
+/** @ingroup async
+ * Callback for getting notified when an asynchronous open completes.
+ *
+ * @param id the device that was opened
+ * @param cookie the data passed to freespace_openDeviceAsync() or
+ *               freespace_openAllDevicesAsync()
+ * @param result FREESPACE_SUCCESS if the device is open; else error code
+ */
+typedef void (*freespace_openCallback)(FreespaceDeviceId id, void* cookie, int result);
+
+/** @ingroup initialization
+ * Function used by the library to allocate memory.
+ *
+ * @param size the number of bytes needed
+ * @param context the data passed to freespace_setAllocator()
+ * @return the memory or NULL if none is available
+ */
+typedef void* (*freespace_mallocFunction)(size_t size, void* context);
+
+/** @ingroup initialization
+ * Function used by the library to free memory from its
+ * freespace_mallocFunction.
+ *
+ * @param ptr the memory to free
+ * @param context the data passed to freespace_setAllocator()
+ */
+typedef void (*freespace_freeFunction)(void* ptr, void* context);
+
+/** @ingroup initialization
+ *
+ * Make the library allocate its memory with the given functions, such
+ * as from an arena, instead of malloc and free. This must be called
+ * before freespace_init() or after freespace_exit().
+ *
+ * Once devices are open the library does not allocate while receiving or
+ * sending; device structures, open requests and buffer pools are only
+ * allocated when devices appear or are opened. Building with
+ * LIBFREESPACE_ALLOCATION_ASSERTS makes any allocation while servicing
+ * open devices abort the process.
+ *
+ * @param mallocFn the allocation function or NULL for malloc
+ * @param freeFn the matching free function or NULL for free
+ * @param context any user data passed to both functions
+ * @return FREESPACE_SUCCESS, or FREESPACE_ERROR_BUSY if memory from the
+ *         previous allocator has not been freed yet
+ */
+LIBFREESPACE_API int freespace_setAllocator(freespace_mallocFunction mallocFn,
+                                            freespace_freeFunction freeFn,
+                                            void* context);
+
+/** @ingroup initialization
+ * Severity of a log message. A subsystem logs the messages at or
+ * below its level.
+ */
+enum FreespaceLogLevel {
+    FREESPACE_LOG_LEVEL_OFF = 0,
+    FREESPACE_LOG_LEVEL_WARN = 1,
+    FREESPACE_LOG_LEVEL_DEBUG = 2,
+    FREESPACE_LOG_LEVEL_TRACE = 3
+};
+
+/** @ingroup initialization
+ * Parts of the library whose log levels are set separately.
+ */
+enum FreespaceLogSubsystem {
+    /** Pass to freespace_setLogLevel() to set every subsystem */
+    FREESPACE_LOG_ALL = -1,
+    /** Opening, closing, reading and writing devices */
+    FREESPACE_LOG_BACKEND = 0,
+    /** Devices appearing and disappearing */
+    FREESPACE_LOG_HOTPLUG = 1,
+    /** Encoding and decoding messages */
+    FREESPACE_LOG_CODECS = 2,
+    FREESPACE_LOG_SUBSYSTEM_COUNT = 3
+};
+
+/** @ingroup initialization
+ * Callback for log messages.
+ *
+ * @param subsystem the FreespaceLogSubsystem that logged the message
+ * @param level the FreespaceLogLevel of the message
+ * @param message the message, without a trailing newline
+ * @param cookie the data passed to freespace_setLogCallback()
+ */
+typedef void (*freespace_logCallback)(int subsystem, int level, const char* message, void* cookie);
+
+/** @ingroup initialization
+ *
+ * Set where log messages go. By default they are written to stderr.
+ * Unless freespace_setLogAsync() is used, the callback is called on the
+ * thread that logged the message, which may be a library thread.
+ *
+ * @param callback the callback function or NULL for stderr
+ * @param cookie any user data
+ * @return FREESPACE_SUCCESS
+ */
+LIBFREESPACE_API int freespace_setLogCallback(freespace_logCallback callback, void* cookie);
+
+/** @ingroup initialization
+ *
+ * Set how much a subsystem logs. All subsystems start at
+ * FREESPACE_LOG_LEVEL_OFF, where logging costs a single check.
+ *
+ * @param subsystem a FreespaceLogSubsystem or FREESPACE_LOG_ALL
+ * @param level a FreespaceLogLevel
+ * @return FREESPACE_SUCCESS or an error
+ */
+LIBFREESPACE_API int freespace_setLogLevel(int subsystem, int level);
+
+/** @ingroup initialization
+ *
+ * Queue log messages in a fixed ring instead of calling the log callback
+ * on the thread that logged them. Logging then never blocks, so trace
+ * logging can stay on without stalling receives; messages that do not
+ * fit are counted and reported as dropped. Enable this before
+ * freespace_init().
+ *
+ * @param enable nonzero to queue messages, 0 to go back to calling the
+ *               callback directly, which first drains the queue
+ * @return FREESPACE_SUCCESS
+ */
+LIBFREESPACE_API int freespace_setLogAsync(int enable);
+
+/** @ingroup initialization
+ *
+ * Pass the queued log messages to the log callback. Call this
+ * periodically from one thread, typically a low priority one, when
+ * freespace_setLogAsync() is enabled.
+ *
+ * @return the number of messages passed to the callback
+ */
+LIBFREESPACE_API int freespace_drainLog();
+
+/** @ingroup initialization
+ *
+ * Start recording a timeline of library activity: reports arriving,
+ * decoding, receive callbacks, sends, hotplug scans and device opens
+ * and closes, each with its thread and device. The newest events are
+ * kept in a ring in memory until written with freespace_traceWrite().
+ *
+ * @param capacity the number of events to keep
+ * @return FREESPACE_SUCCESS or an error
+ */
+LIBFREESPACE_API int freespace_traceStart(int capacity);
+
+/** @ingroup initialization
+ *
+ * Stop recording. The recorded events are kept. Returns once no other
+ * thread is still recording an event.
+ */
+LIBFREESPACE_API void freespace_traceStop();
+
+/** @ingroup initialization
+ *
+ * Free the recorded events. Does nothing while recording. Other threads
+ * may keep calling into the library, but not freespace_traceStart() or
+ * freespace_traceWrite().
+ */
+LIBFREESPACE_API void freespace_traceClear();
+
 /** @ingroup initialization
  *
- * Initialize the Freespace library.
+ * Write the recorded events in the Chrome Trace Event JSON format, which
+ * chrome://tracing and the Perfetto UI open directly. Recording may
+ * continue while this runs.
+ *
+ * @param path the file to write
+ * @return FREESPACE_SUCCESS, FREESPACE_ERROR_NO_DATA if nothing was
+ *         recorded, or FREESPACE_ERROR_IO
+ */
+LIBFREESPACE_API int freespace_traceWrite(const char* path);
+
+/** @ingroup initialization
+ * Direction of a captured report.
+ */
+enum FreespaceRecordDirection {
+    /** Received from the device */
+    FREESPACE_RECORD_INBOUND = 0,
+    /** Sent to the device */
+    FREESPACE_RECORD_OUTBOUND = 1
+};
+
+/** @ingroup initialization
+ *
+ * Start capturing every raw report sent to or received from any device
+ * to a binary file, with its device, HID protocol version, direction
+ * and a nanosecond timestamp. Reports are written a 64 KiB chunk at a
+ * time, so the capture is cheap enough to leave running for hours.
+ * The file starts with the message definitions of this library, so
+ * freespace_schemaDecode() can read it after the definitions change.
+ * Only one capture runs at a time.
+ *
+ * @param path the file to create
+ * @return FREESPACE_SUCCESS, FREESPACE_ERROR_BUSY if already capturing,
+ *         or FREESPACE_ERROR_IO
+ */
+LIBFREESPACE_API int freespace_recorderStart(const char* path);
+
+/** @ingroup initialization
+ *
+ * Like freespace_recorderStart() but the reports are packed: each one
+ * is stored as the bit packed differences from the previous report of
+ * the same device and message type, with sensor fields taken as 16 bit
+ * values and quaternions in a smallest-three form. Packing is lossless
+ * and is most effective on steady streams of motion reports. The
+ * field layout comes from the embedded message definitions, so any
+ * later library can unpack the capture.
+ *
+ * @param path the file to create
+ * @return FREESPACE_SUCCESS, FREESPACE_ERROR_BUSY if already capturing,
+ *         or FREESPACE_ERROR_IO
+ */
+LIBFREESPACE_API int freespace_recorderStartPacked(const char* path);
+
+/** @ingroup initialization
+ *
+ * Stop capturing and write the index that lets freespace_recordingOpen()
+ * find reports without reading the whole file. freespace_exit() stops
+ * a running capture.
+ *
+ * @return FREESPACE_SUCCESS, FREESPACE_ERROR_NO_DATA if not capturing,
+ *         or FREESPACE_ERROR_IO if any part of the capture failed to write
+ */
+LIBFREESPACE_API int freespace_recorderStop();
+
+/** @ingroup initialization
+ * A capture file opened for reading.
+ */
+struct FreespaceRecording;
+
+/** @ingroup initialization
+ * One report read from a capture file.
+ */
+struct FreespaceRecordedReport {
+    /** Position of the report in the capture, starting from 0 */
+    uint64_t sequence;
+    /** Wall clock time in nanoseconds since 1970 */
+    uint64_t timestampNs;
+    FreespaceDeviceId id;
+    /** HID protocol version of the device */
+    int hVer;
+    /** A FreespaceRecordDirection */
+    int direction;
+    int length;
+    /**
+     * The raw report. Valid until the recording is closed, or for a
+     * packed capture until the next read or seek.
+     */
+    const uint8_t* data;
+};
+
+/** @ingroup initialization
+ *
+ * Map a capture file for reading. Only the index is looked at, so
+ * opening is fast whatever the size of the file. A capture that was
+ * not stopped cleanly is readable up to its last complete chunk.
+ *
+ * @param path the file written by freespace_recorderStart()
+ * @param recording set to the opened recording
+ * @return FREESPACE_SUCCESS, FREESPACE_ERROR_NOT_FOUND,
+ *         FREESPACE_ERROR_MALFORMED_MESSAGE if it is not a capture file,
+ *         or another error
+ */
+LIBFREESPACE_API int freespace_recordingOpen(const char* path, struct FreespaceRecording** recording);
+
+/** @ingroup initialization
+ *
+ * Unmap a capture file.
+ */
+LIBFREESPACE_API void freespace_recordingClose(struct FreespaceRecording* recording);
+
+/** @ingroup initialization
+ *
+ * @return the number of reports in the capture
+ */
+LIBFREESPACE_API uint64_t freespace_recordingCount(struct FreespaceRecording* recording);
+
+/** @ingroup initialization
+ *
+ * Read a report by its sequence number. Reading in order is the
+ * fastest; any other report is found through the index.
+ *
+ * @param recording the opened capture
+ * @param sequence the report to read
+ * @param report filled in with the report
+ * @return FREESPACE_SUCCESS, FREESPACE_ERROR_NO_DATA past the end, or
+ *         FREESPACE_ERROR_MALFORMED_MESSAGE if the file is damaged
+ */
+LIBFREESPACE_API int freespace_recordingRead(struct FreespaceRecording* recording,
+                                             uint64_t sequence,
+                                             struct FreespaceRecordedReport* report);
+
+/** @ingroup initialization
+ *
+ * Find the first report at or after a time.
+ *
+ * @param recording the opened capture
+ * @param timestampNs wall clock time in nanoseconds since 1970
+ * @param sequence set to the sequence number of the report
+ * @return FREESPACE_SUCCESS or FREESPACE_ERROR_NO_DATA if every report
+ *         is earlier
+ */
+LIBFREESPACE_API int freespace_recordingSeek(struct FreespaceRecording* recording,
+                                             uint64_t timestampNs,
+                                             uint64_t* sequence);
+
+/** @ingroup initialization
+ * Message definitions loaded from a binary schema, such as the one a
+ * capture carries or the one from freespace_message_schema().
+ */
+struct FreespaceSchema;
+
+/** @ingroup initialization
+ * One field decoded through a schema.
+ */
+struct FreespaceSchemaField {
+    /** The field name from the message definitions */
+    const char* name;
+    /** The element for array fields, otherwise 0 */
+    int index;
+    int64_t value;
+};
+
+/** @ingroup initialization
+ *
+ * Get the message definitions of the library that wrote a capture.
+ * Captures from before schemas were embedded give the definitions of
+ * this library instead.
+ *
+ * @param recording the opened capture
+ * @return the schema, valid until the recording is closed
+ */
+LIBFREESPACE_API const struct FreespaceSchema* freespace_recordingSchema(struct FreespaceRecording* recording);
+
+/** @ingroup initialization
+ *
+ * Load a binary schema. The bytes are copied.
+ *
+ * @param blob the schema
+ * @param length the size of the schema in bytes
+ * @param schema set to the loaded schema
+ * @return FREESPACE_SUCCESS, FREESPACE_ERROR_MALFORMED_MESSAGE or
+ *         FREESPACE_ERROR_OUT_OF_MEMORY
+ */
+LIBFREESPACE_API int freespace_schemaOpen(const uint8_t* blob, int length, struct FreespaceSchema** schema);
+
+/** @ingroup initialization
+ *
+ * Free a schema loaded by freespace_schemaOpen().
+ */
+LIBFREESPACE_API void freespace_schemaClose(struct FreespaceSchema* schema);
+
+/** @ingroup initialization
+ *
+ * Decode a report with a schema instead of the compiled in codecs.
+ * Reserved bytes are skipped; array elements are one field each.
+ *
+ * @param schema the message definitions
+ * @param report the raw report
+ * @param length the length of the report
+ * @param hVer the HID protocol version of the device
+ * @param direction a FreespaceRecordDirection
+ * @param messageName set to the message name if not NULL
+ * @param fields filled in with up to maxFields fields
+ * @param maxFields the size of fields
+ * @return the number of fields in the message, which may be more than
+ *         maxFields, or FREESPACE_ERROR_MALFORMED_MESSAGE if the schema
+ *         does not define the report
+ */
+LIBFREESPACE_API int freespace_schemaDecode(const struct FreespaceSchema* schema,
+                                            const uint8_t* report,
+                                            int length,
+                                            int hVer,
+                                            int direction,
+                                            const char** messageName,
+                                            struct FreespaceSchemaField* fields,
+                                            int maxFields);
+
+/** @ingroup initialization
+ *
+ * Publish every report received from any device to other processes.
+ * Each device gets a shared memory ring named after the publisher and
+ * the device id. The ring holds the raw report, the report decoded
+ * into a struct freespace_message, and the message schema of this
+ * library. A ring is created with the first report from its device.
+ * Only one publisher runs in a process.
+ *
+ * @param name the publisher name readers use, without slashes
+ * @param slotCount reports each ring holds, a power of two, or 0 for
+ *        the default of 1024
+ * @return FREESPACE_SUCCESS, FREESPACE_ERROR_BUSY if already
+ *         publishing, FREESPACE_ERROR_UNEXPECTED for a bad argument, or
+ *         FREESPACE_ERROR_UINIMPLEMENTED on Android
+ */
+LIBFREESPACE_API int freespace_publisherStart(const char* name, int slotCount);
+
+/** @ingroup initialization
+ *
+ * Stop publishing and remove the rings. Readers that have a ring open
+ * keep it, and freespace_sharedNext() reports the end.
+ *
+ * @return FREESPACE_SUCCESS or FREESPACE_ERROR_NO_DATA if not publishing
+ */
+LIBFREESPACE_API int freespace_publisherStop();
+
+/** @ingroup initialization
+ * One device's ring from another process's publisher, opened for
+ * reading.
+ */
+struct FreespaceSharedStream;
+
+/** @ingroup initialization
+ * A report read from a shared ring. The pointers are into the shared
+ * memory and stay valid until the stream is closed, but the publisher
+ * may overwrite the report once the reader falls a ring behind; check
+ * freespace_sharedValid() after using it.
+ */
+struct FreespaceSharedReport {
+    /** Position in the ring's stream of reports, wrapping at 2^32 */
+    uint32_t sequence;
+    /** Reports overwritten before they could be read since the last one */
+    uint32_t dropped;
+    /** Monotonic clock time in nanoseconds when it was published */
+    uint64_t timestampNs;
+    FreespaceDeviceId id;
+    /** HID protocol version of the device */
+    int hVer;
+    int length;
+    /** The raw report */
+    const uint8_t* data;
+    /**
+     * The decoded report, or NULL if it did not decode or the publisher
+     * was built with a different struct freespace_message. The raw
+     * report can then be read with freespace_schemaDecode() and
+     * freespace_sharedSchema().
+     */
+    const struct freespace_message* message;
+};
+
+/** @ingroup initialization
+ *
+ * Open a device's ring from a publisher. Reading starts with the next
+ * report published.
+ *
+ * @param name the name given to freespace_publisherStart()
+ * @param id the device id in the publishing process
+ * @param stream set to the opened stream
+ * @return FREESPACE_SUCCESS, FREESPACE_ERROR_NOT_FOUND if there is no
+ *         such ring (yet), or another error
+ */
+LIBFREESPACE_API int freespace_sharedOpen(const char* name, FreespaceDeviceId id, struct FreespaceSharedStream** stream);
+
+/** @ingroup initialization
+ *
+ * Close a stream opened by freespace_sharedOpen().
+ */
+LIBFREESPACE_API void freespace_sharedClose(struct FreespaceSharedStream* stream);
+
+/** @ingroup initialization
+ *
+ * Get the next report without copying it or making a system call. A
+ * reader that falls behind skips to the oldest report still in the
+ * ring and is told how many it missed.
+ *
+ * @param stream the opened stream
+ * @param report filled in with the report
+ * @return FREESPACE_SUCCESS, FREESPACE_ERROR_NO_DATA if nothing new has
+ *         been published, or FREESPACE_ERROR_NO_DEVICE if the publisher
+ *         has stopped
+ */
+LIBFREESPACE_API int freespace_sharedNext(struct FreespaceSharedStream* stream, struct FreespaceSharedReport* report);
+
+/** @ingroup initialization
+ *
+ * Check that the report from the last freespace_sharedNext() was not
+ * overwritten while it was being used. Anything read from it should be
+ * thrown away if it was.
+ *
+ * @return FREESPACE_SUCCESS or FREESPACE_ERROR_NO_DATA if overwritten
+ */
+LIBFREESPACE_API int freespace_sharedValid(struct FreespaceSharedStream* stream);
+
+/** @ingroup initialization
+ *
+ * @return the message definitions of the publishing library, valid
+ *         until the stream is closed
+ */
+LIBFREESPACE_API const struct FreespaceSchema* freespace_sharedSchema(struct FreespaceSharedStream* stream);
+
+/** @ingroup initialization
+ *
+ * Initialize the Freespace library. On Linux, the backend is picked
+ * as described for FreespaceInitOptions::backend.
  *
  * @return FREESPACE_SUCCESS on success
  */
 LIBFREESPACE_API int freespace_init();
 
+/** @ingroup initialization
+ *
+ * Options for freespace_initWithOptions(). A zeroed structure gives
+ * the same behavior as freespace_init().
+ */
+struct FreespaceInitOptions {
+    /**
+     * Nonzero to receive on a thread owned by the library. Receive,
+     * hotplug and file descriptor callbacks then run on that thread and
+     * the application must not call freespace_perform,
+     * freespace_performBudget or freespace_setFileDescriptorCallbacks.
+     * Other calls made outside of callbacks must be bracketed by
+     * freespace_lock() and freespace_unlock().
+     */
+    int receiveThread;
+
+    /**
+     * SCHED_FIFO priority of the receive thread (1-99). 0 keeps the
+     * default scheduler. Raising the priority usually requires
+     * CAP_SYS_NICE.
+     */
+    int schedPriority;
+
+    /**
+     * Bit mask of the CPUs the receive thread may run on. Bit 0 is CPU 0.
+     * 0 does not restrict the thread.
+     */
+    unsigned long cpuMask;
+
+    /**
+     * Nonzero to spin checking for reports instead of sleeping in poll.
+     * This trades a CPU for wakeup latency and is best combined with
+     * cpuMask.
+     */
+    int busyPoll;
+
+    /**
+     * Comma separated backends to try, such as "hidraw,libusb". When
+     * more than one is built in and named, the first that can open a
+     * device now is used. NULL uses the FREESPACE_BACKEND environment
+     * variable, or else the order the library was configured with.
+     * Ignored on Windows.
+     */
+    const char* backend;
+};
+
+/** @ingroup initialization
+ *
+ * Initialize the Freespace library with options. The receive thread,
+ * if requested, is started here and stopped by freespace_exit(). Its
+ * stack is allocated and touched up front so that it does not fault
+ * after the application calls mlockall.
+ *
+ * @param options the options, or NULL for the defaults
+ * @return FREESPACE_SUCCESS on success. FREESPACE_ERROR_ACCESS if the
+ *         scheduling priority could not be set.
+ */
+LIBFREESPACE_API int freespace_initWithOptions(const struct FreespaceInitOptions* options);
+
+/** @ingroup initialization
+ *
+ * Keep the receive thread from running callbacks until freespace_unlock()
+ * is called. Calls may be nested. This does nothing if no receive thread
+ * is running.
+ */
+LIBFREESPACE_API void freespace_lock();
+
+/** @ingroup initialization
+ *
+ * Release the lock taken by freespace_lock().
+ */
+LIBFREESPACE_API void freespace_unlock();
+
 /** @ingroup initialization
  *
  * Return a human readable string with the version of libfreespace
@@ -183,6 +768,15 @@ LIBFREESPACE_API int freespace_init();
  */
 LIBFREESPACE_API const char* freespace_version();
 
+/** @ingroup initialization
+ *
+ * Return the name of the backend picked by freespace_init(), such as
+ * "hidraw" or "libusb".
+ *
+ * @return the name, or NULL if the library is not initialized
+ */
+LIBFREESPACE_API const char* freespace_backendName();
+
 /** @ingroup initialization
  *
  * Finalize the Freespace library.
@@ -246,6 +840,38 @@ LIBFREESPACE_API int freespace_getDeviceInfo(FreespaceDeviceId id,
  */
 LIBFREESPACE_API int freespace_openDevice(FreespaceDeviceId id);
 
+/** @ingroup async
+ *
+ * Open a Freespace device without blocking. The open is performed on a
+ * background thread and the callback is called from freespace_perform
+ * once it completes. If the device is already open, the callback is
+ * called before this function returns.
+ *
+ * @param id The FreespaceDeviceID of an attached device to open
+ * @param callback the function to call when the open completes
+ * @param cookie passed to the callback
+ * @return FREESPACE_SUCCESS if the open was started
+ */
+LIBFREESPACE_API int freespace_openDeviceAsync(FreespaceDeviceId id,
+                                               freespace_openCallback callback,
+                                               void* cookie);
+
+/** @ingroup async
+ *
+ * Probe and open every attached Freespace device in parallel. The
+ * callback is called from freespace_perform for each device as soon as
+ * it is ready, so the first device can be used while the others are
+ * still being opened. Devices are also reported through the hotplug
+ * callback as usual. Devices that are already open are not reported
+ * again.
+ *
+ * @param callback the function to call as each device is opened
+ * @param cookie passed to the callback
+ * @return FREESPACE_SUCCESS if the scan was started
+ */
+LIBFREESPACE_API int freespace_openAllDevicesAsync(freespace_openCallback callback,
+                                                   void* cookie);
+
 /** @ingroup synchronous
  *
  * Send a message to the specified Freespace device synchronously.
@@ -348,6 +974,102 @@ LIBFREESPACE_API int freespace_setReceiveMessageCallback(FreespaceDeviceId id,
                                                          freespace_receiveMessageCallback callback,
                                                          void* cookie);
 
+/** @ingroup async
+ *
+ * Register a callback function for one message type. Reports of other
+ * types are not decoded on its account, so this is cheaper than
+ * filtering in the callback given to freespace_setReceiveMessageCallback
+ * when the device sends many types that are not used. Reports of a
+ * subscribed type go only to their subscriber. Subscriptions are removed
+ * when the device is closed.
+ *
+ * @param id the FreespaceDeviceId of the device
+ * @param messageType the MessageTypes value, such as
+ *                    FREESPACE_MESSAGE_BODYFRAME
+ * @param callback the callback function or NULL to unsubscribe
+ * @param cookie any user data
+ * @return FREESPACE_SUCCESS or an error
+ */
+LIBFREESPACE_API int freespace_subscribe(FreespaceDeviceId id,
+                                         int messageType,
+                                         freespace_receiveMessageCallback callback,
+                                         void* cookie);
+
+/** @ingroup async
+ *
+ * Subscribe to MotionEngine Output for the fields that will be used,
+ * and have the device send just those. The smallest format and format
+ * flags that carry the fields are chosen with
+ * freespace_util_chooseFormat() and sent in a DataModeControlV2Request,
+ * leaving the operating mode as it is. The request is sent again
+ * whenever the subscription changes. Unsubscribing turns off the
+ * sections that were turned on. The device's response is checked, and
+ * a request that is not taken is retried a few times.
+ *
+ * @param id the FreespaceDeviceId of the device
+ * @param fields the FreespaceMEOutputField values from freespace_util.h
+ *               that will be read, ORed together
+ * @param callback the callback function, which is passed the
+ *                 MotionEngineOutput messages, or NULL to unsubscribe
+ * @param cookie any user data
+ * @return FREESPACE_SUCCESS, FREESPACE_ERROR_UNEXPECTED if no single
+ *         format carries all of the fields, or another error
+ */
+LIBFREESPACE_API int freespace_subscribeMotionEngine(FreespaceDeviceId id,
+                                                     int fields,
+                                                     freespace_receiveMessageCallback callback,
+                                                     void* cookie);
+
+/** @ingroup async
+ *
+ * Register a callback function that is lent the buffer each HID message
+ * was received into. Retaining the buffer lets another thread process
+ * the report without copying it. The library swaps a fresh buffer in
+ * for the next receive.
+ *
+ * @param id the FreespaceDeviceId of the device
+ * @param callback the callback function
+ * @param cookie any user data
+ * @return FREESPACE_SUCCESS or an error
+ */
+LIBFREESPACE_API int freespace_setReceiveBufferCallback(FreespaceDeviceId id,
+                                                        freespace_receiveBufferCallback callback,
+                                                        void* cookie);
+
+/** @ingroup async
+ *
+ * @param buffer a buffer passed to a freespace_receiveBufferCallback
+ * @return the HID message held in the buffer
+ */
+LIBFREESPACE_API const uint8_t* freespace_bufferData(const struct FreespaceBuffer* buffer);
+
+/** @ingroup async
+ *
+ * @param buffer a buffer passed to a freespace_receiveBufferCallback
+ * @return the length of the HID message held in the buffer
+ */
+LIBFREESPACE_API int freespace_bufferLength(const struct FreespaceBuffer* buffer);
+
+/** @ingroup async
+ *
+ * Keep a buffer after the receive buffer callback returns. Each retain
+ * must be matched by a call to freespace_bufferRelease(), which may be
+ * made from any thread. All buffers must be released before
+ * freespace_exit().
+ *
+ * @param buffer a buffer passed to a freespace_receiveBufferCallback
+ */
+LIBFREESPACE_API void freespace_bufferRetain(struct FreespaceBuffer* buffer);
+
+/** @ingroup async
+ *
+ * Give up a reference to a buffer. The buffer returns to the library
+ * once the last reference is released.
+ *
+ * @param buffer a retained buffer
+ */
+LIBFREESPACE_API void freespace_bufferRelease(struct FreespaceBuffer* buffer);
+
 /** @ingroup async
  *
  * Send a message to the specified Freespace device, but do not block.
@@ -386,6 +1108,332 @@ LIBFREESPACE_API int freespace_sendMessageAsync(FreespaceDeviceId id,
                                                 freespace_sendCallback callback,
                                                 void* cookie);
 
+/** @ingroup async
+ * Callback for a request made with freespace_request().
+ *
+ * @param id the device the request was sent to
+ * @param response the decoded response, valid until the callback
+ *                 returns, or NULL if the request failed
+ * @param cookie the data passed to freespace_request()
+ * @param result FREESPACE_SUCCESS, FREESPACE_ERROR_TIMEOUT if no response
+ *               came in time, FREESPACE_ERROR_NO_DEVICE if the device was
+ *               closed, or the error from sending the request
+ */
+typedef void (*freespace_requestCallback)(FreespaceDeviceId id,
+                                          struct freespace_message* response,
+                                          void* cookie,
+                                          int result);
+
+// The number of requests that may be waiting on each open device
+#define FREESPACE_REQUEST_POOL_SIZE 16
+
+/** @ingroup async
+ *
+ * Send a request and wait for its response without blocking, for example
+ * a DataModeControlV2Request answered by a DataModeControlV2Response, or
+ * a BatteryLevelRequest answered by a BatteryLevel. The request is sent
+ * from the next call to freespace_perform(). The first report of the
+ * expected type from the device completes the oldest request waiting for
+ * it, and is not passed on to the receive callbacks; everything else the
+ * device sends meanwhile is delivered as usual. Up to
+ * FREESPACE_REQUEST_POOL_SIZE requests may be waiting on each open
+ * device, and freespace_getNextTimeout() accounts for their timeouts.
+ * They come from a pool set aside when the device is opened, so this
+ * never allocates and may be called from any callback.
+ *
+ * @param id the device to send the request to
+ * @param request the message to send, which is copied
+ * @param expectedResponseType the FREESPACE_MESSAGE_* type of the response
+ * @param timeoutMs how long to wait for the response, from now
+ * @param callback the function to call with the response
+ * @param cookie passed to the callback
+ * @return FREESPACE_SUCCESS if the request was queued,
+ *         FREESPACE_ERROR_BUSY if the device already has
+ *         FREESPACE_REQUEST_POOL_SIZE requests waiting, or another error
+ */
+LIBFREESPACE_API int freespace_request(FreespaceDeviceId id,
+                                       struct freespace_message* request,
+                                       int expectedResponseType,
+                                       unsigned int timeoutMs,
+                                       freespace_requestCallback callback,
+                                       void* cookie);
+
+/** @ingroup async
+ * The most sensor periods a FreespaceConfigProfile can set.
+ */
+#define FREESPACE_CONFIG_MAX_SENSORS 8
+
+/** @ingroup async
+ * The parts of a FreespaceConfigProfile to apply, ORed together.
+ */
+enum FreespaceConfigPart {
+    /** Operating mode, packet and format select and format flags */
+    FREESPACE_CONFIG_DATA_MODE = 0x01,
+    /** Sensor periods */
+    FREESPACE_CONFIG_SENSOR_PERIODS = 0x02,
+    /** Reorientation quaternion */
+    FREESPACE_CONFIG_REORIENTATION = 0x04,
+    /** Button motion suppression */
+    FREESPACE_CONFIG_BMS = 0x08
+};
+
+/** @ingroup async
+ * A device configuration for freespace_configureAsync().
+ */
+struct FreespaceConfigProfile {
+    /** The FreespaceConfigPart bits of the parts to apply */
+    int parts;
+    /** The DataModeControlV2Request operating mode */
+    int mode;
+    /** The DataModeControlV2Request packet select */
+    uint8_t packetSelect;
+    /** The DataModeControlV2Request format select */
+    uint8_t formatSelect;
+    /** The DataModeControlV2Request format flags, bit n for ffn */
+    uint8_t formatFlags;
+    /** The number of entries used in sensors */
+    int sensorCount;
+    /** The SensorPeriodRequest sensor IDs and periods */
+    struct {
+        uint8_t sensor;
+        uint32_t period;
+    } sensors[FREESPACE_CONFIG_MAX_SENSORS];
+    /** The ReorientationRequest quaternion, W, X, Y and Z */
+    uint16_t reorientation[4];
+    /** The BmsRequest value */
+    uint8_t bmsRequest;
+};
+
+/** @ingroup async
+ * Callback for a completed freespace_configureAsync().
+ *
+ * @param ids the devices passed to freespace_configureAsync()
+ * @param results the result for each device: FREESPACE_SUCCESS,
+ *                FREESPACE_ERROR_UNEXPECTED if the device reported a
+ *                setting other than the one sent, or the error from its
+ *                requests
+ * @param count the number of devices
+ * @param cookie the data passed to freespace_configureAsync()
+ */
+typedef void (*freespace_configCallback)(const FreespaceDeviceId* ids,
+                                         const int* results,
+                                         int count,
+                                         void* cookie);
+
+/** @ingroup async
+ *
+ * Apply a profile to several devices at once. Each device is configured
+ * independently with freespace_request(): the data mode and sensor
+ * periods in effect are read, the new ones are sent and the responses
+ * checked against the profile, then the reorientation and BMS requests,
+ * which have no response, are sent. If any step fails, the data mode and
+ * sensor periods already sent to that device are put back as they were.
+ * The callback is called once from freespace_perform(), when every
+ * device is done.
+ *
+ * @param ids the devices to configure
+ * @param count the number of devices
+ * @param profile the configuration, which is copied
+ * @param timeoutMs how long to wait for each response
+ * @param callback the function called with the results
+ * @param cookie passed to the callback
+ * @return FREESPACE_SUCCESS if the configuration was started, in which
+ *         case the callback will be called, or an error
+ */
+LIBFREESPACE_API int freespace_configureAsync(const FreespaceDeviceId* ids,
+                                              int count,
+                                              const struct FreespaceConfigProfile* profile,
+                                              unsigned int timeoutMs,
+                                              freespace_configCallback callback,
+                                              void* cookie);
+
+/** @ingroup async
+ * Which flash an hVer 1 device reads a record from. OR one into the
+ * record type given to freespace_frsReadAsync(). Version 2 devices have
+ * a single flash and ignore it.
+ */
+enum FreespaceFRSTarget {
+    /** The handheld, which is the default */
+    FREESPACE_FRS_HANDHELD = 0,
+    /** The dongle itself */
+    FREESPACE_FRS_DONGLE = 0x10000,
+    /** The dongle's external flash */
+    FREESPACE_FRS_EFLASH = 0x20000
+};
+
+/** @ingroup async
+ * Callback for a completed flash record read.
+ *
+ * @param id the device the record was read from
+ * @param frsType the record type passed to freespace_frsReadAsync()
+ * @param words the record, valid until the callback returns
+ * @param wordCount the number of 32-bit words in the record, 0 if it is empty
+ * @param cookie the data passed to freespace_frsReadAsync()
+ * @param result FREESPACE_SUCCESS, FREESPACE_ERROR_NOT_FOUND if the device
+ *               does not know the record type, FREESPACE_ERROR_TIMEOUT if
+ *               the device stopped answering, or another error
+ */
+typedef void (*freespace_frsReadCallback)(FreespaceDeviceId id,
+                                          int frsType,
+                                          const uint32_t* words,
+                                          int wordCount,
+                                          void* cookie,
+                                          int result);
+
+/** @ingroup async
+ *
+ * Read a flash record (FRS) from a device without blocking. The record is
+ * requested in blocks using the read request that matches the device's
+ * HID protocol version. Responses are reassembled by word offset, busy
+ * answers are retried and words that never arrive are asked for again.
+ * The responses are not passed to the receive callbacks or subscriptions.
+ * Progress is made by freespace_perform(), which must be called when
+ * freespace_getNextTimeout() says so. One record is read from a device at
+ * a time. Closing the device ends the read with FREESPACE_ERROR_NO_DEVICE.
+ *
+ * @param id the FreespaceDeviceId of the device
+ * @param frsType the record type, optionally ORed with a FreespaceFRSTarget
+ * @param callback called once with the record or an error
+ * @param cookie any user data
+ * @return FREESPACE_SUCCESS, FREESPACE_ERROR_BUSY if a read is already in
+ *         progress on the device, or an error
+ */
+LIBFREESPACE_API int freespace_frsReadAsync(FreespaceDeviceId id,
+                                            int frsType,
+                                            freespace_frsReadCallback callback,
+                                            void* cookie);
+
+/** @ingroup async
+ *
+ * Set how records are requested by freespace_frsReadAsync(). The next
+ * block is requested as soon as one completes; devices that queue read
+ * requests can be kept busier by having more than one in flight. The
+ * default is one block of 32 words.
+ *
+ * @param blockWords the number of words asked for by each request
+ * @param blocksInFlight the number of requests outstanding at once, 1 to 8
+ * @return FREESPACE_SUCCESS, FREESPACE_ERROR_BUSY while a read is in
+ *         progress, or FREESPACE_ERROR_UNEXPECTED for a bad argument
+ */
+LIBFREESPACE_API int freespace_frsSetReadWindow(int blockWords, int blocksInFlight);
+
+/** @ingroup async
+ *
+ * Keep the records read by freespace_frsReadAsync() in a directory, one
+ * small file per record. Each file is keyed by the USB vendor and product,
+ * the serial number, part number and firmware version and build the
+ * device reports in its ProductIDResponse. The device is asked for its
+ * product ID once each time it is opened; a record found for that
+ * identity is then handed over without reading it from the device.
+ * The directory must exist. Off by default.
+ *
+ * @param path the directory, or NULL to stop using the cache
+ * @return FREESPACE_SUCCESS or FREESPACE_ERROR_UNEXPECTED if the path is
+ *         empty or too long
+ */
+LIBFREESPACE_API int freespace_frsSetCacheDirectory(const char* path);
+
+/** @ingroup async
+ * A flash record image to be written by freespace_frsWriteAsync(). The
+ * image stays mapped from its file until freespace_frsWriteClose(), and
+ * remembers how much of it the device has taken so an interrupted
+ * write can be resumed.
+ */
+struct FreespaceFRSWrite;
+
+/** @ingroup async
+ * Callback for a completed flash record write.
+ *
+ * @param id the device the record was written to
+ * @param write the image passed to freespace_frsWriteAsync()
+ * @param cookie the data passed to freespace_frsWriteAsync()
+ * @param result FREESPACE_SUCCESS, FREESPACE_ERROR_NOT_FOUND if the device
+ *               does not know the record type, FREESPACE_ERROR_SEND_TOO_LARGE
+ *               if it refused the length, FREESPACE_ERROR_MALFORMED_MESSAGE
+ *               if it found the record invalid, FREESPACE_ERROR_TIMEOUT if
+ *               the device stopped answering, or another error
+ */
+typedef void (*freespace_frsWriteCallback)(FreespaceDeviceId id,
+                                           struct FreespaceFRSWrite* write,
+                                           void* cookie,
+                                           int result);
+
+/** @ingroup async
+ *
+ * Map a flash record image for writing. The file holds the record as
+ * raw 32-bit words in host byte order, and is not read into memory.
+ *
+ * @param path the file to map
+ * @param frsType the record type, with a FreespaceFRSTarget ORed in to
+ *                pick the flash of an hVer 1 device
+ * @param write where to return the image
+ * @return FREESPACE_SUCCESS, FREESPACE_ERROR_NOT_FOUND if the file does
+ *         not exist, FREESPACE_ERROR_MALFORMED_MESSAGE if it is not a
+ *         whole number of words or is too long, or another error
+ */
+LIBFREESPACE_API int freespace_frsWriteOpen(const char* path,
+                                            int frsType,
+                                            struct FreespaceFRSWrite** write);
+
+/** @ingroup async
+ *
+ * Write a flash record image to a device. The device is put in write
+ * mode and sent the words of the image, keeping the number set by
+ * freespace_frsSetWriteWindow() outstanding. Words the device reports
+ * as lost are sent again. The callback is called from
+ * freespace_perform() once the device reports the record complete.
+ *
+ * Starting the write again with the same image after it failed resumes
+ * it from the last word the device acknowledged. Any copy of the record
+ * held by freespace_frsSetCacheDirectory() is dropped.
+ *
+ * @param id the device to write to
+ * @param write the image from freespace_frsWriteOpen()
+ * @param callback the function called when the write completes
+ * @param cookie passed to the callback
+ * @return FREESPACE_SUCCESS if the write was started, FREESPACE_ERROR_BUSY
+ *         if the device or the image already has a write in progress, or
+ *         another error
+ */
+LIBFREESPACE_API int freespace_frsWriteAsync(FreespaceDeviceId id,
+                                             struct FreespaceFRSWrite* write,
+                                             freespace_frsWriteCallback callback,
+                                             void* cookie);
+
+/** @ingroup async
+ *
+ * @param write the image from freespace_frsWriteOpen()
+ * @return the number of words the device has acknowledged
+ */
+LIBFREESPACE_API int freespace_frsWriteProgress(const struct FreespaceFRSWrite* write);
+
+/** @ingroup async
+ *
+ * @param write the image from freespace_frsWriteOpen()
+ * @return the number of words in the image
+ */
+LIBFREESPACE_API int freespace_frsWriteLength(const struct FreespaceFRSWrite* write);
+
+/** @ingroup async
+ *
+ * Unmap an image. A write still in progress is abandoned without
+ * calling its callback.
+ *
+ * @param write the image from freespace_frsWriteOpen(), or NULL
+ */
+LIBFREESPACE_API void freespace_frsWriteClose(struct FreespaceFRSWrite* write);
+
+/** @ingroup async
+ *
+ * Set how many words freespace_frsWriteAsync() sends ahead of the
+ * device's acknowledgements. The default is 8.
+ *
+ * @param wordsInFlight 1 to 64
+ * @return FREESPACE_SUCCESS or FREESPACE_ERROR_UNEXPECTED for a bad
+ *         argument
+ */
+LIBFREESPACE_API int freespace_frsSetWriteWindow(int wordsInFlight);
+
 /** @ingroup async
  *
  * Get the next timeout for a call to select or poll.
@@ -404,6 +1452,84 @@ LIBFREESPACE_API int freespace_getNextTimeout(int* timeoutMsOut);
  */
 LIBFREESPACE_API int freespace_perform();
 
+/** @ingroup async
+ *
+ * Like freespace_perform, but stop once a budget is used up. Devices
+ * with reports waiting are served round robin a few reports at a time,
+ * so a single busy device cannot starve the others. If work is left
+ * over, freespace_getNextTimeout returns 0 until it is done, since the
+ * reports may already have been read off the file descriptors. The next
+ * call continues with the next device in turn.
+ *
+ * @param maxReports the most reports to deliver; <= 0 for no limit
+ * @param maxMicros the most time to spend delivering reports, in
+ *                  microseconds; <= 0 for no limit
+ * @param workRemaining if not NULL, set to 1 if reports are still
+ *                      waiting when the budget ran out, else 0
+ * @return FREESPACE_SUCCESS or an error
+ */
+LIBFREESPACE_API int freespace_performBudget(int maxReports,
+                                             int maxMicros,
+                                             int* workRemaining);
+
+/** @ingroup async
+ *
+ * Keep only the newest report of a message type instead of delivering
+ * every one to the receive callbacks. This suits consumers such as
+ * cursors that sample motion at their own rate. Other message types
+ * are still delivered to the callbacks as usual. The setting lasts
+ * until the device is closed.
+ *
+ * @param id the device
+ * @param messageType the MessageTypes value, such as
+ *                    FREESPACE_MESSAGE_MOTIONENGINEOUTPUT
+ * @param enable nonzero to conflate, 0 to go back to the callbacks
+ * @return FREESPACE_SUCCESS or an error
+ */
+LIBFREESPACE_API int freespace_setConflation(FreespaceDeviceId id, int messageType, int enable);
+
+/** @ingroup async
+ *
+ * Get the newest report of a conflated message type. This does not take
+ * any locks and may be called from any thread while another thread runs
+ * freespace_perform. The report is decoded on the calling thread.
+ *
+ * @param id the device
+ * @param messageType the MessageTypes value passed to freespace_setConflation
+ * @param message where to decode the report
+ * @return FREESPACE_SUCCESS, FREESPACE_ERROR_NO_DATA if nothing has been
+ *         received yet, or an error
+ */
+LIBFREESPACE_API int freespace_getLatest(FreespaceDeviceId id, int messageType, struct freespace_message* message);
+
+/** @ingroup async
+ *
+ * Let the library lower the report rate of a sensor when the application
+ * falls behind, and raise it again once it catches up. The library is
+ * behind when reports fill half of what the backend queues for a device
+ * between calls to freespace_perform, conflated reports are replaced
+ * before being read, or the callbacks reports are dispatched to take
+ * most of the time. The period is doubled or halved with a
+ * SensorPeriodRequest, and only after the load has stayed high or low
+ * for a while. The setting lasts until the device is closed.
+ *
+ * The device is assumed to be running at minPeriodUs when this is called.
+ * Use freespace_performBudget so that freespace_perform returns, and
+ * the rate can be changed, while reports are still arriving faster than
+ * they are handled.
+ *
+ * @param id the device
+ * @param sensor the sensor number, as in SensorPeriodRequest
+ * @param minPeriodUs the shortest period, or 0 to turn rate control off
+ *                    and restore this period
+ * @param maxPeriodUs the longest period
+ * @return FREESPACE_SUCCESS or an error
+ */
+LIBFREESPACE_API int freespace_setRateControl(FreespaceDeviceId id,
+                                              int sensor,
+                                              uint32_t minPeriodUs,
+                                              uint32_t maxPeriodUs);
+
 /** @ingroup async
  *
  * Set callback functions for when file descriptors need to be added
@@ -195,6 +195,42 @@ LIBFREESPACE_API int freespace_util_getAngPos(struct freespace_MotionEngineOutpu
 LIBFREESPACE_API int freespace_util_getActClass(struct freespace_MotionEngineOutput const * meOutPkt,
                                                 struct MultiAxisSensor * sensor);
 
+/** @ingroup util
+ *
+ * MotionEngine Output fields, ORed together for
+ * freespace_util_chooseFormat().
+ */
+enum FreespaceMEOutputField {
+    FREESPACE_ME_POINTER = 0x001,
+    FREESPACE_ME_ACCELERATION = 0x002,
+    FREESPACE_ME_ACC_NO_GRAVITY = 0x004,
+    FREESPACE_ME_ANGULAR_VELOCITY = 0x008,
+    FREESPACE_ME_MAGNETOMETER = 0x010,
+    FREESPACE_ME_TEMPERATURE = 0x020,
+    FREESPACE_ME_INCLINATION = 0x040,
+    FREESPACE_ME_COMPASS_HEADING = 0x080,
+    FREESPACE_ME_ANGULAR_POSITION = 0x100,
+    FREESPACE_ME_ACT_CLASS = 0x200
+};
+
+/** @ingroup util
+ *
+ * Choose the MEOut format and format flags that carry the given fields
+ * in the smallest packet, for a DataModeControlV2Request. Only the
+ * sections holding the fields are enabled. Ties go to the lower format
+ * number.
+ *
+ * @param fields the FreespaceMEOutputField values wanted, ORed together
+ * @param formatSelect where to store the format
+ * @param formatFlags where to store the format flags, bit n for ffn
+ * @return 0 if successful.
+ *         -1 if no single format carries all of the fields.
+ *         -3 if fields has an unrecognized bit set.
+ */
+LIBFREESPACE_API int freespace_util_chooseFormat(int fields,
+                                                 uint8_t * formatSelect,
+                                                 uint8_t * formatFlags);
+
 #ifdef __cplusplus
 }
 #endif
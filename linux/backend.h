@@ -0,0 +1,104 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _BACKEND_H_
+#define _BACKEND_H_
+
+#include "freespace/freespace.h"
+
+/**
+ * The device access functions of freespace.h, as implemented by one
+ * backend. A build can contain several backends; freespace_init() picks
+ * one and every call goes to it until freespace_exit().
+ */
+struct FreespaceBackend {
+    const char* name_;
+
+    /**
+     * The most reports an open device holds for the library before the
+     * ones not read yet are dropped. Rate control measures backlogs
+     * against it.
+     */
+    int queueReports_;
+
+    /**
+     * Look for devices without initializing anything.
+     *
+     * @return FREESPACE_SUCCESS if a device was found that this backend
+     *         can open, FREESPACE_ERROR_ACCESS if devices were found but
+     *         could not be opened, or FREESPACE_ERROR_NOT_FOUND
+     */
+    int (*probe_)();
+
+    int (*init_)();
+    void (*exit_)();
+    int (*setDeviceHotplugCallback_)(freespace_hotplugCallback callback, void* cookie);
+    int (*getDeviceList_)(FreespaceDeviceId* idList, int maxIds, int* numIds);
+    int (*getDeviceInfo_)(FreespaceDeviceId id, struct FreespaceDeviceInfo* info);
+    int (*openDevice_)(FreespaceDeviceId id);
+    int (*openDeviceAsync_)(FreespaceDeviceId id, freespace_openCallback callback, void* cookie);
+    int (*openAllDevicesAsync_)(freespace_openCallback callback, void* cookie);
+    void (*closeDevice_)(FreespaceDeviceId id);
+    int (*checkOpen_)(FreespaceDeviceId id);
+    int (*send_)(FreespaceDeviceId id, const uint8_t* message, int length);
+    int (*sendMessage_)(FreespaceDeviceId id, struct freespace_message* message);
+    int (*read_)(FreespaceDeviceId id, uint8_t* message, int maxLength,
+                 unsigned int timeoutMs, int* actualLength);
+    int (*readMessage_)(FreespaceDeviceId id, struct freespace_message* message,
+                        unsigned int timeoutMs);
+    int (*flush_)(FreespaceDeviceId id);
+    int (*sendAsync_)(FreespaceDeviceId id, const uint8_t* message, int length,
+                      unsigned int timeoutMs, freespace_sendCallback callback, void* cookie);
+    int (*sendMessageAsync_)(FreespaceDeviceId id, struct freespace_message* message,
+                             unsigned int timeoutMs, freespace_sendCallback callback, void* cookie);
+    int (*getNextTimeout_)(int* timeoutMsOut);
+    int (*performBudget_)(int maxReports, int maxMicros, int* workRemaining);
+    void (*setFileDescriptorCallbacks_)(freespace_pollfdAddedCallback addedCallback,
+                                        freespace_pollfdRemovedCallback removedCallback);
+    int (*syncFileDescriptors_)();
+    int (*setReceiveCallback_)(FreespaceDeviceId id, freespace_receiveCallback callback, void* cookie);
+    int (*setReceiveMessageCallback_)(FreespaceDeviceId id, freespace_receiveMessageCallback callback,
+                                      void* cookie);
+    int (*setReceiveBufferCallback_)(FreespaceDeviceId id, freespace_receiveBufferCallback callback,
+                                     void* cookie);
+};
+
+#ifdef LIBFREESPACE_BACKEND_HIDRAW
+extern const struct FreespaceBackend freespace_hidrawBackend;
+#endif
+#ifdef LIBFREESPACE_BACKEND_LIBUSB
+extern const struct FreespaceBackend freespace_libusbBackend;
+#endif
+#ifdef LIBFREESPACE_BACKEND_BROKER
+extern const struct FreespaceBackend freespace_brokerBackend;
+#endif
+#ifdef LIBFREESPACE_BACKEND_TEST
+extern const struct FreespaceBackend freespace_testBackend;
+#endif
+
+/**
+ * Pick a backend and initialize it. Implements freespace_init() and
+ * freespace_initWithOptions().
+ *
+ * @param names comma separated backends to try in order, or NULL for
+ *        the FREESPACE_BACKEND environment variable or else the order
+ *        the library was configured with
+ */
+int freespace_private_initBackend(const char* names);
+
+#endif // _BACKEND_H_
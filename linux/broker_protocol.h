@@ -0,0 +1,105 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _BROKER_PROTOCOL_H_
+#define _BROKER_PROTOCOL_H_
+
+#include "freespace/freespace.h"
+
+/*
+ * Protocol between freespaced and the broker client library. Both ends
+ * are on the same host, so everything is in native byte order. The
+ * socket is SOCK_SEQPACKET: every frame is one packet, a
+ * FreespaceBrokerFrame followed by its payload.
+ *
+ * Requests from the client are answered with a REPLY carrying the same
+ * token. REPORT and HOTPLUG frames come from the daemon at any time,
+ * including between a request and its reply.
+ */
+#define FREESPACE_BROKER_PROTOCOL_VERSION 1
+
+/** Socket the daemon listens on unless told otherwise */
+#define FREESPACE_BROKER_DEFAULT_SOCKET "/var/run/freespaced.sock"
+
+/** Environment variable that overrides the socket for clients */
+#define FREESPACE_BROKER_SOCKET_ENV "FREESPACE_BROKER_SOCKET"
+
+/** Words in the message type mask of a SUBSCRIBE request */
+#define FREESPACE_BROKER_MASK_WORDS ((FREESPACE_MESSAGE_TYPE_COUNT + 31) / 32)
+
+enum FreespaceBrokerFrameType {
+    // Client to daemon
+
+    /** Check the protocol version. Reply: struct FreespaceBrokerHello */
+    FREESPACE_BROKER_HELLO = 1,
+    /** Reply: the device ids as int32_t */
+    FREESPACE_BROKER_LIST = 2,
+    /** Reply: struct FreespaceBrokerInfo */
+    FREESPACE_BROKER_INFO = 3,
+    /** Start receiving the reports of a device, all types at first */
+    FREESPACE_BROKER_OPEN = 4,
+    FREESPACE_BROKER_CLOSE = 5,
+    /**
+     * Choose the message types received from an open device. Payload:
+     * FREESPACE_BROKER_MASK_WORDS uint32_t words, bit n of word n / 32
+     * for message type n; arg_ set means every report is wanted,
+     * including those of unknown type.
+     */
+    FREESPACE_BROKER_SUBSCRIBE = 6,
+    /** Payload: the raw report to send */
+    FREESPACE_BROKER_SEND = 7,
+
+    // Daemon to client
+
+    /** status_ is the result of the request with the same token */
+    FREESPACE_BROKER_REPLY = 64,
+    /** arg_ is the HID protocol version; payload: the raw report */
+    FREESPACE_BROKER_REPORT = 65,
+    /**
+     * arg_ is an enum freespace_hotplugEvent; insertions carry a
+     * struct FreespaceBrokerInfo
+     */
+    FREESPACE_BROKER_HOTPLUG = 66
+};
+
+struct FreespaceBrokerFrame {
+    uint8_t type_;
+    uint8_t arg_;
+    int16_t status_;
+    int32_t id_;
+    uint32_t token_;
+};
+
+struct FreespaceBrokerHello {
+    uint32_t version_;
+    // Message types known to the daemon, for SUBSCRIBE masks
+    uint32_t messageTypeCount_;
+};
+
+struct FreespaceBrokerInfo {
+    uint16_t vendor_;
+    uint16_t product_;
+    int32_t hVer_;
+    char name_[64];
+};
+
+/** Largest frame either side sends */
+#define FREESPACE_BROKER_MAX_FRAME \
+    (sizeof(struct FreespaceBrokerFrame) + 4 * FREESPACE_MAXIMUM_DEVICE_COUNT + FREESPACE_MAX_INPUT_MESSAGE_SIZE)
+
+#endif // _BROKER_PROTOCOL_H_
@@ -209,3 +209,14 @@ int freespace_hotplug_perform(int* recheck) {
         return FREESPACE_ERROR_IO;
     }
 }
+
+int freespace_hotplug_nextEvent(struct FreespaceHotplugEvent* event) {
+    // IOKit notifications are not tracked individually; every event
+    // triggers a rescan from freespace_hotplug_perform().
+    return 0;
+}
+
+void freespace_hotplug_retry(const struct FreespaceHotplugEvent* event) {
+    // Ask for a rescan instead
+    write(writeFd_, "1", 1);
+}
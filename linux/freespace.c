@@ -18,6 +18,22 @@
 #include "freespace/freespace.h"
 #include "freespace/freespace_deviceTable.h"
 #include "hotplug.h"
+#include "worker_pool.h"
+#include "backend.h"
+#include "receive_thread.h"
+#include "freespace_mailbox.h"
+#include "freespace_rate.h"
+#include "freespace_subscribe.h"
+#include "freespace_frs.h"
+#include "freespace_request.h"
+#include "freespace_configure.h"
+#include "freespace_buffer.h"
+#include "freespace_syncQueue.h"
+#include "freespace_alloc.h"
+#include "freespace_trace.h"
+#include "freespace_probes.h"
+#include "freespace_recorder.h"
+#include "freespace_publish.h"
 #include "freespace_config.h"
 
 #include <libusb-1.0/libusb.h>
@@ -25,9 +41,24 @@
 #include <stdio.h>
 #include <poll.h>
 #include <string.h>
+#include <time.h>
 
 #define FREESPACE_RECEIVE_QUEUE_SIZE 8 // Could be tuned better. 3-4 might be good enough
 
+// Asynchronous sends that can be outstanding before sending allocates
+#define FREESPACE_SEND_POOL_SIZE 8
+
+// Reports delivered from one device before moving on to the next
+#define FREESPACE_PERFORM_QUANTUM 4
+
+// libusb 1.0.16 and later can report hotplug events itself.
+#if defined(LIBUSB_API_VERSION) && (LIBUSB_API_VERSION >= 0x01000102)
+#define FREESPACE_LIBUSB_HOTPLUG
+#define FREESPACE_MAXIMUM_HOTPLUG_VENDORS 8
+// Hotplug events waiting for the next perform
+#define FREESPACE_HOTPLUG_QUEUE_LENGTH 32
+#endif
+
 /**
  * The device state is primarily used to keep track of FreespaceDevice allocations.
  * The state machine looks like the following:
@@ -58,9 +89,10 @@ struct FreespaceReceiveTransfer {
     // Convenience backpointer to the device data structure.
     struct FreespaceDevice* device_;
 
-    // Transfer information
+    // Transfer information. The buffer comes from the pool in
+    // freespace_buffer.c so that it can be lent to the application.
     struct libusb_transfer* transfer_;
-    uint8_t buffer_[FREESPACE_MAX_INPUT_MESSAGE_SIZE];
+    struct FreespaceBuffer* buffer_;
 
     // Synchronous interface usage for the state of the
     // queue.
@@ -76,6 +108,7 @@ struct FreespaceDevice {
 
     struct libusb_device* dev_;
     struct libusb_device_handle* handle_;
+    uint8_t busNumber_;
     uint16_t idVendor_;
     uint16_t idProduct_;
     int kernelDriverDetached_;
@@ -86,18 +119,28 @@ struct FreespaceDevice {
     int maxWriteSize_;
     int maxReadSize_;
 
+    // Set while this device holds reserved pool buffers and sends
+    int reserved_;
+
     freespace_receiveCallback receiveCallback_;
     freespace_receiveMessageCallback receiveMessageCallback_;
+    freespace_receiveBufferCallback receiveBufferCallback_;
     void* receiveCookie_;
     void* receiveMessageCookie_;
+    void* receiveBufferCookie_;
 
     int receiveQueueHead_;
     struct FreespaceReceiveTransfer receiveQueue_[FREESPACE_RECEIVE_QUEUE_SIZE];
+
+    // Reports that perform took off the device for nobody but
+    // freespace_read.
+    struct FreespaceSyncQueue syncQueue_;
 };
 
 static struct FreespaceDevice* devices[FREESPACE_MAXIMUM_DEVICE_COUNT];
 static int numDevices = 0;
 static FreespaceDeviceId nextFreeIndex = 0;
+static int performCursor = 0;
 static uint32_t ts = 0;
 
 static struct libusb_context* freespace_libusb_context = NULL;
@@ -106,6 +149,142 @@ static freespace_pollfdRemovedCallback userRemovedCallback = NULL;
 static freespace_hotplugCallback hotplugCallback = NULL;
 static void* hotplugCookie;
 
+// 1 if libusb reports hotplug events, 0 if the netlink code in
+// linux_hotplug.c is used, -1 until the first scan decides.
+static int nativeHotplug = -1;
+#ifdef FREESPACE_LIBUSB_HOTPLUG
+static libusb_hotplug_callback_handle nativeHotplugHandles[FREESPACE_MAXIMUM_HOTPLUG_VENDORS];
+static int nativeHotplugCount = 0;
+
+/**
+ * A hotplug event from libusb. Its callback can run inside any call to
+ * libusb_handle_events, so events are queued and applied from
+ * scanDevices(). The device is referenced while queued.
+ */
+struct NativeHotplugEvent {
+    libusb_device* dev_;
+    libusb_hotplug_event event_;
+};
+static struct NativeHotplugEvent nativeHotplugQueue[FREESPACE_HOTPLUG_QUEUE_LENGTH];
+static int nativeHotplugHead = 0;
+static int nativeHotplugQueued = 0;
+// Set when events were lost to a full queue
+static int nativeHotplugOverflow = 0;
+#endif
+
+/**
+ * An asynchronous send. These are kept in a pool with their transfer
+ * allocated, so that sending does not allocate once devices are open.
+ */
+struct SendTransferInfo {
+    FreespaceDeviceId id;
+    freespace_sendCallback callback;
+    void* cookie;
+    struct libusb_transfer* transfer;
+    uint8_t buffer[FREESPACE_MAX_OUTPUT_MESSAGE_SIZE];
+    struct SendTransferInfo* next;
+};
+
+static struct SendTransferInfo* freeSendTransfers = NULL;
+static int numSendTransfers = 0;
+// FREESPACE_SEND_POOL_SIZE for each open device
+static int reservedSendTransfers = 0;
+
+static struct SendTransferInfo* allocSendTransfer() {
+    struct SendTransferInfo* info;
+
+    info = (struct SendTransferInfo*) freespace_private_calloc(sizeof(struct SendTransferInfo));
+    if (info == NULL) {
+        return NULL;
+    }
+    info->transfer = libusb_alloc_transfer(0);
+    if (info->transfer == NULL) {
+        freespace_private_free(info);
+        return NULL;
+    }
+    numSendTransfers++;
+    return info;
+}
+
+static void putSendTransfer(struct SendTransferInfo* info) {
+    info->next = freeSendTransfers;
+    freeSendTransfers = info;
+}
+
+static struct SendTransferInfo* getSendTransfer() {
+    struct SendTransferInfo* info = freeSendTransfers;
+
+    if (info == NULL) {
+        // More sends outstanding than the pool was filled for. This is
+        // the send path, so don't allocate more.
+        return NULL;
+    }
+    freeSendTransfers = info->next;
+    info->next = NULL;
+    return info;
+}
+
+// Grow the send pool for one more open device
+static int reserveSendTransfers() {
+    struct SendTransferInfo* info;
+
+    while (numSendTransfers < reservedSendTransfers + FREESPACE_SEND_POOL_SIZE) {
+        info = allocSendTransfer();
+        if (info == NULL) {
+            return FREESPACE_ERROR_OUT_OF_MEMORY;
+        }
+        putSendTransfer(info);
+    }
+    reservedSendTransfers += FREESPACE_SEND_POOL_SIZE;
+    return FREESPACE_SUCCESS;
+}
+
+// Reserve everything an open device uses while receiving and sending,
+// so that servicing it never allocates.
+static int reserveDevice(struct FreespaceDevice* device) {
+    int rc;
+
+    if (device->reserved_) {
+        return FREESPACE_SUCCESS;
+    }
+    rc = freespace_private_requestReserve(device->id_);
+    if (rc != FREESPACE_SUCCESS) {
+        return rc;
+    }
+    rc = freespace_private_bufferReserve(FREESPACE_RECEIVE_QUEUE_SIZE + FREESPACE_BUFFER_LEND_SLACK);
+    if (rc != FREESPACE_SUCCESS) {
+        return rc;
+    }
+    rc = reserveSendTransfers();
+    if (rc != FREESPACE_SUCCESS) {
+        freespace_private_bufferUnreserve(FREESPACE_RECEIVE_QUEUE_SIZE + FREESPACE_BUFFER_LEND_SLACK);
+        return rc;
+    }
+    device->reserved_ = 1;
+    return FREESPACE_SUCCESS;
+}
+
+static void unreserveDevice(struct FreespaceDevice* device) {
+    if (device->reserved_) {
+        freespace_private_bufferUnreserve(FREESPACE_RECEIVE_QUEUE_SIZE + FREESPACE_BUFFER_LEND_SLACK);
+        reservedSendTransfers -= FREESPACE_SEND_POOL_SIZE;
+        device->reserved_ = 0;
+    }
+}
+
+// Sends still in flight are not returned to the pool and are leaked.
+static void freeSendTransferPool() {
+    struct SendTransferInfo* info;
+
+    while ((info = freeSendTransfers) != NULL) {
+        freeSendTransfers = info->next;
+        libusb_free_transfer(info->transfer);
+        freespace_private_free(info);
+        numSendTransfers--;
+    }
+    reservedSendTransfers = 0;
+}
+
 static int libusb_to_freespace_error(int libusberror) {
     // libusb returns values greater than 0 for success for some functions.
     if (libusberror >= 0) {
@@ -143,11 +322,8 @@ static int libusb_transfer_status_to_freespace_error(enum libusb_transfer_status
     }
 }
 
-const char* freespace_version() {
-    return LIBFREESPACE_VERSION;
-}
 
-int freespace_init() {
+static int freespace_libusb_init() {
     int rc;
 
     rc = freespace_hotplug_init();
@@ -155,13 +331,27 @@ int freespace_init() {
         return rc;
     }
 
+    nativeHotplug = -1;
     rc = libusb_init(&freespace_libusb_context);
     return libusb_to_freespace_error(rc);
 }
 
-void freespace_exit() {
+static void freespace_libusb_exit() {
     struct FreespaceDevice* device;
     int i;
+
+    // Stop the receive thread before tearing anything down under it
+    freespace_receiveThread_stop();
+
+    // Finish any background opens first. Their done functions release
+    // the handles they opened.
+    if (freespace_workers_getFD() >= 0) {
+        if (userRemovedCallback != NULL) {
+            userRemovedCallback(freespace_workers_getFD());
+        }
+        freespace_workers_exit();
+    }
+
     for (i = 0; i < FREESPACE_MAXIMUM_DEVICE_COUNT; i++) {
         if (devices[i] != NULL) {
             device = devices[i];
@@ -169,13 +359,39 @@ void freespace_exit() {
                 nextFreeIndex = i;
             }
             libusb_unref_device(device->dev_);
-            free(device);
+            freespace_private_free(device);
             devices[i] = NULL;
             numDevices--;
         }
     }
+#ifdef FREESPACE_LIBUSB_HOTPLUG
+    for (i = 0; i < nativeHotplugCount; i++) {
+        libusb_hotplug_deregister_callback(freespace_libusb_context, nativeHotplugHandles[i]);
+    }
+    nativeHotplugCount = 0;
+    for (i = 0; i < nativeHotplugQueued; i++) {
+        libusb_unref_device(nativeHotplugQueue[(nativeHotplugHead + i) % FREESPACE_HOTPLUG_QUEUE_LENGTH].dev_);
+    }
+    nativeHotplugHead = 0;
+    nativeHotplugQueued = 0;
+    nativeHotplugOverflow = 0;
+#endif
+    freeSendTransferPool();
     libusb_exit(freespace_libusb_context);
-    freespace_hotplug_exit();
+    if (nativeHotplug != 1) {
+        // Otherwise this was closed when switching to libusb's hotplug
+        freespace_hotplug_exit();
+    }
+    nativeHotplug = -1;
+    freespace_recorderStop();
+    freespace_publisherStop();
+    freespace_private_mailboxExit();
+    freespace_private_rateExit();
+    freespace_private_subscriptionExit();
+    freespace_private_configExit();
+    freespace_private_requestExit();
+    freespace_private_frsExit();
+    freespace_private_bufferExit();
 }
 
 static struct FreespaceDeviceAPI const * lookupDevice(struct libusb_device_descriptor* desc) {
@@ -196,6 +412,41 @@ static struct FreespaceDeviceAPI const * lookupDevice(struct libusb_device_descr
     return NULL;
 }
 
+// Look for devices on a private libusb context, leaving nothing behind
+static int freespace_libusb_probe() {
+    libusb_context* context;
+    struct libusb_device** devs;
+    ssize_t count;
+    ssize_t i;
+    int rc = FREESPACE_ERROR_NOT_FOUND;
+
+    if (libusb_init(&context) != LIBUSB_SUCCESS) {
+        return FREESPACE_ERROR_NOT_FOUND;
+    }
+
+    count = libusb_get_device_list(context, &devs);
+    for (i = 0; i < count; i++) {
+        struct libusb_device_descriptor desc;
+        struct libusb_device_handle* handle;
+
+        if (libusb_get_device_descriptor(devs[i], &desc) < 0 || lookupDevice(&desc) == NULL) {
+            continue;
+        }
+        if (libusb_open(devs[i], &handle) == LIBUSB_SUCCESS) {
+            libusb_close(handle);
+            rc = FREESPACE_SUCCESS;
+            break;
+        }
+        rc = FREESPACE_ERROR_ACCESS;
+    }
+
+    if (count >= 0) {
+        libusb_free_device_list(devs, 1);
+    }
+    libusb_exit(context);
+    return rc;
+}
+
 static struct FreespaceDevice* findDeviceById(FreespaceDeviceId id) {
     int i;
     for (i = 0; i < FREESPACE_MAXIMUM_DEVICE_COUNT; i++) {
@@ -234,7 +485,7 @@ static void removeFreespaceDevice(struct FreespaceDevice* device) {
                 nextFreeIndex = i;
             }
             libusb_unref_device(device->dev_);
-            free(device);
+            freespace_private_free(device);
             devices[i] = NULL;
             numDevices--;
             return;
@@ -242,24 +493,60 @@ static void removeFreespaceDevice(struct FreespaceDevice* device) {
     }
 }
 
-static int scanDevices() {
+static int addDevice(struct libusb_device* dev,
+                     struct libusb_device_descriptor* desc,
+                     struct FreespaceDeviceAPI const * api) {
+    struct FreespaceDevice* device;
+
+    device = (struct FreespaceDevice*) freespace_private_malloc(sizeof(struct FreespaceDevice));
+    if (device == NULL) {
+        // Out of memory.
+        return FREESPACE_ERROR_OUT_OF_MEMORY;
+    }
+    memset(device, 0, sizeof(struct FreespaceDevice));
+
+    libusb_ref_device(dev);
+    device->dev_ = dev;
+    device->idProduct_ = desc->idProduct;
+    device->idVendor_ = desc->idVendor;
+    device->api_ = api;
+    device->id_ = libusb_get_device_address(dev);
+    device->busNumber_ = libusb_get_bus_number(dev);
+    device->state_ = FREESPACE_CONNECTED;
+    device->ts_ = ts;
+    addFreespaceDevice(device);
+    FREESPACE_PROBE1(hotplug__insert, device->id_);
+    if (hotplugCallback) {
+        hotplugCallback(FREESPACE_HOTPLUG_INSERTION, device->id_, hotplugCookie);
+    }
+    return FREESPACE_SUCCESS;
+}
+
+static void disconnectDevice(struct FreespaceDevice* d) {
+    FREESPACE_PROBE1(hotplug__remove, d->id_);
+    if (hotplugCallback) {
+        hotplugCallback(FREESPACE_HOTPLUG_REMOVAL, d->id_, hotplugCookie);
+    }
+    if (d->state_ == FREESPACE_OPENED) {
+        d->state_ = FREESPACE_DISCONNECTED;
+    } else {
+        removeFreespaceDevice(d);
+    }
+}
+
+// Enumerate the whole bus, adding new devices and removing missing ones.
+static int rescanDevices() {
     struct libusb_device** devs;
     ssize_t count;
     ssize_t i;
     int rc;
-    int needToRescan;
-
-    // Check if the devices need to be rescanned.
-    rc = freespace_hotplug_perform(&needToRescan);
-    if (rc != FREESPACE_SUCCESS || !needToRescan) {
-        return rc;
-    }
 
     count = libusb_get_device_list(freespace_libusb_context, &devs);
     if (count < 0) {
         return libusb_to_freespace_error(count);
     }
 
+    FREESPACE_TRACE_BEGIN("hotplugScan", -1);
     ts++;
     for (i = 0; i < count; i++) {
         struct libusb_device_descriptor desc;
@@ -279,63 +566,275 @@ static int scanDevices() {
             struct FreespaceDevice* device;
             device = findDeviceById(deviceAddress);
             if (device == NULL) {
-                device = (struct FreespaceDevice*) malloc(sizeof(struct FreespaceDevice));
-                if (device == NULL) {
-                    // Out of memory.
+                rc = addDevice(dev, &desc, api);
+                if (rc != FREESPACE_SUCCESS) {
                     libusb_free_device_list(devs, 1);
-                    return FREESPACE_ERROR_OUT_OF_MEMORY;
+                    FREESPACE_TRACE_END("hotplugScan", -1);
+                    return rc;
                 }
-                memset(device, 0, sizeof(struct FreespaceDevice));
-
-                libusb_ref_device(dev);
-                device->dev_ = dev;
-                device->idProduct_ = desc.idProduct;
-                device->idVendor_ = desc.idVendor;
-                device->api_ = api;
-                device->id_ = libusb_get_device_address(dev);
-                device->state_ = FREESPACE_CONNECTED;
+            } else {
                 device->ts_ = ts;
-                addFreespaceDevice(device);
-                if (hotplugCallback) {
-                    hotplugCallback(FREESPACE_HOTPLUG_INSERTION, device->id_, hotplugCookie);
-                }
             }
-            device->ts_ = ts;
         }
     }
 
     for (i = 0; i < FREESPACE_MAXIMUM_DEVICE_COUNT; i++) {
         struct FreespaceDevice* d = devices[i];
-        if (d != NULL && d->ts_ != ts) {
-            if (hotplugCallback) {
-                hotplugCallback(FREESPACE_HOTPLUG_REMOVAL, d->id_, hotplugCookie);
+        if (d != NULL && d->ts_ != ts && d->state_ != FREESPACE_DISCONNECTED) {
+            disconnectDevice(d);
+        }
+    }
+
+    libusb_free_device_list(devs, 1);
+    FREESPACE_TRACE_END("hotplugScan", -1);
+    return FREESPACE_SUCCESS;
+}
+
+// Add the one device named by a hotplug event.
+static int addHotplugDevice(const struct FreespaceHotplugEvent* event) {
+    struct libusb_device** devs;
+    struct libusb_device_descriptor desc;
+    struct FreespaceDeviceAPI const * api;
+    ssize_t count;
+    ssize_t i;
+    int rc = FREESPACE_SUCCESS;
+    int found = 0;
+
+    if (findDeviceById(event->deviceAddress_) != NULL) {
+        // Already known
+        return FREESPACE_SUCCESS;
+    }
+
+    // libusb has no lookup by address, but the list is cached so only
+    // the matching entry needs its descriptor read.
+    count = libusb_get_device_list(freespace_libusb_context, &devs);
+    if (count < 0) {
+        return libusb_to_freespace_error(count);
+    }
+
+    for (i = 0; i < count; i++) {
+        struct libusb_device* dev = devs[i];
+        if (libusb_get_bus_number(dev) != event->busNumber_ ||
+            libusb_get_device_address(dev) != event->deviceAddress_) {
+            continue;
+        }
+
+        found = 1;
+        if (libusb_get_device_descriptor(dev, &desc) < 0) {
+            break;
+        }
+        api = lookupDevice(&desc);
+        if (api != NULL) {
+            rc = addDevice(dev, &desc, api);
+        }
+        break;
+    }
+    libusb_free_device_list(devs, 1);
+
+    if (!found) {
+        // libusb hasn't seen it yet. Try again later.
+        freespace_hotplug_retry(event);
+    }
+    return rc;
+}
+
+#ifdef FREESPACE_LIBUSB_HOTPLUG
+static int LIBUSB_CALL nativeHotplugCallback(libusb_context* ctx,
+                                             libusb_device* dev,
+                                             libusb_hotplug_event event,
+                                             void* userData) {
+    struct NativeHotplugEvent* queued;
+
+    // This may be deep inside a read, close or another libusb call, so
+    // leave the device list and the application's callback to perform.
+    if (nativeHotplugQueued == FREESPACE_HOTPLUG_QUEUE_LENGTH) {
+        // Too many to remember. Rescan once they've been applied.
+        nativeHotplugOverflow = 1;
+        return 0;
+    }
+    queued = &nativeHotplugQueue[(nativeHotplugHead + nativeHotplugQueued) % FREESPACE_HOTPLUG_QUEUE_LENGTH];
+    queued->dev_ = libusb_ref_device(dev);
+    queued->event_ = event;
+    nativeHotplugQueued++;
+
+    // Stay registered
+    return 0;
+}
+
+// Apply the events queued by nativeHotplugCallback()
+static int applyNativeHotplugEvents() {
+    struct libusb_device_descriptor desc;
+    struct FreespaceDeviceAPI const * api;
+    struct FreespaceDevice* device;
+    int rc = FREESPACE_SUCCESS;
+    int i;
+
+    while (nativeHotplugQueued > 0) {
+        // Take it off first, in case the application's callback runs libusb
+        struct NativeHotplugEvent event = nativeHotplugQueue[nativeHotplugHead];
+        nativeHotplugHead = (nativeHotplugHead + 1) % FREESPACE_HOTPLUG_QUEUE_LENGTH;
+        nativeHotplugQueued--;
+
+        if (event.event_ == LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED) {
+            // The registration only filters on vendor
+            if (libusb_get_device_descriptor(event.dev_, &desc) == 0) {
+                api = lookupDevice(&desc);
+                if (api != NULL && findDeviceById(libusb_get_device_address(event.dev_)) == NULL) {
+                    rc = addDevice(event.dev_, &desc, api);
+                }
             }
-            if (d->state_ == FREESPACE_OPENED) {
-                d->state_ = FREESPACE_DISCONNECTED;
-            } else {
-                removeFreespaceDevice(d);
+        } else if (event.event_ == LIBUSB_HOTPLUG_EVENT_DEVICE_LEFT) {
+            for (i = 0; i < FREESPACE_MAXIMUM_DEVICE_COUNT; i++) {
+                device = devices[i];
+                if (device != NULL && device->dev_ == event.dev_ && device->state_ != FREESPACE_DISCONNECTED) {
+                    disconnectDevice(device);
+                    break;
+                }
+            }
+        }
+        libusb_unref_device(event.dev_);
+        if (rc != FREESPACE_SUCCESS) {
+            return rc;
+        }
+    }
+
+    if (nativeHotplugOverflow) {
+        nativeHotplugOverflow = 0;
+        return rescanDevices();
+    }
+    return FREESPACE_SUCCESS;
+}
+#endif
+
+// Use libusb's own hotplug support if it has it. This registers one
+// callback per vendor in the device table. Existing devices are reported
+// through the callback during registration, so this also does the
+// initial scan.
+static void startNativeHotplug() {
+#ifdef FREESPACE_LIBUSB_HOTPLUG
+    int i;
+    int j;
+    int rc;
+
+    nativeHotplug = 0;
+    if (!libusb_has_capability(LIBUSB_CAP_HAS_HOTPLUG)) {
+        return;
+    }
+
+    for (i = 0; i < freespace_deviceAPITableNum; i++) {
+        uint16_t idVendor = freespace_deviceAPITable[i].idVendor_;
+
+        for (j = 0; j < i; j++) {
+            if (freespace_deviceAPITable[j].idVendor_ == idVendor) {
+                break;
+            }
+        }
+        if (j < i) {
+            // Already registered for this vendor
+            continue;
+        }
+
+        rc = LIBUSB_ERROR_NO_MEM;
+        if (nativeHotplugCount < FREESPACE_MAXIMUM_HOTPLUG_VENDORS) {
+            rc = libusb_hotplug_register_callback(freespace_libusb_context,
+                                                  LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED |
+                                                  LIBUSB_HOTPLUG_EVENT_DEVICE_LEFT,
+                                                  LIBUSB_HOTPLUG_ENUMERATE,
+                                                  idVendor,
+                                                  LIBUSB_HOTPLUG_MATCH_ANY,
+                                                  LIBUSB_HOTPLUG_MATCH_ANY,
+                                                  nativeHotplugCallback,
+                                                  NULL,
+                                                  &nativeHotplugHandles[nativeHotplugCount]);
+        }
+        if (rc != LIBUSB_SUCCESS) {
+            // Fall back to netlink. Anything added so far is found
+            // again by its rescan.
+            for (j = 0; j < nativeHotplugCount; j++) {
+                libusb_hotplug_deregister_callback(freespace_libusb_context, nativeHotplugHandles[j]);
+            }
+            nativeHotplugCount = 0;
+            return;
+        }
+        nativeHotplugCount++;
+    }
+
+    nativeHotplug = 1;
+
+    // The netlink socket isn't needed anymore
+    if (userRemovedCallback != NULL) {
+        userRemovedCallback(freespace_hotplug_getFD());
+    }
+    freespace_hotplug_exit();
+#else
+    nativeHotplug = 0;
+#endif
+}
+
+static int scanDevices() {
+    struct FreespaceHotplugEvent event;
+    int rc;
+    int needToRescan;
+
+    if (nativeHotplug < 0) {
+        startNativeHotplug();
+    }
+    if (nativeHotplug) {
+#ifdef FREESPACE_LIBUSB_HOTPLUG
+        return applyNativeHotplugEvents();
+#else
+        return FREESPACE_SUCCESS;
+#endif
+    }
+
+    // Check if the devices need to be rescanned.
+    rc = freespace_hotplug_perform(&needToRescan);
+    if (rc != FREESPACE_SUCCESS) {
+        return rc;
+    }
+    if (needToRescan) {
+        return rescanDevices();
+    }
+
+    // Apply just the changes that the hotplug code saw
+    while (freespace_hotplug_nextEvent(&event)) {
+        if (event.action_ == FREESPACE_HOTPLUG_ADD) {
+            rc = addHotplugDevice(&event);
+            if (rc != FREESPACE_SUCCESS) {
+                return rc;
+            }
+        } else {
+            struct FreespaceDevice* d = findDeviceById(event.deviceAddress_);
+            if (d != NULL && d->busNumber_ == event.busNumber_ &&
+                d->state_ != FREESPACE_DISCONNECTED) {
+                disconnectDevice(d);
             }
         }
     }
 
-    libusb_free_device_list(devs, 1);
     return FREESPACE_SUCCESS;
 }
 
-int freespace_setDeviceHotplugCallback(freespace_hotplugCallback callback,
-                                       void* cookie) {
+static int freespace_libusb_setDeviceHotplugCallback(freespace_hotplugCallback callback,
+                                                     void* cookie) {
     hotplugCallback = callback;
     hotplugCookie = cookie;
     return FREESPACE_SUCCESS;
 }
 
-int freespace_getDeviceList(FreespaceDeviceId* idList,
-                            int maxIds,
-                            int* numIds) {
+static int freespace_libusb_getDeviceList(FreespaceDeviceId* idList,
+                                          int maxIds,
+                                          int* numIds) {
     int i;
     int rc;
     *numIds = 0;
 
+    if (nativeHotplug == 1) {
+        // Let libusb deliver any pending hotplug callbacks
+        struct timeval tv = {0, 0};
+        libusb_handle_events_timeout(freespace_libusb_context, &tv);
+    }
+
     rc = scanDevices();
     if (rc != FREESPACE_SUCCESS) {
         return rc;
@@ -351,8 +850,8 @@ int freespace_getDeviceList(FreespaceDeviceId* idList,
     return FREESPACE_SUCCESS;
 }
 
-int freespace_getDeviceInfo(FreespaceDeviceId id,
-                            struct FreespaceDeviceInfo* info) {
+static int freespace_libusb_getDeviceInfo(FreespaceDeviceId id,
+                                          struct FreespaceDeviceInfo* info) {
     struct FreespaceDevice* device = findDeviceById(id);
 
     if (device != NULL) {
@@ -366,39 +865,256 @@ int freespace_getDeviceInfo(FreespaceDeviceId id,
     }
 }
 
+static int64_t nowMicros() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (int64_t) now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
 static void receiveCallback(struct libusb_transfer* transfer) {
     struct FreespaceReceiveTransfer* rt = (struct FreespaceReceiveTransfer*) transfer->user_data;
-    struct FreespaceDevice* device = rt->device_;
 
-    if (transfer->status == LIBUSB_TRANSFER_CANCELLED) {
-        // Canceled. This only happens on cleanup. Don't report errors or resubmit.
-        rt->submitted_ = 0;
+    // Queue the transfer. It is either read synchronously or delivered
+    // to the async callbacks by dispatchReceive(). Canceled transfers
+    // only happen on cleanup and are never delivered.
+    rt->submitted_ = 0;
+}
+
+static int hasReceiveCallback(struct FreespaceDevice* device) {
+    return device->receiveCallback_ != NULL ||
+           device->receiveMessageCallback_ != NULL ||
+           device->receiveBufferCallback_ != NULL;
+}
+
+// Receives go through perform when there is an async callback, a
+// request or flash record transfer waiting for its response, a
+// subscription or a conflated message type to fill in.
+static int isAsyncReceive(struct FreespaceDevice* device) {
+    return hasReceiveCallback(device) ||
+           freespace_private_requestActive(device->id_) ||
+           freespace_private_frsActive(device->id_) ||
+           freespace_private_mailboxActive(device->id_) ||
+           freespace_private_subscriptionActive(device->id_);
+}
+
+static int hasReceivePending(struct FreespaceDevice* device) {
+    struct FreespaceReceiveTransfer* rt = &device->receiveQueue_[device->receiveQueueHead_];
+
+    if (!isAsyncReceive(device)) {
+        // Synchronous reads pick these up
+        return 0;
+    }
+    if (device->syncQueue_.count_ > 0 && hasReceiveCallback(device)) {
+        return 1;
+    }
+    return rt->transfer_ != NULL && !rt->submitted_;
+}
+
+// Give a report to the requests, flash record reads, mailboxes and
+// subscriptions. Returns nonzero if one of them took it.
+static int interceptReceive(struct FreespaceDevice* device, const uint8_t* report, int length) {
+    return freespace_private_requestDeliver(device->id_, report, length, device->api_->hVer_) ||
+           freespace_private_frsDeliver(device->id_, report, length, device->api_->hVer_) ||
+           freespace_private_mailboxDeliver(device->id_, report, length, device->api_->hVer_) ||
+           freespace_private_subscriptionDeliver(device->id_, report, length, device->api_->hVer_);
+}
+
+// Hand the buffer of a completed receive to the receive buffer callback.
+// The transfer gets a fresh buffer from the pool, so the application can
+// keep the old one past the callback without anything being copied.
+static void lendReceiveBuffer(struct FreespaceDevice* device, struct FreespaceReceiveTransfer* rt) {
+    struct FreespaceBuffer* lent;
+    struct FreespaceBuffer* fresh;
+    int rc = libusb_transfer_status_to_freespace_error(rt->transfer_->status);
+
+    if (rc != FREESPACE_SUCCESS) {
+        device->receiveBufferCallback_(device->id_, NULL, device->receiveBufferCookie_, rc);
         return;
     }
 
-    if (device->receiveCallback_ != NULL || device->receiveMessageCallback_ != NULL) {
-        // Using async interface, so call user back immediately.
-        int rc = libusb_transfer_status_to_freespace_error(transfer->status);
-        if (device->receiveCallback_ != NULL) {
-            device->receiveCallback_(device->id_, (const uint8_t*) transfer->buffer, transfer->actual_length, device->receiveCookie_, rc);
+    fresh = freespace_private_bufferAcquire();
+    if (fresh == NULL) {
+        device->receiveBufferCallback_(device->id_, NULL, device->receiveBufferCookie_, FREESPACE_ERROR_OUT_OF_MEMORY);
+        return;
+    }
+
+    lent = rt->buffer_;
+    lent->length_ = rt->transfer_->actual_length;
+    rt->buffer_ = fresh;
+    rt->transfer_->buffer = fresh->data_;
+
+    device->receiveBufferCallback_(device->id_, lent, device->receiveBufferCookie_, FREESPACE_SUCCESS);
+    freespace_bufferRelease(lent);
+}
+
+// Copy a report that was kept for freespace_read into a pooled buffer
+// for the receive buffer callback, once a callback is set.
+static void lendReportCopy(struct FreespaceDevice* device, const uint8_t* report, int length, int rc) {
+    struct FreespaceBuffer* buffer;
+
+    if (rc != FREESPACE_SUCCESS) {
+        device->receiveBufferCallback_(device->id_, NULL, device->receiveBufferCookie_, rc);
+        return;
+    }
+
+    buffer = freespace_private_bufferAcquire();
+    if (buffer == NULL) {
+        device->receiveBufferCallback_(device->id_, NULL, device->receiveBufferCookie_, FREESPACE_ERROR_OUT_OF_MEMORY);
+        return;
+    }
+    memcpy(buffer->data_, report, length);
+    buffer->length_ = length;
+    device->receiveBufferCallback_(device->id_, buffer, device->receiveBufferCookie_, FREESPACE_SUCCESS);
+    freespace_bufferRelease(buffer);
+}
+
+// Run the receive callbacks on one report. rt is the transfer it came
+// in on, whose buffer is lent out, or NULL if it was kept in the sync
+// queue.
+static void deliverReceive(struct FreespaceDevice* device,
+                           struct FreespaceReceiveTransfer* rt,
+                           const uint8_t* report,
+                           int length,
+                           int rc) {
+    struct libusb_transfer* transfer = rt != NULL ? rt->transfer_ : NULL;
+
+    if (device->receiveCallback_ != NULL) {
+        FREESPACE_TRACE_BEGIN("callback", device->id_);
+        FREESPACE_PROBE1(callback__entry, device->id_);
+        device->receiveCallback_(device->id_, report, length, device->receiveCookie_, rc);
+        FREESPACE_PROBE1(callback__return, device->id_);
+        FREESPACE_TRACE_END("callback", device->id_);
+    }
+    if (device->receiveMessageCallback_ != NULL) {
+        struct freespace_message m;
+        int decodeRc = rc;
+
+        if (decodeRc == FREESPACE_SUCCESS) {
+            FREESPACE_TRACE_BEGIN("decode", device->id_);
+            decodeRc = freespace_decode_message(report, length, &m, device->api_->hVer_);
+            FREESPACE_TRACE_END("decode", device->id_);
+            FREESPACE_PROBE3(decode__done, device->id_, decodeRc == FREESPACE_SUCCESS ? m.messageType : -1, decodeRc);
+        }
+        FREESPACE_TRACE_BEGIN("callback", device->id_);
+        FREESPACE_PROBE1(callback__entry, device->id_);
+        if (decodeRc == FREESPACE_SUCCESS) {
+            device->receiveMessageCallback_(device->id_, &m, device->receiveMessageCookie_, FREESPACE_SUCCESS);
+        } else {
+            device->receiveMessageCallback_(device->id_, NULL, device->receiveMessageCookie_, decodeRc);
+        }
+        FREESPACE_PROBE1(callback__return, device->id_);
+        FREESPACE_TRACE_END("callback", device->id_);
+    }
+    // A callback above may have closed the device and freed the transfer.
+    if (device->receiveBufferCallback_ != NULL && (rt == NULL || rt->transfer_ == transfer)) {
+        FREESPACE_TRACE_BEGIN("callback", device->id_);
+        FREESPACE_PROBE1(callback__entry, device->id_);
+        if (rt != NULL) {
+            lendReceiveBuffer(device, rt);
+        } else {
+            lendReportCopy(device, report, length, rc);
+        }
+        FREESPACE_PROBE1(callback__return, device->id_);
+        FREESPACE_TRACE_END("callback", device->id_);
+    }
+}
+
+// Deliver up to maxReports completed receives (no limit if <= 0) to the
+// async callbacks and resubmit their transfers. drained is set once
+// nothing more is waiting on the device. Reports that only
+// freespace_read wants are moved to the sync queue so that the
+// transfers keep going for the requests, flash record reads,
+// subscriptions and mailboxes.
+static int dispatchReceive(struct FreespaceDevice* device, int maxReports, int* numDispatched, int* drained) {
+    struct FreespaceReceiveTransfer* rt;
+    struct libusb_transfer* transfer;
+    uint8_t report[FREESPACE_MAX_INPUT_MESSAGE_SIZE];
+    int64_t dispatchStart;
+    int length;
+    int rc;
+
+    *numDispatched = 0;
+    *drained = 0;
+
+    // Reports kept for freespace_read before a callback was set
+    while (device->syncQueue_.count_ > 0 && hasReceiveCallback(device) &&
+           device->state_ == FREESPACE_OPENED) {
+        if (maxReports > 0 && *numDispatched >= maxReports) {
+            return FREESPACE_SUCCESS;
+        }
+        rc = freespace_private_syncQueuePop(&device->syncQueue_, report, sizeof(report), &length);
+        deliverReceive(device, NULL, report, length, rc);
+        (*numDispatched)++;
+    }
+
+    for (;;) {
+        // A callback may have closed the device.
+        if (device->state_ != FREESPACE_OPENED || !isAsyncReceive(device)) {
+            *drained = 1;
+            break;
+        }
+
+        rt = &device->receiveQueue_[device->receiveQueueHead_];
+        transfer = rt->transfer_;
+        if (transfer == NULL || rt->submitted_) {
+            *drained = 1;
+            break;
+        }
+        if (maxReports > 0 && *numDispatched >= maxReports) {
+            break;
+        }
+
+        rc = libusb_transfer_status_to_freespace_error(transfer->status);
+        FREESPACE_TRACE_INSTANT("report", device->id_);
+        FREESPACE_PROBE3(report__received, device->id_, transfer->actual_length,
+                         transfer->actual_length > 0 ? transfer->buffer[0] : -1);
+        if (rc == FREESPACE_SUCCESS) {
+            FREESPACE_RECORD(device->id_, device->api_->hVer_, FREESPACE_RECORD_INBOUND,
+                             transfer->buffer, transfer->actual_length);
+            FREESPACE_PUBLISH(device->id_, device->api_->hVer_, transfer->buffer, transfer->actual_length);
+            FREESPACE_RATE_RECEIVED(device->id_);
         }
-        if (device->receiveMessageCallback_ != NULL) {
-            struct freespace_message m;
-            
-            rc = freespace_decode_message((const uint8_t*) transfer->buffer, transfer->actual_length, &m, device->api_->hVer_);
-            if (rc == FREESPACE_SUCCESS) {
-                device->receiveMessageCallback_(device->id_, &m, device->receiveMessageCookie_, FREESPACE_SUCCESS);
-            } else {
-                device->receiveMessageCallback_(device->id_, NULL, device->receiveMessageCookie_, rc);
-            }
+        FREESPACE_RATE_DISPATCH_BEGIN(dispatchStart);
+        // Conflated reports are read with freespace_getLatest instead,
+        // and responses to requests, flash record responses and
+        // subscribed ones have already been handled.
+        if (rc == FREESPACE_SUCCESS &&
+            interceptReceive(device, (const uint8_t*) transfer->buffer, transfer->actual_length)) {
+            // Handled
+        } else if (hasReceiveCallback(device)) {
+            deliverReceive(device, rt, (const uint8_t*) transfer->buffer, transfer->actual_length, rc);
+        } else {
+            freespace_private_syncQueuePush(&device->syncQueue_, (const uint8_t*) transfer->buffer,
+                                            transfer->actual_length, rc);
+        }
+        FREESPACE_RATE_DISPATCH_END(dispatchStart);
+        (*numDispatched)++;
+
+        if (rt->transfer_ != transfer) {
+            // Closed from the callback and the transfer freed.
+            *drained = 1;
+            break;
         }
 
         // Re-submit the transfer for the to get the next receive going.
         // NOTE: Can't handle any error returns here.
+        rt->submitted_ = 1;
         libusb_submit_transfer(transfer);
-    } else {
-        // Using sync interface, so queue.
-        rt->submitted_ = 0;
+        device->receiveQueueHead_++;
+        if (device->receiveQueueHead_ >= FREESPACE_RECEIVE_QUEUE_SIZE) {
+            device->receiveQueueHead_ = 0;
+        }
+    }
+
+    return FREESPACE_SUCCESS;
+}
+
+static void freeReceiveTransfer(struct FreespaceReceiveTransfer* rt) {
+    libusb_free_transfer(rt->transfer_);
+    rt->transfer_ = NULL;
+    if (rt->buffer_ != NULL) {
+        freespace_bufferRelease(rt->buffer_);
+        rt->buffer_ = NULL;
     }
 }
 
@@ -422,14 +1138,12 @@ int freespace_terminateReceiveTransfers(struct FreespaceDevice* device) {
                     canceledCount++;
                 } else {
                     // Force free on error.
-                    libusb_free_transfer(rt->transfer_);
-                    rt->transfer_ = NULL;
+                    freeReceiveTransfer(rt);
                     rt->submitted_ = 0;
                 }
             } else {
                 // Not submitted to libusb, so this can be freed immediatedly.
-                libusb_free_transfer(rt->transfer_);
-                rt->transfer_ = NULL;
+                freeReceiveTransfer(rt);
             }
         }
     }
@@ -453,8 +1167,7 @@ int freespace_terminateReceiveTransfers(struct FreespaceDevice* device) {
             struct FreespaceReceiveTransfer* rt = &device->receiveQueue_[i];
             if (rt->transfer_ != NULL && rt->submitted_ == 0) {
                 // Cancel completed.
-                libusb_free_transfer(rt->transfer_);
-                rt->transfer_ = NULL;
+                freeReceiveTransfer(rt);
                 canceledCount--;
             }
         }
@@ -466,8 +1179,7 @@ int freespace_terminateReceiveTransfers(struct FreespaceDevice* device) {
     for (i = 0; i < FREESPACE_RECEIVE_QUEUE_SIZE; i++) {
         struct FreespaceReceiveTransfer* rt = &device->receiveQueue_[i];
         if (rt->transfer_ != NULL) {
-            libusb_free_transfer(rt->transfer_);
-            rt->transfer_ = NULL;
+            freeReceiveTransfer(rt);
         }
     }
 
@@ -479,14 +1191,26 @@ int freespace_initiateReceiveTransfers(struct FreespaceDevice* device) {
     int i;
 
     device->receiveQueueHead_ = 0;
+    freespace_private_syncQueueClear(&device->syncQueue_);
     for (i = 0; i < FREESPACE_RECEIVE_QUEUE_SIZE; i++) {
         struct FreespaceReceiveTransfer* rt = &device->receiveQueue_[i];
         rt->device_ = device;
+        rt->buffer_ = freespace_private_bufferAcquire();
         rt->transfer_ = libusb_alloc_transfer(0);
+        if (rt->buffer_ == NULL || rt->transfer_ == NULL) {
+            if (rt->transfer_ != NULL) {
+                freeReceiveTransfer(rt);
+            } else if (rt->buffer_ != NULL) {
+                freespace_bufferRelease(rt->buffer_);
+                rt->buffer_ = NULL;
+            }
+            freespace_terminateReceiveTransfers(device);
+            return FREESPACE_ERROR_OUT_OF_MEMORY;
+        }
         libusb_fill_interrupt_transfer(rt->transfer_,
                                        device->handle_,
                                        device->readEndpointAddress_,
-                                       rt->buffer_,
+                                       rt->buffer_->data_,
                                        device->maxReadSize_,
                                        receiveCallback,
                                        rt,
@@ -503,20 +1227,35 @@ int freespace_initiateReceiveTransfers(struct FreespaceDevice* device) {
     return libusb_to_freespace_error(rc);
 }
 
-int freespace_openDevice(FreespaceDeviceId id) {
-    struct FreespaceDevice* device = findDeviceById(id);
+// Release everything acquired by openDeviceHandle().
+static void closeDeviceHandle(struct FreespaceDevice* device) {
+    // Release our lock on the interface.
+    libusb_release_interface(device->handle_, device->api_->controlInterfaceNumber_);
+
+    // Re-attach the kernel driver if we detached it before.
+    if (device->kernelDriverDetached_) {
+        // This currently fails, and there doesn't seem to be anything that we
+        // can do.
+        libusb_attach_kernel_driver(device->handle_, device->api_->controlInterfaceNumber_);
+        device->kernelDriverDetached_ = 0;
+    }
+    libusb_close(device->handle_);
+    device->handle_ = NULL;
+}
+
+// Open the USB device, claim the control interface and find its endpoints.
+// Only dev_, api_ and the fields filled in here are used, so this can run
+// on a worker thread against a scratch FreespaceDevice.
+static int openDeviceHandle(struct FreespaceDevice* device) {
     struct libusb_config_descriptor *config;
     const struct libusb_interface_descriptor* intd;
     int controlInterfaceNumber;
     int i;
     int rc;
 
-    if (device == NULL) {
-        return FREESPACE_ERROR_NOT_FOUND;
-    }
-
     rc = libusb_open(device->dev_, &device->handle_);
     if (rc != LIBUSB_SUCCESS) {
+        device->handle_ = NULL;
         return libusb_to_freespace_error(rc);
     }
 
@@ -532,11 +1271,13 @@ int freespace_openDevice(FreespaceDeviceId id) {
 
     rc = libusb_claim_interface(device->handle_, controlInterfaceNumber);
     if (rc != LIBUSB_SUCCESS) {
+        closeDeviceHandle(device);
         return libusb_to_freespace_error(rc);
     }
 
     rc = libusb_get_active_config_descriptor(device->dev_, &config);
     if (rc != LIBUSB_SUCCESS) {
+        closeDeviceHandle(device);
         return libusb_to_freespace_error(rc);
     }
 
@@ -553,50 +1294,252 @@ int freespace_openDevice(FreespaceDeviceId id) {
             device->maxWriteSize_ = endpoint->wMaxPacketSize;
         }
     }
+    libusb_free_config_descriptor(config);
+
     if (device->maxReadSize_ == 0 || device->maxWriteSize_ == 0) {
         // Weird.  The device didn't have a read and write endpoint.
+        closeDeviceHandle(device);
         return FREESPACE_ERROR_UNEXPECTED;
     }
 
+    return FREESPACE_SUCCESS;
+}
+
+static int freespace_libusb_openDevice(FreespaceDeviceId id) {
+    struct FreespaceDevice* device = findDeviceById(id);
+    int rc;
+
+    if (device == NULL) {
+        return FREESPACE_ERROR_NOT_FOUND;
+    }
+
+    FREESPACE_TRACE_BEGIN("open", id);
+    rc = reserveDevice(device);
+    if (rc != FREESPACE_SUCCESS) {
+        FREESPACE_TRACE_END("open", id);
+        return rc;
+    }
+    rc = openDeviceHandle(device);
+    if (rc != FREESPACE_SUCCESS) {
+        unreserveDevice(device);
+        FREESPACE_TRACE_END("open", id);
+        return rc;
+    }
+
     device->state_ = FREESPACE_OPENED;
 
     // Start the receive queue working.
     rc = freespace_initiateReceiveTransfers(device);
+    FREESPACE_TRACE_END("open", id);
+    return rc;
+}
+
+/**
+ * An open running on the worker pool. The USB work is done against
+ * scratch_, which is copied into the real device on completion.
+ */
+struct FreespaceOpenJob {
+    struct FreespaceWorkItem item_;
+
+    FreespaceDeviceId id_;
+    struct FreespaceDevice scratch_;
+    int rc_;
+
+    freespace_openCallback callback_;
+    void* cookie_;
+};
+
+static int startWorkers() {
+    int rc;
+
+    if (freespace_workers_getFD() >= 0) {
+        return FREESPACE_SUCCESS;
+    }
+
+    rc = freespace_workers_init();
+    if (rc != FREESPACE_SUCCESS) {
+        return rc;
+    }
+
+    if (userAddedCallback != NULL) {
+        userAddedCallback(freespace_workers_getFD(), POLLIN);
+    }
+    return FREESPACE_SUCCESS;
+}
+
+static void openJobWork(struct FreespaceWorkItem* item) {
+    struct FreespaceOpenJob* job = (struct FreespaceOpenJob*) item;
+    job->rc_ = openDeviceHandle(&job->scratch_);
+}
+
+static void openJobDone(struct FreespaceWorkItem* item) {
+    struct FreespaceOpenJob* job = (struct FreespaceOpenJob*) item;
+    struct FreespaceDevice* device = NULL;
+
+    if (!item->cancelled_) {
+        device = findDeviceById(job->id_);
+        if (device == NULL || device->dev_ != job->scratch_.dev_ ||
+            device->state_ == FREESPACE_DISCONNECTED) {
+            // Unplugged while we were opening it
+            device = NULL;
+            if (job->rc_ == FREESPACE_SUCCESS) {
+                job->rc_ = FREESPACE_ERROR_NO_DEVICE;
+            }
+        } else if (device->state_ == FREESPACE_OPENED) {
+            // Opened synchronously in the meantime
+            device = NULL;
+        }
+    }
+
+    if (device != NULL && job->rc_ == FREESPACE_SUCCESS) {
+        job->rc_ = reserveDevice(device);
+    }
+
+    if (device != NULL && job->rc_ == FREESPACE_SUCCESS) {
+        device->handle_ = job->scratch_.handle_;
+        device->kernelDriverDetached_ = job->scratch_.kernelDriverDetached_;
+        device->readEndpointAddress_ = job->scratch_.readEndpointAddress_;
+        device->maxReadSize_ = job->scratch_.maxReadSize_;
+        device->writeEndpointAddress_ = job->scratch_.writeEndpointAddress_;
+        device->maxWriteSize_ = job->scratch_.maxWriteSize_;
+        job->scratch_.handle_ = NULL;
+
+        device->state_ = FREESPACE_OPENED;
+        job->rc_ = freespace_initiateReceiveTransfers(device);
+    } else if (job->scratch_.handle_ != NULL) {
+        closeDeviceHandle(&job->scratch_);
+    }
+
+    if (!item->cancelled_ && job->callback_ != NULL) {
+        job->callback_(job->id_, job->cookie_, job->rc_);
+    }
+
+    libusb_unref_device(job->scratch_.dev_);
+    freespace_private_free(job);
+}
+
+static int submitOpenJob(struct FreespaceDevice* device,
+                         freespace_openCallback callback,
+                         void* cookie) {
+    int rc;
+    struct FreespaceOpenJob* job;
+
+    job = (struct FreespaceOpenJob*) freespace_private_malloc(sizeof(struct FreespaceOpenJob));
+    if (job == NULL) {
+        return FREESPACE_ERROR_OUT_OF_MEMORY;
+    }
+    memset(job, 0, sizeof(struct FreespaceOpenJob));
+    job->id_ = device->id_;
+    job->scratch_.dev_ = libusb_ref_device(device->dev_);
+    job->scratch_.api_ = device->api_;
+    job->callback_ = callback;
+    job->cookie_ = cookie;
+
+    rc = freespace_workers_submit(&job->item_, openJobWork, openJobDone);
+    if (rc != FREESPACE_SUCCESS) {
+        libusb_unref_device(job->scratch_.dev_);
+        freespace_private_free(job);
+    }
     return rc;
 }
 
-void freespace_closeDevice(FreespaceDeviceId id) {
+static int freespace_libusb_openDeviceAsync(FreespaceDeviceId id,
+                                            freespace_openCallback callback,
+                                            void* cookie) {
+    struct FreespaceDevice* device = findDeviceById(id);
+    int rc;
+
+    if (device == NULL) {
+        return FREESPACE_ERROR_NOT_FOUND;
+    }
+
+    if (device->state_ == FREESPACE_DISCONNECTED) {
+        return FREESPACE_ERROR_NO_DEVICE;
+    }
+
+    if (device->state_ == FREESPACE_OPENED) {
+        if (callback != NULL) {
+            callback(id, cookie, FREESPACE_SUCCESS);
+        }
+        return FREESPACE_SUCCESS;
+    }
+
+    rc = startWorkers();
+    if (rc != FREESPACE_SUCCESS) {
+        return rc;
+    }
+
+    return submitOpenJob(device, callback, cookie);
+}
+
+static int freespace_libusb_openAllDevicesAsync(freespace_openCallback callback, void* cookie) {
+    int i;
+    int rc;
+
+    rc = startWorkers();
+    if (rc != FREESPACE_SUCCESS) {
+        return rc;
+    }
+
+    rc = scanDevices();
+    if (rc != FREESPACE_SUCCESS) {
+        return rc;
+    }
+
+    for (i = 0; i < FREESPACE_MAXIMUM_DEVICE_COUNT; i++) {
+        struct FreespaceDevice* device = devices[i];
+        if (device == NULL || device->state_ != FREESPACE_CONNECTED) {
+            continue;
+        }
+
+        rc = submitOpenJob(device, callback, cookie);
+        if (rc != FREESPACE_SUCCESS) {
+            return rc;
+        }
+    }
+
+    return FREESPACE_SUCCESS;
+}
+
+static void freespace_libusb_closeDevice(FreespaceDeviceId id) {
     struct FreespaceDevice* device;
     device = findDeviceById(id);
     if (device != NULL && device->handle_ != NULL) {
+        FREESPACE_TRACE_BEGIN("close", id);
         // Stop receives.
         freespace_terminateReceiveTransfers(device);
 
         // Should we wait until everything terminates cleanly?
 
-        // Release our lock on the interface.
-        libusb_release_interface(device->handle_, device->api_->controlInterfaceNumber_);
-
-        // Re-attach the kernel driver if we detached it before.
-        if (device->kernelDriverDetached_) {
-            // This currently fails, and there doesn't seem to be anything that we
-            // can do.
-            libusb_attach_kernel_driver(device->handle_, device->api_->controlInterfaceNumber_);
-        }
-        libusb_close(device->handle_);
-        device->handle_ = NULL;
+        closeDeviceHandle(device);
+        unreserveDevice(device);
+        freespace_private_requestReset(id);
+        freespace_private_frsReset(id);
+        freespace_private_mailboxReset(id);
+        freespace_private_rateReset(id);
+        freespace_private_subscriptionReset(id);
 
         if (device->state_ == FREESPACE_DISCONNECTED) {
             removeFreespaceDevice(device);
         } else {
             device->state_ = FREESPACE_CONNECTED;
         }
+        FREESPACE_TRACE_END("close", id);
+    }
+}
+
+static int freespace_libusb_checkOpen(FreespaceDeviceId id) {
+    struct FreespaceDevice* device = findDeviceById(id);
+
+    if (device == NULL || device->state_ != FREESPACE_OPENED) {
+        return FREESPACE_ERROR_NOT_FOUND;
     }
+    return FREESPACE_SUCCESS;
 }
 
-int freespace_private_send(FreespaceDeviceId id,
-                           const uint8_t* message,
-                           int length) {
+static int freespace_libusb_send(FreespaceDeviceId id,
+                                 const uint8_t* message,
+                                 int length) {
     int rc;
     int count;
     struct FreespaceDevice* device;
@@ -611,7 +1554,12 @@ int freespace_private_send(FreespaceDeviceId id,
         return FREESPACE_ERROR_SEND_TOO_LARGE;
     }
 
+    FREESPACE_PROBE2(write__submitted, id, length);
+    FREESPACE_RECORD(id, device->api_->hVer_, FREESPACE_RECORD_OUTBOUND, message, length);
+    FREESPACE_TRACE_BEGIN("write", id);
     rc = libusb_interrupt_transfer(device->handle_, device->writeEndpointAddress_, (unsigned char*) message, length, &count, 0);
+    FREESPACE_TRACE_END("write", id);
+    FREESPACE_PROBE2(write__completed, id, libusb_to_freespace_error(rc));
     if (rc != LIBUSB_SUCCESS) {
         return libusb_to_freespace_error(rc);
     }
@@ -623,8 +1571,8 @@ int freespace_private_send(FreespaceDeviceId id,
     return FREESPACE_SUCCESS;
 }
 
-int freespace_sendMessage(FreespaceDeviceId id,
-                          struct freespace_message* message) {
+static int freespace_libusb_sendMessage(FreespaceDeviceId id,
+                                        struct freespace_message* message) {
     int rc;
     uint8_t msgBuf[FREESPACE_MAX_OUTPUT_MESSAGE_SIZE];
     struct FreespaceDeviceInfo info;
@@ -634,7 +1582,7 @@ int freespace_sendMessage(FreespaceDeviceId id,
         message->dest = FREESPACE_RESERVED_ADDRESS;
     }
 
-    rc = freespace_getDeviceInfo(id, &info);
+    rc = freespace_libusb_getDeviceInfo(id, &info);
     if (rc != FREESPACE_SUCCESS) {
         return rc;
     }
@@ -645,16 +1593,18 @@ int freespace_sendMessage(FreespaceDeviceId id,
         return rc;
     }
     
-    return freespace_private_send(id, msgBuf, rc);
+    return freespace_libusb_send(id, msgBuf, rc);
 }
 
-int freespace_private_read(FreespaceDeviceId id,
-                           uint8_t* message,
-                           int maxLength,
-                           unsigned int timeoutMs,
-                           int* actualLength) {
+static int freespace_libusb_read(FreespaceDeviceId id,
+                                 uint8_t* message,
+                                 int maxLength,
+                                 unsigned int timeoutMs,
+                                 int* actualLength) {
     struct FreespaceDevice* device = findDeviceById(id);
     struct FreespaceReceiveTransfer* rt;
+    int64_t deadline;
+    int64_t now;
     int rc;
 
     if (device == NULL || device->state_ != FREESPACE_OPENED) {
@@ -667,67 +1617,90 @@ int freespace_private_read(FreespaceDeviceId id,
         return FREESPACE_ERROR_RECEIVE_BUFFER_TOO_SMALL;
     }
 
-    rt = &device->receiveQueue_[device->receiveQueueHead_];
+    // Reports that freespace_perform already took off the device
+    rc = freespace_private_syncQueuePop(&device->syncQueue_, message, maxLength, actualLength);
+    if (rc != FREESPACE_ERROR_NO_DATA) {
+        return rc;
+    }
+
+    deadline = nowMicros() + (int64_t) timeoutMs * 1000;
+    for (;;) {
+        rt = &device->receiveQueue_[device->receiveQueueHead_];
 
-    // Check if we need to wait.
-    if (rt->submitted_ != 0) {
-        struct timeval tv;
+        // Check if we need to wait.
+        if (rt->submitted_ != 0) {
+            struct timeval tv;
 
-        tv.tv_sec = timeoutMs / 1000;
-        tv.tv_usec = (timeoutMs % 1000) * 1000;
+            tv.tv_sec = timeoutMs / 1000;
+            tv.tv_usec = (timeoutMs % 1000) * 1000;
 
-        // Wait.
-        do {
-            rc = libusb_handle_events_timeout(freespace_libusb_context, &tv);
-            if (rc != LIBUSB_SUCCESS) {
-                return libusb_to_freespace_error(rc);
-            }
+            // Wait.
+            do {
+                rc = libusb_handle_events_timeout(freespace_libusb_context, &tv);
+                if (rc != LIBUSB_SUCCESS) {
+                    return libusb_to_freespace_error(rc);
+                }
 
-            // Keep trying until something has been received.
-            // Note that libusb_handle_events_timeout could return
-            // without a receive if it ends up doing some other
-            // processing such as an async send completion or
-            // something on another device.
+                // Keep trying until something has been received.
+                // Note that libusb_handle_events_timeout could return
+                // without a receive if it ends up doing some other
+                // processing such as an async send completion or
+                // something on another device.
 
-            // TODO: update tv with time left.
-            timeoutMs = 0;
-        } while (rt->submitted_ != 0 && timeoutMs > 0);
+                // TODO: update tv with time left.
+                timeoutMs = 0;
+            } while (rt->submitted_ != 0 && timeoutMs > 0);
 
-        if (rt->submitted_ != 0) {
-            return LIBUSB_ERROR_TIMEOUT;
+            if (rt->submitted_ != 0) {
+                return LIBUSB_ERROR_TIMEOUT;
+            }
         }
-    }
 
-    // Copy the message out.
-    *actualLength = rt->transfer_->actual_length;
-    memcpy(message, rt->buffer_, *actualLength);
-    rc = libusb_transfer_status_to_freespace_error(rt->transfer_->status);
+        // Copy the message out.
+        *actualLength = rt->transfer_->actual_length;
+        memcpy(message, rt->buffer_->data_, *actualLength);
+        rc = libusb_transfer_status_to_freespace_error(rt->transfer_->status);
+        if (rc == FREESPACE_SUCCESS) {
+            FREESPACE_RECORD(id, device->api_->hVer_, FREESPACE_RECORD_INBOUND, message, *actualLength);
+            FREESPACE_PUBLISH(id, device->api_->hVer_, message, *actualLength);
+        }
 
-    // Resubmit the transfer
-    rt->submitted_ = 1;
-    libusb_submit_transfer(rt->transfer_);
-    device->receiveQueueHead_++;
-    if (device->receiveQueueHead_ >= FREESPACE_RECEIVE_QUEUE_SIZE) {
-        device->receiveQueueHead_ = 0;
-    }
+        // Resubmit the transfer
+        rt->submitted_ = 1;
+        libusb_submit_transfer(rt->transfer_);
+        device->receiveQueueHead_++;
+        if (device->receiveQueueHead_ >= FREESPACE_RECEIVE_QUEUE_SIZE) {
+            device->receiveQueueHead_ = 0;
+        }
 
-    return rc;
+        if (rc != FREESPACE_SUCCESS || !interceptReceive(device, message, *actualLength)) {
+            return rc;
+        }
+
+        // Taken by a request, flash record read, subscription or
+        // mailbox, so wait for the next one in the time left.
+        now = nowMicros();
+        if (now >= deadline) {
+            return FREESPACE_ERROR_TIMEOUT;
+        }
+        timeoutMs = (unsigned int) ((deadline - now + 999) / 1000);
+    }
 }
 
-int freespace_readMessage(FreespaceDeviceId id,
-                          struct freespace_message* message,
-                          unsigned int timeoutMs) {
+static int freespace_libusb_readMessage(FreespaceDeviceId id,
+                                        struct freespace_message* message,
+                                        unsigned int timeoutMs) {
     int rc;
     uint8_t buffer[FREESPACE_MAX_INPUT_MESSAGE_SIZE];
     int actLen;
     struct FreespaceDeviceInfo info;
     
-    rc = freespace_getDeviceInfo(id, &info);
+    rc = freespace_libusb_getDeviceInfo(id, &info);
     if (rc != FREESPACE_SUCCESS) {
         return rc;
     }
     
-    rc = freespace_private_read(id, buffer, sizeof(buffer), timeoutMs, &actLen);
+    rc = freespace_libusb_read(id, buffer, sizeof(buffer), timeoutMs, &actLen);
     
     if (rc == FREESPACE_SUCCESS) {
         return freespace_decode_message(buffer, actLen, message, info.hVer);
@@ -736,7 +1709,7 @@ int freespace_readMessage(FreespaceDeviceId id,
     }
 }
 
-int freespace_flush(FreespaceDeviceId id) {
+static int freespace_libusb_flush(FreespaceDeviceId id) {
     struct FreespaceDevice* device = findDeviceById(id);
     struct FreespaceReceiveTransfer* rt;
     struct timeval tv;
@@ -747,6 +1720,7 @@ int freespace_flush(FreespaceDeviceId id) {
         return FREESPACE_ERROR_NOT_FOUND;
     }
 
+    freespace_private_syncQueueClear(&device->syncQueue_);
 
     // As long as there's work, try again.
     do {
@@ -778,31 +1752,29 @@ int freespace_flush(FreespaceDeviceId id) {
     return FREESPACE_SUCCESS;
 }
 
-struct SendTransferInfo {
-    FreespaceDeviceId id;
-    freespace_sendCallback callback;
-    void* cookie;
-};
-
 static void sendCallback(struct libusb_transfer* transfer) {
     struct SendTransferInfo* info = (struct SendTransferInfo*) transfer->user_data;
     int rc = libusb_transfer_status_to_freespace_error(transfer->status);
-    info->callback(info->id, info->cookie, rc);
 
-    free(info);
+    FREESPACE_TRACE_INSTANT("sendComplete", info->id);
+    FREESPACE_PROBE2(write__completed, info->id, rc);
+    if (info->callback != NULL) {
+        info->callback(info->id, info->cookie, rc);
+    }
+    putSendTransfer(info);
 }
 
-int freespace_private_sendAsync(FreespaceDeviceId id,
-                                const uint8_t* message,
-                                int length,
-                                unsigned int timeoutMs,
-                                freespace_sendCallback callback,
-                                void* cookie) {
+static int freespace_libusb_sendAsync(FreespaceDeviceId id,
+                                      const uint8_t* message,
+                                      int length,
+                                      unsigned int timeoutMs,
+                                      freespace_sendCallback callback,
+                                      void* cookie) {
 #ifdef __APPLE__
     // @TODO: Figure out why libusb on darwin doesn't seem to work with asynchronous messages
     int rc;
 
-    rc = freespace_private_send(id, message, length);
+    rc = freespace_libusb_send(id, message, length);
     if (callback != NULL) {
         callback(id, cookie, rc);
     }
@@ -810,58 +1782,62 @@ int freespace_private_sendAsync(FreespaceDeviceId id,
     return libusb_to_freespace_error(rc);
 #else
     struct FreespaceDevice* device;
-    device = findDeviceById(id);
+    struct SendTransferInfo* info;
     struct libusb_transfer* transfer;
     int rc;
 
+    device = findDeviceById(id);
+
     if (device == NULL || device->state_ != FREESPACE_OPENED) {
         return FREESPACE_ERROR_NOT_FOUND;
     }
 
-    if (length > device->maxWriteSize_) {
+    if (length > device->maxWriteSize_ || length > FREESPACE_MAX_OUTPUT_MESSAGE_SIZE) {
         return FREESPACE_ERROR_SEND_TOO_LARGE;
     }
 
-    transfer = libusb_alloc_transfer(0);
-    if (transfer == NULL) {
+    FREESPACE_HOT_PATH_BEGIN();
+    info = getSendTransfer();
+    FREESPACE_HOT_PATH_END();
+    if (info == NULL) {
         return FREESPACE_ERROR_OUT_OF_MEMORY;
     }
+    info->id = id;
+    info->callback = callback;
+    info->cookie = cookie;
 
+    // Copy the message so that the caller's buffer, often on its stack,
+    // does not need to outlive the transfer.
+    memcpy(info->buffer, message, length);
+
+    transfer = info->transfer;
     transfer->dev_handle = device->handle_;
     transfer->endpoint = device->writeEndpointAddress_;
     transfer->type = LIBUSB_TRANSFER_TYPE_INTERRUPT;
     transfer->timeout = timeoutMs;
-    transfer->buffer = (unsigned char*) message;
+    transfer->buffer = info->buffer;
     transfer->length = length;
-    transfer->flags = LIBUSB_TRANSFER_FREE_TRANSFER;
-
-    if (callback != NULL) {
-        struct SendTransferInfo* info = (struct SendTransferInfo*) malloc(sizeof(struct SendTransferInfo));
-    	if (info == NULL) {
-    	    libusb_free_transfer(transfer);
-            return FREESPACE_ERROR_OUT_OF_MEMORY;
-    	}
-    	info->id = id;
-        info->callback = callback;
-        info->cookie = cookie;
-    	transfer->callback = sendCallback;
-    	transfer->user_data = info;
-    } else {
-    	transfer->callback = NULL;
-    	transfer->user_data = NULL;
-    }
+    transfer->flags = 0;
+    transfer->callback = sendCallback;
+    transfer->user_data = info;
 
+    FREESPACE_TRACE_INSTANT("sendEnqueue", id);
+    FREESPACE_PROBE2(write__submitted, id, length);
+    FREESPACE_RECORD(id, device->api_->hVer_, FREESPACE_RECORD_OUTBOUND, message, length);
     rc = libusb_submit_transfer(transfer);
+    if (rc != LIBUSB_SUCCESS) {
+        putSendTransfer(info);
+    }
 
     return libusb_to_freespace_error(rc);
 #endif
 }
 
-int freespace_sendMessageAsync(FreespaceDeviceId id,
-                               struct freespace_message* message,
-                               unsigned int timeoutMs,
-                               freespace_sendCallback callback,
-                               void* cookie) {
+static int freespace_libusb_sendMessageAsync(FreespaceDeviceId id,
+                                             struct freespace_message* message,
+                                             unsigned int timeoutMs,
+                                             freespace_sendCallback callback,
+                                             void* cookie) {
 
     int rc;
     uint8_t msgBuf[FREESPACE_MAX_OUTPUT_MESSAGE_SIZE];
@@ -872,7 +1848,7 @@ int freespace_sendMessageAsync(FreespaceDeviceId id,
         message->dest = FREESPACE_RESERVED_ADDRESS;
     }
     
-    rc = freespace_getDeviceInfo(id, &info);
+    rc = freespace_libusb_getDeviceInfo(id, &info);
     if (rc != FREESPACE_SUCCESS) {
         return rc;
     }
@@ -883,41 +1859,125 @@ int freespace_sendMessageAsync(FreespaceDeviceId id,
         return rc;
     }
 
-    return freespace_private_sendAsync(id, msgBuf, rc, timeoutMs, callback, cookie);
+    return freespace_libusb_sendAsync(id, msgBuf, rc, timeoutMs, callback, cookie);
 }
 
-int freespace_getNextTimeout(int* timeoutMsOut) {
+static int freespace_libusb_getNextTimeout(int* timeoutMsOut) {
     struct timeval tv;
-    int hotplugTimeout = freespace_hotplug_timeout();
+    int hotplugTimeout = nativeHotplug == 1 ? -1 : freespace_hotplug_timeout();
     int timeoutMs;
+    int i;
 
     int rc = libusb_get_next_timeout(freespace_libusb_context, &tv);
     if (rc == 1) {
         // libusb has a timeout
         timeoutMs = tv.tv_sec * 1000 + tv.tv_usec / 1000;
 
-        if (hotplugTimeout > 0 && hotplugTimeout < timeoutMs) {
+        if (hotplugTimeout >= 0 && hotplugTimeout < timeoutMs) {
             timeoutMs = hotplugTimeout;
         }
-    } else if (rc == 0 && hotplugTimeout > 0) {
+    } else if (rc == 0 && hotplugTimeout >= 0) {
         // The hotplug code has a timeout.
         timeoutMs = hotplugTimeout;
     } else {
         // No one has a timeout.
         timeoutMs = -1;
     }
+
+#ifdef FREESPACE_LIBUSB_HOTPLUG
+    // Hotplug events queued during the last libusb call
+    if (nativeHotplugQueued > 0 || nativeHotplugOverflow) {
+        timeoutMs = 0;
+    }
+#endif
+
+    // Completed receives left over by freespace_performBudget have
+    // already been taken off the file descriptors, so nothing would
+    // wake poll for them.
+    for (i = 0; i < FREESPACE_MAXIMUM_DEVICE_COUNT && timeoutMs != 0; i++) {
+        struct FreespaceDevice* device = devices[i];
+        if (device != NULL && device->state_ == FREESPACE_OPENED && hasReceivePending(device)) {
+            timeoutMs = 0;
+        }
+    }
     *timeoutMsOut = timeoutMs;
     return libusb_to_freespace_error(rc);
 }
 
-int freespace_perform() {
+static int freespace_libusb_performBudget(int maxReports, int maxMicros, int* workRemaining) {
     struct timeval tv = {0, 0};
+    int64_t deadline = 0;
+    int reports = 0;
+    int pending;
+    int i;
     int rc;
 
+    if (workRemaining != NULL) {
+        *workRemaining = 0;
+    }
+    if (maxMicros > 0) {
+        deadline = nowMicros() + maxMicros;
+    }
+
     scanDevices();
 
+    // Report any background opens that have completed
+    rc = freespace_workers_perform();
+    if (rc != FREESPACE_SUCCESS) {
+        return rc;
+    }
+
+    // This only queues up completed receives
     rc = libusb_handle_events_timeout(freespace_libusb_context, &tv);
-    return libusb_to_freespace_error(rc);
+    if (rc != LIBUSB_SUCCESS) {
+        return libusb_to_freespace_error(rc);
+    }
+
+    // Deliver them round robin, a quantum at a time, starting after the
+    // device that was served last.
+    do {
+        pending = 0;
+        for (i = 0; i < FREESPACE_MAXIMUM_DEVICE_COUNT; i++) {
+            int idx = (performCursor + i) % FREESPACE_MAXIMUM_DEVICE_COUNT;
+            struct FreespaceDevice* device = devices[idx];
+            int quantum = FREESPACE_PERFORM_QUANTUM;
+            int numDispatched;
+            int drained;
+
+            if (device == NULL || device->state_ != FREESPACE_OPENED) {
+                continue;
+            }
+
+            if ((maxReports > 0 && reports >= maxReports) ||
+                (deadline != 0 && reports > 0 && nowMicros() >= deadline)) {
+                // Out of budget. Note every device still waiting.
+                if (hasReceivePending(device)) {
+                    if (workRemaining != NULL) {
+                        *workRemaining = 1;
+                    }
+                    FREESPACE_RATE_BACKLOGGED(device->id_);
+                }
+                continue;
+            }
+
+            if (maxReports > 0 && maxReports - reports < quantum) {
+                quantum = maxReports - reports;
+            }
+
+            FREESPACE_HOT_PATH_BEGIN();
+            dispatchReceive(device, quantum, &numDispatched, &drained);
+            FREESPACE_HOT_PATH_END();
+            reports += numDispatched;
+            if (numDispatched > 0) {
+                performCursor = (idx + 1) % FREESPACE_MAXIMUM_DEVICE_COUNT;
+            }
+            if (!drained) {
+                pending = 1;
+            }
+        }
+    } while (pending);
+
+    return FREESPACE_SUCCESS;
 }
 
 static void pollfd_added_cb(int fd, short events, void* user_data) {
@@ -931,15 +1991,15 @@ static void pollfd_removed_cb(int fd, void* user_data) {
     }
 }
 
-void freespace_setFileDescriptorCallbacks(freespace_pollfdAddedCallback addedCallback,
-                                          freespace_pollfdRemovedCallback removedCallback) {
+static void freespace_libusb_setFileDescriptorCallbacks(freespace_pollfdAddedCallback addedCallback,
+                                                        freespace_pollfdRemovedCallback removedCallback) {
     userAddedCallback = addedCallback;
     userRemovedCallback = removedCallback;
 
     libusb_set_pollfd_notifiers(freespace_libusb_context, pollfd_added_cb, pollfd_removed_cb, NULL);
 }
 
-int freespace_syncFileDescriptors() {
+static int freespace_libusb_syncFileDescriptors() {
     const struct libusb_pollfd** usbfds;
     int i;
 
@@ -947,8 +2007,16 @@ int freespace_syncFileDescriptors() {
         return FREESPACE_SUCCESS;
     }
 
-    // Add the hotplug code's fd
-    userAddedCallback(freespace_hotplug_getFD(), POLLIN);
+    // Add the hotplug code's fd. libusb's own hotplug support uses
+    // its pollfds instead.
+    if (freespace_hotplug_getFD() >= 0) {
+        userAddedCallback(freespace_hotplug_getFD(), POLLIN);
+    }
+
+    // Add the background open completion fd
+    if (freespace_workers_getFD() >= 0) {
+        userAddedCallback(freespace_workers_getFD(), POLLIN);
+    }
 
     // Add all of libusb's handles
     usbfds = libusb_get_pollfds(freespace_libusb_context);
@@ -960,93 +2028,95 @@ int freespace_syncFileDescriptors() {
     return FREESPACE_SUCCESS;
 }
 
-int freespace_private_setReceiveCallback(FreespaceDeviceId id,
-                                         freespace_receiveCallback callback,
-                                         void* cookie) {
+static int freespace_libusb_setReceiveCallback(FreespaceDeviceId id,
+                                               freespace_receiveCallback callback,
+                                               void* cookie) {
     struct FreespaceDevice* device = findDeviceById(id);
     int wereInSyncMode;
+    int numDispatched;
+    int drained;
 
     if (device == NULL) {
         return FREESPACE_ERROR_NOT_FOUND;
     }
 
-    wereInSyncMode = (device->receiveCallback_ == NULL && device->receiveMessageCallback_ == NULL);
+    wereInSyncMode = !hasReceiveCallback(device);
     device->receiveCallback_ = callback;
     device->receiveCookie_ = cookie;
 
     if (callback != NULL && wereInSyncMode && device->state_ == FREESPACE_OPENED) {
         // Transition from sync mode to async mode.
-
         // Need to run the callback on all received messages.
-        struct FreespaceReceiveTransfer* rt;
-        rt = &device->receiveQueue_[device->receiveQueueHead_];
-        while (rt->submitted_ == 0) {
-            callback(device->id_,
-                     (const uint8_t*) rt->buffer_,
-                     rt->transfer_->actual_length,
-                     cookie,
-                     libusb_transfer_status_to_freespace_error(rt->transfer_->status));
-
-            rt->submitted_ = 1;
-            libusb_submit_transfer(rt->transfer_);
-            device->receiveQueueHead_++;
-            if (device->receiveQueueHead_ >= FREESPACE_RECEIVE_QUEUE_SIZE) {
-                device->receiveQueueHead_ = 0;
-            }
-
-            rt = &device->receiveQueue_[device->receiveQueueHead_];
-        }
+        dispatchReceive(device, 0, &numDispatched, &drained);
     }
     return FREESPACE_SUCCESS;
 }
 
-int freespace_setReceiveMessageCallback(FreespaceDeviceId id,
-                                        freespace_receiveMessageCallback callback,
-                                        void* cookie) {
+static int freespace_libusb_setReceiveMessageCallback(FreespaceDeviceId id,
+                                                      freespace_receiveMessageCallback callback,
+                                                      void* cookie) {
     struct FreespaceDevice* device = findDeviceById(id);
     int wereInSyncMode;
-    int rc;
+    int numDispatched;
+    int drained;
 
     if (device == NULL) {
         return FREESPACE_ERROR_NOT_FOUND;
     }
 
-    wereInSyncMode = (device->receiveMessageCallback_ == NULL && device->receiveCallback_ == NULL);
+    wereInSyncMode = !hasReceiveCallback(device);
     device->receiveMessageCallback_ = callback;
     device->receiveMessageCookie_ = cookie;
 
     if (callback != NULL && wereInSyncMode && device->state_ == FREESPACE_OPENED) {
-        struct freespace_message m;
-        
         // Transition from sync mode to async mode.
-
         // Need to run the callback on all received messages.
-        struct FreespaceReceiveTransfer* rt;
-        rt = &device->receiveQueue_[device->receiveQueueHead_];
-        while (rt->submitted_ == 0) {
-            rc = freespace_decode_message((const uint8_t*) rt->buffer_, rt->transfer_->actual_length, &m, device->api_->hVer_);
-            if (rc == FREESPACE_SUCCESS) {
-                callback(device->id_,
-                         &m,
-                         cookie,
-                         libusb_transfer_status_to_freespace_error(rt->transfer_->status));
-            } else {
-                callback(device->id_,
-                         NULL,
-                         cookie,
-                         rc);
-            }
+        dispatchReceive(device, 0, &numDispatched, &drained);
+    }
+    return FREESPACE_SUCCESS;
+}
 
-            rt->submitted_ = 1;
-            libusb_submit_transfer(rt->transfer_);
-            device->receiveQueueHead_++;
-            if (device->receiveQueueHead_ >= FREESPACE_RECEIVE_QUEUE_SIZE) {
-                device->receiveQueueHead_ = 0;
-            }
+static int freespace_libusb_setReceiveBufferCallback(FreespaceDeviceId id,
+                                                     freespace_receiveBufferCallback callback,
+                                                     void* cookie) {
+    struct FreespaceDevice* device = findDeviceById(id);
 
-            rt = &device->receiveQueue_[device->receiveQueueHead_];
-        }
+    if (device == NULL) {
+        return FREESPACE_ERROR_NOT_FOUND;
     }
+
+    // Anything already received is lent out by the next perform.
+    device->receiveBufferCallback_ = callback;
+    device->receiveBufferCookie_ = cookie;
     return FREESPACE_SUCCESS;
 }
 
+const struct FreespaceBackend freespace_libusbBackend = {
+    .name_ = "libusb",
+    .queueReports_ = FREESPACE_RECEIVE_QUEUE_SIZE,
+    .probe_ = freespace_libusb_probe,
+    .init_ = freespace_libusb_init,
+    .exit_ = freespace_libusb_exit,
+    .setDeviceHotplugCallback_ = freespace_libusb_setDeviceHotplugCallback,
+    .getDeviceList_ = freespace_libusb_getDeviceList,
+    .getDeviceInfo_ = freespace_libusb_getDeviceInfo,
+    .openDevice_ = freespace_libusb_openDevice,
+    .openDeviceAsync_ = freespace_libusb_openDeviceAsync,
+    .openAllDevicesAsync_ = freespace_libusb_openAllDevicesAsync,
+    .closeDevice_ = freespace_libusb_closeDevice,
+    .checkOpen_ = freespace_libusb_checkOpen,
+    .send_ = freespace_libusb_send,
+    .sendMessage_ = freespace_libusb_sendMessage,
+    .read_ = freespace_libusb_read,
+    .readMessage_ = freespace_libusb_readMessage,
+    .flush_ = freespace_libusb_flush,
+    .sendAsync_ = freespace_libusb_sendAsync,
+    .sendMessageAsync_ = freespace_libusb_sendMessageAsync,
+    .getNextTimeout_ = freespace_libusb_getNextTimeout,
+    .performBudget_ = freespace_libusb_performBudget,
+    .setFileDescriptorCallbacks_ = freespace_libusb_setFileDescriptorCallbacks,
+    .syncFileDescriptors_ = freespace_libusb_syncFileDescriptors,
+    .setReceiveCallback_ = freespace_libusb_setReceiveCallback,
+    .setReceiveMessageCallback_ = freespace_libusb_setReceiveMessageCallback,
+    .setReceiveBufferCallback_ = freespace_libusb_setReceiveBufferCallback,
+};
@@ -0,0 +1,335 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/*
+ * The entry points of freespace.h that need a device backend. Each one
+ * forwards to the backend chosen by freespace_init().
+ */
+
+#include "freespace/freespace.h"
+#include "freespace_config.h"
+#include "backend.h"
+#include "freespace_log.h"
+#include "freespace_frs.h"
+#include "freespace_request.h"
+#include "freespace_configure.h"
+#include "freespace_rate.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define WARN(...) FREESPACE_LOG(FREESPACE_LOG_BACKEND, FREESPACE_LOG_LEVEL_WARN, __VA_ARGS__)
+#define DEBUG(...) FREESPACE_LOG(FREESPACE_LOG_BACKEND, FREESPACE_LOG_LEVEL_DEBUG, __VA_ARGS__)
+
+// Used when neither freespace_initWithOptions nor the environment names any
+#ifndef LIBFREESPACE_BACKEND_ORDER
+#define LIBFREESPACE_BACKEND_ORDER ""
+#endif
+
+static const struct FreespaceBackend* const backends_[] = {
+#ifdef LIBFREESPACE_BACKEND_HIDRAW
+    &freespace_hidrawBackend,
+#endif
+#ifdef LIBFREESPACE_BACKEND_LIBUSB
+    &freespace_libusbBackend,
+#endif
+#ifdef LIBFREESPACE_BACKEND_BROKER
+    &freespace_brokerBackend,
+#endif
+#ifdef LIBFREESPACE_BACKEND_TEST
+    &freespace_testBackend,
+#endif
+    NULL
+};
+
+#define NUM_BACKENDS ((int) (sizeof(backends_) / sizeof(backends_[0])) - 1)
+
+// The backend in use between freespace_init and freespace_exit
+static const struct FreespaceBackend* backend_;
+
+#define GET_BACKEND() \
+    if (backend_ == NULL) { \
+        return FREESPACE_ERROR_UNEXPECTED; \
+    }
+
+static const struct FreespaceBackend* _findBackend(const char* name, size_t length) {
+    int i;
+    for (i = 0; i < NUM_BACKENDS; i++) {
+        if (strlen(backends_[i]->name_) == length &&
+            strncmp(backends_[i]->name_, name, length) == 0) {
+            return backends_[i];
+        }
+    }
+    return NULL;
+}
+
+int freespace_private_initBackend(const char* names) {
+    const struct FreespaceBackend* candidates[NUM_BACKENDS + 1];
+    int probes[NUM_BACKENDS + 1];
+    int numCandidates = 0;
+    const char* name;
+    int pass;
+    int i;
+    int rc = FREESPACE_ERROR_NOT_FOUND;
+
+    if (names == NULL) {
+        names = getenv("FREESPACE_BACKEND");
+    }
+    if (names == NULL || names[0] == '\0') {
+        names = LIBFREESPACE_BACKEND_ORDER;
+    }
+
+    for (name = names; *name != '\0'; ) {
+        size_t length = strcspn(name, ", ");
+        const struct FreespaceBackend* backend = _findBackend(name, length);
+
+        if (backend == NULL && length > 0) {
+            DEBUG("No %.*s backend in this build", (int) length, name);
+        }
+        for (i = 0; backend != NULL && i < numCandidates; i++) {
+            if (candidates[i] == backend) {
+                backend = NULL;
+            }
+        }
+        if (backend != NULL) {
+            candidates[numCandidates++] = backend;
+        }
+
+        name += length;
+        if (*name != '\0') {
+            name++;
+        }
+    }
+
+    if (numCandidates == 0) {
+        WARN("None of the backends \"%s\" is available", names);
+        return FREESPACE_ERROR_NOT_FOUND;
+    }
+
+    // With a choice, prefer a backend that can open a device now, then
+    // one that may see devices later. One that only sees devices it
+    // cannot open comes last, and its opens fail as they would have.
+    for (i = 0; i < numCandidates; i++) {
+        probes[i] = numCandidates > 1 ? candidates[i]->probe_() : FREESPACE_SUCCESS;
+        DEBUG("Probing the %s backend: %d", candidates[i]->name_, probes[i]);
+    }
+    for (pass = 0; pass < 3; pass++) {
+        for (i = 0; i < numCandidates; i++) {
+            int probe = probes[i];
+            if ((pass == 0 && probe != FREESPACE_SUCCESS) ||
+                (pass == 1 && probe != FREESPACE_ERROR_NOT_FOUND) ||
+                (pass == 2 && (probe == FREESPACE_SUCCESS || probe == FREESPACE_ERROR_NOT_FOUND))) {
+                continue;
+            }
+
+            rc = candidates[i]->init_();
+            if (rc == FREESPACE_SUCCESS) {
+                DEBUG("Using the %s backend", candidates[i]->name_);
+                backend_ = candidates[i];
+                return FREESPACE_SUCCESS;
+            }
+            WARN("Could not initialize the %s backend: %d", candidates[i]->name_, rc);
+        }
+    }
+    return rc;
+}
+
+const char* freespace_version() {
+    return LIBFREESPACE_VERSION;
+}
+
+const char* freespace_backendName() {
+    return backend_ != NULL ? backend_->name_ : NULL;
+}
+
+int freespace_init() {
+    return freespace_private_initBackend(NULL);
+}
+
+void freespace_exit() {
+    if (backend_ != NULL) {
+        backend_->exit_();
+        backend_ = NULL;
+    }
+}
+
+int freespace_setDeviceHotplugCallback(freespace_hotplugCallback callback,
+                                       void* cookie) {
+    GET_BACKEND();
+    return backend_->setDeviceHotplugCallback_(callback, cookie);
+}
+
+int freespace_getDeviceList(FreespaceDeviceId* idList,
+                            int maxIds,
+                            int* numIds) {
+    GET_BACKEND();
+    return backend_->getDeviceList_(idList, maxIds, numIds);
+}
+
+int freespace_getDeviceInfo(FreespaceDeviceId id,
+                            struct FreespaceDeviceInfo* info) {
+    GET_BACKEND();
+    return backend_->getDeviceInfo_(id, info);
+}
+
+int freespace_openDevice(FreespaceDeviceId id) {
+    GET_BACKEND();
+    return backend_->openDevice_(id);
+}
+
+int freespace_openDeviceAsync(FreespaceDeviceId id,
+                              freespace_openCallback callback,
+                              void* cookie) {
+    GET_BACKEND();
+    return backend_->openDeviceAsync_(id, callback, cookie);
+}
+
+int freespace_openAllDevicesAsync(freespace_openCallback callback, void* cookie) {
+    GET_BACKEND();
+    return backend_->openAllDevicesAsync_(callback, cookie);
+}
+
+void freespace_closeDevice(FreespaceDeviceId id) {
+    if (backend_ != NULL) {
+        backend_->closeDevice_(id);
+    }
+}
+
+int freespace_private_send(FreespaceDeviceId id, const uint8_t* message, int length) {
+    GET_BACKEND();
+    return backend_->send_(id, message, length);
+}
+
+int freespace_sendMessage(FreespaceDeviceId id, struct freespace_message* message) {
+    GET_BACKEND();
+    return backend_->sendMessage_(id, message);
+}
+
+int freespace_private_read(FreespaceDeviceId id,
+                           uint8_t* message,
+                           int maxLength,
+                           unsigned int timeoutMs,
+                           int* actualLength) {
+    GET_BACKEND();
+    return backend_->read_(id, message, maxLength, timeoutMs, actualLength);
+}
+
+int freespace_readMessage(FreespaceDeviceId id,
+                          struct freespace_message* message,
+                          unsigned int timeoutMs) {
+    GET_BACKEND();
+    return backend_->readMessage_(id, message, timeoutMs);
+}
+
+int freespace_flush(FreespaceDeviceId id) {
+    GET_BACKEND();
+    return backend_->flush_(id);
+}
+
+int freespace_private_sendAsync(FreespaceDeviceId id,
+                                const uint8_t* message,
+                                int length,
+                                unsigned int timeoutMs,
+                                freespace_sendCallback callback,
+                                void* cookie) {
+    GET_BACKEND();
+    return backend_->sendAsync_(id, message, length, timeoutMs, callback, cookie);
+}
+
+int freespace_sendMessageAsync(FreespaceDeviceId id,
+                               struct freespace_message* message,
+                               unsigned int timeoutMs,
+                               freespace_sendCallback callback,
+                               void* cookie) {
+    GET_BACKEND();
+    return backend_->sendMessageAsync_(id, message, timeoutMs, callback, cookie);
+}
+
+int freespace_getNextTimeout(int* timeoutMsOut) {
+    int rc;
+    GET_BACKEND();
+    rc = backend_->getNextTimeout_(timeoutMsOut);
+    if (rc == FREESPACE_SUCCESS) {
+        freespace_private_frsNextTimeout(timeoutMsOut);
+        freespace_private_requestNextTimeout(timeoutMsOut);
+        freespace_private_configNextTimeout(timeoutMsOut);
+    }
+    return rc;
+}
+
+int freespace_perform() {
+    return freespace_performBudget(0, 0, NULL);
+}
+
+int freespace_performBudget(int maxReports, int maxMicros, int* workRemaining) {
+    int rc;
+    int remaining = 0;
+    GET_BACKEND();
+    rc = backend_->performBudget_(maxReports, maxMicros, &remaining);
+    if (workRemaining != NULL) {
+        *workRemaining = remaining;
+    }
+    freespace_private_ratePerform();
+    // Requests that are due go out after the backend has caught up
+    freespace_private_frsPerform();
+    freespace_private_configPerform();
+    freespace_private_requestPerform();
+    return rc;
+}
+
+void freespace_setFileDescriptorCallbacks(freespace_pollfdAddedCallback addedCallback,
+                                          freespace_pollfdRemovedCallback removedCallback) {
+    if (backend_ != NULL) {
+        backend_->setFileDescriptorCallbacks_(addedCallback, removedCallback);
+    }
+}
+
+int freespace_syncFileDescriptors() {
+    GET_BACKEND();
+    return backend_->syncFileDescriptors_();
+}
+
+int freespace_private_checkOpen(FreespaceDeviceId id) {
+    GET_BACKEND();
+    return backend_->checkOpen_(id);
+}
+
+int freespace_private_queueReports() {
+    return backend_ != NULL ? backend_->queueReports_ : 0;
+}
+
+int freespace_private_setReceiveCallback(FreespaceDeviceId id,
+                                         freespace_receiveCallback callback,
+                                         void* cookie) {
+    GET_BACKEND();
+    return backend_->setReceiveCallback_(id, callback, cookie);
+}
+
+int freespace_setReceiveMessageCallback(FreespaceDeviceId id,
+                                        freespace_receiveMessageCallback callback,
+                                        void* cookie) {
+    GET_BACKEND();
+    return backend_->setReceiveMessageCallback_(id, callback, cookie);
+}
+
+int freespace_setReceiveBufferCallback(FreespaceDeviceId id,
+                                       freespace_receiveBufferCallback callback,
+                                       void* cookie) {
+    GET_BACKEND();
+    return backend_->setReceiveBufferCallback_(id, callback, cookie);
+}
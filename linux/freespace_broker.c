@@ -0,0 +1,1371 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/*
+ * A backend that reaches the devices through freespaced instead of
+ * opening them, so that any number of applications can share them.
+ * Applications choose it with FREESPACE_BACKEND=broker, without being
+ * rebuilt.
+ *
+ * Reports come from the daemon as REPORT frames on one socket. Frames
+ * that arrive while a synchronous call waits for its reply are queued
+ * and dispatched by the next freespace_perform().
+ */
+
+#include "freespace/freespace.h"
+#include "freespace_config.h"
+#include "broker_protocol.h"
+#include "receive_thread.h"
+#include "backend.h"
+#include "freespace_mailbox.h"
+#include "freespace_rate.h"
+#include "freespace_subscribe.h"
+#include "freespace_frs.h"
+#include "freespace_request.h"
+#include "freespace_configure.h"
+#include "freespace_buffer.h"
+#include "freespace_alloc.h"
+#include "freespace_log.h"
+#include "freespace_trace.h"
+#include "freespace_probes.h"
+#include "freespace_recorder.h"
+#include "freespace_publish.h"
+
+#include <stdlib.h>
+#include <errno.h>
+#include <string.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+// Log levels are set at runtime with freespace_setLogLevel()
+#define WARN(...) FREESPACE_LOG(FREESPACE_LOG_BACKEND, FREESPACE_LOG_LEVEL_WARN, __VA_ARGS__)
+#define DEBUG(...) FREESPACE_LOG(FREESPACE_LOG_BACKEND, FREESPACE_LOG_LEVEL_DEBUG, __VA_ARGS__)
+#define TRACE(...) FREESPACE_LOG(FREESPACE_LOG_BACKEND, FREESPACE_LOG_LEVEL_TRACE, __VA_ARGS__)
+
+// How long to wait for the daemon to answer a request
+#define BROKER_REPLY_TIMEOUT_MS 2000
+
+// Frames held while waiting for a reply
+#define BROKER_QUEUE_LENGTH 64
+
+// Sends whose result has not come back yet
+#define BROKER_MAX_PENDING_SENDS 16
+
+enum FreespaceDeviceState {
+    FREESPACE_NONE,
+    FREESPACE_CONNECTED,
+    FREESPACE_OPENED,
+    FREESPACE_DISCONNECTED,
+};
+
+struct FreespaceDevice {
+    FreespaceDeviceId id_;
+    enum FreespaceDeviceState state_;
+    struct FreespaceDeviceInfo info_;
+    char name_[64];
+
+    // The message types last asked of the daemon
+    int all_;
+    uint32_t mask_[FREESPACE_BROKER_MASK_WORDS];
+
+    freespace_receiveCallback receiveCallback_;
+    freespace_receiveMessageCallback receiveMessageCallback_;
+    freespace_receiveBufferCallback receiveBufferCallback_;
+    void* receiveCookie_;
+    void* receiveMessageCookie_;
+    void* receiveBufferCookie_;
+
+    // Pooled buffer for the next report when a receive buffer callback is set
+    struct FreespaceBuffer* spare_;
+    // Set while open, once the pool has buffers set aside for it
+    int reserved_;
+};
+
+struct FreespacePendingSend {
+    uint32_t token_;
+    FreespaceDeviceId id_;
+    freespace_sendCallback callback_;
+    void* cookie_;
+    // When to give up on the reply, or 0 for never
+    int64_t deadline_;
+    // The result to fail with at the deadline
+    int status_;
+};
+
+struct FreespacePendingOpen {
+    FreespaceDeviceId id_;
+    int result_;
+    freespace_openCallback callback_;
+    void* cookie_;
+};
+
+struct FreespaceQueuedFrame {
+    int length_;
+    uint8_t frame_[FREESPACE_BROKER_MAX_FRAME];
+    // Only used in the overflow list
+    struct FreespaceQueuedFrame* next_;
+};
+
+struct freespace_context {
+    int fd_;
+    uint32_t nextToken_;
+
+    // Whether the daemon numbers the message types as we do. If not, it
+    // is always asked for every report.
+    int typesMatch_;
+
+    struct FreespaceDevice devices_[FREESPACE_MAXIMUM_DEVICE_COUNT];
+
+    struct FreespaceQueuedFrame queue_[BROKER_QUEUE_LENGTH];
+    int queueHead_;
+    int queueCount_;
+
+    // Replies and hotplug events that arrived with the queue full of them,
+    // oldest first
+    struct FreespaceQueuedFrame* overflowHead_;
+    struct FreespaceQueuedFrame* overflowTail_;
+
+    struct FreespacePendingSend sends_[BROKER_MAX_PENDING_SENDS];
+    struct FreespacePendingOpen opens_[FREESPACE_MAXIMUM_DEVICE_COUNT];
+    int numOpens_;
+
+    freespace_pollfdAddedCallback userAddedCallback;
+    freespace_pollfdRemovedCallback userRemovedCallback;
+    freespace_hotplugCallback hotplugCallback;
+    void* hotplugCookie;
+};
+
+/* global variables */
+static struct freespace_context ctx_ = { -1 };
+
+/* local functions */
+static void _dispatch(const uint8_t* frame, int length, int* numReports);
+static void _lostDaemon();
+
+#define GET_DEVICE(id, device) \
+    struct FreespaceDevice* device = _findDeviceById(id); \
+    if (device == NULL) { \
+        return FREESPACE_ERROR_INVALID_DEVICE; \
+    }
+
+#define GET_DEVICE_IF_OPEN(id, device) \
+    GET_DEVICE(id, device) \
+    switch (device->state_) { \
+        case FREESPACE_OPENED: \
+            break; \
+        case FREESPACE_CONNECTED: \
+        case FREESPACE_DISCONNECTED: \
+            return FREESPACE_ERROR_NO_DEVICE; \
+        default:\
+            return FREESPACE_ERROR_UNEXPECTED;\
+    }
+
+
+static struct FreespaceDevice* _findDeviceById(FreespaceDeviceId id) {
+    int i;
+    for (i = 0; i < FREESPACE_MAXIMUM_DEVICE_COUNT; i++) {
+        if (ctx_.devices_[i].state_ != FREESPACE_NONE && ctx_.devices_[i].id_ == id) {
+            return &ctx_.devices_[i];
+        }
+    }
+    return NULL;
+}
+
+static int64_t _nowMicros() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (int64_t) now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+static int _sendFrame(int type, int arg, FreespaceDeviceId id, uint32_t token,
+                      const void* payload, int length) {
+    uint8_t frame[FREESPACE_BROKER_MAX_FRAME];
+    struct FreespaceBrokerFrame* header = (struct FreespaceBrokerFrame*) frame;
+
+    if (ctx_.fd_ < 0) {
+        return FREESPACE_ERROR_NO_DEVICE;
+    }
+    if (length > (int) (sizeof(frame) - sizeof(*header))) {
+        return FREESPACE_ERROR_SEND_TOO_LARGE;
+    }
+
+    memset(header, 0, sizeof(*header));
+    header->type_ = (uint8_t) type;
+    header->arg_ = (uint8_t) arg;
+    header->id_ = id;
+    header->token_ = token;
+    if (length > 0) {
+        memcpy(frame + sizeof(*header), payload, length);
+    }
+
+    if (send(ctx_.fd_, frame, sizeof(*header) + length, MSG_NOSIGNAL) < 0) {
+        WARN("Sending to freespaced failed: %s", strerror(errno));
+        _lostDaemon();
+        return FREESPACE_ERROR_IO;
+    }
+    return FREESPACE_SUCCESS;
+}
+
+// Receive one frame, waiting up to timeoutMs (not at all if 0). Returns
+// its length, 0 on timeout or an error.
+static int _receiveFrame(uint8_t* frame, int timeoutMs) {
+    struct pollfd pfd;
+    ssize_t rc;
+
+    if (ctx_.fd_ < 0) {
+        return FREESPACE_ERROR_NO_DEVICE;
+    }
+
+    for (;;) {
+        rc = recv(ctx_.fd_, frame, FREESPACE_BROKER_MAX_FRAME, MSG_DONTWAIT);
+        if (rc > 0) {
+            if (rc < (ssize_t) sizeof(struct FreespaceBrokerFrame)) {
+                WARN("Short frame from freespaced");
+                continue;
+            }
+            return (int) rc;
+        }
+        if (rc == 0) {
+            WARN("freespaced closed the connection");
+            _lostDaemon();
+            return FREESPACE_ERROR_IO;
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        if (errno != EAGAIN && errno != EWOULDBLOCK) {
+            WARN("Receiving from freespaced failed: %s", strerror(errno));
+            _lostDaemon();
+            return FREESPACE_ERROR_IO;
+        }
+        if (timeoutMs <= 0) {
+            return 0;
+        }
+
+        pfd.fd = ctx_.fd_;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        rc = poll(&pfd, 1, timeoutMs);
+        if (rc < 0 && errno != EINTR) {
+            return FREESPACE_ERROR_IO;
+        }
+        if (rc == 0) {
+            return 0;
+        }
+    }
+}
+
+// Make room by removing the oldest report, or frame already discarded,
+// from the queue. Returns 0 if the queue only holds replies and hotplug
+// events.
+static int _evictReport() {
+    int i;
+
+    for (i = 0; i < ctx_.queueCount_; i++) {
+        struct FreespaceQueuedFrame* queued = &ctx_.queue_[(ctx_.queueHead_ + i) % BROKER_QUEUE_LENGTH];
+        struct FreespaceBrokerFrame* header = (struct FreespaceBrokerFrame*) queued->frame_;
+        if (header->type_ == FREESPACE_BROKER_REPORT || header->type_ == 0) {
+            // Close the gap
+            for (; i < ctx_.queueCount_ - 1; i++) {
+                struct FreespaceQueuedFrame* next = &ctx_.queue_[(ctx_.queueHead_ + i + 1) % BROKER_QUEUE_LENGTH];
+                memcpy(queued->frame_, next->frame_, next->length_);
+                queued->length_ = next->length_;
+                queued = next;
+            }
+            ctx_.queueCount_--;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void _enqueue(const uint8_t* frame, int length) {
+    const struct FreespaceBrokerFrame* header = (const struct FreespaceBrokerFrame*) frame;
+    struct FreespaceQueuedFrame* queued;
+
+    // Replies and hotplug events are never dropped: losing a reply would
+    // leave its send pending for good. Reports give way to them.
+    if (header->type_ != FREESPACE_BROKER_REPORT && ctx_.overflowHead_ != NULL) {
+        queued = NULL;
+    } else if (ctx_.queueCount_ < BROKER_QUEUE_LENGTH || _evictReport()) {
+        queued = &ctx_.queue_[(ctx_.queueHead_ + ctx_.queueCount_) % BROKER_QUEUE_LENGTH];
+        ctx_.queueCount_++;
+    } else if (header->type_ == FREESPACE_BROKER_REPORT) {
+        WARN("Dropped a report from freespaced while waiting for a reply");
+        return;
+    } else {
+        queued = NULL;
+    }
+
+    if (queued == NULL) {
+        queued = (struct FreespaceQueuedFrame*) freespace_private_malloc(sizeof(*queued));
+        if (queued == NULL) {
+            WARN("Dropped a frame from freespaced: out of memory");
+            return;
+        }
+        queued->next_ = NULL;
+        if (ctx_.overflowTail_ != NULL) {
+            ctx_.overflowTail_->next_ = queued;
+        } else {
+            ctx_.overflowHead_ = queued;
+        }
+        ctx_.overflowTail_ = queued;
+    }
+    memcpy(queued->frame_, frame, length);
+    queued->length_ = length;
+}
+
+// Take the oldest queued frame, refilling the queue from the overflow
+// list. Returns its length, or 0 if nothing is queued.
+static int _dequeue(uint8_t* frame) {
+    struct FreespaceQueuedFrame* queued;
+    int length;
+
+    if (ctx_.queueCount_ > 0) {
+        queued = &ctx_.queue_[ctx_.queueHead_];
+        length = queued->length_;
+        memcpy(frame, queued->frame_, length);
+        ctx_.queueHead_ = (ctx_.queueHead_ + 1) % BROKER_QUEUE_LENGTH;
+        ctx_.queueCount_--;
+    } else if (ctx_.overflowHead_ != NULL) {
+        queued = ctx_.overflowHead_;
+        length = queued->length_;
+        memcpy(frame, queued->frame_, length);
+        ctx_.overflowHead_ = queued->next_;
+        if (ctx_.overflowHead_ == NULL) {
+            ctx_.overflowTail_ = NULL;
+        }
+        freespace_private_free(queued);
+    } else {
+        return 0;
+    }
+    return length;
+}
+
+static void _freeOverflow() {
+    while (ctx_.overflowHead_ != NULL) {
+        struct FreespaceQueuedFrame* next = ctx_.overflowHead_->next_;
+        freespace_private_free(ctx_.overflowHead_);
+        ctx_.overflowHead_ = next;
+    }
+    ctx_.overflowTail_ = NULL;
+}
+
+// Drop the queued reports of a device. They stay queued as empty frames.
+static void _discardQueued(FreespaceDeviceId id) {
+    int i;
+    for (i = 0; i < ctx_.queueCount_; i++) {
+        struct FreespaceQueuedFrame* queued = &ctx_.queue_[(ctx_.queueHead_ + i) % BROKER_QUEUE_LENGTH];
+        struct FreespaceBrokerFrame* header = (struct FreespaceBrokerFrame*) queued->frame_;
+        if (header->type_ == FREESPACE_BROKER_REPORT && header->id_ == id) {
+            header->type_ = 0;
+        }
+    }
+}
+
+// Send a request and wait for its reply. Anything else received in the
+// meantime is queued.
+static int _request(int type, int arg, FreespaceDeviceId id, const void* payload, int length,
+                    void* reply, int maxReply, int* replyLength) {
+    uint8_t frame[FREESPACE_BROKER_MAX_FRAME];
+    const struct FreespaceBrokerFrame* header = (const struct FreespaceBrokerFrame*) frame;
+    int64_t deadline = _nowMicros() + BROKER_REPLY_TIMEOUT_MS * 1000;
+    uint32_t token;
+    int rc;
+
+    // Token 0 is for requests that want no reply
+    token = ++ctx_.nextToken_;
+    if (token == 0) {
+        token = ++ctx_.nextToken_;
+    }
+
+    rc = _sendFrame(type, arg, id, token, payload, length);
+    if (rc != FREESPACE_SUCCESS) {
+        return rc;
+    }
+
+    for (;;) {
+        int remainingMs = (int) ((deadline - _nowMicros()) / 1000);
+        if (remainingMs <= 0) {
+            WARN("No reply from freespaced");
+            return FREESPACE_ERROR_TIMEOUT;
+        }
+
+        rc = _receiveFrame(frame, remainingMs);
+        if (rc < 0) {
+            return rc;
+        }
+        if (rc == 0) {
+            continue;
+        }
+
+        if (header->type_ == FREESPACE_BROKER_REPLY && header->token_ == token) {
+            if (reply != NULL) {
+                int n = rc - (int) sizeof(*header);
+                if (n > maxReply) {
+                    n = maxReply;
+                }
+                memcpy(reply, frame + sizeof(*header), n);
+                *replyLength = n;
+            }
+            return header->status_;
+        }
+        _enqueue(frame, rc);
+    }
+}
+
+static struct FreespaceDevice* _addDevice(FreespaceDeviceId id, const struct FreespaceBrokerInfo* info) {
+    struct FreespaceDevice* device = _findDeviceById(id);
+    int i;
+
+    if (device == NULL) {
+        for (i = 0; i < FREESPACE_MAXIMUM_DEVICE_COUNT; i++) {
+            if (ctx_.devices_[i].state_ == FREESPACE_NONE) {
+                device = &ctx_.devices_[i];
+                break;
+            }
+        }
+        if (device == NULL) {
+            WARN("No room for device %d", id);
+            return NULL;
+        }
+        memset(device, 0, sizeof(*device));
+        device->id_ = id;
+        device->state_ = FREESPACE_CONNECTED;
+    }
+
+    memcpy(device->name_, info->name_, sizeof(device->name_));
+    device->name_[sizeof(device->name_) - 1] = '\0';
+    device->info_.name = device->name_;
+    device->info_.vendor = info->vendor_;
+    device->info_.product = info->product_;
+    device->info_.hVer = info->hVer_;
+    return device;
+}
+
+// Reserve the pool buffers an open device reads into and lends out, and
+// its requests, so that receiving never grows the pools
+static int _reserveBuffers(struct FreespaceDevice* device) {
+    int rc;
+
+    if (device->reserved_) {
+        return FREESPACE_SUCCESS;
+    }
+    rc = freespace_private_requestReserve(device->id_);
+    if (rc != FREESPACE_SUCCESS) {
+        return rc;
+    }
+    rc = freespace_private_bufferReserve(1 + FREESPACE_BUFFER_LEND_SLACK);
+    if (rc == FREESPACE_SUCCESS) {
+        device->reserved_ = 1;
+    }
+    return rc;
+}
+
+static void _releaseSpare(struct FreespaceDevice* device) {
+    if (device->spare_ != NULL) {
+        freespace_bufferRelease(device->spare_);
+        device->spare_ = NULL;
+    }
+    if (device->reserved_) {
+        freespace_private_bufferUnreserve(1 + FREESPACE_BUFFER_LEND_SLACK);
+        device->reserved_ = 0;
+    }
+}
+
+// The connection is gone; so are all of the devices
+static void _lostDaemon() {
+    int i;
+
+    if (ctx_.fd_ < 0) {
+        return;
+    }
+    if (ctx_.userRemovedCallback) {
+        ctx_.userRemovedCallback(ctx_.fd_);
+    }
+    close(ctx_.fd_);
+    ctx_.fd_ = -1;
+
+    // No reply is coming. This may be deep inside a send, so the
+    // callbacks are left to the next perform.
+    for (i = 0; i < BROKER_MAX_PENDING_SENDS; i++) {
+        if (ctx_.sends_[i].token_ != 0) {
+            ctx_.sends_[i].deadline_ = 1;
+            ctx_.sends_[i].status_ = FREESPACE_ERROR_NO_DEVICE;
+        }
+    }
+
+    for (i = 0; i < FREESPACE_MAXIMUM_DEVICE_COUNT; i++) {
+        struct FreespaceDevice* device = &ctx_.devices_[i];
+        if (device->state_ == FREESPACE_NONE || device->state_ == FREESPACE_DISCONNECTED) {
+            continue;
+        }
+        if (device->state_ == FREESPACE_OPENED) {
+            // Freed when it is closed
+            device->state_ = FREESPACE_DISCONNECTED;
+        } else {
+            device->state_ = FREESPACE_NONE;
+        }
+        if (ctx_.hotplugCallback) {
+            ctx_.hotplugCallback(FREESPACE_HOTPLUG_REMOVAL, device->id_, ctx_.hotplugCookie);
+        }
+    }
+}
+
+static int _connect() {
+    struct sockaddr_un addr;
+    const char* path = getenv(FREESPACE_BROKER_SOCKET_ENV);
+
+    if (path == NULL || path[0] == '\0') {
+        path = FREESPACE_BROKER_DEFAULT_SOCKET;
+    }
+    if (strlen(path) >= sizeof(addr.sun_path)) {
+        return FREESPACE_ERROR_NOT_FOUND;
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path);
+
+    ctx_.fd_ = socket(AF_UNIX, SOCK_SEQPACKET, 0);
+    if (ctx_.fd_ < 0) {
+        return FREESPACE_ERROR_IO;
+    }
+    if (connect(ctx_.fd_, (struct sockaddr*) &addr, sizeof(addr)) < 0) {
+        int rc = (errno == EACCES) ? FREESPACE_ERROR_ACCESS : FREESPACE_ERROR_NOT_FOUND;
+        WARN("Could not connect to freespaced at %s: %s", path, strerror(errno));
+        close(ctx_.fd_);
+        ctx_.fd_ = -1;
+        return rc;
+    }
+    return FREESPACE_SUCCESS;
+}
+
+// The daemon is there if its socket takes a connection
+static int freespace_broker_probe() {
+    int rc = _connect();
+    if (rc == FREESPACE_SUCCESS) {
+        close(ctx_.fd_);
+        ctx_.fd_ = -1;
+    }
+    return rc;
+}
+
+static int freespace_broker_init() {
+    struct FreespaceBrokerHello hello;
+    int32_t ids[FREESPACE_MAXIMUM_DEVICE_COUNT];
+    int length = 0;
+    int i;
+    int rc;
+
+    memset(&ctx_, 0, sizeof(ctx_));
+    ctx_.fd_ = -1;
+
+    rc = _connect();
+    if (rc != FREESPACE_SUCCESS) {
+        return rc;
+    }
+
+    rc = _request(FREESPACE_BROKER_HELLO, 0, -1, NULL, 0, &hello, sizeof(hello), &length);
+    if (rc == FREESPACE_SUCCESS && (length != sizeof(hello) ||
+                                    hello.version_ != FREESPACE_BROKER_PROTOCOL_VERSION)) {
+        WARN("freespaced speaks another protocol version");
+        rc = FREESPACE_ERROR_UNEXPECTED;
+    }
+    if (rc != FREESPACE_SUCCESS) {
+        _lostDaemon();
+        return rc;
+    }
+    ctx_.typesMatch_ = (hello.messageTypeCount_ == FREESPACE_MESSAGE_TYPE_COUNT);
+
+    rc = _request(FREESPACE_BROKER_LIST, 0, -1, NULL, 0, ids, sizeof(ids), &length);
+    if (rc != FREESPACE_SUCCESS) {
+        _lostDaemon();
+        return rc;
+    }
+    for (i = 0; i < length / (int) sizeof(int32_t); i++) {
+        struct FreespaceBrokerInfo info;
+        int infoLength = 0;
+        if (_request(FREESPACE_BROKER_INFO, 0, ids[i], NULL, 0,
+                     &info, sizeof(info), &infoLength) == FREESPACE_SUCCESS &&
+            infoLength == sizeof(info)) {
+            _addDevice(ids[i], &info);
+        }
+    }
+
+    return FREESPACE_SUCCESS;
+}
+
+static void freespace_broker_exit() {
+    int i;
+
+    // Stop the receive thread before tearing anything down under it
+    freespace_receiveThread_stop();
+
+    if (ctx_.fd_ >= 0) {
+        if (ctx_.userRemovedCallback) {
+            ctx_.userRemovedCallback(ctx_.fd_);
+        }
+        close(ctx_.fd_);
+        ctx_.fd_ = -1;
+    }
+    for (i = 0; i < FREESPACE_MAXIMUM_DEVICE_COUNT; i++) {
+        _releaseSpare(&ctx_.devices_[i]);
+        ctx_.devices_[i].state_ = FREESPACE_NONE;
+    }
+    for (i = 0; i < BROKER_MAX_PENDING_SENDS; i++) {
+        struct FreespacePendingSend pending = ctx_.sends_[i];
+        if (pending.token_ != 0) {
+            ctx_.sends_[i].token_ = 0;
+            pending.callback_(pending.id_, pending.cookie_, FREESPACE_ERROR_NO_DEVICE);
+        }
+    }
+    _freeOverflow();
+    ctx_.queueCount_ = 0;
+
+    freespace_recorderStop();
+    freespace_publisherStop();
+    freespace_private_mailboxExit();
+    freespace_private_rateExit();
+    freespace_private_subscriptionExit();
+    freespace_private_configExit();
+    freespace_private_requestExit();
+    freespace_private_frsExit();
+    freespace_private_bufferExit();
+}
+
+static int freespace_broker_setDeviceHotplugCallback(freespace_hotplugCallback callback,
+                                                     void* cookie) {
+    ctx_.hotplugCallback = callback;
+    ctx_.hotplugCookie = cookie;
+    return FREESPACE_SUCCESS;
+}
+
+static int freespace_broker_getDeviceList(FreespaceDeviceId* idList,
+                                          int maxIds,
+                                          int* numIds) {
+    int i;
+
+    *numIds = 0;
+    for (i = 0; i < FREESPACE_MAXIMUM_DEVICE_COUNT && *numIds < maxIds; i++) {
+        if (ctx_.devices_[i].state_ != FREESPACE_NONE &&
+            ctx_.devices_[i].state_ != FREESPACE_DISCONNECTED) {
+            idList[*numIds] = ctx_.devices_[i].id_;
+            *numIds = *numIds + 1;
+        }
+    }
+    return FREESPACE_SUCCESS;
+}
+
+static int freespace_broker_getDeviceInfo(FreespaceDeviceId id,
+                                          struct FreespaceDeviceInfo* info) {
+    GET_DEVICE(id, device);
+
+    *info = device->info_;
+    return FREESPACE_SUCCESS;
+}
+
+static int freespace_broker_openDevice(FreespaceDeviceId id) {
+    int rc;
+    GET_DEVICE(id, device);
+
+    if (device->state_ == FREESPACE_DISCONNECTED) {
+        return FREESPACE_ERROR_NO_DEVICE;
+    }
+    if (device->state_ == FREESPACE_OPENED) {
+        return FREESPACE_SUCCESS;
+    }
+
+    FREESPACE_TRACE_BEGIN("open", id);
+    rc = _reserveBuffers(device);
+    if (rc != FREESPACE_SUCCESS) {
+        FREESPACE_TRACE_END("open", id);
+        return rc;
+    }
+    rc = _request(FREESPACE_BROKER_OPEN, 0, id, NULL, 0, NULL, 0, NULL);
+    if (rc != FREESPACE_SUCCESS) {
+        _releaseSpare(device);
+    } else {
+        // The daemon starts by sending every report
+        device->state_ = FREESPACE_OPENED;
+        device->all_ = 1;
+        memset(device->mask_, 0, sizeof(device->mask_));
+    }
+    FREESPACE_TRACE_END("open", id);
+    return rc;
+}
+
+// The daemon holds the devices open, so opening one only takes a round
+// trip. The callback is still deferred to freespace_perform().
+static int _deferOpen(FreespaceDeviceId id, freespace_openCallback callback, void* cookie) {
+    struct FreespacePendingOpen* open;
+
+    if (ctx_.numOpens_ == FREESPACE_MAXIMUM_DEVICE_COUNT) {
+        return FREESPACE_ERROR_BUSY;
+    }
+    open = &ctx_.opens_[ctx_.numOpens_++];
+    open->id_ = id;
+    open->result_ = freespace_broker_openDevice(id);
+    open->callback_ = callback;
+    open->cookie_ = cookie;
+    return FREESPACE_SUCCESS;
+}
+
+static int freespace_broker_openDeviceAsync(FreespaceDeviceId id,
+                                            freespace_openCallback callback,
+                                            void* cookie) {
+    GET_DEVICE(id, device);
+
+    if (device->state_ == FREESPACE_DISCONNECTED) {
+        return FREESPACE_ERROR_NO_DEVICE;
+    }
+    return _deferOpen(id, callback, cookie);
+}
+
+static int freespace_broker_openAllDevicesAsync(freespace_openCallback callback, void* cookie) {
+    int i;
+    int rc;
+
+    for (i = 0; i < FREESPACE_MAXIMUM_DEVICE_COUNT; i++) {
+        if (ctx_.devices_[i].state_ != FREESPACE_CONNECTED) {
+            continue;
+        }
+        rc = _deferOpen(ctx_.devices_[i].id_, callback, cookie);
+        if (rc != FREESPACE_SUCCESS) {
+            return rc;
+        }
+    }
+    return FREESPACE_SUCCESS;
+}
+
+static void freespace_broker_closeDevice(FreespaceDeviceId id) {
+    struct FreespaceDevice* device = _findDeviceById(id);
+    if (device == NULL) {
+        DEBUG("closeDevice() -- failed to get device %d", id);
+        return;
+    }
+
+    freespace_private_requestReset(id);
+    freespace_private_frsReset(id);
+    freespace_private_mailboxReset(id);
+    freespace_private_rateReset(id);
+    freespace_private_subscriptionReset(id);
+
+    if (device->state_ == FREESPACE_CONNECTED) {
+        TRACE("closeDevice() that is not opened");
+        return;
+    }
+
+    FREESPACE_TRACE_BEGIN("close", id);
+    if (device->state_ == FREESPACE_OPENED) {
+        _sendFrame(FREESPACE_BROKER_CLOSE, 0, id, 0, NULL, 0);
+        device->state_ = FREESPACE_CONNECTED;
+    } else if (device->state_ == FREESPACE_DISCONNECTED) {
+        // Unplugged while open; it was kept for this close
+        device->state_ = FREESPACE_NONE;
+    }
+    _discardQueued(id);
+    _releaseSpare(device);
+    FREESPACE_TRACE_END("close", id);
+}
+
+static int freespace_broker_checkOpen(FreespaceDeviceId id) {
+    GET_DEVICE_IF_OPEN(id, device);
+    return FREESPACE_SUCCESS;
+}
+
+static int freespace_broker_send(FreespaceDeviceId id, const uint8_t* message, int length) {
+    int rc;
+    GET_DEVICE_IF_OPEN(id, device);
+
+    FREESPACE_PROBE2(write__submitted, id, length);
+    FREESPACE_RECORD(id, device->info_.hVer, FREESPACE_RECORD_OUTBOUND, message, length);
+    rc = _request(FREESPACE_BROKER_SEND, 0, id, message, length, NULL, 0, NULL);
+    FREESPACE_PROBE2(write__completed, id, rc);
+    return rc;
+}
+
+static int freespace_broker_sendMessage(FreespaceDeviceId id, struct freespace_message* message) {
+    int rc;
+    uint8_t msgBuf[FREESPACE_MAX_OUTPUT_MESSAGE_SIZE];
+    GET_DEVICE_IF_OPEN(id, device);
+
+    // Address is reserved for now and must be set to 0 by the caller.
+    if (message->dest == 0) {
+        message->dest = FREESPACE_RESERVED_ADDRESS;
+    }
+    message->ver = device->info_.hVer;
+
+    rc = freespace_encode_message(message, msgBuf, FREESPACE_MAX_OUTPUT_MESSAGE_SIZE);
+    if (rc <= FREESPACE_SUCCESS) {
+        return rc;
+    }
+    return freespace_broker_send(id, msgBuf, rc);
+}
+
+// Ask the daemon for the message types the device is read for. Only the
+// subscriptions and mailboxes are served if nothing else is set up.
+static void _syncTypes(struct FreespaceDevice* device, int all) {
+    uint32_t mask[FREESPACE_BROKER_MASK_WORDS];
+
+    memset(mask, 0, sizeof(mask));
+    if (!all) {
+        all = !ctx_.typesMatch_ ||
+              device->receiveCallback_ != NULL ||
+              device->receiveMessageCallback_ != NULL ||
+              device->receiveBufferCallback_ != NULL ||
+              (!freespace_private_subscriptionActive(device->id_) &&
+               !freespace_private_mailboxActive(device->id_) &&
+               !freespace_private_frsActive(device->id_) &&
+               !freespace_private_requestActive(device->id_));
+    }
+    if (!all) {
+        freespace_private_subscriptionTypes(device->id_, mask);
+        freespace_private_mailboxTypes(device->id_, mask);
+        freespace_private_frsTypes(device->id_, mask);
+        freespace_private_requestTypes(device->id_, mask);
+    }
+
+    if (all == device->all_ && (all || memcmp(mask, device->mask_, sizeof(mask)) == 0)) {
+        return;
+    }
+    if (_sendFrame(FREESPACE_BROKER_SUBSCRIBE, all, device->id_, 0, mask, sizeof(mask)) == FREESPACE_SUCCESS) {
+        device->all_ = all;
+        memcpy(device->mask_, mask, sizeof(mask));
+    }
+}
+
+static int freespace_broker_read(FreespaceDeviceId id,
+                                 uint8_t* message,
+                                 int maxLength,
+                                 unsigned int timeoutMs,
+                                 int* actualLength) {
+    uint8_t frame[FREESPACE_BROKER_MAX_FRAME];
+    const struct FreespaceBrokerFrame* header = (const struct FreespaceBrokerFrame*) frame;
+    int64_t deadline = _nowMicros() + (int64_t) timeoutMs * 1000;
+    int length;
+    int i;
+    GET_DEVICE_IF_OPEN(id, device);
+
+    _syncTypes(device, 1);
+
+    // The oldest report may already be queued
+    for (i = 0; i < ctx_.queueCount_; i++) {
+        struct FreespaceQueuedFrame* queued = &ctx_.queue_[(ctx_.queueHead_ + i) % BROKER_QUEUE_LENGTH];
+        struct FreespaceBrokerFrame* queuedHeader = (struct FreespaceBrokerFrame*) queued->frame_;
+        if (queuedHeader->type_ == FREESPACE_BROKER_REPORT && queuedHeader->id_ == id) {
+            length = queued->length_ - (int) sizeof(*queuedHeader);
+            if (length > maxLength) {
+                return FREESPACE_ERROR_RECEIVE_BUFFER_TOO_SMALL;
+            }
+            memcpy(message, queued->frame_ + sizeof(*queuedHeader), length);
+            *actualLength = length;
+            queuedHeader->type_ = 0;
+            FREESPACE_RECORD(id, device->info_.hVer, FREESPACE_RECORD_INBOUND, message, length);
+            return FREESPACE_SUCCESS;
+        }
+    }
+
+    for (;;) {
+        int remainingMs = (int) ((deadline - _nowMicros()) / 1000);
+        int rc = _receiveFrame(frame, remainingMs > 0 ? remainingMs : 0);
+        if (rc < 0) {
+            return rc;
+        }
+        if (rc == 0) {
+            if (remainingMs <= 0) {
+                return FREESPACE_ERROR_TIMEOUT;
+            }
+            continue;
+        }
+
+        if (header->type_ == FREESPACE_BROKER_REPORT && header->id_ == id) {
+            length = rc - (int) sizeof(*header);
+            if (length > maxLength) {
+                return FREESPACE_ERROR_RECEIVE_BUFFER_TOO_SMALL;
+            }
+            memcpy(message, frame + sizeof(*header), length);
+            *actualLength = length;
+            FREESPACE_RECORD(id, device->info_.hVer, FREESPACE_RECORD_INBOUND, message, length);
+            return FREESPACE_SUCCESS;
+        }
+        _enqueue(frame, rc);
+    }
+}
+
+static int freespace_broker_readMessage(FreespaceDeviceId id,
+                                        struct freespace_message* message,
+                                        unsigned int timeoutMs) {
+    uint8_t buffer[FREESPACE_MAX_INPUT_MESSAGE_SIZE];
+    int length = 0;
+    int rc;
+    GET_DEVICE_IF_OPEN(id, device);
+
+    rc = freespace_broker_read(id, buffer, sizeof(buffer), timeoutMs, &length);
+    if (rc != FREESPACE_SUCCESS) {
+        return rc;
+    }
+    return freespace_decode_message(buffer, length, message, device->info_.hVer);
+}
+
+static int freespace_broker_flush(FreespaceDeviceId id) {
+    uint8_t frame[FREESPACE_BROKER_MAX_FRAME];
+    const struct FreespaceBrokerFrame* header = (const struct FreespaceBrokerFrame*) frame;
+    int rc;
+    GET_DEVICE_IF_OPEN(id, device);
+
+    _discardQueued(id);
+    while ((rc = _receiveFrame(frame, 0)) > 0) {
+        if (header->type_ != FREESPACE_BROKER_REPORT || header->id_ != id) {
+            _enqueue(frame, rc);
+        }
+    }
+    return rc < 0 ? rc : FREESPACE_SUCCESS;
+}
+
+static int freespace_broker_sendAsync(FreespaceDeviceId id,
+                                      const uint8_t* message,
+                                      int length,
+                                      unsigned int timeoutMs,
+                                      freespace_sendCallback callback,
+                                      void* cookie) {
+    struct FreespacePendingSend* pending = NULL;
+    uint32_t token = 0;
+    int rc;
+    int i;
+    GET_DEVICE_IF_OPEN(id, device);
+
+    // Without a callback nobody wants the reply
+    if (callback != NULL) {
+        for (i = 0; i < BROKER_MAX_PENDING_SENDS; i++) {
+            if (ctx_.sends_[i].token_ == 0) {
+                pending = &ctx_.sends_[i];
+                break;
+            }
+        }
+        if (pending == NULL) {
+            return FREESPACE_ERROR_BUSY;
+        }
+        token = ++ctx_.nextToken_;
+        if (token == 0) {
+            token = ++ctx_.nextToken_;
+        }
+    }
+
+    FREESPACE_TRACE_INSTANT("sendEnqueue", id);
+    FREESPACE_PROBE2(write__submitted, id, length);
+    FREESPACE_RECORD(id, device->info_.hVer, FREESPACE_RECORD_OUTBOUND, message, length);
+    rc = _sendFrame(FREESPACE_BROKER_SEND, 0, id, token, message, length);
+    if (rc == FREESPACE_SUCCESS && pending != NULL) {
+        pending->token_ = token;
+        pending->id_ = id;
+        pending->callback_ = callback;
+        pending->cookie_ = cookie;
+        pending->deadline_ = timeoutMs > 0 ? _nowMicros() + (int64_t) timeoutMs * 1000 : 0;
+        pending->status_ = FREESPACE_ERROR_TIMEOUT;
+    }
+    return rc;
+}
+
+static int freespace_broker_sendMessageAsync(FreespaceDeviceId id,
+                                             struct freespace_message* message,
+                                             unsigned int timeoutMs,
+                                             freespace_sendCallback callback,
+                                             void* cookie) {
+    int rc;
+    uint8_t msgBuf[FREESPACE_MAX_OUTPUT_MESSAGE_SIZE];
+    GET_DEVICE_IF_OPEN(id, device);
+
+    // Address is reserved for now and must be set to 0 by the caller.
+    if (message->dest == 0) {
+        message->dest = FREESPACE_RESERVED_ADDRESS;
+    }
+    message->ver = device->info_.hVer;
+
+    rc = freespace_encode_message(message, msgBuf, FREESPACE_MAX_OUTPUT_MESSAGE_SIZE);
+    if (rc <= FREESPACE_SUCCESS) {
+        return rc;
+    }
+    return freespace_broker_sendAsync(id, msgBuf, rc, timeoutMs, callback, cookie);
+}
+
+static int freespace_broker_getNextTimeout(int* timeoutMsOut) {
+    int64_t now;
+    int i;
+
+    // Queued frames and deferred callbacks are not signalled on the socket
+    if (ctx_.queueCount_ > 0 || ctx_.overflowHead_ != NULL || ctx_.numOpens_ > 0) {
+        *timeoutMsOut = 0;
+        return FREESPACE_SUCCESS;
+    }
+
+    *timeoutMsOut = -1;
+    now = _nowMicros();
+    for (i = 0; i < BROKER_MAX_PENDING_SENDS; i++) {
+        const struct FreespacePendingSend* pending = &ctx_.sends_[i];
+        if (pending->token_ != 0 && pending->deadline_ != 0) {
+            int64_t ms = pending->deadline_ > now ? (pending->deadline_ - now + 999) / 1000 : 0;
+            if (*timeoutMsOut < 0 || ms < *timeoutMsOut) {
+                *timeoutMsOut = (int) ms;
+            }
+        }
+    }
+    return FREESPACE_SUCCESS;
+}
+
+// Fail the sends whose reply did not come in time or will never come
+static void _expireSends() {
+    int64_t now = _nowMicros();
+    int i;
+
+    for (i = 0; i < BROKER_MAX_PENDING_SENDS; i++) {
+        struct FreespacePendingSend pending = ctx_.sends_[i];
+        if (pending.token_ != 0 && pending.deadline_ != 0 && pending.deadline_ <= now) {
+            ctx_.sends_[i].token_ = 0;
+            FREESPACE_TRACE_INSTANT("sendComplete", pending.id_);
+            FREESPACE_PROBE2(write__completed, pending.id_, pending.status_);
+            pending.callback_(pending.id_, pending.cookie_, pending.status_);
+        }
+    }
+}
+
+// Out of budget: tell rate control which devices still have reports
+// waiting, in the queue or next on the socket.
+static void _noteBacklog() {
+    struct FreespaceBrokerFrame header;
+    int i;
+
+    if (!freespace_private_rateEnabled) {
+        return;
+    }
+    for (i = 0; i < ctx_.queueCount_; i++) {
+        const struct FreespaceQueuedFrame* queued = &ctx_.queue_[(ctx_.queueHead_ + i) % BROKER_QUEUE_LENGTH];
+        const struct FreespaceBrokerFrame* frame = (const struct FreespaceBrokerFrame*) queued->frame_;
+        if (frame->type_ == FREESPACE_BROKER_REPORT) {
+            freespace_private_rateBacklogged(frame->id_);
+        }
+    }
+    if (recv(ctx_.fd_, &header, sizeof(header), MSG_PEEK | MSG_DONTWAIT) == (ssize_t) sizeof(header) &&
+        header.type_ == FREESPACE_BROKER_REPORT) {
+        freespace_private_rateBacklogged(header.id_);
+    }
+}
+
+static void _deliverReport(struct FreespaceDevice* device, const uint8_t* report, int length) {
+    uint8_t hVer = (uint8_t) device->info_.hVer;
+    const uint8_t* data = report;
+    struct FreespaceBuffer* lent = NULL;
+    int64_t dispatchStart;
+    int wantBuffer;
+    int rc;
+
+    FREESPACE_TRACE_INSTANT("report", device->id_);
+    FREESPACE_PROBE3(report__received, device->id_, length, data[0]);
+    FREESPACE_RECORD(device->id_, hVer, FREESPACE_RECORD_INBOUND, data, length);
+    FREESPACE_PUBLISH(device->id_, hVer, data, length);
+    FREESPACE_RATE_RECEIVED(device->id_);
+
+    FREESPACE_RATE_DISPATCH_BEGIN(dispatchStart);
+    if (freespace_private_requestDeliver(device->id_, data, length, hVer) ||
+        freespace_private_frsDeliver(device->id_, data, length, hVer) ||
+        freespace_private_mailboxDeliver(device->id_, data, length, hVer) ||
+        freespace_private_subscriptionDeliver(device->id_, data, length, hVer)) {
+        // Conflated or handled by a subscriber
+        FREESPACE_RATE_DISPATCH_END(dispatchStart);
+        return;
+    }
+
+    // Copy into a pooled buffer if it is going to be lent out. Take it
+    // from the device so that closing it from a callback does not
+    // release it.
+    wantBuffer = (device->receiveBufferCallback_ != NULL);
+    if (wantBuffer) {
+        if (device->spare_ == NULL) {
+            device->spare_ = freespace_private_bufferAcquire();
+        }
+        if (device->spare_ != NULL) {
+            lent = device->spare_;
+            device->spare_ = NULL;
+            memcpy(lent->data_, report, length);
+            lent->length_ = length;
+            data = lent->data_;
+        }
+    }
+
+    if (device->receiveCallback_) {
+        FREESPACE_TRACE_BEGIN("callback", device->id_);
+        FREESPACE_PROBE1(callback__entry, device->id_);
+        device->receiveCallback_(device->id_, data, length, device->receiveCookie_, FREESPACE_SUCCESS);
+        FREESPACE_PROBE1(callback__return, device->id_);
+        FREESPACE_TRACE_END("callback", device->id_);
+    }
+
+    if (device->receiveMessageCallback_) {
+        struct freespace_message m;
+
+        FREESPACE_TRACE_BEGIN("decode", device->id_);
+        rc = freespace_decode_message(data, length, &m, hVer);
+        FREESPACE_TRACE_END("decode", device->id_);
+        FREESPACE_PROBE3(decode__done, device->id_, rc == FREESPACE_SUCCESS ? m.messageType : -1, rc);
+
+        FREESPACE_TRACE_BEGIN("callback", device->id_);
+        FREESPACE_PROBE1(callback__entry, device->id_);
+        device->receiveMessageCallback_(
+                device->id_,
+                rc == FREESPACE_SUCCESS ? &m : NULL,
+                device->receiveMessageCookie_, rc);
+        FREESPACE_PROBE1(callback__return, device->id_);
+        FREESPACE_TRACE_END("callback", device->id_);
+    }
+
+    if (wantBuffer && device->receiveBufferCallback_) {
+        FREESPACE_TRACE_BEGIN("callback", device->id_);
+        FREESPACE_PROBE1(callback__entry, device->id_);
+        if (lent != NULL) {
+            device->receiveBufferCallback_(device->id_, lent, device->receiveBufferCookie_, FREESPACE_SUCCESS);
+        } else {
+            device->receiveBufferCallback_(device->id_, NULL, device->receiveBufferCookie_, FREESPACE_ERROR_OUT_OF_MEMORY);
+        }
+        FREESPACE_PROBE1(callback__return, device->id_);
+        FREESPACE_TRACE_END("callback", device->id_);
+    }
+    if (lent != NULL) {
+        freespace_bufferRelease(lent);
+    }
+    FREESPACE_RATE_DISPATCH_END(dispatchStart);
+}
+
+static void _dispatch(const uint8_t* frame, int length, int* numReports) {
+    const struct FreespaceBrokerFrame* header = (const struct FreespaceBrokerFrame*) frame;
+    const uint8_t* payload = frame + sizeof(*header);
+    int payloadLength = length - (int) sizeof(*header);
+    struct FreespaceDevice* device;
+    int i;
+
+    switch (header->type_) {
+        case FREESPACE_BROKER_REPORT:
+            device = _findDeviceById(header->id_);
+            // Reports still in flight when the device was closed
+            if (device == NULL || device->state_ != FREESPACE_OPENED ||
+                payloadLength <= 0 || payloadLength > FREESPACE_MAX_INPUT_MESSAGE_SIZE) {
+                return;
+            }
+            (*numReports)++;
+            _deliverReport(device, payload, payloadLength);
+            break;
+
+        case FREESPACE_BROKER_REPLY:
+            for (i = 0; i < BROKER_MAX_PENDING_SENDS; i++) {
+                struct FreespacePendingSend pending = ctx_.sends_[i];
+                if (pending.token_ != 0 && pending.token_ == header->token_) {
+                    ctx_.sends_[i].token_ = 0;
+                    FREESPACE_TRACE_INSTANT("sendComplete", pending.id_);
+                    FREESPACE_PROBE2(write__completed, pending.id_, header->status_);
+                    pending.callback_(pending.id_, pending.cookie_, header->status_);
+                    break;
+                }
+            }
+            break;
+
+        case FREESPACE_BROKER_HOTPLUG:
+            if (header->arg_ == FREESPACE_HOTPLUG_INSERTION) {
+                if (payloadLength != sizeof(struct FreespaceBrokerInfo)) {
+                    return;
+                }
+                device = _findDeviceById(header->id_);
+                if (device != NULL && device->state_ == FREESPACE_DISCONNECTED) {
+                    // The id was reused before the old device was closed
+                    WARN("Device %d inserted before it was closed", header->id_);
+                    return;
+                }
+                if (_addDevice(header->id_, (const struct FreespaceBrokerInfo*) payload) == NULL) {
+                    return;
+                }
+                FREESPACE_PROBE1(hotplug__insert, header->id_);
+            } else {
+                device = _findDeviceById(header->id_);
+                if (device == NULL) {
+                    return;
+                }
+                if (device->state_ == FREESPACE_OPENED) {
+                    // Freed when it is closed
+                    device->state_ = FREESPACE_DISCONNECTED;
+                } else {
+                    device->state_ = FREESPACE_NONE;
+                }
+                FREESPACE_PROBE1(hotplug__remove, header->id_);
+            }
+            if (ctx_.hotplugCallback) {
+                ctx_.hotplugCallback((enum freespace_hotplugEvent) header->arg_,
+                                     header->id_, ctx_.hotplugCookie);
+            }
+            break;
+
+        default:
+            // Discarded while queued
+            break;
+    }
+}
+
+static int freespace_broker_performBudget(int maxReports, int maxMicros, int* workRemaining) {
+    uint8_t frame[FREESPACE_BROKER_MAX_FRAME];
+    int64_t deadline = maxMicros > 0 ? _nowMicros() + maxMicros : 0;
+    int reports = 0;
+    int rc = FREESPACE_SUCCESS;
+    int i;
+
+    if (workRemaining) {
+        *workRemaining = 0;
+    }
+
+    // Opens completed since the last call
+    while (ctx_.numOpens_ > 0) {
+        struct FreespacePendingOpen open = ctx_.opens_[0];
+        ctx_.numOpens_--;
+        memmove(&ctx_.opens_[0], &ctx_.opens_[1], ctx_.numOpens_ * sizeof(open));
+        if (open.callback_) {
+            open.callback_(open.id_, open.cookie_, open.result_);
+        }
+    }
+
+    _expireSends();
+
+    if (ctx_.fd_ < 0) {
+        return FREESPACE_ERROR_NO_DEVICE;
+    }
+
+    // Subscriptions and callbacks may have changed since the last call
+    for (i = 0; i < FREESPACE_MAXIMUM_DEVICE_COUNT; i++) {
+        if (ctx_.devices_[i].state_ == FREESPACE_OPENED) {
+            _syncTypes(&ctx_.devices_[i], 0);
+        }
+    }
+
+    FREESPACE_HOT_PATH_BEGIN();
+    for (;;) {
+        if ((maxReports > 0 && reports >= maxReports) ||
+            (deadline != 0 && reports > 0 && _nowMicros() >= deadline)) {
+            if (workRemaining) {
+                *workRemaining = 1;
+            }
+            _noteBacklog();
+            break;
+        }
+
+        // Copied out, since a callback may queue more frames
+        rc = _dequeue(frame);
+        if (rc > 0) {
+            _dispatch(frame, rc, &reports);
+            rc = FREESPACE_SUCCESS;
+            continue;
+        }
+
+        rc = _receiveFrame(frame, 0);
+        if (rc <= 0) {
+            break;
+        }
+        _dispatch(frame, rc, &reports);
+        rc = FREESPACE_SUCCESS;
+    }
+    FREESPACE_HOT_PATH_END();
+
+    return rc;
+}
+
+static void freespace_broker_setFileDescriptorCallbacks(freespace_pollfdAddedCallback addedCallback,
+                                                        freespace_pollfdRemovedCallback removedCallback) {
+    ctx_.userAddedCallback = addedCallback;
+    ctx_.userRemovedCallback = removedCallback;
+}
+
+static int freespace_broker_syncFileDescriptors() {
+    // Everything arrives on the one socket
+    if (ctx_.userAddedCallback != NULL && ctx_.fd_ >= 0) {
+        ctx_.userAddedCallback(ctx_.fd_, POLLIN);
+    }
+    return FREESPACE_SUCCESS;
+}
+
+static int freespace_broker_setReceiveCallback(FreespaceDeviceId id,
+                                               freespace_receiveCallback callback,
+                                               void* cookie) {
+    GET_DEVICE(id, device);
+
+    device->receiveCallback_ = callback;
+    device->receiveCookie_ = cookie;
+    return FREESPACE_SUCCESS;
+}
+
+static int freespace_broker_setReceiveMessageCallback(FreespaceDeviceId id,
+                                                      freespace_receiveMessageCallback callback,
+                                                      void* cookie) {
+    GET_DEVICE(id, device);
+
+    device->receiveMessageCallback_ = callback;
+    device->receiveMessageCookie_ = cookie;
+    return FREESPACE_SUCCESS;
+}
+
+static int freespace_broker_setReceiveBufferCallback(FreespaceDeviceId id,
+                                                     freespace_receiveBufferCallback callback,
+                                                     void* cookie) {
+    GET_DEVICE(id, device);
+
+    device->receiveBufferCallback_ = callback;
+    device->receiveBufferCookie_ = cookie;
+
+    // Get the first buffer now rather than while receiving
+    if (callback != NULL && device->spare_ == NULL) {
+        device->spare_ = freespace_private_bufferAcquire();
+    }
+    return FREESPACE_SUCCESS;
+}
+
+const struct FreespaceBackend freespace_brokerBackend = {
+    .name_ = "broker",
+    // Reports back up into the hidraw queue the daemon reads from
+    .queueReports_ = BROKER_QUEUE_LENGTH,
+    .probe_ = freespace_broker_probe,
+    .init_ = freespace_broker_init,
+    .exit_ = freespace_broker_exit,
+    .setDeviceHotplugCallback_ = freespace_broker_setDeviceHotplugCallback,
+    .getDeviceList_ = freespace_broker_getDeviceList,
+    .getDeviceInfo_ = freespace_broker_getDeviceInfo,
+    .openDevice_ = freespace_broker_openDevice,
+    .openDeviceAsync_ = freespace_broker_openDeviceAsync,
+    .openAllDevicesAsync_ = freespace_broker_openAllDevicesAsync,
+    .closeDevice_ = freespace_broker_closeDevice,
+    .checkOpen_ = freespace_broker_checkOpen,
+    .send_ = freespace_broker_send,
+    .sendMessage_ = freespace_broker_sendMessage,
+    .read_ = freespace_broker_read,
+    .readMessage_ = freespace_broker_readMessage,
+    .flush_ = freespace_broker_flush,
+    .sendAsync_ = freespace_broker_sendAsync,
+    .sendMessageAsync_ = freespace_broker_sendMessageAsync,
+    .getNextTimeout_ = freespace_broker_getNextTimeout,
+    .performBudget_ = freespace_broker_performBudget,
+    .setFileDescriptorCallbacks_ = freespace_broker_setFileDescriptorCallbacks,
+    .syncFileDescriptors_ = freespace_broker_syncFileDescriptors,
+    .setReceiveCallback_ = freespace_broker_setReceiveCallback,
+    .setReceiveMessageCallback_ = freespace_broker_setReceiveMessageCallback,
+    .setReceiveBufferCallback_ = freespace_broker_setReceiveBufferCallback,
+};
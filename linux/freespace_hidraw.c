@@ -18,16 +18,34 @@
 #include "freespace/freespace.h"
 #include "freespace/freespace_deviceTable.h"
 #include "freespace_config.h"
+#include "worker_pool.h"
+#include "backend.h"
+#include "receive_thread.h"
+#include "freespace_mailbox.h"
+#include "freespace_rate.h"
+#include "freespace_subscribe.h"
+#include "freespace_frs.h"
+#include "freespace_request.h"
+#include "freespace_configure.h"
+#include "freespace_buffer.h"
+#include "freespace_alloc.h"
+#include "freespace_log.h"
+#include "freespace_trace.h"
+#include "freespace_probes.h"
+#include "freespace_recorder.h"
+#include "freespace_publish.h"
 
 #include <stdlib.h>
 #include <stdio.h>
 #include <errno.h>
 #include <string.h>
 #include <poll.h>
+#include <time.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <fcntl.h>
 #include <dirent.h>
+#include <limits.h>
 #include <unistd.h>
 
 #include <linux/types.h>
@@ -40,29 +58,14 @@
  *    - support synchronous API
  */
 
-// #define _FREESPACE_DEBUG
-// #define _FREESPACE_WARN
-// #define _FREESPACE_TRACE
+// Log levels are set at runtime with freespace_setLogLevel()
+#define WARN(...) FREESPACE_LOG(FREESPACE_LOG_BACKEND, FREESPACE_LOG_LEVEL_WARN, __VA_ARGS__)
+#define DEBUG(...) FREESPACE_LOG(FREESPACE_LOG_BACKEND, FREESPACE_LOG_LEVEL_DEBUG, __VA_ARGS__)
+#define TRACE(...) FREESPACE_LOG(FREESPACE_LOG_BACKEND, FREESPACE_LOG_LEVEL_TRACE, __VA_ARGS__)
 
-#define LOGF(fmt, lvl, ...) fprintf(stderr, "libfreespace (%20s:%4d): " #lvl " " fmt "\n", __func__, __LINE__, ##__VA_ARGS__);
-
-#ifdef _FREESPACE_WARN
-#define WARN(fmt, ...) LOGF(fmt,  WARN, ##__VA_ARGS__)
-#else
-#define WARN(...)
-#endif
-
-#ifdef _FREESPACE_DEBUG
-#define DEBUG(fmt, ...) LOGF(fmt, DEBUG, ##__VA_ARGS__)
-#else
-#define DEBUG(...)
-#endif
-
-#ifdef _FREESPACE_TRACE
-#define TRACE(fmt, ...) LOGF(fmt, TRACE, ##__VA_ARGS__)
-#else
-#define TRACE(...)
-#endif
+#define HOTPLUG_WARN(...) FREESPACE_LOG(FREESPACE_LOG_HOTPLUG, FREESPACE_LOG_LEVEL_WARN, __VA_ARGS__)
+#define HOTPLUG_DEBUG(...) FREESPACE_LOG(FREESPACE_LOG_HOTPLUG, FREESPACE_LOG_LEVEL_DEBUG, __VA_ARGS__)
+#define HOTPLUG_TRACE(...) FREESPACE_LOG(FREESPACE_LOG_HOTPLUG, FREESPACE_LOG_LEVEL_TRACE, __VA_ARGS__)
 
 /**
  * The device state is primarily used to keep track of FreespaceDevice allocations.
@@ -94,8 +97,8 @@ enum FreespaceDeviceState {
 
 struct FreespaceDevice;
 
-static const int NUM_MAX_JOBS = 5;
-static const int NUM_MAX_FREE_JOBS = 3;
+// Jobs that can be queued. One more may be in the middle of being written.
+#define NUM_MAX_JOBS 5
 
 struct FreespaceBGWriteJob {
     int fd;
@@ -117,7 +120,9 @@ struct FreespaceBGWriter {
     int exitThread;
 
     int queueLen;
-    int numFree;
+
+    // All the jobs, so that writing never allocates
+    struct FreespaceBGWriteJob jobs[NUM_MAX_JOBS + 1];
 };
 
 /* Allocate job struct. If the queue is full, drop the next job belonging to
@@ -149,12 +154,24 @@ struct FreespaceDevice {
 
     freespace_receiveCallback receiveCallback_;
     freespace_receiveMessageCallback receiveMessageCallback_;
+    freespace_receiveBufferCallback receiveBufferCallback_;
     void* receiveCookie_;
     void* receiveMessageCookie_;
+    void* receiveBufferCookie_;
+
+    // Pooled buffer for the next read when a receive buffer callback is set
+    struct FreespaceBuffer* spare_;
+    // Set while open, once the pool has buffers set aside for it
+    int reserved_;
 };
 
+// Reports read from one device before moving on to the next
+#define FREESPACE_PERFORM_QUANTUM 4
+
 #define DEV_DIR "/dev"
 #define HIDRAW_PREFIX  "hidraw"
+// HIDRAW_BUFFER_SIZE in the kernel, past which new reports are dropped
+#define HIDRAW_QUEUE_REPORTS 64
 
 #define GET_DEVICE(id, device) \
     struct FreespaceDevice* device = findDeviceById(id); \
@@ -184,6 +201,10 @@ struct freespace_context {
 
     int inotify_fd;
     int inotify_wd;
+    int initialScanDone;
+
+    // Where freespace_performBudget starts serving devices
+    int performCursor;
 
     freespace_pollfdAddedCallback userAddedCallback;
     freespace_pollfdRemovedCallback userRemovedCallback;
@@ -201,15 +222,16 @@ static struct freespace_context ctx_;
 /* local functions */
 static int _inotify_init();
 static int _inotify_process();
-static int _readDevice(struct FreespaceDevice * device);
+static int _readDevice(struct FreespaceDevice * device, int maxReports, int64_t deadline,
+                       int * numRead, int * drained);
 static int _disconnect(struct FreespaceDevice * device);
 static void _deallocateDevice(struct FreespaceDevice* device);
 static int _write(int fd, const uint8_t* message, int length);
 static int _scanAllDevices();
+static int _openPath(const char * path, int * fd);
+static int _reserveBuffers(struct FreespaceDevice* device);
+static void _releaseSpare(struct FreespaceDevice* device);
 
-const char* freespace_version() {
-    return LIBFREESPACE_VERSION;
-}
 
 static struct FreespaceDevice* findDeviceById(FreespaceDeviceId id) {
     int i;
@@ -223,8 +245,11 @@ static struct FreespaceDevice* findDeviceById(FreespaceDeviceId id) {
 }
 
 // Initialize inotify
-int freespace_init() {
+static int freespace_hidraw_init() {
     int rc = 0;
+#ifdef LIBFREESPACE_THREADED_WRITES
+    int i;
+#endif
     memset(&ctx_, 0, sizeof(ctx_));
     rc = _inotify_init();
     if (rc != 0) {
@@ -242,14 +267,31 @@ int freespace_init() {
 
     pthread_mutex_init(&ctx_.writer.mutex, NULL);
     pthread_cond_init(&ctx_.writer.cond, NULL);
+
+    for (i = 0; i < NUM_MAX_JOBS + 1; i++) {
+        _returnWriteJobLocked(&ctx_.writer.jobs[i]);
+    }
 #endif
 
     return FREESPACE_SUCCESS;
 }
 
 // Disconnect, deallocate device and remove all callbacks
-void freespace_exit() {
+static void freespace_hidraw_exit() {
     int i;
+
+    // Stop the receive thread before tearing anything down under it
+    freespace_receiveThread_stop();
+
+    // Finish any background opens first. Their done functions release
+    // the descriptors they opened.
+    if (freespace_workers_getFD() >= 0) {
+        if (ctx_.userRemovedCallback) {
+            ctx_.userRemovedCallback(freespace_workers_getFD());
+        }
+        freespace_workers_exit();
+    }
+
     for (i = 0; i < FREESPACE_MAXIMUM_DEVICE_COUNT; i++) {
         struct FreespaceDevice * device = ctx_.devices[i];
         if (device == NULL) {
@@ -281,20 +323,29 @@ void freespace_exit() {
     pthread_cond_destroy(&ctx_.writer.cond);
 #endif
 
+    freespace_recorderStop();
+    freespace_publisherStop();
+    freespace_private_mailboxExit();
+    freespace_private_rateExit();
+    freespace_private_subscriptionExit();
+    freespace_private_configExit();
+    freespace_private_requestExit();
+    freespace_private_frsExit();
+    freespace_private_bufferExit();
     return;
 }
 
 
-int freespace_setDeviceHotplugCallback(freespace_hotplugCallback callback,
-                                       void* cookie) {
+static int freespace_hidraw_setDeviceHotplugCallback(freespace_hotplugCallback callback,
+                                                     void* cookie) {
     ctx_.hotplugCallback = callback;
     ctx_.hotplugCookie = cookie;
     return FREESPACE_SUCCESS;
 }
 
-int freespace_getDeviceList(FreespaceDeviceId* idList,
-                            int maxIds,
-                            int* numIds) {
+static int freespace_hidraw_getDeviceList(FreespaceDeviceId* idList,
+                                          int maxIds,
+                                          int* numIds) {
     int i;
     int rc;
     *numIds = 0;
@@ -314,8 +365,8 @@ int freespace_getDeviceList(FreespaceDeviceId* idList,
     return FREESPACE_SUCCESS;
 }
 
-int freespace_getDeviceInfo(FreespaceDeviceId id,
-                            struct FreespaceDeviceInfo* info) {
+static int freespace_hidraw_getDeviceInfo(FreespaceDeviceId id,
+                                          struct FreespaceDeviceInfo* info) {
     GET_DEVICE(id, device);
 
     info->vendor = device->api_->idVendor_;
@@ -326,7 +377,8 @@ int freespace_getDeviceInfo(FreespaceDeviceId id,
 }
 
 // This hidraw implementation handles only async messages
-int freespace_openDevice(FreespaceDeviceId id) {
+static int freespace_hidraw_openDevice(FreespaceDeviceId id) {
+    int rc;
     GET_DEVICE(id, device);
 
     if (device->state_ == FREESPACE_DISCONNECTED) {
@@ -341,31 +393,41 @@ int freespace_openDevice(FreespaceDeviceId id) {
         return FREESPACE_ERROR_UNEXPECTED;
     }
 
-    device->fd_ = open(device->hidrawPath_, O_RDWR | O_NONBLOCK);
-    if (device->fd_ < 0) {
-        WARN("Failed opening %s: %s", device->hidrawPath_, strerror(errno));
-        return FREESPACE_ERROR_IO;
+    FREESPACE_TRACE_BEGIN("open", id);
+    rc = _reserveBuffers(device);
+    if (rc != FREESPACE_SUCCESS) {
+        FREESPACE_TRACE_END("open", id);
+        return rc;
+    }
+    rc = _openPath(device->hidrawPath_, &device->fd_);
+    if (rc != FREESPACE_SUCCESS) {
+        _releaseSpare(device);
+        FREESPACE_TRACE_END("open", id);
+        return rc;
     }
-
-    // flush the device
-    uint8_t buf[1024];
-    while (read(device->fd_, buf, sizeof(buf)) > 0);
 
     if (ctx_.userAddedCallback) {
         ctx_.userAddedCallback(device->fd_, POLLIN);
     }
 
     device->state_ = FREESPACE_OPENED;
+    FREESPACE_TRACE_END("open", id);
     return FREESPACE_SUCCESS;
 }
 
-void freespace_closeDevice(FreespaceDeviceId id) {
+static void freespace_hidraw_closeDevice(FreespaceDeviceId id) {
     struct FreespaceDevice* device = findDeviceById(id);
     if (device == NULL) {
         DEBUG("closeDevice() -- failed to get device %d", id);
         return;
     }
 
+    freespace_private_requestReset(id);
+    freespace_private_frsReset(id);
+    freespace_private_mailboxReset(id);
+    freespace_private_rateReset(id);
+    freespace_private_subscriptionReset(id);
+
     if (device->state_ == FREESPACE_CONNECTED) {
         TRACE("closeDevice() that is not opened");
         // not open
@@ -374,6 +436,7 @@ void freespace_closeDevice(FreespaceDeviceId id) {
 
     if (device->state_ == FREESPACE_OPENED) {
         DEBUG("closeDevice() opened device");
+        FREESPACE_TRACE_BEGIN("close", id);
 #ifdef LIBFREESPACE_THREADED_WRITES
         pthread_mutex_lock(&ctx_.writer.mutex );
         _flushWriteJobsLocked(device, -1);
@@ -387,7 +450,9 @@ void freespace_closeDevice(FreespaceDeviceId id) {
             close(device->fd_);
             device->fd_ = -1;
         }
+        _releaseSpare(device);
         device->state_ = FREESPACE_CONNECTED;
+        FREESPACE_TRACE_END("close", id);
         return;
     }
 
@@ -401,11 +466,16 @@ void freespace_closeDevice(FreespaceDeviceId id) {
     DEBUG("Closed device %d", id);
 }
 
-int freespace_private_send(FreespaceDeviceId id, const uint8_t* message, int length) {
+static int freespace_hidraw_checkOpen(FreespaceDeviceId id) {
+    GET_DEVICE_IF_OPEN(id, device);
+    return FREESPACE_SUCCESS;
+}
+
+static int freespace_hidraw_send(FreespaceDeviceId id, const uint8_t* message, int length) {
     return FREESPACE_ERROR_UINIMPLEMENTED;
 }
 
-int freespace_sendMessage(FreespaceDeviceId id, struct freespace_message* message) {
+static int freespace_hidraw_sendMessage(FreespaceDeviceId id, struct freespace_message* message) {
     int rc;
     uint8_t msgBuf[FREESPACE_MAX_OUTPUT_MESSAGE_SIZE];
     GET_DEVICE_IF_OPEN(id, device);
@@ -422,35 +492,35 @@ int freespace_sendMessage(FreespaceDeviceId id, struct freespace_message* messag
         return rc;
     }
     
-    return freespace_private_send(id, msgBuf, rc);
+    return freespace_hidraw_send(id, msgBuf, rc);
 }
 
-int freespace_private_read(FreespaceDeviceId id,
-                           uint8_t* message,
-                           int maxLength,
-                           unsigned int timeoutMs,
-                           int* actualLength) {
+static int freespace_hidraw_read(FreespaceDeviceId id,
+                                 uint8_t* message,
+                                 int maxLength,
+                                 unsigned int timeoutMs,
+                                 int* actualLength) {
     GET_DEVICE_IF_OPEN(id, device);
 
     // TODO
     return FREESPACE_ERROR_UINIMPLEMENTED;
 }
 
-int freespace_readMessage(FreespaceDeviceId id,
-                          struct freespace_message* message,
-                          unsigned int timeoutMs) {
+static int freespace_hidraw_readMessage(FreespaceDeviceId id,
+                                        struct freespace_message* message,
+                                        unsigned int timeoutMs) {
     GET_DEVICE_IF_OPEN(id, device);
     return FREESPACE_ERROR_UINIMPLEMENTED;
 
 }
 
-int freespace_flush(FreespaceDeviceId id) {
+static int freespace_hidraw_flush(FreespaceDeviceId id) {
     // TODO
     return FREESPACE_ERROR_UINIMPLEMENTED;
 
 }
 
-int _write(int fd, const uint8_t* message, int length) {
+static int _writeReport(int fd, const uint8_t* message, int length) {
     int rc = write(fd, message, length);
     if (rc < 0) {
         if (errno == ENOENT || errno == ENODEV) {
@@ -474,15 +544,29 @@ int _write(int fd, const uint8_t* message, int length) {
     return FREESPACE_SUCCESS;
 }
 
-int freespace_private_sendAsync(FreespaceDeviceId id,
-                                const uint8_t* message,
-                                int length,
-                                unsigned int timeoutMs,
-                                freespace_sendCallback callback,
-                                void* cookie) {
+int _write(int fd, const uint8_t* message, int length) {
+    int rc;
+
+    // Writes only know the descriptor, so they are not tagged with a device
+    FREESPACE_PROBE2(write__submitted, -1, length);
+    FREESPACE_TRACE_BEGIN("write", -1);
+    rc = _writeReport(fd, message, length);
+    FREESPACE_TRACE_END("write", -1);
+    FREESPACE_PROBE2(write__completed, -1, rc);
+    return rc;
+}
+
+static int freespace_hidraw_sendAsync(FreespaceDeviceId id,
+                                      const uint8_t* message,
+                                      int length,
+                                      unsigned int timeoutMs,
+                                      freespace_sendCallback callback,
+                                      void* cookie) {
 #ifndef LIBFREESPACE_THREADED_WRITES
 
     GET_DEVICE_IF_OPEN(id, device);
+    FREESPACE_TRACE_INSTANT("sendEnqueue", id);
+    FREESPACE_RECORD(id, device->api_->hVer_, FREESPACE_RECORD_OUTBOUND, message, length);
     return _write(device->fd_, message, length);
 #else
     ssize_t rc;
@@ -493,15 +577,10 @@ int freespace_private_sendAsync(FreespaceDeviceId id,
     pthread_mutex_lock(&ctx_.writer.mutex );
     job = _popFreeJobLocked(device);
     if (!job) {
-        if (ctx_.writer.queueLen + 1 > NUM_MAX_JOBS) {
-            // our queue is full, we need to evict a job belonging to this device
-            _flushWriteJobsLocked(device, 1);
-            // there should be a job in our free pool now
-            job = _popFreeJobLocked(device);
-        } else {
-            // ok, create a new job
-            job = malloc(sizeof(struct FreespaceBGWriteJob));
-        }
+        // our queue is full, we need to evict a job belonging to this device
+        _flushWriteJobsLocked(device, 1);
+        // there should be a job in our free pool now
+        job = _popFreeJobLocked(device);
     }
 
     if (job) {
@@ -513,8 +592,11 @@ int freespace_private_sendAsync(FreespaceDeviceId id,
         job->length = length;
 
         rc = _pushWriteJobLocked(job);
+        FREESPACE_TRACE_INSTANT("sendEnqueue", id);
+        FREESPACE_RECORD(id, device->api_->hVer_, FREESPACE_RECORD_OUTBOUND, message, length);
     } else {
-        WARN("error allocating a write job");
+        WARN("write queue is full of other devices' jobs");
+        rc = FREESPACE_ERROR_BUSY;
     }
 
     pthread_mutex_unlock(&ctx_.writer.mutex);
@@ -523,11 +605,11 @@ int freespace_private_sendAsync(FreespaceDeviceId id,
 #endif
 }
 
-int freespace_sendMessageAsync(FreespaceDeviceId id,
-                               struct freespace_message* message,
-                               unsigned int timeoutMs,
-                               freespace_sendCallback callback,
-                               void* cookie) {
+static int freespace_hidraw_sendMessageAsync(FreespaceDeviceId id,
+                                             struct freespace_message* message,
+                                             unsigned int timeoutMs,
+                                             freespace_sendCallback callback,
+                                             void* cookie) {
 
     int rc;
     uint8_t msgBuf[FREESPACE_MAX_OUTPUT_MESSAGE_SIZE];
@@ -544,105 +626,181 @@ int freespace_sendMessageAsync(FreespaceDeviceId id,
         return rc;
     }
 
-    return freespace_private_sendAsync(id, msgBuf, rc, timeoutMs, callback, cookie);
+    return freespace_hidraw_sendAsync(id, msgBuf, rc, timeoutMs, callback, cookie);
 }
 
-int freespace_getNextTimeout(int* timeoutMsOut) {
+static int freespace_hidraw_getNextTimeout(int* timeoutMsOut) {
     // TODO
     *timeoutMsOut = -1;
     return FREESPACE_SUCCESS;
 }
 
-int freespace_perform() {
+
+static int64_t _nowMicros() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (int64_t) now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+static int freespace_hidraw_performBudget(int maxReports, int maxMicros, int* workRemaining) {
     int i;
     int n;
     int nfds;
     int rc;
-    static int needToRescan = 1;
+    int result = FREESPACE_SUCCESS;
+    int reports = 0;
+    int numReady = 0;
+    int deadlineSet = maxMicros > 0;
+    int64_t deadline = 0;
+    struct pollfd fds[FREESPACE_MAXIMUM_DEVICE_COUNT + 1];
+    int fdIndex[FREESPACE_MAXIMUM_DEVICE_COUNT + 1];
+
+    // Devices with reports waiting, as an index into ctx_.devices and the
+    // cookie of the device that was there.
+    int readyIndex[FREESPACE_MAXIMUM_DEVICE_COUNT];
+    int readyCookie[FREESPACE_MAXIMUM_DEVICE_COUNT];
+
+    if (workRemaining) {
+        *workRemaining = 0;
+    }
+    if (deadlineSet) {
+        deadline = _nowMicros() + maxMicros;
+    }
 
     // Initial scan of all devices
-    if (needToRescan) {
+    if (!ctx_.initialScanDone) {
         _scanAllDevices();
-        needToRescan = 0;
+        ctx_.initialScanDone = 1;
     }
 
-    struct pollfd fds[FREESPACE_MAXIMUM_DEVICE_COUNT + 1];
+    // Report any background opens that have completed
+    rc = freespace_workers_perform();
+    if (rc != FREESPACE_SUCCESS) {
+        return rc;
+    }
 
     // Populate fds[]
     fds[0].fd = ctx_.inotify_fd;
     fds[0].events = POLLIN;
-
-    for (i = 0, n = 0; n < ctx_.numDevices && i < FREESPACE_MAXIMUM_DEVICE_COUNT; ++i) {
-        struct FreespaceDevice * device = ctx_.devices[i];
-        if (!device) {
+    fds[0].revents = 0;
+
+    // Start at the round robin cursor so that the device served first
+    // changes from call to call.
+    for (i = 0, n = 1; i < FREESPACE_MAXIMUM_DEVICE_COUNT; ++i) {
+        int idx = (ctx_.performCursor + i) % FREESPACE_MAXIMUM_DEVICE_COUNT;
+        struct FreespaceDevice * device = ctx_.devices[idx];
+        if (!device || device->fd_ < 0) {
             continue;
         }
 
-        ++n;
         fds[n].fd = device->fd_;
         fds[n].events = POLLIN | POLLHUP | POLLERR;
+        fds[n].revents = 0;
+        fdIndex[n] = idx;
+        ++n;
     }
 
     // Poll open file descriptors
-    nfds = poll(fds, ctx_.numDevices + 1, 0);
+    nfds = poll(fds, n, 0);
+    if (nfds < 0) {
+        WARN("poll() failed: %s", strerror(errno));
+        return FREESPACE_ERROR_UNEXPECTED;
+    }
+    if (nfds == 0) {
+        return FREESPACE_SUCCESS;
+    }
 
-    i = 0;
-    n = 0;
-    if (nfds > 0 ) {
-        // inotify events
-        if (fds[0].revents & POLLIN) {
+    // inotify events
+    if (fds[0].revents & POLLIN) {
+        if ((rc = _inotify_process())) {
+            return rc;
+        }
+    }
+
+    // Handle disconnects and find the devices that have reports
+    for (i = 1; i < n; ++i) {
+        struct FreespaceDevice * device = ctx_.devices[fdIndex[i]];
+        if (!device || device->fd_ != fds[i].fd) {
+            continue;
+        }
 
-            fds[0].revents = 0;
-            --nfds;
-            if ((rc = _inotify_process())) {
+        if (fds[i].revents & (POLLHUP | POLLERR)) {
+            DEBUG("Disconnect device %d", device->id_);
+            rc = _disconnect(device);
+            if (rc) {
                 return rc;
             }
+        } else if ((fds[i].revents & POLLIN) && device->state_ == FREESPACE_OPENED) {
+            readyIndex[numReady] = fdIndex[i];
+            readyCookie[numReady] = device->cookie_;
+            numReady++;
         }
+    }
+
+    // Serve the ready devices round robin, a quantum at a time, until
+    // they are drained or the budget runs out.
+    while (numReady > 0) {
+        for (i = 0; i < numReady; ) {
+            struct FreespaceDevice * device = ctx_.devices[readyIndex[i]];
+            int quantum = FREESPACE_PERFORM_QUANTUM;
+            int numRead = 0;
+            int drained = 1;
 
-        // Other device->fd_
-        while (nfds > 0) {
-            while (n < ctx_.numDevices && i < FREESPACE_MAXIMUM_DEVICE_COUNT) {
-                struct FreespaceDevice * device = ctx_.devices[i];
-                if (!device) {
-                    ++i;
-                    continue;
+            if (maxReports > 0 && maxReports - reports < quantum) {
+                quantum = maxReports - reports;
+            }
+
+            // The device may have been closed by an earlier callback
+            if (device != NULL && device->cookie_ == readyCookie[i] &&
+                device->state_ == FREESPACE_OPENED) {
+                FREESPACE_HOT_PATH_BEGIN();
+                rc = _readDevice(device, quantum, deadlineSet ? deadline : 0, &numRead, &drained);
+                FREESPACE_HOT_PATH_END();
+                reports += numRead;
+                if (rc != FREESPACE_SUCCESS) {
+                    result = rc;
+                    drained = 1;
                 }
-                ++n;
+            }
+
+            // The next call starts with the device after this one
+            ctx_.performCursor = (readyIndex[i] + 1) % FREESPACE_MAXIMUM_DEVICE_COUNT;
+
+            if (drained) {
+                // Drop it, keeping the order of the others
+                numReady--;
+                memmove(&readyIndex[i], &readyIndex[i + 1], (numReady - i) * sizeof(int));
+                memmove(&readyCookie[i], &readyCookie[i + 1], (numReady - i) * sizeof(int));
+            } else {
                 ++i;
+            }
 
-                if (fds[n].revents) {
-                    if (fds[n].revents & (POLLHUP | POLLERR)) {
-                        DEBUG("Disconnect device %d", device->id_);
-                        rc = _disconnect(device);
-                    }
-                    if (fds[n].revents & POLLIN) {
-                        if (device->state_ == FREESPACE_OPENED) {
-                            rc = _readDevice(device);
-                        }
-                    }
-                    if (rc) {
-                        return rc;
+            if ((maxReports > 0 && reports >= maxReports) ||
+                (deadlineSet && _nowMicros() >= deadline)) {
+                if (workRemaining && numReady > 0) {
+                    *workRemaining = 1;
+                }
+                for (i = 0; i < numReady; i++) {
+                    device = ctx_.devices[readyIndex[i]];
+                    if (device != NULL && device->cookie_ == readyCookie[i]) {
+                        FREESPACE_RATE_BACKLOGGED(device->id_);
                     }
-                    --nfds;
-                    break;
                 }
+                return result;
             }
         }
-    } else if (nfds < 0 ) {
-        WARN("poll() failed: %s", strerror(errno));
-        return FREESPACE_ERROR_UNEXPECTED;
     }
 
-    return FREESPACE_SUCCESS;
+    return result;
 }
 
-void freespace_setFileDescriptorCallbacks(freespace_pollfdAddedCallback addedCallback,
-                                          freespace_pollfdRemovedCallback removedCallback) {
+static void freespace_hidraw_setFileDescriptorCallbacks(freespace_pollfdAddedCallback addedCallback,
+                                                        freespace_pollfdRemovedCallback removedCallback) {
     ctx_.userAddedCallback = addedCallback;
     ctx_.userRemovedCallback = removedCallback;
 }
 
-int freespace_syncFileDescriptors() {
+static int freespace_hidraw_syncFileDescriptors() {
     int i;
     int n;
 
@@ -653,6 +811,11 @@ int freespace_syncFileDescriptors() {
     // Add the hot-plug inotify's fd
     ctx_.userAddedCallback(ctx_.inotify_fd, POLLIN);
 
+    // Add the background open completion fd
+    if (freespace_workers_getFD() >= 0) {
+        ctx_.userAddedCallback(freespace_workers_getFD(), POLLIN);
+    }
+
     i = 0;
     n = 0;
     for (; n < ctx_.numDevices && i < FREESPACE_MAXIMUM_DEVICE_COUNT; i++) {
@@ -669,9 +832,9 @@ int freespace_syncFileDescriptors() {
     return FREESPACE_SUCCESS;
 }
 
-int freespace_private_setReceiveCallback(FreespaceDeviceId id,
-                                         freespace_receiveCallback callback,
-                                         void* cookie) {
+static int freespace_hidraw_setReceiveCallback(FreespaceDeviceId id,
+                                               freespace_receiveCallback callback,
+                                               void* cookie) {
     GET_DEVICE(id, device);
 
     device->receiveCallback_ = callback;
@@ -680,9 +843,9 @@ int freespace_private_setReceiveCallback(FreespaceDeviceId id,
     return FREESPACE_SUCCESS;
 }
 
-int freespace_setReceiveMessageCallback(FreespaceDeviceId id,
-                                        freespace_receiveMessageCallback callback,
-                                        void* cookie) {
+static int freespace_hidraw_setReceiveMessageCallback(FreespaceDeviceId id,
+                                                      freespace_receiveMessageCallback callback,
+                                                      void* cookie) {
     GET_DEVICE(id, device);
 
     device->receiveMessageCallback_ = callback;
@@ -691,15 +854,95 @@ int freespace_setReceiveMessageCallback(FreespaceDeviceId id,
     return FREESPACE_SUCCESS;
 }
 
-static int _readDevice(struct FreespaceDevice * device) {
+static int freespace_hidraw_setReceiveBufferCallback(FreespaceDeviceId id,
+                                                     freespace_receiveBufferCallback callback,
+                                                     void* cookie) {
+    GET_DEVICE(id, device);
+
+    device->receiveBufferCallback_ = callback;
+    device->receiveBufferCookie_ = cookie;
+
+    // Get the first buffer now rather than while receiving
+    if (callback != NULL && device->spare_ == NULL) {
+        device->spare_ = freespace_private_bufferAcquire();
+    }
+
+    return FREESPACE_SUCCESS;
+}
+
+// Reserve the pool buffers an open device reads into and lends out, and
+// its requests, so that receiving never grows the pools
+static int _reserveBuffers(struct FreespaceDevice* device) {
+    int rc;
+
+    if (device->reserved_) {
+        return FREESPACE_SUCCESS;
+    }
+    rc = freespace_private_requestReserve(device->id_);
+    if (rc != FREESPACE_SUCCESS) {
+        return rc;
+    }
+    rc = freespace_private_bufferReserve(1 + FREESPACE_BUFFER_LEND_SLACK);
+    if (rc == FREESPACE_SUCCESS) {
+        device->reserved_ = 1;
+    }
+    return rc;
+}
+
+static void _releaseSpare(struct FreespaceDevice* device) {
+    if (device->spare_ != NULL) {
+        freespace_bufferRelease(device->spare_);
+        device->spare_ = NULL;
+    }
+    if (device->reserved_) {
+        freespace_private_bufferUnreserve(1 + FREESPACE_BUFFER_LEND_SLACK);
+        device->reserved_ = 0;
+    }
+}
+
+// Read and dispatch up to maxReports reports (no limit if <= 0) or until
+// the deadline from _nowMicros() passes (none if 0). drained is set once
+// the device has nothing more to read.
+static int _readDevice(struct FreespaceDevice * device, int maxReports, int64_t deadline,
+                       int * numRead, int * drained) {
     ssize_t rc;
-    uint8_t buf[FREESPACE_MAX_OUTPUT_MESSAGE_SIZE];
+    int length;
+    uint8_t buf[FREESPACE_MAX_INPUT_MESSAGE_SIZE];
+    uint8_t* data;
+    int wantBuffer;
+    struct FreespaceBuffer* lent;
+    int64_t dispatchStart;
+
+    *numRead = 0;
+    *drained = 0;
+    while (maxReports <= 0 || *numRead < maxReports) {
+        if (*numRead > 0 && deadline != 0 && _nowMicros() >= deadline) {
+            break;
+        }
+
+        // A callback may have closed the device
+        if (device->state_ != FREESPACE_OPENED) {
+            *drained = 1;
+            break;
+        }
+
+        // Read straight into a pooled buffer if it is going to be lent out
+        data = buf;
+        wantBuffer = (device->receiveBufferCallback_ != NULL);
+        if (wantBuffer) {
+            if (device->spare_ == NULL) {
+                device->spare_ = freespace_private_bufferAcquire();
+            }
+            if (device->spare_ != NULL) {
+                data = device->spare_->data_;
+            }
+        }
 
-    while (1) {
-        rc = read(device->fd_, buf, sizeof(buf));
+        rc = read(device->fd_, data, FREESPACE_MAX_INPUT_MESSAGE_SIZE);
         if (rc < 0) {
             if (errno == EAGAIN) {
                 // no more data
+                *drained = 1;
                 break;
             }
 
@@ -716,21 +959,74 @@ static int _readDevice(struct FreespaceDevice * device) {
             // Disconnected.... hot-plug will catch this later and notify
             return FREESPACE_ERROR_NO_DEVICE;
         }
+        (*numRead)++;
+        length = (int) rc;
+        FREESPACE_TRACE_INSTANT("report", device->id_);
+        FREESPACE_PROBE3(report__received, device->id_, length, data[0]);
+        FREESPACE_RECORD(device->id_, device->api_->hVer_, FREESPACE_RECORD_INBOUND, data, length);
+        FREESPACE_PUBLISH(device->id_, device->api_->hVer_, data, length);
+        FREESPACE_RATE_RECEIVED(device->id_);
+
+        FREESPACE_RATE_DISPATCH_BEGIN(dispatchStart);
+        if (freespace_private_requestDeliver(device->id_, data, length, device->api_->hVer_) ||
+            freespace_private_frsDeliver(device->id_, data, length, device->api_->hVer_) ||
+            freespace_private_mailboxDeliver(device->id_, data, length, device->api_->hVer_) ||
+            freespace_private_subscriptionDeliver(device->id_, data, length, device->api_->hVer_)) {
+            // Conflated or handled by a subscriber
+            FREESPACE_RATE_DISPATCH_END(dispatchStart);
+            continue;
+        }
+
+        // Take the buffer from the device so that closing it from one of
+        // the callbacks does not release it.
+        lent = NULL;
+        if (data != buf) {
+            lent = device->spare_;
+            lent->length_ = length;
+            device->spare_ = NULL;
+        }
 
         if (device->receiveCallback_) {
-            device->receiveCallback_(device->id_, buf, (int) rc, device->receiveCookie_, FREESPACE_SUCCESS);
+            FREESPACE_TRACE_BEGIN("callback", device->id_);
+            FREESPACE_PROBE1(callback__entry, device->id_);
+            device->receiveCallback_(device->id_, data, length, device->receiveCookie_, FREESPACE_SUCCESS);
+            FREESPACE_PROBE1(callback__return, device->id_);
+            FREESPACE_TRACE_END("callback", device->id_);
         }
 
         if (device->receiveMessageCallback_) {
             struct freespace_message m;
 
-            rc = freespace_decode_message(buf, rc, &m, device->api_->hVer_);
+            FREESPACE_TRACE_BEGIN("decode", device->id_);
+            rc = freespace_decode_message(data, length, &m, device->api_->hVer_);
+            FREESPACE_TRACE_END("decode", device->id_);
+            FREESPACE_PROBE3(decode__done, device->id_, rc == FREESPACE_SUCCESS ? m.messageType : -1, (int) rc);
 
+            FREESPACE_TRACE_BEGIN("callback", device->id_);
+            FREESPACE_PROBE1(callback__entry, device->id_);
             device->receiveMessageCallback_(
                     device->id_,
                     rc == FREESPACE_SUCCESS ? &m : NULL,
                     device->receiveMessageCookie_, rc);
+            FREESPACE_PROBE1(callback__return, device->id_);
+            FREESPACE_TRACE_END("callback", device->id_);
+        }
+
+        if (wantBuffer && device->receiveBufferCallback_) {
+            FREESPACE_TRACE_BEGIN("callback", device->id_);
+            FREESPACE_PROBE1(callback__entry, device->id_);
+            if (lent != NULL) {
+                device->receiveBufferCallback_(device->id_, lent, device->receiveBufferCookie_, FREESPACE_SUCCESS);
+            } else {
+                device->receiveBufferCallback_(device->id_, NULL, device->receiveBufferCookie_, FREESPACE_ERROR_OUT_OF_MEMORY);
+            }
+            FREESPACE_PROBE1(callback__return, device->id_);
+            FREESPACE_TRACE_END("callback", device->id_);
+        }
+        if (lent != NULL) {
+            freespace_bufferRelease(lent);
         }
+        FREESPACE_RATE_DISPATCH_END(dispatchStart);
     }
     return FREESPACE_SUCCESS;
 }
@@ -808,6 +1104,75 @@ static int _isFreespaceDevice(const char * path, struct FreespaceDeviceAPI const
     return FREESPACE_SUCCESS;
 }
 
+static int _isFreespaceProduct(unsigned int vendor, unsigned int product) {
+    int i;
+    for (i = 0; i < freespace_deviceAPITableNum; i++) {
+        struct FreespaceDeviceAPI const * api = &freespace_deviceAPITable[i];
+        if (api->idVendor_ == vendor &&
+            (api->idProduct_ & api->mask_) == (product & api->mask_)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Find Freespace devices from sysfs, which needs no access to the nodes
+static int freespace_hidraw_probe() {
+    int rc = FREESPACE_ERROR_NOT_FOUND;
+    int devNum;
+    char path[PATH_MAX];
+    char uevent[512];
+    struct dirent * ent;
+    DIR * dev_dir;
+
+    dev_dir = opendir(DEV_DIR);
+    if (dev_dir == NULL) {
+        return FREESPACE_ERROR_NOT_FOUND;
+    }
+
+    while ((ent = readdir(dev_dir)) != NULL) {
+        unsigned int bus;
+        unsigned int vendor;
+        unsigned int product;
+        const char* id;
+        ssize_t n;
+        int fd;
+
+        if (sscanf(ent->d_name, HIDRAW_PREFIX "%d", &devNum) != 1) {
+            continue;
+        }
+
+        snprintf(path, sizeof(path), "/sys/class/hidraw/%s/device/uevent", ent->d_name);
+        fd = open(path, O_RDONLY);
+        if (fd < 0) {
+            continue;
+        }
+        n = read(fd, uevent, sizeof(uevent) - 1);
+        close(fd);
+        if (n <= 0) {
+            continue;
+        }
+        uevent[n] = '\0';
+
+        id = strstr(uevent, "HID_ID=");
+        if (id == NULL || sscanf(id, "HID_ID=%x:%x:%x", &bus, &vendor, &product) != 3 ||
+            !_isFreespaceProduct(vendor, product)) {
+            continue;
+        }
+
+        snprintf(path, sizeof(path), "%s/%s", DEV_DIR, ent->d_name);
+        if (access(path, R_OK | W_OK) == 0) {
+            rc = FREESPACE_SUCCESS;
+            break;
+        }
+        DEBUG("No access to %s", path);
+        rc = FREESPACE_ERROR_ACCESS;
+    }
+
+    closedir(dev_dir);
+    return rc;
+}
+
 static int _allocateNewDevice(struct FreespaceDevice** out_device) {
     struct FreespaceDevice* device;
     *out_device = 0;
@@ -816,7 +1181,7 @@ static int _allocateNewDevice(struct FreespaceDevice** out_device) {
         return FREESPACE_ERROR_OUT_OF_MEMORY;
     }
 
-    device = (struct FreespaceDevice*) malloc(sizeof(struct FreespaceDevice));
+    device = (struct FreespaceDevice*) freespace_private_malloc(sizeof(struct FreespaceDevice));
     if (device == NULL) {
         // Out of memory.
         return FREESPACE_ERROR_OUT_OF_MEMORY;
@@ -854,17 +1219,9 @@ static FreespaceDeviceId _assignId() {
     return -1;
 }
 
-static int _scanDevice(const char * devName) {
-
-    int rc, i, n, devNum;
-    char absPath[NAME_MAX] = "";
+static struct FreespaceDevice* _findDeviceByDevNum(int devNum) {
+    int i, n;
     struct FreespaceDevice * device;
-    struct FreespaceDeviceAPI const * API = 0;
-
-    // get <num> from hidraw<num>
-    if (sscanf(devName, "hidraw%u", &devNum) != 1) {
-        return FREESPACE_ERROR_UNEXPECTED;
-    }
 
     for (i = 0, n = 0; n < ctx_.numDevices && i < FREESPACE_MAXIMUM_DEVICE_COUNT; i++) {
         device = ctx_.devices[i];
@@ -874,10 +1231,52 @@ static int _scanDevice(const char * devName) {
         }
 
         n++;
-        if (device->devNum_ != devNum) {
-            continue;
+        if (device->devNum_ == devNum) {
+            return device;
         }
+    }
+
+    return NULL;
+}
+
+// Allocate a device in the CONNECTED state. The caller sends the
+// hotplug notification once the device is fully set up.
+static int _addDevice(int devNum,
+                      const char * absPath,
+                      struct FreespaceDeviceAPI const * API,
+                      struct FreespaceDevice ** out_device) {
+    struct FreespaceDevice * device;
+    int rc = _allocateNewDevice(&device);
+    if (rc != FREESPACE_SUCCESS) {
+        return rc;
+    }
+
+    device->state_ = FREESPACE_CONNECTED;
+    device->fd_ = -1;
+    device->id_ = _assignId();
+    device->devNum_ = devNum;
+    strncpy(device->hidrawPath_, absPath, sizeof(device->hidrawPath_));
+    device->api_ = API;
+
+    DEBUG("Found freespace device at %s. ** Num devices: %d **", absPath, ctx_.numDevices);
+    *out_device = device;
+    return FREESPACE_SUCCESS;
+}
+
+static int _scanDevice(const char * devName) {
 
+    int rc, devNum;
+    char absPath[NAME_MAX] = "";
+    struct FreespaceDevice * device;
+    struct FreespaceDeviceAPI const * API = 0;
+
+    // get <num> from hidraw<num>
+    if (sscanf(devName, "hidraw%u", &devNum) != 1) {
+        return FREESPACE_ERROR_UNEXPECTED;
+    }
+
+    device = _findDeviceByDevNum(devNum);
+    if (device != NULL) {
         switch (device->state_) {
             case FREESPACE_OPENED:
             case FREESPACE_CONNECTED:
@@ -907,36 +1306,28 @@ static int _scanDevice(const char * devName) {
         return rc;
     }
 
-    // Allocate a device
-    {
-
-        int rc = _allocateNewDevice(&device);
-        if (rc != FREESPACE_SUCCESS) {
-            return rc;
-        }
-
-        device->state_ = FREESPACE_CONNECTED;
-        device->fd_ = -1;
-        device->id_ = _assignId();
-        device->devNum_ = devNum;
-        strncpy(device->hidrawPath_, absPath, sizeof(device->hidrawPath_));
-        device->api_ = API;
+    rc = _addDevice(devNum, absPath, API, &device);
+    if (rc != FREESPACE_SUCCESS) {
+        return rc;
+    }
 
-        if (ctx_.hotplugCallback) {
-            ctx_.hotplugCallback(FREESPACE_HOTPLUG_INSERTION, device->id_, ctx_.hotplugCookie);
-        }
+    FREESPACE_PROBE1(hotplug__insert, device->id_);
+    if (ctx_.hotplugCallback) {
+        ctx_.hotplugCallback(FREESPACE_HOTPLUG_INSERTION, device->id_, ctx_.hotplugCookie);
     }
 
-    DEBUG("Found freespace device at %s. ** Num devices: %d **", absPath, ctx_.numDevices);
     return FREESPACE_SUCCESS;
 }
 
 // Check whether a hidraw device is added/removed to/from the device directory /dev)
 static int _scanAllDevices() {
+    DIR* dev_dir;
+
     TRACE("Scanning all hidraw devices");
     // Check if a device has been added (iterate all of /dev)
-    DIR* dev_dir = opendir(DEV_DIR);
+    dev_dir = opendir(DEV_DIR);
     if (dev_dir) {
+        FREESPACE_TRACE_BEGIN("hotplugScan", -1);
         struct dirent*  ent;
 
         while ( (ent = readdir(dev_dir)) != NULL ) {
@@ -946,6 +1337,7 @@ static int _scanAllDevices() {
 
             _scanDevice(ent->d_name);
         }
+        FREESPACE_TRACE_END("hotplugScan", -1);
     } else {
         WARN("Failed opening %s", DEV_DIR);
         return FREESPACE_ERROR_ACCESS;
@@ -956,6 +1348,280 @@ static int _scanAllDevices() {
     return FREESPACE_SUCCESS;
 }
 
+// Open a hidraw node for async use and discard anything already queued.
+// This may block, so it is safe to call from the worker threads.
+static int _openPath(const char * path, int * fd) {
+    uint8_t buf[1024];
+
+    *fd = open(path, O_RDWR | O_NONBLOCK);
+    if (*fd < 0) {
+        WARN("Failed opening %s: %s", path, strerror(errno));
+        return FREESPACE_ERROR_IO;
+    }
+
+    // flush the device
+    while (read(*fd, buf, sizeof(buf)) > 0);
+
+    return FREESPACE_SUCCESS;
+}
+
+/**
+ * A probe and/or open running on the worker pool. When id_ is -1 the
+ * hidraw node has not been identified yet and is probed first.
+ */
+struct FreespaceOpenJob {
+    struct FreespaceWorkItem item_;
+
+    FreespaceDeviceId id_;
+    int deviceCookie_;
+    int devNum_;
+    char hidrawPath_[16];
+    struct FreespaceDeviceAPI const * api_;
+
+    int fd_;
+    int rc_;
+
+    freespace_openCallback callback_;
+    void* cookie_;
+};
+
+static int _startWorkers() {
+    int rc;
+
+    if (freespace_workers_getFD() >= 0) {
+        return FREESPACE_SUCCESS;
+    }
+
+    rc = freespace_workers_init();
+    if (rc != FREESPACE_SUCCESS) {
+        return rc;
+    }
+
+    if (ctx_.userAddedCallback) {
+        ctx_.userAddedCallback(freespace_workers_getFD(), POLLIN);
+    }
+    return FREESPACE_SUCCESS;
+}
+
+// Runs on a worker thread. Only touches the job.
+static void _openJobWork(struct FreespaceWorkItem * item) {
+    struct FreespaceOpenJob * job = (struct FreespaceOpenJob *) item;
+
+    if (job->id_ < 0) {
+        if (access(job->hidrawPath_, R_OK | W_OK)) {
+            // can't access this file, just skip
+            DEBUG(" -- %s: %s", job->hidrawPath_, strerror(errno));
+            return;
+        }
+
+        job->rc_ = _isFreespaceDevice(job->hidrawPath_, &job->api_);
+        if (job->api_ == NULL) {
+            TRACE("Not a freespace device: %s", job->hidrawPath_);
+            return;
+        }
+    }
+
+    job->rc_ = _openPath(job->hidrawPath_, &job->fd_);
+}
+
+static void _openJobReleaseFd(struct FreespaceOpenJob * job) {
+    if (job->fd_ >= 0) {
+        close(job->fd_);
+        job->fd_ = -1;
+    }
+}
+
+// Runs on the thread calling freespace_perform.
+static void _openJobDone(struct FreespaceWorkItem * item) {
+    struct FreespaceOpenJob * job = (struct FreespaceOpenJob *) item;
+    struct FreespaceDevice * device;
+    int isNew = 0;
+    int rc;
+
+    if (item->cancelled_) {
+        _openJobReleaseFd(job);
+        freespace_private_free(job);
+        return;
+    }
+
+    if (job->id_ < 0) {
+        if (job->api_ == NULL) {
+            // Not ours
+            _openJobReleaseFd(job);
+            freespace_private_free(job);
+            return;
+        }
+
+        device = _findDeviceByDevNum(job->devNum_);
+        if (device != NULL) {
+            // Picked up by hotplug while we were probing it. Finish the
+            // open on that device, so the callback is still called.
+            job->id_ = device->id_;
+            job->deviceCookie_ = device->cookie_;
+        } else {
+            rc = _addDevice(job->devNum_, job->hidrawPath_, job->api_, &device);
+            if (rc != FREESPACE_SUCCESS) {
+                _openJobReleaseFd(job);
+                freespace_private_free(job);
+                return;
+            }
+            job->id_ = device->id_;
+            isNew = 1;
+        }
+    }
+
+    if (!isNew) {
+        device = findDeviceById(job->id_);
+        if (device == NULL || device->cookie_ != job->deviceCookie_ ||
+            device->state_ == FREESPACE_DISCONNECTED) {
+            // Removed while we were opening it
+            _openJobReleaseFd(job);
+            job->rc_ = FREESPACE_ERROR_NO_DEVICE;
+            device = NULL;
+        } else if (device->state_ == FREESPACE_OPENED) {
+            // Opened synchronously in the meantime
+            _openJobReleaseFd(job);
+            device = NULL;
+        }
+    }
+
+    if (device != NULL && job->rc_ == FREESPACE_SUCCESS) {
+        job->rc_ = _reserveBuffers(device);
+        if (job->rc_ != FREESPACE_SUCCESS) {
+            _openJobReleaseFd(job);
+        }
+    }
+
+    if (device != NULL && job->rc_ == FREESPACE_SUCCESS) {
+        device->fd_ = job->fd_;
+        device->state_ = FREESPACE_OPENED;
+        if (ctx_.userAddedCallback) {
+            ctx_.userAddedCallback(device->fd_, POLLIN);
+        }
+    }
+
+    // Announce new devices only once they are usable, so that the
+    // hotplug callback does not open them a second time.
+    if (isNew) {
+        FREESPACE_PROBE1(hotplug__insert, job->id_);
+    }
+    if (isNew && ctx_.hotplugCallback) {
+        ctx_.hotplugCallback(FREESPACE_HOTPLUG_INSERTION, job->id_, ctx_.hotplugCookie);
+    }
+
+    if (job->callback_) {
+        job->callback_(job->id_, job->cookie_, job->rc_);
+    }
+    freespace_private_free(job);
+}
+
+static int _submitOpenJob(FreespaceDeviceId id,
+                          int deviceCookie,
+                          int devNum,
+                          const char * path,
+                          freespace_openCallback callback,
+                          void* cookie) {
+    int rc;
+    struct FreespaceOpenJob * job;
+
+    job = (struct FreespaceOpenJob *) freespace_private_malloc(sizeof(struct FreespaceOpenJob));
+    if (job == NULL) {
+        return FREESPACE_ERROR_OUT_OF_MEMORY;
+    }
+    memset(job, 0, sizeof(struct FreespaceOpenJob));
+    job->id_ = id;
+    job->deviceCookie_ = deviceCookie;
+    job->devNum_ = devNum;
+    strncpy(job->hidrawPath_, path, sizeof(job->hidrawPath_) - 1);
+    job->fd_ = -1;
+    job->callback_ = callback;
+    job->cookie_ = cookie;
+
+    rc = freespace_workers_submit(&job->item_, _openJobWork, _openJobDone);
+    if (rc != FREESPACE_SUCCESS) {
+        freespace_private_free(job);
+    }
+    return rc;
+}
+
+static int freespace_hidraw_openDeviceAsync(FreespaceDeviceId id,
+                                            freespace_openCallback callback,
+                                            void* cookie) {
+    int rc;
+    GET_DEVICE(id, device);
+
+    if (device->state_ == FREESPACE_DISCONNECTED) {
+        return FREESPACE_ERROR_NO_DEVICE;
+    }
+
+    if (device->state_ == FREESPACE_OPENED) {
+        if (callback) {
+            callback(id, cookie, FREESPACE_SUCCESS);
+        }
+        return FREESPACE_SUCCESS;
+    }
+
+    if (device->state_ != FREESPACE_CONNECTED) {
+        return FREESPACE_ERROR_UNEXPECTED;
+    }
+
+    rc = _startWorkers();
+    if (rc != FREESPACE_SUCCESS) {
+        return rc;
+    }
+
+    return _submitOpenJob(id, device->cookie_, device->devNum_, device->hidrawPath_,
+                          callback, cookie);
+}
+
+static int freespace_hidraw_openAllDevicesAsync(freespace_openCallback callback, void* cookie) {
+    int rc;
+    int devNum;
+    char absPath[PATH_MAX] = "";
+    struct FreespaceDevice * device;
+    struct dirent * ent;
+    DIR * dev_dir;
+
+    rc = _startWorkers();
+    if (rc != FREESPACE_SUCCESS) {
+        return rc;
+    }
+
+    // The probes below replace the blocking scan in freespace_perform
+    ctx_.initialScanDone = 1;
+
+    dev_dir = opendir(DEV_DIR);
+    if (dev_dir == NULL) {
+        WARN("Failed opening %s", DEV_DIR);
+        return FREESPACE_ERROR_ACCESS;
+    }
+
+    while ((ent = readdir(dev_dir)) != NULL) {
+        if (sscanf(ent->d_name, "hidraw%u", &devNum) != 1) {
+            continue;
+        }
+
+        snprintf(absPath, sizeof(absPath), "%s/%s", DEV_DIR, ent->d_name);
+        device = _findDeviceByDevNum(devNum);
+        if (device == NULL) {
+            // Unknown node: probe and open it
+            rc = _submitOpenJob(-1, 0, devNum, absPath, callback, cookie);
+        } else if (device->state_ == FREESPACE_CONNECTED) {
+            rc = _submitOpenJob(device->id_, device->cookie_, devNum, absPath,
+                                callback, cookie);
+        } else {
+            continue;
+        }
+
+        if (rc != FREESPACE_SUCCESS) {
+            break;
+        }
+    }
+
+    closedir(dev_dir);
+    return rc;
+}
+
 // Create and initialize inotify instance
 // Add watch to about events specified by when new file is created or deleted in
 // the device directory (/dev)
@@ -964,20 +1630,20 @@ static int _inotify_init() {
 
     ctx_.inotify_fd = inotify_init();
     if (ctx_.inotify_fd < 0) {
-        WARN("Failed inotify_init: %s", strerror(errno));
+        HOTPLUG_WARN("Failed inotify_init: %s", strerror(errno));
         return FREESPACE_ERROR_IO;
     }
 
     rc = fcntl(ctx_.inotify_fd, F_SETFL, O_NONBLOCK);  // Set to non-blocking
     if (rc < 0) {
-        WARN("Failed inotify -> non block: %s", strerror(errno));
+        HOTPLUG_WARN("Failed inotify -> non block: %s", strerror(errno));
         return FREESPACE_ERROR_IO;
     }
 
     // watch for files added or permissions changed under /dev
     ctx_.inotify_wd = inotify_add_watch(ctx_.inotify_fd, DEV_DIR, IN_CREATE | IN_ATTRIB);
     if (ctx_.inotify_wd < 0) {
-        WARN("Failed inotify_add_watch: %s", strerror(errno));
+        HOTPLUG_WARN("Failed inotify_add_watch: %s", strerror(errno));
         return FREESPACE_ERROR_IO;
     }
 
@@ -1000,29 +1666,29 @@ static int _inotify_process() {
             // done!
             return FREESPACE_SUCCESS;
         }
-        WARN("inotify: fd read error: %s", strerror(errno));
+        HOTPLUG_WARN("inotify: fd read error: %s", strerror(errno));
         return FREESPACE_ERROR_IO;
     }
 
     struct inotify_event * event = (struct inotify_event *) (buf);
 
     if (event->wd != ctx_.inotify_wd) {
-        WARN("inotify: watchdog does not match! -- %d != %d", event->wd, ctx_.inotify_wd);
+        HOTPLUG_WARN("inotify: watchdog does not match! -- %d != %d", event->wd, ctx_.inotify_wd);
         return FREESPACE_ERROR_IO;
     }
 
     if (event->len > sizeof(buf)) {
-        TRACE("inotify: event read length violation. event size: %u, buffer size: %zu",
+        HOTPLUG_TRACE("inotify: event read length violation. event size: %u, buffer size: %zu",
               event->len, sizeof(buf));
         return FREESPACE_ERROR_IO;
     }
 
     if (strncmp(event->name, HIDRAW_PREFIX, strlen(HIDRAW_PREFIX)) != 0) {
-        TRACE("inotify: skip event - %s/%s:%04x ", DEV_DIR, event->name, event->mask);
+        HOTPLUG_TRACE("inotify: skip event - %s/%s:%04x ", DEV_DIR, event->name, event->mask);
         return FREESPACE_SUCCESS;
     }
 
-    DEBUG("inotify: handle event - %s/%s:%04x ", DEV_DIR, event->name, event->mask);
+    HOTPLUG_DEBUG("inotify: handle event - %s/%s:%04x ", DEV_DIR, event->name, event->mask);
     if (event->mask & (IN_CREATE | IN_ATTRIB)) {
         return _scanDevice(event->name);
     }
@@ -1040,7 +1706,7 @@ static void _deallocateDevice(struct FreespaceDevice* device) {
 
 #if 1 // this should not be necessary.
             if (device->fd_ > 0) {
-                DEBUG("Deallocate device (%s) -- fd still open!", device->hidrawPath_)
+                DEBUG("Deallocate device (%s) -- fd still open!", device->hidrawPath_);
                 if (ctx_.userRemovedCallback) {
                     ctx_.userRemovedCallback(device->fd_);
                 }
@@ -1048,7 +1714,8 @@ static void _deallocateDevice(struct FreespaceDevice* device) {
                 device->fd_ = -1;
             }
 #endif
-            free(device);
+            _releaseSpare(device);
+            freespace_private_free(device);
             ctx_.devices[i] = NULL;
             ctx_.numDevices--;
             DEBUG("Freed device. ** Num devices: %d **", ctx_.numDevices);
@@ -1083,6 +1750,7 @@ static int _disconnect(struct FreespaceDevice * device) {
 
         device->state_ = FREESPACE_DISCONNECTED;
         TRACE("*** Sending removal notification for device %d while opened", device->id_);
+        FREESPACE_PROBE1(hotplug__remove, device->id_);
         if (ctx_.hotplugCallback) {
             ctx_.hotplugCallback(FREESPACE_HOTPLUG_REMOVAL, device->id_, ctx_.hotplugCookie);
         }
@@ -1109,6 +1777,7 @@ static int _disconnect(struct FreespaceDevice * device) {
         device = NULL;
 
         TRACE("*** Sending removal notification for device %d while connected", id);
+        FREESPACE_PROBE1(hotplug__remove, id);
         if (ctx_.hotplugCallback) {
             ctx_.hotplugCallback(FREESPACE_HOTPLUG_REMOVAL, id, ctx_.hotplugCookie);
         }
@@ -1134,12 +1803,6 @@ static struct FreespaceBGWriteJob * _popFreeJobLocked() {
 }
 
 static int _returnWriteJobLocked(struct FreespaceBGWriteJob * j) {
-    if (ctx_.writer.numFree + 1 > NUM_MAX_FREE_JOBS) {
-        free(j);
-        return 0;
-    }
-
-    ctx_.writer.numFree++;
     j->next = ctx_.writer.free;
     ctx_.writer.free = j;
     return FREESPACE_SUCCESS;
@@ -1218,6 +1881,7 @@ static void * _writeThread_fn(void * ptr) {
           while (ctx_.writer.exitThread == 0 && (j = _popWriteJobLocked()) != NULL) {
               pthread_mutex_unlock(&ctx_.writer.mutex);
               _write(j->fd, j->message, j->length);
+              FREESPACE_TRACE_INSTANT("sendComplete", -1);
               pthread_mutex_lock(&ctx_.writer.mutex );
               _returnWriteJobLocked(j);
           }
@@ -1229,3 +1893,33 @@ static void * _writeThread_fn(void * ptr) {
 }
 
 #endif
+
+const struct FreespaceBackend freespace_hidrawBackend = {
+    .name_ = "hidraw",
+    .queueReports_ = HIDRAW_QUEUE_REPORTS,
+    .probe_ = freespace_hidraw_probe,
+    .init_ = freespace_hidraw_init,
+    .exit_ = freespace_hidraw_exit,
+    .setDeviceHotplugCallback_ = freespace_hidraw_setDeviceHotplugCallback,
+    .getDeviceList_ = freespace_hidraw_getDeviceList,
+    .getDeviceInfo_ = freespace_hidraw_getDeviceInfo,
+    .openDevice_ = freespace_hidraw_openDevice,
+    .openDeviceAsync_ = freespace_hidraw_openDeviceAsync,
+    .openAllDevicesAsync_ = freespace_hidraw_openAllDevicesAsync,
+    .closeDevice_ = freespace_hidraw_closeDevice,
+    .checkOpen_ = freespace_hidraw_checkOpen,
+    .send_ = freespace_hidraw_send,
+    .sendMessage_ = freespace_hidraw_sendMessage,
+    .read_ = freespace_hidraw_read,
+    .readMessage_ = freespace_hidraw_readMessage,
+    .flush_ = freespace_hidraw_flush,
+    .sendAsync_ = freespace_hidraw_sendAsync,
+    .sendMessageAsync_ = freespace_hidraw_sendMessageAsync,
+    .getNextTimeout_ = freespace_hidraw_getNextTimeout,
+    .performBudget_ = freespace_hidraw_performBudget,
+    .setFileDescriptorCallbacks_ = freespace_hidraw_setFileDescriptorCallbacks,
+    .syncFileDescriptors_ = freespace_hidraw_syncFileDescriptors,
+    .setReceiveCallback_ = freespace_hidraw_setReceiveCallback,
+    .setReceiveMessageCallback_ = freespace_hidraw_setReceiveMessageCallback,
+    .setReceiveBufferCallback_ = freespace_hidraw_setReceiveBufferCallback,
+};
@@ -0,0 +1,879 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/*
+ * A backend with no hardware behind it. Devices are added, fed reports
+ * and answer sends through the functions of test_backend.h, and the
+ * library serves them as it would serve real ones: reports are received
+ * by freespace_perform() and go through the requests, flash record
+ * reads, mailboxes and subscriptions to the callbacks. Applications and
+ * tests choose it with FREESPACE_BACKEND=test.
+ */
+
+#include "freespace/freespace.h"
+#include "freespace_config.h"
+#include "test_backend.h"
+#include "receive_thread.h"
+#include "backend.h"
+#include "freespace_mailbox.h"
+#include "freespace_rate.h"
+#include "freespace_subscribe.h"
+#include "freespace_frs.h"
+#include "freespace_request.h"
+#include "freespace_configure.h"
+#include "freespace_buffer.h"
+#include "freespace_alloc.h"
+#include "freespace_log.h"
+#include "freespace_trace.h"
+#include "freespace_probes.h"
+#include "freespace_recorder.h"
+#include "freespace_publish.h"
+
+#include <string.h>
+#include <time.h>
+
+// Log levels are set at runtime with freespace_setLogLevel()
+#define WARN(...) FREESPACE_LOG(FREESPACE_LOG_BACKEND, FREESPACE_LOG_LEVEL_WARN, __VA_ARGS__)
+#define DEBUG(...) FREESPACE_LOG(FREESPACE_LOG_BACKEND, FREESPACE_LOG_LEVEL_DEBUG, __VA_ARGS__)
+#define TRACE(...) FREESPACE_LOG(FREESPACE_LOG_BACKEND, FREESPACE_LOG_LEVEL_TRACE, __VA_ARGS__)
+
+// Sends whose callback has not been called yet
+#define TEST_MAX_PENDING_SENDS 16
+
+// Hotplug events not yet passed to the callback
+#define TEST_MAX_HOTPLUG_EVENTS (2 * FREESPACE_MAXIMUM_DEVICE_COUNT)
+
+// The number of reports read from a device before moving on to the next
+#define FREESPACE_PERFORM_QUANTUM 4
+
+enum FreespaceDeviceState {
+    FREESPACE_NONE,
+    FREESPACE_CONNECTED,
+    FREESPACE_OPENED,
+    FREESPACE_DISCONNECTED,
+};
+
+struct FreespaceTestReport {
+    int length_;
+    uint8_t data_[FREESPACE_MAX_INPUT_MESSAGE_SIZE];
+};
+
+struct FreespaceDevice {
+    FreespaceDeviceId id_;
+    enum FreespaceDeviceState state_;
+    struct FreespaceDeviceInfo info_;
+    char name_[64];
+
+    freespace_receiveCallback receiveCallback_;
+    freespace_receiveMessageCallback receiveMessageCallback_;
+    freespace_receiveBufferCallback receiveBufferCallback_;
+    void* receiveCookie_;
+    void* receiveMessageCookie_;
+    void* receiveBufferCookie_;
+
+    // Pooled buffer for the next report when a receive buffer callback is set
+    struct FreespaceBuffer* spare_;
+    // Set while open, once the pool has buffers set aside for it
+    int reserved_;
+
+    // Reports injected and not yet received, oldest first
+    struct FreespaceTestReport queue_[FREESPACE_TEST_QUEUE_SIZE];
+    int queueHead_;
+    int queueCount_;
+};
+
+struct FreespacePendingSend {
+    FreespaceDeviceId id_;
+    freespace_sendCallback callback_;
+    void* cookie_;
+    int status_;
+};
+
+struct FreespacePendingOpen {
+    FreespaceDeviceId id_;
+    int result_;
+    freespace_openCallback callback_;
+    void* cookie_;
+};
+
+struct FreespaceHotplugEvent {
+    enum freespace_hotplugEvent event_;
+    FreespaceDeviceId id_;
+};
+
+struct freespace_context {
+    int initialized_;
+    FreespaceDeviceId nextId_;
+    // The device slot served first by the next freespace_perform
+    int performCursor_;
+
+    struct FreespaceDevice devices_[FREESPACE_MAXIMUM_DEVICE_COUNT];
+
+    struct FreespacePendingSend sends_[TEST_MAX_PENDING_SENDS];
+    int numSends_;
+    struct FreespacePendingOpen opens_[FREESPACE_MAXIMUM_DEVICE_COUNT];
+    int numOpens_;
+    struct FreespaceHotplugEvent hotplugEvents_[TEST_MAX_HOTPLUG_EVENTS];
+    int numHotplugEvents_;
+
+    freespace_testSendCallback sendCallback_;
+    void* sendCookie_;
+
+    freespace_hotplugCallback hotplugCallback;
+    void* hotplugCookie;
+};
+
+/* global variables */
+static struct freespace_context ctx_;
+
+#define GET_DEVICE(id, device) \
+    struct FreespaceDevice* device = _findDeviceById(id); \
+    if (device == NULL) { \
+        return FREESPACE_ERROR_INVALID_DEVICE; \
+    }
+
+#define GET_DEVICE_IF_OPEN(id, device) \
+    GET_DEVICE(id, device) \
+    switch (device->state_) { \
+        case FREESPACE_OPENED: \
+            break; \
+        case FREESPACE_CONNECTED: \
+        case FREESPACE_DISCONNECTED: \
+            return FREESPACE_ERROR_NO_DEVICE; \
+        default:\
+            return FREESPACE_ERROR_UNEXPECTED;\
+    }
+
+
+static struct FreespaceDevice* _findDeviceById(FreespaceDeviceId id) {
+    int i;
+    for (i = 0; i < FREESPACE_MAXIMUM_DEVICE_COUNT; i++) {
+        if (ctx_.devices_[i].state_ != FREESPACE_NONE && ctx_.devices_[i].id_ == id) {
+            return &ctx_.devices_[i];
+        }
+    }
+    return NULL;
+}
+
+static int64_t _nowMicros() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (int64_t) now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+static int _queueHotplug(enum freespace_hotplugEvent event, FreespaceDeviceId id) {
+    struct FreespaceHotplugEvent* queued;
+
+    if (ctx_.numHotplugEvents_ == TEST_MAX_HOTPLUG_EVENTS) {
+        return FREESPACE_ERROR_BUSY;
+    }
+    queued = &ctx_.hotplugEvents_[ctx_.numHotplugEvents_++];
+    queued->event_ = event;
+    queued->id_ = id;
+    return FREESPACE_SUCCESS;
+}
+
+// Reserve the pool buffers an open device reads into and lends out, and
+// its requests, so that receiving never grows the pools
+static int _reserveBuffers(struct FreespaceDevice* device) {
+    int rc;
+
+    if (device->reserved_) {
+        return FREESPACE_SUCCESS;
+    }
+    rc = freespace_private_requestReserve(device->id_);
+    if (rc != FREESPACE_SUCCESS) {
+        return rc;
+    }
+    rc = freespace_private_bufferReserve(1 + FREESPACE_BUFFER_LEND_SLACK);
+    if (rc == FREESPACE_SUCCESS) {
+        device->reserved_ = 1;
+    }
+    return rc;
+}
+
+static void _releaseSpare(struct FreespaceDevice* device) {
+    if (device->spare_ != NULL) {
+        freespace_bufferRelease(device->spare_);
+        device->spare_ = NULL;
+    }
+    if (device->reserved_) {
+        freespace_private_bufferUnreserve(1 + FREESPACE_BUFFER_LEND_SLACK);
+        device->reserved_ = 0;
+    }
+}
+
+int freespace_test_addDevice(const struct FreespaceDeviceInfo* info, FreespaceDeviceId* id) {
+    struct FreespaceDevice* device = NULL;
+    int i;
+    int rc;
+
+    if (!ctx_.initialized_ || info == NULL || id == NULL) {
+        return FREESPACE_ERROR_UNEXPECTED;
+    }
+    for (i = 0; i < FREESPACE_MAXIMUM_DEVICE_COUNT; i++) {
+        if (ctx_.devices_[i].state_ == FREESPACE_NONE) {
+            device = &ctx_.devices_[i];
+            break;
+        }
+    }
+    if (device == NULL) {
+        return FREESPACE_ERROR_BUSY;
+    }
+
+    rc = _queueHotplug(FREESPACE_HOTPLUG_INSERTION, ctx_.nextId_);
+    if (rc != FREESPACE_SUCCESS) {
+        return rc;
+    }
+    memset(device, 0, sizeof(*device));
+    device->id_ = ctx_.nextId_++;
+    device->state_ = FREESPACE_CONNECTED;
+    if (info->name != NULL) {
+        strncpy(device->name_, info->name, sizeof(device->name_) - 1);
+    }
+    device->info_ = *info;
+    device->info_.name = device->name_;
+    *id = device->id_;
+    return FREESPACE_SUCCESS;
+}
+
+int freespace_test_removeDevice(FreespaceDeviceId id) {
+    int rc;
+    GET_DEVICE(id, device);
+
+    if (device->state_ == FREESPACE_DISCONNECTED) {
+        return FREESPACE_ERROR_NO_DEVICE;
+    }
+    rc = _queueHotplug(FREESPACE_HOTPLUG_REMOVAL, id);
+    if (rc != FREESPACE_SUCCESS) {
+        return rc;
+    }
+    if (device->state_ == FREESPACE_OPENED) {
+        // Freed when it is closed
+        device->state_ = FREESPACE_DISCONNECTED;
+        device->queueCount_ = 0;
+    } else {
+        device->state_ = FREESPACE_NONE;
+    }
+    return FREESPACE_SUCCESS;
+}
+
+int freespace_test_inject(FreespaceDeviceId id, const uint8_t* report, int length) {
+    struct FreespaceTestReport* queued;
+    GET_DEVICE_IF_OPEN(id, device);
+
+    if (length <= 0 || length > FREESPACE_MAX_INPUT_MESSAGE_SIZE) {
+        return FREESPACE_ERROR_UNEXPECTED;
+    }
+    if (device->queueCount_ == FREESPACE_TEST_QUEUE_SIZE) {
+        return FREESPACE_ERROR_BUSY;
+    }
+    queued = &device->queue_[(device->queueHead_ + device->queueCount_) % FREESPACE_TEST_QUEUE_SIZE];
+    memcpy(queued->data_, report, length);
+    queued->length_ = length;
+    device->queueCount_++;
+    return FREESPACE_SUCCESS;
+}
+
+void freespace_test_setSendCallback(freespace_testSendCallback callback, void* cookie) {
+    ctx_.sendCallback_ = callback;
+    ctx_.sendCookie_ = cookie;
+}
+
+// Only used when named, so there is never a device to find up front
+static int freespace_test_probe() {
+    return FREESPACE_ERROR_NOT_FOUND;
+}
+
+static int freespace_test_init() {
+    memset(&ctx_, 0, sizeof(ctx_));
+    ctx_.initialized_ = 1;
+    return FREESPACE_SUCCESS;
+}
+
+static void freespace_test_exit() {
+    int i;
+
+    // Stop the receive thread before tearing anything down under it
+    freespace_receiveThread_stop();
+
+    for (i = 0; i < FREESPACE_MAXIMUM_DEVICE_COUNT; i++) {
+        _releaseSpare(&ctx_.devices_[i]);
+        ctx_.devices_[i].state_ = FREESPACE_NONE;
+    }
+    for (i = 0; i < ctx_.numSends_; i++) {
+        struct FreespacePendingSend pending = ctx_.sends_[i];
+        pending.callback_(pending.id_, pending.cookie_, FREESPACE_ERROR_NO_DEVICE);
+    }
+    ctx_.numSends_ = 0;
+    ctx_.initialized_ = 0;
+
+    freespace_recorderStop();
+    freespace_publisherStop();
+    freespace_private_mailboxExit();
+    freespace_private_rateExit();
+    freespace_private_subscriptionExit();
+    freespace_private_configExit();
+    freespace_private_requestExit();
+    freespace_private_frsExit();
+    freespace_private_bufferExit();
+}
+
+static int freespace_test_setDeviceHotplugCallback(freespace_hotplugCallback callback,
+                                                   void* cookie) {
+    ctx_.hotplugCallback = callback;
+    ctx_.hotplugCookie = cookie;
+    return FREESPACE_SUCCESS;
+}
+
+static int freespace_test_getDeviceList(FreespaceDeviceId* idList,
+                                        int maxIds,
+                                        int* numIds) {
+    int i;
+
+    *numIds = 0;
+    for (i = 0; i < FREESPACE_MAXIMUM_DEVICE_COUNT && *numIds < maxIds; i++) {
+        if (ctx_.devices_[i].state_ != FREESPACE_NONE &&
+            ctx_.devices_[i].state_ != FREESPACE_DISCONNECTED) {
+            idList[*numIds] = ctx_.devices_[i].id_;
+            *numIds = *numIds + 1;
+        }
+    }
+    return FREESPACE_SUCCESS;
+}
+
+static int freespace_test_getDeviceInfo(FreespaceDeviceId id,
+                                        struct FreespaceDeviceInfo* info) {
+    GET_DEVICE(id, device);
+
+    *info = device->info_;
+    return FREESPACE_SUCCESS;
+}
+
+static int freespace_test_openDevice(FreespaceDeviceId id) {
+    int rc;
+    GET_DEVICE(id, device);
+
+    if (device->state_ == FREESPACE_DISCONNECTED) {
+        return FREESPACE_ERROR_NO_DEVICE;
+    }
+    if (device->state_ == FREESPACE_OPENED) {
+        return FREESPACE_SUCCESS;
+    }
+
+    FREESPACE_TRACE_BEGIN("open", id);
+    rc = _reserveBuffers(device);
+    if (rc == FREESPACE_SUCCESS) {
+        device->state_ = FREESPACE_OPENED;
+        device->queueHead_ = 0;
+        device->queueCount_ = 0;
+    }
+    FREESPACE_TRACE_END("open", id);
+    return rc;
+}
+
+// Opening takes no time, but the callback is still deferred to
+// freespace_perform().
+static int _deferOpen(FreespaceDeviceId id, freespace_openCallback callback, void* cookie) {
+    struct FreespacePendingOpen* open;
+
+    if (ctx_.numOpens_ == FREESPACE_MAXIMUM_DEVICE_COUNT) {
+        return FREESPACE_ERROR_BUSY;
+    }
+    open = &ctx_.opens_[ctx_.numOpens_++];
+    open->id_ = id;
+    open->result_ = freespace_test_openDevice(id);
+    open->callback_ = callback;
+    open->cookie_ = cookie;
+    return FREESPACE_SUCCESS;
+}
+
+static int freespace_test_openDeviceAsync(FreespaceDeviceId id,
+                                          freespace_openCallback callback,
+                                          void* cookie) {
+    GET_DEVICE(id, device);
+
+    if (device->state_ == FREESPACE_DISCONNECTED) {
+        return FREESPACE_ERROR_NO_DEVICE;
+    }
+    return _deferOpen(id, callback, cookie);
+}
+
+static int freespace_test_openAllDevicesAsync(freespace_openCallback callback, void* cookie) {
+    int i;
+    int rc;
+
+    for (i = 0; i < FREESPACE_MAXIMUM_DEVICE_COUNT; i++) {
+        if (ctx_.devices_[i].state_ != FREESPACE_CONNECTED) {
+            continue;
+        }
+        rc = _deferOpen(ctx_.devices_[i].id_, callback, cookie);
+        if (rc != FREESPACE_SUCCESS) {
+            return rc;
+        }
+    }
+    return FREESPACE_SUCCESS;
+}
+
+static void freespace_test_closeDevice(FreespaceDeviceId id) {
+    struct FreespaceDevice* device = _findDeviceById(id);
+    if (device == NULL) {
+        DEBUG("closeDevice() -- failed to get device %d", id);
+        return;
+    }
+
+    freespace_private_requestReset(id);
+    freespace_private_frsReset(id);
+    freespace_private_mailboxReset(id);
+    freespace_private_rateReset(id);
+    freespace_private_subscriptionReset(id);
+
+    if (device->state_ == FREESPACE_CONNECTED) {
+        TRACE("closeDevice() that is not opened");
+        return;
+    }
+
+    FREESPACE_TRACE_BEGIN("close", id);
+    if (device->state_ == FREESPACE_OPENED) {
+        device->state_ = FREESPACE_CONNECTED;
+    } else if (device->state_ == FREESPACE_DISCONNECTED) {
+        // Unplugged while open; it was kept for this close
+        device->state_ = FREESPACE_NONE;
+    }
+    device->queueCount_ = 0;
+    _releaseSpare(device);
+    FREESPACE_TRACE_END("close", id);
+}
+
+static int freespace_test_checkOpen(FreespaceDeviceId id) {
+    GET_DEVICE_IF_OPEN(id, device);
+    return FREESPACE_SUCCESS;
+}
+
+// Hand a sent report to the test's send callback
+static int _write(struct FreespaceDevice* device, const uint8_t* message, int length) {
+    int rc = FREESPACE_SUCCESS;
+
+    FREESPACE_PROBE2(write__submitted, device->id_, length);
+    FREESPACE_RECORD(device->id_, device->info_.hVer, FREESPACE_RECORD_OUTBOUND, message, length);
+    if (ctx_.sendCallback_ != NULL) {
+        rc = ctx_.sendCallback_(device->id_, message, length, ctx_.sendCookie_);
+    }
+    FREESPACE_PROBE2(write__completed, device->id_, rc);
+    return rc;
+}
+
+static int freespace_test_send(FreespaceDeviceId id, const uint8_t* message, int length) {
+    GET_DEVICE_IF_OPEN(id, device);
+
+    if (length > FREESPACE_MAX_OUTPUT_MESSAGE_SIZE) {
+        return FREESPACE_ERROR_SEND_TOO_LARGE;
+    }
+    return _write(device, message, length);
+}
+
+static int freespace_test_sendMessage(FreespaceDeviceId id, struct freespace_message* message) {
+    int rc;
+    uint8_t msgBuf[FREESPACE_MAX_OUTPUT_MESSAGE_SIZE];
+    GET_DEVICE_IF_OPEN(id, device);
+
+    // Address is reserved for now and must be set to 0 by the caller.
+    if (message->dest == 0) {
+        message->dest = FREESPACE_RESERVED_ADDRESS;
+    }
+    message->ver = device->info_.hVer;
+
+    rc = freespace_encode_message(message, msgBuf, FREESPACE_MAX_OUTPUT_MESSAGE_SIZE);
+    if (rc <= FREESPACE_SUCCESS) {
+        return rc;
+    }
+    return freespace_test_send(id, msgBuf, rc);
+}
+
+// Take the oldest report queued on the device
+static int _dequeue(struct FreespaceDevice* device, uint8_t* report) {
+    struct FreespaceTestReport* queued;
+
+    if (device->queueCount_ == 0) {
+        return 0;
+    }
+    queued = &device->queue_[device->queueHead_];
+    memcpy(report, queued->data_, queued->length_);
+    device->queueHead_ = (device->queueHead_ + 1) % FREESPACE_TEST_QUEUE_SIZE;
+    device->queueCount_--;
+    return queued->length_;
+}
+
+// Nothing arrives while this waits, so it only returns what is queued
+static int freespace_test_read(FreespaceDeviceId id,
+                               uint8_t* message,
+                               int maxLength,
+                               unsigned int timeoutMs,
+                               int* actualLength) {
+    GET_DEVICE_IF_OPEN(id, device);
+
+    if (device->queueCount_ == 0) {
+        return FREESPACE_ERROR_TIMEOUT;
+    }
+    if (device->queue_[device->queueHead_].length_ > maxLength) {
+        return FREESPACE_ERROR_RECEIVE_BUFFER_TOO_SMALL;
+    }
+    *actualLength = _dequeue(device, message);
+    FREESPACE_RECORD(id, device->info_.hVer, FREESPACE_RECORD_INBOUND, message, *actualLength);
+    return FREESPACE_SUCCESS;
+}
+
+static int freespace_test_readMessage(FreespaceDeviceId id,
+                                      struct freespace_message* message,
+                                      unsigned int timeoutMs) {
+    uint8_t buffer[FREESPACE_MAX_INPUT_MESSAGE_SIZE];
+    int length = 0;
+    int rc;
+    GET_DEVICE_IF_OPEN(id, device);
+
+    rc = freespace_test_read(id, buffer, sizeof(buffer), timeoutMs, &length);
+    if (rc != FREESPACE_SUCCESS) {
+        return rc;
+    }
+    return freespace_decode_message(buffer, length, message, device->info_.hVer);
+}
+
+static int freespace_test_flush(FreespaceDeviceId id) {
+    GET_DEVICE_IF_OPEN(id, device);
+
+    device->queueCount_ = 0;
+    return FREESPACE_SUCCESS;
+}
+
+static int freespace_test_sendAsync(FreespaceDeviceId id,
+                                    const uint8_t* message,
+                                    int length,
+                                    unsigned int timeoutMs,
+                                    freespace_sendCallback callback,
+                                    void* cookie) {
+    struct FreespacePendingSend* pending;
+    int rc;
+    GET_DEVICE_IF_OPEN(id, device);
+
+    if (length > FREESPACE_MAX_OUTPUT_MESSAGE_SIZE) {
+        return FREESPACE_ERROR_SEND_TOO_LARGE;
+    }
+    if (callback != NULL && ctx_.numSends_ == TEST_MAX_PENDING_SENDS) {
+        return FREESPACE_ERROR_BUSY;
+    }
+
+    FREESPACE_TRACE_INSTANT("sendEnqueue", id);
+    rc = _write(device, message, length);
+    if (callback != NULL) {
+        // The result goes to the callback from freespace_perform()
+        pending = &ctx_.sends_[ctx_.numSends_++];
+        pending->id_ = id;
+        pending->callback_ = callback;
+        pending->cookie_ = cookie;
+        pending->status_ = rc;
+        rc = FREESPACE_SUCCESS;
+    }
+    return rc;
+}
+
+static int freespace_test_sendMessageAsync(FreespaceDeviceId id,
+                                           struct freespace_message* message,
+                                           unsigned int timeoutMs,
+                                           freespace_sendCallback callback,
+                                           void* cookie) {
+    int rc;
+    uint8_t msgBuf[FREESPACE_MAX_OUTPUT_MESSAGE_SIZE];
+    GET_DEVICE_IF_OPEN(id, device);
+
+    // Address is reserved for now and must be set to 0 by the caller.
+    if (message->dest == 0) {
+        message->dest = FREESPACE_RESERVED_ADDRESS;
+    }
+    message->ver = device->info_.hVer;
+
+    rc = freespace_encode_message(message, msgBuf, FREESPACE_MAX_OUTPUT_MESSAGE_SIZE);
+    if (rc <= FREESPACE_SUCCESS) {
+        return rc;
+    }
+    return freespace_test_sendAsync(id, msgBuf, rc, timeoutMs, callback, cookie);
+}
+
+static int freespace_test_getNextTimeout(int* timeoutMsOut) {
+    int i;
+
+    *timeoutMsOut = -1;
+    if (ctx_.numOpens_ > 0 || ctx_.numSends_ > 0 || ctx_.numHotplugEvents_ > 0) {
+        *timeoutMsOut = 0;
+        return FREESPACE_SUCCESS;
+    }
+    for (i = 0; i < FREESPACE_MAXIMUM_DEVICE_COUNT; i++) {
+        if (ctx_.devices_[i].state_ == FREESPACE_OPENED && ctx_.devices_[i].queueCount_ > 0) {
+            *timeoutMsOut = 0;
+            break;
+        }
+    }
+    return FREESPACE_SUCCESS;
+}
+
+static void _deliverReport(struct FreespaceDevice* device, const uint8_t* report, int length) {
+    uint8_t hVer = (uint8_t) device->info_.hVer;
+    const uint8_t* data = report;
+    struct FreespaceBuffer* lent = NULL;
+    int64_t dispatchStart;
+    int wantBuffer;
+    int rc;
+
+    FREESPACE_TRACE_INSTANT("report", device->id_);
+    FREESPACE_PROBE3(report__received, device->id_, length, data[0]);
+    FREESPACE_RECORD(device->id_, hVer, FREESPACE_RECORD_INBOUND, data, length);
+    FREESPACE_PUBLISH(device->id_, hVer, data, length);
+    FREESPACE_RATE_RECEIVED(device->id_);
+
+    FREESPACE_RATE_DISPATCH_BEGIN(dispatchStart);
+    if (freespace_private_requestDeliver(device->id_, data, length, hVer) ||
+        freespace_private_frsDeliver(device->id_, data, length, hVer) ||
+        freespace_private_mailboxDeliver(device->id_, data, length, hVer) ||
+        freespace_private_subscriptionDeliver(device->id_, data, length, hVer)) {
+        // Conflated or handled by a subscriber
+        FREESPACE_RATE_DISPATCH_END(dispatchStart);
+        return;
+    }
+
+    // Copy into a pooled buffer if it is going to be lent out. Take it
+    // from the device so that closing it from a callback does not
+    // release it.
+    wantBuffer = (device->receiveBufferCallback_ != NULL);
+    if (wantBuffer) {
+        if (device->spare_ == NULL) {
+            device->spare_ = freespace_private_bufferAcquire();
+        }
+        if (device->spare_ != NULL) {
+            lent = device->spare_;
+            device->spare_ = NULL;
+            memcpy(lent->data_, report, length);
+            lent->length_ = length;
+            data = lent->data_;
+        }
+    }
+
+    if (device->receiveCallback_) {
+        FREESPACE_TRACE_BEGIN("callback", device->id_);
+        FREESPACE_PROBE1(callback__entry, device->id_);
+        device->receiveCallback_(device->id_, data, length, device->receiveCookie_, FREESPACE_SUCCESS);
+        FREESPACE_PROBE1(callback__return, device->id_);
+        FREESPACE_TRACE_END("callback", device->id_);
+    }
+
+    if (device->receiveMessageCallback_) {
+        struct freespace_message m;
+
+        FREESPACE_TRACE_BEGIN("decode", device->id_);
+        rc = freespace_decode_message(data, length, &m, hVer);
+        FREESPACE_TRACE_END("decode", device->id_);
+        FREESPACE_PROBE3(decode__done, device->id_, rc == FREESPACE_SUCCESS ? m.messageType : -1, rc);
+
+        FREESPACE_TRACE_BEGIN("callback", device->id_);
+        FREESPACE_PROBE1(callback__entry, device->id_);
+        device->receiveMessageCallback_(
+                device->id_,
+                rc == FREESPACE_SUCCESS ? &m : NULL,
+                device->receiveMessageCookie_, rc);
+        FREESPACE_PROBE1(callback__return, device->id_);
+        FREESPACE_TRACE_END("callback", device->id_);
+    }
+
+    if (wantBuffer && device->receiveBufferCallback_) {
+        FREESPACE_TRACE_BEGIN("callback", device->id_);
+        FREESPACE_PROBE1(callback__entry, device->id_);
+        if (lent != NULL) {
+            device->receiveBufferCallback_(device->id_, lent, device->receiveBufferCookie_, FREESPACE_SUCCESS);
+        } else {
+            device->receiveBufferCallback_(device->id_, NULL, device->receiveBufferCookie_, FREESPACE_ERROR_OUT_OF_MEMORY);
+        }
+        FREESPACE_PROBE1(callback__return, device->id_);
+        FREESPACE_TRACE_END("callback", device->id_);
+    }
+    if (lent != NULL) {
+        freespace_bufferRelease(lent);
+    }
+    FREESPACE_RATE_DISPATCH_END(dispatchStart);
+}
+
+static int freespace_test_performBudget(int maxReports, int maxMicros, int* workRemaining) {
+    uint8_t report[FREESPACE_MAX_INPUT_MESSAGE_SIZE];
+    int64_t deadline = maxMicros > 0 ? _nowMicros() + maxMicros : 0;
+    int reports = 0;
+    int busy;
+    int i;
+
+    if (workRemaining) {
+        *workRemaining = 0;
+    }
+
+    // Hotplug events, opens and sends completed since the last call. Each
+    // is taken off its list before its callback, which may add more.
+    while (ctx_.numHotplugEvents_ > 0) {
+        struct FreespaceHotplugEvent event = ctx_.hotplugEvents_[0];
+        ctx_.numHotplugEvents_--;
+        memmove(&ctx_.hotplugEvents_[0], &ctx_.hotplugEvents_[1], ctx_.numHotplugEvents_ * sizeof(event));
+        if (event.event_ == FREESPACE_HOTPLUG_INSERTION) {
+            FREESPACE_PROBE1(hotplug__insert, event.id_);
+        } else {
+            FREESPACE_PROBE1(hotplug__remove, event.id_);
+        }
+        if (ctx_.hotplugCallback) {
+            ctx_.hotplugCallback(event.event_, event.id_, ctx_.hotplugCookie);
+        }
+    }
+    while (ctx_.numOpens_ > 0) {
+        struct FreespacePendingOpen open = ctx_.opens_[0];
+        ctx_.numOpens_--;
+        memmove(&ctx_.opens_[0], &ctx_.opens_[1], ctx_.numOpens_ * sizeof(open));
+        if (open.callback_) {
+            open.callback_(open.id_, open.cookie_, open.result_);
+        }
+    }
+    while (ctx_.numSends_ > 0) {
+        struct FreespacePendingSend pending = ctx_.sends_[0];
+        ctx_.numSends_--;
+        memmove(&ctx_.sends_[0], &ctx_.sends_[1], ctx_.numSends_ * sizeof(pending));
+        FREESPACE_TRACE_INSTANT("sendComplete", pending.id_);
+        pending.callback_(pending.id_, pending.cookie_, pending.status_);
+    }
+
+    // Serve the devices round robin, a quantum at a time, until they are
+    // drained or the budget runs out. Reports injected by the callbacks
+    // are served too.
+    FREESPACE_HOT_PATH_BEGIN();
+    do {
+        busy = 0;
+        for (i = 0; i < FREESPACE_MAXIMUM_DEVICE_COUNT; i++) {
+            int idx = (ctx_.performCursor_ + i) % FREESPACE_MAXIMUM_DEVICE_COUNT;
+            struct FreespaceDevice* device = &ctx_.devices_[idx];
+            int quantum = FREESPACE_PERFORM_QUANTUM;
+
+            while (quantum > 0 && device->state_ == FREESPACE_OPENED && device->queueCount_ > 0) {
+                int length;
+
+                if ((maxReports > 0 && reports >= maxReports) ||
+                    (deadline != 0 && reports > 0 && _nowMicros() >= deadline)) {
+                    int j;
+                    if (workRemaining) {
+                        *workRemaining = 1;
+                    }
+                    for (j = 0; j < FREESPACE_MAXIMUM_DEVICE_COUNT; j++) {
+                        if (ctx_.devices_[j].state_ == FREESPACE_OPENED && ctx_.devices_[j].queueCount_ > 0) {
+                            FREESPACE_RATE_BACKLOGGED(ctx_.devices_[j].id_);
+                        }
+                    }
+                    // The next call starts with the device that was cut short
+                    ctx_.performCursor_ = idx;
+                    FREESPACE_HOT_PATH_END();
+                    return FREESPACE_SUCCESS;
+                }
+
+                // Copied out, since a callback may close the device
+                length = _dequeue(device, report);
+                reports++;
+                quantum--;
+                busy = 1;
+                _deliverReport(device, report, length);
+            }
+        }
+        ctx_.performCursor_ = (ctx_.performCursor_ + 1) % FREESPACE_MAXIMUM_DEVICE_COUNT;
+    } while (busy);
+    FREESPACE_HOT_PATH_END();
+
+    return FREESPACE_SUCCESS;
+}
+
+static void freespace_test_setFileDescriptorCallbacks(freespace_pollfdAddedCallback addedCallback,
+                                                      freespace_pollfdRemovedCallback removedCallback) {
+    // There are no file descriptors; freespace_getNextTimeout() says when
+    // to call freespace_perform()
+}
+
+static int freespace_test_syncFileDescriptors() {
+    return FREESPACE_SUCCESS;
+}
+
+static int freespace_test_setReceiveCallback(FreespaceDeviceId id,
+                                             freespace_receiveCallback callback,
+                                             void* cookie) {
+    GET_DEVICE(id, device);
+
+    device->receiveCallback_ = callback;
+    device->receiveCookie_ = cookie;
+    return FREESPACE_SUCCESS;
+}
+
+static int freespace_test_setReceiveMessageCallback(FreespaceDeviceId id,
+                                                    freespace_receiveMessageCallback callback,
+                                                    void* cookie) {
+    GET_DEVICE(id, device);
+
+    device->receiveMessageCallback_ = callback;
+    device->receiveMessageCookie_ = cookie;
+    return FREESPACE_SUCCESS;
+}
+
+static int freespace_test_setReceiveBufferCallback(FreespaceDeviceId id,
+                                                   freespace_receiveBufferCallback callback,
+                                                   void* cookie) {
+    GET_DEVICE(id, device);
+
+    device->receiveBufferCallback_ = callback;
+    device->receiveBufferCookie_ = cookie;
+
+    // Get the first buffer now rather than while receiving
+    if (callback != NULL && device->spare_ == NULL) {
+        device->spare_ = freespace_private_bufferAcquire();
+    }
+    return FREESPACE_SUCCESS;
+}
+
+const struct FreespaceBackend freespace_testBackend = {
+    .name_ = "test",
+    .queueReports_ = FREESPACE_TEST_QUEUE_SIZE,
+    .probe_ = freespace_test_probe,
+    .init_ = freespace_test_init,
+    .exit_ = freespace_test_exit,
+    .setDeviceHotplugCallback_ = freespace_test_setDeviceHotplugCallback,
+    .getDeviceList_ = freespace_test_getDeviceList,
+    .getDeviceInfo_ = freespace_test_getDeviceInfo,
+    .openDevice_ = freespace_test_openDevice,
+    .openDeviceAsync_ = freespace_test_openDeviceAsync,
+    .openAllDevicesAsync_ = freespace_test_openAllDevicesAsync,
+    .closeDevice_ = freespace_test_closeDevice,
+    .checkOpen_ = freespace_test_checkOpen,
+    .send_ = freespace_test_send,
+    .sendMessage_ = freespace_test_sendMessage,
+    .read_ = freespace_test_read,
+    .readMessage_ = freespace_test_readMessage,
+    .flush_ = freespace_test_flush,
+    .sendAsync_ = freespace_test_sendAsync,
+    .sendMessageAsync_ = freespace_test_sendMessageAsync,
+    .getNextTimeout_ = freespace_test_getNextTimeout,
+    .performBudget_ = freespace_test_performBudget,
+    .setFileDescriptorCallbacks_ = freespace_test_setFileDescriptorCallbacks,
+    .syncFileDescriptors_ = freespace_test_syncFileDescriptors,
+    .setReceiveCallback_ = freespace_test_setReceiveCallback,
+    .setReceiveMessageCallback_ = freespace_test_setReceiveMessageCallback,
+    .setReceiveBufferCallback_ = freespace_test_setReceiveBufferCallback,
+};
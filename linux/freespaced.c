@@ -0,0 +1,642 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/*
+ * freespaced owns every Freespace device on the host and shares them
+ * with any number of applications over a Unix domain socket, so that
+ * they no longer fight over claiming the devices. Applications link
+ * against the broker build of libfreespace, which speaks the protocol
+ * in broker_protocol.h behind the usual freespace.h API.
+ *
+ * Each report is read once and its message type looked up once; it is
+ * then sent to the clients that have the device open and want the type.
+ * Reports are never queued for a slow client: if its socket is full the
+ * report is dropped for that client only.
+ */
+
+#include "freespace/freespace.h"
+#include "broker_protocol.h"
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <errno.h>
+#include <string.h>
+#include <signal.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#define FREESPACED_MAX_CLIENTS 32
+
+// Descriptors libfreespace asks to be polled
+#define FREESPACED_MAX_LIBRARY_FDS (FREESPACE_MAXIMUM_DEVICE_COUNT + 4)
+
+struct BrokerDevice {
+    FreespaceDeviceId id_; // -1 when unused
+    uint8_t hVer_;
+};
+
+// What a client wants from one open device
+struct BrokerSubscription {
+    FreespaceDeviceId id_; // -1 when unused
+    int all_;
+    uint32_t mask_[FREESPACE_BROKER_MASK_WORDS];
+};
+
+struct BrokerClient {
+    int fd_; // -1 when unused
+    unsigned int dropped_;
+    struct BrokerSubscription subscriptions_[FREESPACE_MAXIMUM_DEVICE_COUNT];
+};
+
+static struct BrokerDevice devices_[FREESPACE_MAXIMUM_DEVICE_COUNT];
+static struct BrokerClient clients_[FREESPACED_MAX_CLIENTS];
+static struct pollfd libraryFds_[FREESPACED_MAX_LIBRARY_FDS];
+static int numLibraryFds_;
+static int listenFd_ = -1;
+static volatile sig_atomic_t quit_;
+
+static void _log(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    fprintf(stderr, "freespaced: ");
+    vfprintf(stderr, format, args);
+    fprintf(stderr, "\n");
+    va_end(args);
+}
+
+static void _onSignal(int sig) {
+    quit_ = 1;
+}
+
+static void _fdAdded(FreespaceFileHandleType fd, short events) {
+    int i;
+    for (i = 0; i < numLibraryFds_; i++) {
+        if (libraryFds_[i].fd == fd) {
+            libraryFds_[i].events = events;
+            return;
+        }
+    }
+    if (numLibraryFds_ == FREESPACED_MAX_LIBRARY_FDS) {
+        _log("too many descriptors to poll");
+        return;
+    }
+    libraryFds_[numLibraryFds_].fd = fd;
+    libraryFds_[numLibraryFds_].events = events;
+    numLibraryFds_++;
+}
+
+static void _fdRemoved(FreespaceFileHandleType fd) {
+    int i;
+    for (i = 0; i < numLibraryFds_; i++) {
+        if (libraryFds_[i].fd == fd) {
+            libraryFds_[i] = libraryFds_[--numLibraryFds_];
+            return;
+        }
+    }
+}
+
+static struct BrokerDevice* _findDevice(FreespaceDeviceId id) {
+    int i;
+    for (i = 0; i < FREESPACE_MAXIMUM_DEVICE_COUNT; i++) {
+        if (devices_[i].id_ == id && id >= 0) {
+            return &devices_[i];
+        }
+    }
+    return NULL;
+}
+
+static struct BrokerSubscription* _findSubscription(struct BrokerClient* client, FreespaceDeviceId id) {
+    int i;
+    for (i = 0; i < FREESPACE_MAXIMUM_DEVICE_COUNT; i++) {
+        if (client->subscriptions_[i].id_ == id && id >= 0) {
+            return &client->subscriptions_[i];
+        }
+    }
+    return NULL;
+}
+
+static void _closeClient(struct BrokerClient* client) {
+    if (client->dropped_ > 0) {
+        _log("client %d missed %u reports", client->fd_, client->dropped_);
+    }
+    close(client->fd_);
+    client->fd_ = -1;
+}
+
+// Reports and hotplug events are sent without blocking
+static int _sendFrame(struct BrokerClient* client, const uint8_t* frame, int length) {
+    ssize_t rc = send(client->fd_, frame, length, MSG_DONTWAIT | MSG_NOSIGNAL);
+    if (rc < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            client->dropped_++;
+            return FREESPACE_ERROR_BUSY;
+        }
+        _closeClient(client);
+        return FREESPACE_ERROR_IO;
+    }
+    return FREESPACE_SUCCESS;
+}
+
+static void _reply(struct BrokerClient* client, const struct FreespaceBrokerFrame* request,
+                   int status, const void* payload, int length) {
+    uint8_t frame[FREESPACE_BROKER_MAX_FRAME];
+    struct FreespaceBrokerFrame* header = (struct FreespaceBrokerFrame*) frame;
+
+    // Token 0 asks for no reply
+    if (request->token_ == 0) {
+        return;
+    }
+
+    memset(header, 0, sizeof(*header));
+    header->type_ = FREESPACE_BROKER_REPLY;
+    header->status_ = (int16_t) status;
+    header->id_ = request->id_;
+    header->token_ = request->token_;
+    if (length > 0) {
+        memcpy(frame + sizeof(*header), payload, length);
+    }
+
+    // Never block the daemon on one client. A dropped reply would leave
+    // the client waiting on it, so a client too far behind to take one is
+    // disconnected instead.
+    if (send(client->fd_, frame, sizeof(*header) + length, MSG_DONTWAIT | MSG_NOSIGNAL) < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            _log("client %d is not reading replies", client->fd_);
+        }
+        _closeClient(client);
+    }
+}
+
+static void _receiveCallback(FreespaceDeviceId id,
+                             const uint8_t* message,
+                             int length,
+                             void* cookie,
+                             int result) {
+    struct BrokerDevice* device = (struct BrokerDevice*) cookie;
+    uint8_t frame[FREESPACE_BROKER_MAX_FRAME];
+    struct FreespaceBrokerFrame* header = (struct FreespaceBrokerFrame*) frame;
+    int type;
+    int i;
+
+    if (result != FREESPACE_SUCCESS || length <= 0 || length > FREESPACE_MAX_INPUT_MESSAGE_SIZE) {
+        return;
+    }
+
+    memset(header, 0, sizeof(*header));
+    header->type_ = FREESPACE_BROKER_REPORT;
+    header->arg_ = device->hVer_;
+    header->id_ = id;
+    memcpy(frame + sizeof(*header), message, length);
+
+    type = freespace_peek_message_type(message, length, device->hVer_);
+    for (i = 0; i < FREESPACED_MAX_CLIENTS; i++) {
+        struct BrokerSubscription* subscription;
+
+        if (clients_[i].fd_ < 0) {
+            continue;
+        }
+        subscription = _findSubscription(&clients_[i], id);
+        if (subscription == NULL) {
+            continue;
+        }
+        if (subscription->all_ ||
+            (type >= 0 && (subscription->mask_[type / 32] & (1u << (type % 32))) != 0)) {
+            _sendFrame(&clients_[i], frame, sizeof(*header) + length);
+        }
+    }
+}
+
+static void _getInfo(FreespaceDeviceId id, struct FreespaceBrokerInfo* brokerInfo) {
+    struct FreespaceDeviceInfo info;
+
+    memset(brokerInfo, 0, sizeof(*brokerInfo));
+    if (freespace_getDeviceInfo(id, &info) == FREESPACE_SUCCESS) {
+        brokerInfo->vendor_ = info.vendor;
+        brokerInfo->product_ = info.product;
+        brokerInfo->hVer_ = info.hVer;
+        if (info.name != NULL) {
+            strncpy(brokerInfo->name_, info.name, sizeof(brokerInfo->name_) - 1);
+        }
+    }
+}
+
+static void _broadcastHotplug(enum freespace_hotplugEvent event, FreespaceDeviceId id) {
+    uint8_t frame[sizeof(struct FreespaceBrokerFrame) + sizeof(struct FreespaceBrokerInfo)];
+    struct FreespaceBrokerFrame* header = (struct FreespaceBrokerFrame*) frame;
+    int length = sizeof(*header);
+    int i;
+
+    memset(header, 0, sizeof(*header));
+    header->type_ = FREESPACE_BROKER_HOTPLUG;
+    header->arg_ = (uint8_t) event;
+    header->id_ = id;
+    if (event == FREESPACE_HOTPLUG_INSERTION) {
+        _getInfo(id, (struct FreespaceBrokerInfo*) (frame + sizeof(*header)));
+        length += sizeof(struct FreespaceBrokerInfo);
+    }
+
+    for (i = 0; i < FREESPACED_MAX_CLIENTS; i++) {
+        if (clients_[i].fd_ >= 0) {
+            _sendFrame(&clients_[i], frame, length);
+        }
+    }
+}
+
+// Open a device for good. Returns 1 if it is new to the clients.
+static int _addDevice(FreespaceDeviceId id) {
+    struct FreespaceDeviceInfo info;
+    int i;
+    int rc;
+
+    if (_findDevice(id) != NULL) {
+        return 0;
+    }
+    for (i = 0; i < FREESPACE_MAXIMUM_DEVICE_COUNT; i++) {
+        if (devices_[i].id_ < 0) {
+            break;
+        }
+    }
+    if (i == FREESPACE_MAXIMUM_DEVICE_COUNT) {
+        _log("no room for device %d", id);
+        return 0;
+    }
+
+    rc = freespace_getDeviceInfo(id, &info);
+    if (rc == FREESPACE_SUCCESS) {
+        rc = freespace_openDevice(id);
+    }
+    if (rc != FREESPACE_SUCCESS) {
+        _log("could not open device %d: %d", id, rc);
+        return 0;
+    }
+
+    devices_[i].id_ = id;
+    devices_[i].hVer_ = (uint8_t) info.hVer;
+    freespace_private_setReceiveCallback(id, _receiveCallback, &devices_[i]);
+    _log("opened device %d (%s)", id, info.name != NULL ? info.name : "");
+    return 1;
+}
+
+static void _removeDevice(FreespaceDeviceId id) {
+    struct BrokerDevice* device = _findDevice(id);
+    int i;
+
+    for (i = 0; i < FREESPACED_MAX_CLIENTS; i++) {
+        struct BrokerSubscription* subscription = _findSubscription(&clients_[i], id);
+        if (subscription != NULL) {
+            subscription->id_ = -1;
+        }
+    }
+    if (device != NULL) {
+        device->id_ = -1;
+        freespace_closeDevice(id);
+        _log("closed device %d", id);
+    }
+}
+
+static void _hotplugCallback(enum freespace_hotplugEvent event, FreespaceDeviceId id, void* cookie) {
+    if (event == FREESPACE_HOTPLUG_INSERTION) {
+        if (_addDevice(id)) {
+            _broadcastHotplug(event, id);
+        }
+    } else {
+        // The clients hear about it while the id is still valid
+        _broadcastHotplug(event, id);
+        _removeDevice(id);
+    }
+}
+
+static void _handleRequest(struct BrokerClient* client, const uint8_t* frame, int length) {
+    const struct FreespaceBrokerFrame* request = (const struct FreespaceBrokerFrame*) frame;
+    const uint8_t* payload = frame + sizeof(*request);
+    int payloadLength = length - (int) sizeof(*request);
+    struct BrokerSubscription* subscription;
+    int i;
+    int rc;
+
+    if (payloadLength < 0) {
+        _closeClient(client);
+        return;
+    }
+
+    switch (request->type_) {
+        case FREESPACE_BROKER_HELLO: {
+            struct FreespaceBrokerHello hello;
+            hello.version_ = FREESPACE_BROKER_PROTOCOL_VERSION;
+            hello.messageTypeCount_ = FREESPACE_MESSAGE_TYPE_COUNT;
+            _reply(client, request, FREESPACE_SUCCESS, &hello, sizeof(hello));
+            break;
+        }
+
+        case FREESPACE_BROKER_LIST: {
+            int32_t ids[FREESPACE_MAXIMUM_DEVICE_COUNT];
+            int n = 0;
+            for (i = 0; i < FREESPACE_MAXIMUM_DEVICE_COUNT; i++) {
+                if (devices_[i].id_ >= 0) {
+                    ids[n++] = devices_[i].id_;
+                }
+            }
+            _reply(client, request, FREESPACE_SUCCESS, ids, n * sizeof(int32_t));
+            break;
+        }
+
+        case FREESPACE_BROKER_INFO: {
+            struct FreespaceBrokerInfo info;
+            if (_findDevice(request->id_) == NULL) {
+                _reply(client, request, FREESPACE_ERROR_INVALID_DEVICE, NULL, 0);
+                break;
+            }
+            _getInfo(request->id_, &info);
+            _reply(client, request, FREESPACE_SUCCESS, &info, sizeof(info));
+            break;
+        }
+
+        case FREESPACE_BROKER_OPEN:
+            if (_findDevice(request->id_) == NULL) {
+                _reply(client, request, FREESPACE_ERROR_INVALID_DEVICE, NULL, 0);
+                break;
+            }
+            subscription = _findSubscription(client, request->id_);
+            for (i = 0; subscription == NULL && i < FREESPACE_MAXIMUM_DEVICE_COUNT; i++) {
+                if (client->subscriptions_[i].id_ < 0) {
+                    subscription = &client->subscriptions_[i];
+                }
+            }
+            if (subscription == NULL) {
+                _reply(client, request, FREESPACE_ERROR_BUSY, NULL, 0);
+                break;
+            }
+            memset(subscription, 0, sizeof(*subscription));
+            subscription->id_ = request->id_;
+            subscription->all_ = 1;
+            _reply(client, request, FREESPACE_SUCCESS, NULL, 0);
+            break;
+
+        case FREESPACE_BROKER_CLOSE:
+            subscription = _findSubscription(client, request->id_);
+            if (subscription != NULL) {
+                subscription->id_ = -1;
+            }
+            _reply(client, request, FREESPACE_SUCCESS, NULL, 0);
+            break;
+
+        case FREESPACE_BROKER_SUBSCRIBE:
+            subscription = _findSubscription(client, request->id_);
+            if (subscription == NULL) {
+                _reply(client, request, FREESPACE_ERROR_NO_DEVICE, NULL, 0);
+                break;
+            }
+            if (payloadLength != sizeof(subscription->mask_)) {
+                _reply(client, request, FREESPACE_ERROR_MALFORMED_MESSAGE, NULL, 0);
+                break;
+            }
+            subscription->all_ = request->arg_ != 0;
+            memcpy(subscription->mask_, payload, sizeof(subscription->mask_));
+            _reply(client, request, FREESPACE_SUCCESS, NULL, 0);
+            break;
+
+        case FREESPACE_BROKER_SEND:
+            if (_findDevice(request->id_) == NULL) {
+                _reply(client, request, FREESPACE_ERROR_NO_DEVICE, NULL, 0);
+                break;
+            }
+            if (payloadLength > FREESPACE_MAX_OUTPUT_MESSAGE_SIZE) {
+                _reply(client, request, FREESPACE_ERROR_SEND_TOO_LARGE, NULL, 0);
+                break;
+            }
+            // Not every backend reports completion through the callback,
+            // so the client is told whether the report was accepted.
+            rc = freespace_private_sendAsync(request->id_, payload, payloadLength, 1000, NULL, NULL);
+            _reply(client, request, rc, NULL, 0);
+            break;
+
+        default:
+            _reply(client, request, FREESPACE_ERROR_UINIMPLEMENTED, NULL, 0);
+            break;
+    }
+}
+
+static void _acceptClient() {
+    int fd = accept(listenFd_, NULL, NULL);
+    int i;
+    int j;
+
+    if (fd < 0) {
+        return;
+    }
+    for (i = 0; i < FREESPACED_MAX_CLIENTS; i++) {
+        if (clients_[i].fd_ < 0) {
+            memset(&clients_[i], 0, sizeof(clients_[i]));
+            clients_[i].fd_ = fd;
+            for (j = 0; j < FREESPACE_MAXIMUM_DEVICE_COUNT; j++) {
+                clients_[i].subscriptions_[j].id_ = -1;
+            }
+            return;
+        }
+    }
+    _log("too many clients");
+    close(fd);
+}
+
+static void _readClient(struct BrokerClient* client) {
+    uint8_t frame[FREESPACE_BROKER_MAX_FRAME];
+    ssize_t rc;
+
+    while (client->fd_ >= 0) {
+        rc = recv(client->fd_, frame, sizeof(frame), MSG_DONTWAIT);
+        if (rc < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+            return;
+        }
+        if (rc <= 0) {
+            _closeClient(client);
+            return;
+        }
+        _handleRequest(client, frame, (int) rc);
+    }
+}
+
+static int _listen(const char* path, int mode) {
+    struct sockaddr_un addr;
+
+    if (strlen(path) >= sizeof(addr.sun_path)) {
+        _log("socket path too long: %s", path);
+        return -1;
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path);
+
+    listenFd_ = socket(AF_UNIX, SOCK_SEQPACKET, 0);
+    if (listenFd_ < 0) {
+        _log("socket: %s", strerror(errno));
+        return -1;
+    }
+
+    // A previous instance may have left its socket behind
+    unlink(path);
+    if (bind(listenFd_, (struct sockaddr*) &addr, sizeof(addr)) < 0 ||
+        chmod(path, mode) < 0 ||
+        listen(listenFd_, 8) < 0) {
+        _log("cannot listen on %s: %s", path, strerror(errno));
+        close(listenFd_);
+        listenFd_ = -1;
+        return -1;
+    }
+    return 0;
+}
+
+static void _usage(const char* program) {
+    fprintf(stderr,
+            "usage: %s [-s socket] [-m mode] [-b backends]\n"
+            "  -s socket    path to listen on (default %s)\n"
+            "  -m mode      octal permissions of the socket (default 0660)\n"
+            "  -b backends  backends to try in order (default hidraw,libusb)\n",
+            program, FREESPACE_BROKER_DEFAULT_SOCKET);
+}
+
+int main(int argc, char* argv[]) {
+    const char* path = FREESPACE_BROKER_DEFAULT_SOCKET;
+    int mode = 0660;
+    struct FreespaceInitOptions options;
+    struct pollfd fds[1 + FREESPACED_MAX_CLIENTS + FREESPACED_MAX_LIBRARY_FDS];
+    FreespaceDeviceId ids[FREESPACE_MAXIMUM_DEVICE_COUNT];
+    struct sigaction action;
+    int numIds;
+    int opt;
+    int i;
+    int rc;
+
+    // Never the broker backend, which would connect back to us
+    memset(&options, 0, sizeof(options));
+    options.backend = "hidraw,libusb";
+
+    while ((opt = getopt(argc, argv, "s:m:b:h")) != -1) {
+        switch (opt) {
+            case 'b':
+                options.backend = optarg;
+                break;
+            case 's':
+                path = optarg;
+                break;
+            case 'm':
+                mode = (int) strtol(optarg, NULL, 8);
+                break;
+            default:
+                _usage(argv[0]);
+                return opt == 'h' ? 0 : 1;
+        }
+    }
+
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = _onSignal;
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+
+    for (i = 0; i < FREESPACE_MAXIMUM_DEVICE_COUNT; i++) {
+        devices_[i].id_ = -1;
+    }
+    for (i = 0; i < FREESPACED_MAX_CLIENTS; i++) {
+        clients_[i].fd_ = -1;
+    }
+
+    rc = freespace_initWithOptions(&options);
+    if (rc != FREESPACE_SUCCESS) {
+        _log("freespace_init failed: %d", rc);
+        return 1;
+    }
+    _log("using the %s backend", freespace_backendName());
+    freespace_setFileDescriptorCallbacks(_fdAdded, _fdRemoved);
+    freespace_setDeviceHotplugCallback(_hotplugCallback, NULL);
+    freespace_syncFileDescriptors();
+
+    if (_listen(path, mode) < 0) {
+        freespace_exit();
+        return 1;
+    }
+
+    // Devices already present. Some backends only find them on the
+    // first perform, and those arrive through the hotplug callback.
+    if (freespace_getDeviceList(ids, FREESPACE_MAXIMUM_DEVICE_COUNT, &numIds) == FREESPACE_SUCCESS) {
+        for (i = 0; i < numIds; i++) {
+            _addDevice(ids[i]);
+        }
+    }
+    freespace_perform();
+
+    _log("listening on %s", path);
+    while (!quit_) {
+        int n = 0;
+        int timeoutMs;
+
+        fds[n].fd = listenFd_;
+        fds[n].events = POLLIN;
+        n++;
+        for (i = 0; i < FREESPACED_MAX_CLIENTS; i++) {
+            if (clients_[i].fd_ >= 0) {
+                fds[n].fd = clients_[i].fd_;
+                fds[n].events = POLLIN;
+                n++;
+            }
+        }
+        for (i = 0; i < numLibraryFds_; i++) {
+            fds[n++] = libraryFds_[i];
+        }
+
+        freespace_getNextTimeout(&timeoutMs);
+        rc = poll(fds, n, timeoutMs);
+        if (rc < 0 && errno != EINTR) {
+            _log("poll: %s", strerror(errno));
+            break;
+        }
+
+        rc = freespace_perform();
+        if (rc != FREESPACE_SUCCESS && rc != FREESPACE_ERROR_NO_DEVICE) {
+            _log("freespace_perform: %d", rc);
+        }
+
+        if (fds[0].revents & POLLIN) {
+            _acceptClient();
+        }
+        for (i = 0; i < FREESPACED_MAX_CLIENTS; i++) {
+            if (clients_[i].fd_ >= 0) {
+                _readClient(&clients_[i]);
+            }
+        }
+    }
+
+    _log("exiting");
+    for (i = 0; i < FREESPACED_MAX_CLIENTS; i++) {
+        if (clients_[i].fd_ >= 0) {
+            _closeClient(&clients_[i]);
+        }
+    }
+    close(listenFd_);
+    unlink(path);
+    for (i = 0; i < FREESPACE_MAXIMUM_DEVICE_COUNT; i++) {
+        if (devices_[i].id_ >= 0) {
+            freespace_closeDevice(devices_[i].id_);
+        }
+    }
+    freespace_exit();
+    return 0;
+}
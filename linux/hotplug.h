@@ -18,6 +18,31 @@
 #ifndef _HOTPLUG_H_
 #define _HOTPLUG_H_
 
+#include <stdint.h>
+
+/**
+ * What happened to a device reported by freespace_hotplug_nextEvent().
+ */
+enum FreespaceHotplugAction {
+    FREESPACE_HOTPLUG_ADD,
+    FREESPACE_HOTPLUG_REMOVE
+};
+
+/**
+ * A single USB device insertion or removal. Only events for devices
+ * listed in freespace_deviceAPITable are reported.
+ */
+struct FreespaceHotplugEvent {
+    enum FreespaceHotplugAction action_;
+    int busNumber_;
+    int deviceAddress_;
+    uint16_t idVendor_;
+    uint16_t idProduct_;
+
+    // Number of times the event has been handed back with
+    // freespace_hotplug_retry().
+    int retries_;
+};
 
 /**
  * Initialize the hotplug file descriptor
@@ -48,10 +73,31 @@ int freespace_hotplug_getFD();
 
 /**
  * Handle hotplug event
- * @param recheck set to one when to rescan for new devices.
+ * @param recheck set to one when all devices need to be rescanned. This
+ * happens the first time through and whenever individual events could
+ * not be tracked. Otherwise the changes are available from
+ * freespace_hotplug_nextEvent().
  * Returns FREESPACE_SUCCESS if some kind of hotplug event occurred
  * Returns an error code otherwise
  */
 int freespace_hotplug_perform(int* recheck);
 
+/**
+ * Get the next device insertion or removal that is ready to be applied.
+ * Insertions are held back until the bus has settled.
+ *
+ * @param event where to store the event
+ * @return 1 if an event was returned, 0 if none are ready
+ */
+int freespace_hotplug_nextEvent(struct FreespaceHotplugEvent* event);
+
+/**
+ * Hand an event back to be delivered again after the settling time,
+ * for example because the device is not enumerated yet. Events that
+ * have been retried too often cause a full rescan instead.
+ *
+ * @param event the event returned by freespace_hotplug_nextEvent()
+ */
+void freespace_hotplug_retry(const struct FreespaceHotplugEvent* event);
+
 #endif // _HOTPLUG_H_
@@ -17,19 +17,44 @@
 
 #include "hotplug.h"
 #include "freespace/freespace.h"
+#include "freespace/freespace_deviceTable.h"
 
 #include <sys/socket.h>
+#include <sys/timerfd.h>
 #include <linux/netlink.h>
 #include <errno.h>
 #include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <unistd.h>
 #include <string.h>
 
 #define FREESPACE_HOTPLUG_SETTLING_TIME 100 /*ms*/
 
+// Largest uevent the kernel sends (UEVENT_BUFFER_SIZE)
+#define FREESPACE_HOTPLUG_UEVENT_SIZE 2048
+
+// Events waiting to be applied. If more than this arrive before the
+// backend picks them up, fall back to a full rescan.
+#define FREESPACE_HOTPLUG_QUEUE_SIZE 32
+
+// How many times an insertion is retried before giving up on it and
+// rescanning everything.
+#define FREESPACE_HOTPLUG_MAX_RETRIES 3
+
 // The socket for listening for hotplug events
 static int sock_ = -1;
-static int delay_ = FREESPACE_HOTPLUG_SETTLING_TIME;
+
+// Settling timer. Armed whenever an insertion is seen.
+static int timerFd_ = -1;
+static int settling_ = 0;
+
+// Set when everything needs to be rescanned
+static int rescan_ = 1;
+
+static struct FreespaceHotplugEvent queue_[FREESPACE_HOTPLUG_QUEUE_SIZE];
+static int queueHead_ = 0;
+static int queueLength_ = 0;
 
 int freespace_hotplug_init() {
     struct sockaddr_nl snl;
@@ -80,17 +105,27 @@ int freespace_hotplug_init() {
         return FREESPACE_ERROR_UNEXPECTED;
     }
 
+    timerFd_ = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK);
+    if (timerFd_ < 0) {
+        close(sock);
+        return FREESPACE_ERROR_UNEXPECTED;
+    }
+
     sock_ = sock;
 
-    // See below for details on the state machine. Setting
-    // delay here will signal a rescan the first time through.
-    delay_ = FREESPACE_HOTPLUG_SETTLING_TIME;
+    // Signal a full scan the first time through.
+    rescan_ = 1;
+    settling_ = 0;
+    queueHead_ = 0;
+    queueLength_ = 0;
     return FREESPACE_SUCCESS;
 }
 
 void freespace_hotplug_exit() {
     close(sock_);
     sock_ = -1;
+    close(timerFd_);
+    timerFd_ = -1;
 }
 
 int freespace_hotplug_getFD() {
@@ -98,56 +133,221 @@ int freespace_hotplug_getFD() {
 }
 
 int freespace_hotplug_timeout() {
-    return delay_;
+    struct itimerspec remaining;
+
+    if (!settling_) {
+        // A pending rescan should happen right away
+        return rescan_ ? 0 : -1;
+    }
+
+    if (timerfd_gettime(timerFd_, &remaining) < 0) {
+        return -1;
+    }
+
+    // Round up so that the caller doesn't wake up just before expiry.
+    return (int) (remaining.it_value.tv_sec * 1000 +
+                  (remaining.it_value.tv_nsec + 999999) / 1000000);
+}
+
+static void startSettling() {
+    struct itimerspec spec;
+
+    memset(&spec, 0, sizeof(spec));
+    spec.it_value.tv_sec = FREESPACE_HOTPLUG_SETTLING_TIME / 1000;
+    spec.it_value.tv_nsec = (FREESPACE_HOTPLUG_SETTLING_TIME % 1000) * 1000000;
+    if (timerfd_settime(timerFd_, 0, &spec, NULL) < 0) {
+        // Without a timer there's no way to know when to look again.
+        rescan_ = 1;
+        return;
+    }
+    settling_ = 1;
+}
+
+static void queueEvent(const struct FreespaceHotplugEvent* event) {
+    if (queueLength_ == FREESPACE_HOTPLUG_QUEUE_SIZE) {
+        // Lost track. Rescan everything once the bus settles.
+        queueLength_ = 0;
+        rescan_ = 1;
+    }
+    if (rescan_) {
+        // A rescan picks this up anyway.
+        return;
+    }
+
+    queue_[(queueHead_ + queueLength_) % FREESPACE_HOTPLUG_QUEUE_SIZE] = *event;
+    queueLength_++;
+}
+
+static int isFreespaceProduct(uint16_t idVendor, uint16_t idProduct) {
+    int i;
+    for (i = 0; i < freespace_deviceAPITableNum; i++) {
+        struct FreespaceDeviceAPI const * api = &freespace_deviceAPITable[i];
+        if (idVendor == api->idVendor_ &&
+            (idProduct & api->mask_) == (api->idProduct_ & api->mask_)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Parse one kernel uevent. These look like "ACTION@DEVPATH" followed by
+// NUL separated KEY=value pairs. Only whole USB devices (not their
+// interfaces) are of interest.
+static void parseUevent(const char* buf, int len) {
+    struct FreespaceHotplugEvent event;
+    const char* action = NULL;
+    const char* subsystem = NULL;
+    const char* devtype = NULL;
+    const char* product = NULL;
+    const char* devpath = NULL;
+    unsigned int idVendor;
+    unsigned int idProduct;
+    int i;
+
+    memset(&event, 0, sizeof(event));
+    event.busNumber_ = -1;
+    event.deviceAddress_ = -1;
+
+    // Skip the header
+    i = strnlen(buf, len) + 1;
+    while (i < len) {
+        const char* key = &buf[i];
+        i += strnlen(key, len - i) + 1;
+
+        if (strncmp(key, "ACTION=", 7) == 0) {
+            action = key + 7;
+        } else if (strncmp(key, "SUBSYSTEM=", 10) == 0) {
+            subsystem = key + 10;
+        } else if (strncmp(key, "DEVTYPE=", 8) == 0) {
+            devtype = key + 8;
+        } else if (strncmp(key, "DEVPATH=", 8) == 0) {
+            devpath = key + 8;
+        } else if (strncmp(key, "PRODUCT=", 8) == 0) {
+            product = key + 8;
+        } else if (strncmp(key, "BUSNUM=", 7) == 0) {
+            event.busNumber_ = atoi(key + 7);
+        } else if (strncmp(key, "DEVNUM=", 7) == 0) {
+            event.deviceAddress_ = atoi(key + 7);
+        }
+    }
+
+    if (action == NULL || subsystem == NULL || devtype == NULL || product == NULL || devpath == NULL) {
+        return;
+    }
+    if (strcmp(subsystem, "usb") != 0 || strcmp(devtype, "usb_device") != 0) {
+        return;
+    }
+
+    // PRODUCT is idVendor/idProduct/bcdDevice in hex
+    if (sscanf(product, "%x/%x", &idVendor, &idProduct) != 2) {
+        return;
+    }
+    if (!isFreespaceProduct((uint16_t) idVendor, (uint16_t) idProduct)) {
+        return;
+    }
+    event.idVendor_ = (uint16_t) idVendor;
+    event.idProduct_ = (uint16_t) idProduct;
+
+    if (strcmp(action, "add") == 0) {
+        event.action_ = FREESPACE_HOTPLUG_ADD;
+
+        // USB insertions cause a lot of events over a fraction
+        // of a second. Wait until the system settles.
+        startSettling();
+    } else if (strcmp(action, "remove") == 0) {
+        event.action_ = FREESPACE_HOTPLUG_REMOVE;
+    } else {
+        return;
+    }
+
+    if (event.busNumber_ < 0 || event.deviceAddress_ < 0) {
+        // Old kernels don't say which device this was.
+        rescan_ = 1;
+        startSettling();
+        return;
+    }
+
+    queueEvent(&event);
 }
 
 int freespace_hotplug_perform(int* recheck) {
-    char buf[16];
+    char buf[FREESPACE_HOTPLUG_UEVENT_SIZE];
+    struct sockaddr_nl snl;
+    struct iovec iov;
+    struct msghdr msg;
+    uint64_t expirations;
     int rc;
-    int gotEvent = 0;
-
-    // The uevent queue receives notifications on
-    // device insertion, removal, and some changes. We
-    // don't care what happens here. We just need to
-    // know when to call into libusb to rescan the
-    // USB bus.
-    // NOTE: buf doesn't need to be large. The kernel
-    //       will truncate notifications to fit inside
-    //       buf and even though this looks like a
-    //       stream interface, the kernel does not
-    //       split messages up.
+
+    *recheck = 0;
+
     for (;;) {
         // Drain the uevent queue until an error
-        rc = recv(sock_, buf, sizeof(buf), 0);
-        if (rc > 0) {
-            gotEvent = 1;
-        } else {
+        iov.iov_base = buf;
+        iov.iov_len = sizeof(buf) - 1;
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_name = &snl;
+        msg.msg_namelen = sizeof(snl);
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+
+        rc = recvmsg(sock_, &msg, 0);
+        if (rc <= 0) {
             break;
         }
-    }
 
-    // USB insertions cause a lot of events over a fraction
-    // of a second. Wait until the system settles if we get
-    // an event.
-    if (gotEvent) {
-        // Never recheck immediately.
-        *recheck = 0;
-        delay_ = FREESPACE_HOTPLUG_SETTLING_TIME;
-    } else {
-        // If we were delaying and now there are no events,
-        // then signal a recheck. This happens on our
-        // settling time timeout or if the user's event loop
-        // polls us superfluously.
-        if (delay_ > 0) {
-            *recheck = 1;
-            delay_ = 0;
-        } else {
-            *recheck = 0;
+        // Only trust messages from the kernel itself.
+        if (snl.nl_pid != 0 || (msg.msg_flags & MSG_TRUNC)) {
+            continue;
         }
+        buf[rc] = '\0';
+        parseUevent(buf, rc);
     }
-    if (errno == EAGAIN) {
-        return FREESPACE_SUCCESS;
-    } else {
+    if (rc < 0 && errno != EAGAIN) {
         return FREESPACE_ERROR_IO;
     }
+
+    // Check whether the bus has settled
+    if (settling_ && read(timerFd_, &expirations, sizeof(expirations)) > 0) {
+        settling_ = 0;
+    }
+
+    if (rescan_ && !settling_) {
+        *recheck = 1;
+        rescan_ = 0;
+        queueLength_ = 0;
+    }
+
+    return FREESPACE_SUCCESS;
+}
+
+int freespace_hotplug_nextEvent(struct FreespaceHotplugEvent* event) {
+    struct FreespaceHotplugEvent* head;
+
+    if (queueLength_ == 0) {
+        return 0;
+    }
+
+    // Removals can be applied right away, but insertions (and anything
+    // queued after them) wait until the bus settles.
+    head = &queue_[queueHead_];
+    if (settling_ && head->action_ == FREESPACE_HOTPLUG_ADD) {
+        return 0;
+    }
+
+    *event = *head;
+    queueHead_ = (queueHead_ + 1) % FREESPACE_HOTPLUG_QUEUE_SIZE;
+    queueLength_--;
+    return 1;
+}
+
+void freespace_hotplug_retry(const struct FreespaceHotplugEvent* event) {
+    struct FreespaceHotplugEvent retry = *event;
+
+    retry.retries_++;
+    if (retry.retries_ > FREESPACE_HOTPLUG_MAX_RETRIES) {
+        rescan_ = 1;
+    } else {
+        queueEvent(&retry);
+    }
+    startSettling();
 }
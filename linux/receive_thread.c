@@ -0,0 +1,262 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE // pthread_setaffinity_np
+#endif
+
+#include "receive_thread.h"
+#include "backend.h"
+#include "freespace/freespace.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <string.h>
+#include <unistd.h>
+
+// Most file descriptors the library hands out: hotplug, the worker pool,
+// libusb's own and one per device.
+#define FREESPACE_RECEIVE_MAX_FDS (FREESPACE_MAXIMUM_DEVICE_COUNT + 16)
+
+// The receive thread's stack. It is touched when the thread starts so
+// that it is resident before the application calls mlockall.
+#define FREESPACE_RECEIVE_STACK_SIZE (256 * 1024)
+#define FREESPACE_RECEIVE_STACK_PREFAULT (64 * 1024)
+
+static pthread_t thread_;
+static int running_ = 0;
+static volatile int exitThread_ = 0;
+static int busyPoll_ = 0;
+
+// Held while the receive thread is in the library, and by the
+// application through freespace_lock(). waiters_ counts application
+// threads wanting the lock so that a busy polling thread backs off.
+static pthread_mutex_t mutex_;
+static volatile int waiters_ = 0;
+
+// fds_[0] is the read end of wakePipe_, the rest are the library's
+// descriptors as reported through the file descriptor callbacks.
+static struct pollfd fds_[FREESPACE_RECEIVE_MAX_FDS + 1];
+static int numFds_ = 1;
+static int wakePipe_[2] = { -1, -1 };
+
+static void wake() {
+    if (write(wakePipe_[1], "1", 1) < 0) {
+        // Already pending
+    }
+}
+
+// These are called with mutex_ held.
+static void fdAdded(int fd, short events) {
+    int i;
+    for (i = 1; i < numFds_; i++) {
+        if (fds_[i].fd == fd) {
+            fds_[i].events = events;
+            return;
+        }
+    }
+    if (numFds_ <= FREESPACE_RECEIVE_MAX_FDS) {
+        fds_[numFds_].fd = fd;
+        fds_[numFds_].events = events;
+        numFds_++;
+    }
+    wake();
+}
+
+static void fdRemoved(int fd) {
+    int i;
+    for (i = 1; i < numFds_; i++) {
+        if (fds_[i].fd == fd) {
+            fds_[i] = fds_[numFds_ - 1];
+            numFds_--;
+            break;
+        }
+    }
+    wake();
+}
+
+static void prefaultStack() {
+    volatile char buf[FREESPACE_RECEIVE_STACK_PREFAULT];
+    memset((char*) buf, 0, sizeof(buf));
+}
+
+static void* receiveThread(void* arg) {
+    struct pollfd fds[FREESPACE_RECEIVE_MAX_FDS + 1];
+    char drain[16];
+    int nfds;
+    int timeoutMs;
+
+    prefaultStack();
+
+    while (!exitThread_) {
+        // Perform first so that the initial device scan happens right away
+        pthread_mutex_lock(&mutex_);
+        freespace_perform();
+        pthread_mutex_unlock(&mutex_);
+
+        if (busyPoll_) {
+            // Let the application in
+            while (waiters_ > 0 && !exitThread_) {
+                sched_yield();
+            }
+            continue;
+        }
+
+        pthread_mutex_lock(&mutex_);
+        nfds = numFds_;
+        memcpy(fds, fds_, nfds * sizeof(struct pollfd));
+        freespace_getNextTimeout(&timeoutMs);
+        pthread_mutex_unlock(&mutex_);
+
+        if (poll(fds, nfds, timeoutMs) < 0 && errno != EINTR) {
+            break;
+        }
+        if (fds[0].revents & POLLIN) {
+            while (read(wakePipe_[0], drain, sizeof(drain)) > 0);
+        }
+    }
+
+    return NULL;
+}
+
+static int startThread(const struct FreespaceInitOptions* options) {
+    pthread_attr_t attr;
+    pthread_mutexattr_t mattr;
+    struct sched_param param;
+    int rc;
+
+    if (pipe(wakePipe_) < 0) {
+        return FREESPACE_ERROR_UNEXPECTED;
+    }
+    fcntl(wakePipe_[0], F_SETFL, O_NONBLOCK);
+    fcntl(wakePipe_[1], F_SETFL, O_NONBLOCK);
+    fds_[0].fd = wakePipe_[0];
+    fds_[0].events = POLLIN;
+    numFds_ = 1;
+
+    // Recursive, so that callbacks on the receive thread can call back
+    // into the library.
+    pthread_mutexattr_init(&mattr);
+    pthread_mutexattr_settype(&mattr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&mutex_, &mattr);
+    pthread_mutexattr_destroy(&mattr);
+
+    // Track the library's descriptors ourselves.
+    pthread_mutex_lock(&mutex_);
+    freespace_setFileDescriptorCallbacks(fdAdded, fdRemoved);
+    freespace_syncFileDescriptors();
+    pthread_mutex_unlock(&mutex_);
+
+    busyPoll_ = options->busyPoll;
+    exitThread_ = 0;
+
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, FREESPACE_RECEIVE_STACK_SIZE);
+    if (options->schedPriority > 0) {
+        pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+        pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
+        memset(&param, 0, sizeof(param));
+        param.sched_priority = options->schedPriority;
+        pthread_attr_setschedparam(&attr, &param);
+    }
+
+    rc = pthread_create(&thread_, &attr, receiveThread, NULL);
+    pthread_attr_destroy(&attr);
+    if (rc != 0) {
+        freespace_setFileDescriptorCallbacks(NULL, NULL);
+        pthread_mutex_destroy(&mutex_);
+        close(wakePipe_[0]);
+        close(wakePipe_[1]);
+        wakePipe_[0] = wakePipe_[1] = -1;
+        return rc == EPERM ? FREESPACE_ERROR_ACCESS : FREESPACE_ERROR_COULD_NOT_CREATE_THREAD;
+    }
+    running_ = 1;
+
+    if (options->cpuMask != 0) {
+#ifdef __linux__
+        cpu_set_t cpus;
+        int cpu;
+
+        CPU_ZERO(&cpus);
+        for (cpu = 0; cpu < (int) (sizeof(options->cpuMask) * 8); cpu++) {
+            if (options->cpuMask & (1UL << cpu)) {
+                CPU_SET(cpu, &cpus);
+            }
+        }
+        if (pthread_setaffinity_np(thread_, sizeof(cpus), &cpus) != 0) {
+            freespace_receiveThread_stop();
+            return FREESPACE_ERROR_UNEXPECTED;
+        }
+#else
+        freespace_receiveThread_stop();
+        return FREESPACE_ERROR_UINIMPLEMENTED;
+#endif
+    }
+
+    return FREESPACE_SUCCESS;
+}
+
+int freespace_initWithOptions(const struct FreespaceInitOptions* options) {
+    int rc;
+
+    rc = freespace_private_initBackend(options != NULL ? options->backend : NULL);
+    if (rc != FREESPACE_SUCCESS || options == NULL || !options->receiveThread) {
+        return rc;
+    }
+
+    rc = startThread(options);
+    if (rc != FREESPACE_SUCCESS) {
+        freespace_exit();
+    }
+    return rc;
+}
+
+void freespace_receiveThread_stop() {
+    if (!running_) {
+        return;
+    }
+
+    exitThread_ = 1;
+    wake();
+    pthread_join(thread_, NULL);
+    running_ = 0;
+
+    freespace_setFileDescriptorCallbacks(NULL, NULL);
+    pthread_mutex_destroy(&mutex_);
+    close(wakePipe_[0]);
+    close(wakePipe_[1]);
+    wakePipe_[0] = wakePipe_[1] = -1;
+}
+
+void freespace_lock() {
+    if (!running_) {
+        return;
+    }
+    __sync_fetch_and_add(&waiters_, 1);
+    pthread_mutex_lock(&mutex_);
+    __sync_fetch_and_sub(&waiters_, 1);
+}
+
+void freespace_unlock() {
+    if (!running_) {
+        return;
+    }
+    pthread_mutex_unlock(&mutex_);
+}
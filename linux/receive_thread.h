@@ -0,0 +1,27 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _RECEIVE_THREAD_H_
+#define _RECEIVE_THREAD_H_
+
+/**
+ * Stop the receive thread started by freespace_initWithOptions(), if
+ * any. Backends call this first thing in freespace_exit().
+ */
+void freespace_receiveThread_stop();
+
+#endif // _RECEIVE_THREAD_H_
@@ -0,0 +1,82 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _TEST_BACKEND_H_
+#define _TEST_BACKEND_H_
+
+#include "freespace/freespace.h"
+
+/*
+ * The 'test' backend keeps its devices in memory, so that the request,
+ * configuration, subscription and rate control code can be driven
+ * without hardware. Applications choose it with FREESPACE_BACKEND=test.
+ * The functions below stand in for the device side. They may only be
+ * called between freespace_init() and freespace_exit(), from the thread
+ * that calls freespace_perform(), and not from its callbacks unless
+ * noted.
+ */
+
+// Reports each test device holds until they are received, as many as a
+// hidraw queue
+#define FREESPACE_TEST_QUEUE_SIZE 64
+
+/**
+ * Called with each report sent to a test device. It may answer by
+ * calling freespace_test_inject().
+ *
+ * @return the result of the send
+ */
+typedef int (*freespace_testSendCallback)(FreespaceDeviceId id,
+                                          const uint8_t* report,
+                                          int length,
+                                          void* cookie);
+
+/**
+ * Plug in a device. The hotplug callback is called from the next
+ * freespace_perform().
+ *
+ * @param info the device to report; the name is copied
+ * @param id set to the id of the new device
+ * @return FREESPACE_SUCCESS or FREESPACE_ERROR_BUSY if there are
+ *         FREESPACE_MAXIMUM_DEVICE_COUNT devices already
+ */
+int freespace_test_addDevice(const struct FreespaceDeviceInfo* info, FreespaceDeviceId* id);
+
+/**
+ * Unplug a device. An open device stays until it is closed, as with the
+ * other backends.
+ */
+int freespace_test_removeDevice(FreespaceDeviceId id);
+
+/**
+ * Queue a report from an open device, to be received by the next
+ * freespace_perform(). May be called from the send callback.
+ *
+ * @return FREESPACE_SUCCESS, FREESPACE_ERROR_BUSY if the device already
+ *         holds FREESPACE_TEST_QUEUE_SIZE reports or
+ *         FREESPACE_ERROR_NO_DEVICE if it is not open
+ */
+int freespace_test_inject(FreespaceDeviceId id, const uint8_t* report, int length);
+
+/**
+ * Set the callback that answers sends, or NULL to have every send
+ * succeed unanswered.
+ */
+void freespace_test_setSendCallback(freespace_testSendCallback callback, void* cookie);
+
+#endif // _TEST_BACKEND_H_
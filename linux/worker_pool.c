@@ -0,0 +1,216 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "worker_pool.h"
+#include "freespace/freespace.h"
+
+#include <pthread.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+struct FreespaceWorkQueue {
+    struct FreespaceWorkItem* head;
+    struct FreespaceWorkItem* tail;
+};
+
+static pthread_t threads_[FREESPACE_WORKER_COUNT];
+static int threadCount_ = 0;
+static pthread_mutex_t mutex_ = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t cond_ = PTHREAD_COND_INITIALIZER;
+static int exitThreads_ = 0;
+
+// Work waiting for a thread, and work waiting for its done function.
+static struct FreespaceWorkQueue pending_;
+static struct FreespaceWorkQueue completed_;
+
+// Self-pipe used to wake up the application's poll loop when
+// work completes.
+static int readFd_ = -1;
+static int writeFd_ = -1;
+
+static void pushLocked(struct FreespaceWorkQueue* q, struct FreespaceWorkItem* item) {
+    item->next_ = NULL;
+    if (q->tail == NULL) {
+        q->head = item;
+    } else {
+        q->tail->next_ = item;
+    }
+    q->tail = item;
+}
+
+static struct FreespaceWorkItem* popLocked(struct FreespaceWorkQueue* q) {
+    struct FreespaceWorkItem* item = q->head;
+    if (item != NULL) {
+        q->head = item->next_;
+        if (q->head == NULL) {
+            q->tail = NULL;
+        }
+        item->next_ = NULL;
+    }
+    return item;
+}
+
+static void* workerThread(void* arg) {
+    struct FreespaceWorkItem* item;
+
+    pthread_mutex_lock(&mutex_);
+    for (;;) {
+        while (!exitThreads_ && pending_.head == NULL) {
+            pthread_cond_wait(&cond_, &mutex_);
+        }
+        if (exitThreads_) {
+            break;
+        }
+
+        item = popLocked(&pending_);
+        pthread_mutex_unlock(&mutex_);
+
+        item->work_(item);
+
+        pthread_mutex_lock(&mutex_);
+        pushLocked(&completed_, item);
+
+        // Wake the application. A full pipe already means that it
+        // will wake up, so errors are not interesting.
+        if (write(writeFd_, "1", 1) < 0) {
+            // Nothing to do
+        }
+    }
+    pthread_mutex_unlock(&mutex_);
+
+    return NULL;
+}
+
+int freespace_workers_init() {
+    int fds[2];
+    int i;
+
+    if (threadCount_ > 0) {
+        return FREESPACE_SUCCESS;
+    }
+
+    if (pipe(fds) < 0) {
+        return FREESPACE_ERROR_UNEXPECTED;
+    }
+    fcntl(fds[0], F_SETFL, O_NONBLOCK);
+    fcntl(fds[1], F_SETFL, O_NONBLOCK);
+    readFd_ = fds[0];
+    writeFd_ = fds[1];
+
+    exitThreads_ = 0;
+    for (i = 0; i < FREESPACE_WORKER_COUNT; i++) {
+        if (pthread_create(&threads_[i], NULL, workerThread, NULL) != 0) {
+            break;
+        }
+        threadCount_++;
+    }
+
+    if (threadCount_ == 0) {
+        close(readFd_);
+        close(writeFd_);
+        readFd_ = -1;
+        writeFd_ = -1;
+        return FREESPACE_ERROR_COULD_NOT_CREATE_THREAD;
+    }
+    return FREESPACE_SUCCESS;
+}
+
+void freespace_workers_exit() {
+    struct FreespaceWorkItem* item;
+    int i;
+
+    if (threadCount_ == 0) {
+        return;
+    }
+
+    pthread_mutex_lock(&mutex_);
+    exitThreads_ = 1;
+    pthread_cond_broadcast(&cond_);
+    pthread_mutex_unlock(&mutex_);
+
+    for (i = 0; i < threadCount_; i++) {
+        pthread_join(threads_[i], NULL);
+    }
+    threadCount_ = 0;
+
+    // No threads are left, so the queues can be walked without the lock.
+    while ((item = popLocked(&completed_)) != NULL) {
+        item->cancelled_ = 1;
+        item->done_(item);
+    }
+    while ((item = popLocked(&pending_)) != NULL) {
+        item->cancelled_ = 1;
+        item->done_(item);
+    }
+
+    close(readFd_);
+    close(writeFd_);
+    readFd_ = -1;
+    writeFd_ = -1;
+}
+
+int freespace_workers_submit(struct FreespaceWorkItem* item,
+                             freespace_workFn work,
+                             freespace_workFn done) {
+    if (threadCount_ == 0) {
+        return FREESPACE_ERROR_UNEXPECTED;
+    }
+
+    item->work_ = work;
+    item->done_ = done;
+    item->cancelled_ = 0;
+
+    pthread_mutex_lock(&mutex_);
+    pushLocked(&pending_, item);
+    pthread_cond_signal(&cond_);
+    pthread_mutex_unlock(&mutex_);
+
+    return FREESPACE_SUCCESS;
+}
+
+int freespace_workers_getFD() {
+    return readFd_;
+}
+
+int freespace_workers_perform() {
+    struct FreespaceWorkItem* item;
+    char buf[16];
+
+    if (threadCount_ == 0) {
+        return FREESPACE_SUCCESS;
+    }
+
+    // Drain the wakeup pipe before taking the completed work so that
+    // nothing that completes afterwards is missed.
+    while (read(readFd_, buf, sizeof(buf)) > 0);
+
+    for (;;) {
+        pthread_mutex_lock(&mutex_);
+        item = popLocked(&completed_);
+        pthread_mutex_unlock(&mutex_);
+
+        if (item == NULL) {
+            break;
+        }
+
+        // Run without the lock. The done function may submit more work.
+        item->done_(item);
+    }
+
+    return FREESPACE_SUCCESS;
+}
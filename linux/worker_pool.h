@@ -0,0 +1,83 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _WORKER_POOL_H_
+#define _WORKER_POOL_H_
+
+/**
+ * Number of threads used to run blocking device operations
+ * (probing, opening) in the background.
+ */
+#define FREESPACE_WORKER_COUNT 4
+
+struct FreespaceWorkItem;
+
+/**
+ * Function run on a work item. The work function runs on a pool
+ * thread; the done function runs on the thread that calls
+ * freespace_workers_perform().
+ */
+typedef void (*freespace_workFn)(struct FreespaceWorkItem* item);
+
+/**
+ * Header of a unit of work. Embed this as the first member of the
+ * job structure; the pool never allocates or frees jobs itself.
+ */
+struct FreespaceWorkItem {
+    freespace_workFn work_;
+    freespace_workFn done_;
+
+    // Set when the pool is shut down before the done function could
+    // be run normally. The done function must then only release
+    // resources and not call back into the application.
+    int cancelled_;
+
+    struct FreespaceWorkItem* next_;
+};
+
+/**
+ * Start the worker threads. Calling this more than once is harmless.
+ */
+int freespace_workers_init();
+
+/**
+ * Stop the worker threads. Work items that have not been completed
+ * have their done function called with cancelled_ set.
+ */
+void freespace_workers_exit();
+
+/**
+ * Queue a work item.
+ */
+int freespace_workers_submit(struct FreespaceWorkItem* item,
+                             freespace_workFn work,
+                             freespace_workFn done);
+
+/**
+ * Get the file descriptor that becomes readable when completed
+ * work items are waiting. This is for use by poll or select.
+ *
+ * @return the descriptor or -1 if the pool is not running
+ */
+int freespace_workers_getFD();
+
+/**
+ * Run the done function of every completed work item.
+ */
+int freespace_workers_perform();
+
+#endif // _WORKER_POOL_H_
@@ -0,0 +1,213 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "fake_device.h"
+
+#include <string.h>
+#include <time.h>
+
+static struct FakeDevice devices_[FREESPACE_MAXIMUM_DEVICE_COUNT];
+static int numDevices_ = 0;
+// Set by fake_forbidAllocations(), and while fake_pump() is in
+// freespace_perform()
+static int forbid_ = 0;
+static int performing_ = 0;
+
+static struct FakeDevice* findDevice(FreespaceDeviceId id) {
+    int i;
+    for (i = 0; i < numDevices_; i++) {
+        if (devices_[i].id == id) {
+            return &devices_[i];
+        }
+    }
+    return NULL;
+}
+
+static int64_t nowMillis() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t) ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+static void answerMode(struct FakeDevice* device, const uint8_t* request) {
+    int operatingStatus = request[5] & 1;
+    int outputStatus = (request[5] >> 4) & 1;
+    uint8_t response[9];
+
+    device->modeRequests++;
+    // outputStatus only asks; operatingStatus leaves the mode alone
+    if (!outputStatus) {
+        if (!operatingStatus) {
+            device->mode = (request[5] >> 1) & 7;
+        }
+        device->packetSelect = request[6];
+        device->formatSelect = request[7];
+        device->formatFlags = request[8];
+    }
+    if (!device->answer) {
+        return;
+    }
+
+    memset(response, 0, sizeof(response));
+    response[0] = 5;
+    response[1] = sizeof(response);
+    response[4] = 20;
+    response[5] = (uint8_t) ((device->mode << 1) | (device->mode << 5));
+    response[6] = device->packetSelect;
+    response[7] = device->formatSelect;
+    response[8] = device->formatFlags;
+    CHECK_RC(FREESPACE_SUCCESS, freespace_test_inject(device->id, response, sizeof(response)));
+}
+
+static void answerPeriod(struct FakeDevice* device, const uint8_t* request) {
+    int commit = request[5] & 1;
+    int get = (request[5] >> 1) & 1;
+    uint8_t sensor = request[6];
+    uint32_t period = request[8] | request[9] << 8 | request[10] << 16 | (uint32_t) request[11] << 24;
+    uint8_t response[12];
+
+    device->periodRequests++;
+    if (!get && commit) {
+        device->lastSensor = sensor;
+        device->lastPeriod = period;
+        if (!device->rejectPeriods) {
+            device->periods[sensor] = period;
+        }
+    }
+    if (!device->answer) {
+        return;
+    }
+
+    period = device->periods[sensor];
+    memset(response, 0, sizeof(response));
+    response[0] = 5;
+    response[1] = sizeof(response);
+    response[4] = 23;
+    response[6] = sensor;
+    response[8] = (uint8_t) period;
+    response[9] = (uint8_t) (period >> 8);
+    response[10] = (uint8_t) (period >> 16);
+    response[11] = (uint8_t) (period >> 24);
+    CHECK_RC(FREESPACE_SUCCESS, freespace_test_inject(device->id, response, sizeof(response)));
+}
+
+static int onSend(FreespaceDeviceId id, const uint8_t* report, int length, void* cookie) {
+    struct FakeDevice* device = findDevice(id);
+
+    // Version 2 output reports carry the message type in the fifth byte
+    if (device == NULL || length < 5 || report[0] != 7) {
+        return FREESPACE_SUCCESS;
+    }
+    if (report[4] == 20 && length >= 9) {
+        answerMode(device, report);
+    } else if (report[4] == 22 && length >= 12) {
+        answerPeriod(device, report);
+    }
+    return FREESPACE_SUCCESS;
+}
+
+static void* strictMalloc(size_t size, void* context) {
+    (void) context;
+    if (forbid_ && performing_) {
+        fprintf(stderr, "allocated %lu bytes while servicing open devices\n", (unsigned long) size);
+        abort();
+    }
+    return malloc(size);
+}
+
+static void strictFree(void* ptr, void* context) {
+    (void) context;
+    free(ptr);
+}
+
+void fake_init() {
+    struct FreespaceInitOptions options;
+
+    CHECK_RC(FREESPACE_SUCCESS, freespace_setAllocator(strictMalloc, strictFree, NULL));
+    memset(&options, 0, sizeof(options));
+    options.backend = "test";
+    CHECK_RC(FREESPACE_SUCCESS, freespace_initWithOptions(&options));
+    CHECK(strcmp(freespace_backendName(), "test") == 0);
+    freespace_test_setSendCallback(onSend, NULL);
+}
+
+struct FakeDevice* fake_open() {
+    struct FreespaceDeviceInfo info;
+    struct FakeDevice* device;
+
+    CHECK(numDevices_ < FREESPACE_MAXIMUM_DEVICE_COUNT);
+    device = &devices_[numDevices_++];
+    memset(device, 0, sizeof(*device));
+    device->answer = 1;
+
+    memset(&info, 0, sizeof(info));
+    info.name = "Fake handheld";
+    info.vendor = 0x1d5a;
+    info.product = 0xc080;
+    info.hVer = 2;
+    CHECK_RC(FREESPACE_SUCCESS, freespace_test_addDevice(&info, &device->id));
+    CHECK_RC(FREESPACE_SUCCESS, freespace_openDevice(device->id));
+    return device;
+}
+
+int fake_pump(int (*done)(void* cookie), void* cookie, int timeoutMs) {
+    int64_t deadline = nowMillis() + timeoutMs;
+    int finished = 0;
+
+    for (;;) {
+        int nextMs = -1;
+
+        performing_ = 1;
+        CHECK_RC(FREESPACE_SUCCESS, freespace_perform());
+        performing_ = 0;
+        if (done != NULL && (finished = done(cookie)) != 0) {
+            return finished;
+        }
+        if (nowMillis() >= deadline) {
+            return finished;
+        }
+        CHECK_RC(FREESPACE_SUCCESS, freespace_getNextTimeout(&nextMs));
+        if (nextMs != 0) {
+            struct timespec ts = { 0, 1000000 };
+            nanosleep(&ts, NULL);
+        }
+    }
+}
+
+void fake_forbidAllocations(int forbid) {
+    forbid_ = forbid;
+}
+
+void fake_run(int timeoutMs) {
+    fake_pump(NULL, NULL, timeoutMs);
+}
+
+int fake_sendMotion(struct FakeDevice* device, uint32_t sequence) {
+    uint8_t report[54];
+
+    memset(report, 0, sizeof(report));
+    report[0] = 38;
+    report[1] = sizeof(report);
+    report[4] = device->formatSelect;
+    report[5] = device->formatFlags;
+    report[6] = (uint8_t) sequence;
+    report[7] = (uint8_t) (sequence >> 8);
+    report[8] = (uint8_t) (sequence >> 16);
+    report[9] = (uint8_t) (sequence >> 24);
+    return freespace_test_inject(device->id, report, sizeof(report));
+}
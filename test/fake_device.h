@@ -0,0 +1,109 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _FAKE_DEVICE_H_
+#define _FAKE_DEVICE_H_
+
+#include "freespace/freespace.h"
+#include "test_backend.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+ * A device on the test backend that answers DataModeControlV2Request
+ * and SensorPeriodRequest as a handheld would, for the tests.
+ */
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            exit(1); \
+        } \
+    } while (0)
+
+#define CHECK_RC(expected, actual) \
+    do { \
+        int rc_ = (actual); \
+        if (rc_ != (expected)) { \
+            fprintf(stderr, "%s:%d: %s returned %d, expected %d\n", __FILE__, __LINE__, #actual, rc_, (expected)); \
+            exit(1); \
+        } \
+    } while (0)
+
+struct FakeDevice {
+    FreespaceDeviceId id;
+    // 0 to leave requests unanswered
+    int answer;
+    // Nonzero to answer sensor period requests without taking the period
+    int rejectPeriods;
+
+    // The state the device reports
+    uint8_t mode;
+    uint8_t packetSelect;
+    uint8_t formatSelect;
+    uint8_t formatFlags;
+    uint32_t periods[256];
+
+    // Requests seen
+    int modeRequests;
+    int periodRequests;
+    // The last period set
+    uint8_t lastSensor;
+    uint32_t lastPeriod;
+};
+
+/**
+ * Initialize the library with the test backend, allocating through
+ * a checked allocator.
+ */
+void fake_init();
+
+/**
+ * Plug in and open a HID protocol version 2 device.
+ */
+struct FakeDevice* fake_open();
+
+/**
+ * Call freespace_perform() until done(cookie) is nonzero or timeoutMs
+ * passes.
+ *
+ * @return the last value of done
+ */
+int fake_pump(int (*done)(void* cookie), void* cookie, int timeoutMs);
+
+/**
+ * Abort if the library allocates from freespace_perform() in
+ * fake_pump(), as LIBFREESPACE_ALLOCATION_ASSERTS would, while forbid is
+ * nonzero. Allocations in the calls that set things up are still
+ * allowed.
+ */
+void fake_forbidAllocations(int forbid);
+
+/**
+ * Pump for timeoutMs.
+ */
+void fake_run(int timeoutMs);
+
+/**
+ * Queue a MotionEngineOutput report in the device's current format.
+ */
+int fake_sendMotion(struct FakeDevice* device, uint32_t sequence);
+
+#endif // _FAKE_DEVICE_H_
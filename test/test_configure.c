@@ -0,0 +1,107 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/*
+ * freespace_configureAsync() against devices on the test backend: a
+ * data mode and sensor periods applied to two devices at once, and
+ * rolled back when a device does not take them. Each step is requested
+ * from the callback of the one before while receiving, which must not
+ * allocate.
+ */
+
+#include "fake_device.h"
+
+#include <string.h>
+
+struct Outcome {
+    int calls;
+    int count;
+    int results[2];
+};
+
+static void onConfigured(const FreespaceDeviceId* ids, const int* results, int count, void* cookie) {
+    struct Outcome* outcome = (struct Outcome*) cookie;
+    int i;
+
+    outcome->calls++;
+    outcome->count = count;
+    for (i = 0; i < count && i < 2; i++) {
+        outcome->results[i] = results[i];
+    }
+}
+
+static int called(void* cookie) {
+    return ((struct Outcome*) cookie)->calls > 0;
+}
+
+int main() {
+    struct FakeDevice* first;
+    struct FakeDevice* second;
+    struct FreespaceConfigProfile profile;
+    struct Outcome outcome;
+    FreespaceDeviceId ids[2];
+
+    fake_init();
+    first = fake_open();
+    second = fake_open();
+    first->periods[0] = second->periods[0] = 4000;
+    first->periods[1] = second->periods[1] = 4000;
+    fake_forbidAllocations(1);
+
+    memset(&profile, 0, sizeof(profile));
+    profile.parts = FREESPACE_CONFIG_DATA_MODE | FREESPACE_CONFIG_SENSOR_PERIODS;
+    profile.mode = 4;
+    profile.packetSelect = 8;
+    profile.formatSelect = 0;
+    profile.formatFlags = 0x01;
+    profile.sensorCount = 2;
+    profile.sensors[0].sensor = 0;
+    profile.sensors[0].period = 8000;
+    profile.sensors[1].sensor = 1;
+    profile.sensors[1].period = 16000;
+
+    // Both devices take the profile
+    ids[0] = first->id;
+    ids[1] = second->id;
+    memset(&outcome, 0, sizeof(outcome));
+    CHECK_RC(FREESPACE_SUCCESS, freespace_configureAsync(ids, 2, &profile, 500, onConfigured, &outcome));
+    CHECK(outcome.calls == 0);
+    CHECK(fake_pump(called, &outcome, 2000));
+    CHECK(outcome.count == 2);
+    CHECK_RC(FREESPACE_SUCCESS, outcome.results[0]);
+    CHECK_RC(FREESPACE_SUCCESS, outcome.results[1]);
+    CHECK(first->mode == 4 && first->packetSelect == 8 && first->formatFlags == 0x01);
+    CHECK(first->periods[0] == 8000 && first->periods[1] == 16000);
+    CHECK(second->mode == 4 && second->periods[1] == 16000);
+
+    // The second device keeps its periods, so it is put back as it was
+    second->rejectPeriods = 1;
+    profile.mode = 5;
+    profile.sensors[0].period = 2000;
+    memset(&outcome, 0, sizeof(outcome));
+    CHECK_RC(FREESPACE_SUCCESS, freespace_configureAsync(ids, 2, &profile, 500, onConfigured, &outcome));
+    CHECK(fake_pump(called, &outcome, 2000));
+    CHECK_RC(FREESPACE_SUCCESS, outcome.results[0]);
+    CHECK_RC(FREESPACE_ERROR_UNEXPECTED, outcome.results[1]);
+    CHECK(first->mode == 5 && first->periods[0] == 2000);
+    CHECK(second->mode == 4 && second->periods[0] == 8000);
+    CHECK(second->lastSensor == 0 && second->lastPeriod == 8000);
+
+    freespace_exit();
+    return 0;
+}
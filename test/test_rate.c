@@ -0,0 +1,102 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/*
+ * freespace_setRateControl() against a device on the test backend: the
+ * sensor period is doubled while reports are left waiting or the
+ * callbacks take up the time, and halved again once the application
+ * keeps up.
+ */
+
+#include "fake_device.h"
+
+#include <string.h>
+#include <time.h>
+
+#define MIN_PERIOD_US 4000
+#define MAX_PERIOD_US 32000
+
+static int64_t nowMillis() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t) ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+// Takes most of the time between reports, without any piling up
+static void onSlowReceive(FreespaceDeviceId id, struct freespace_message* message, void* cookie, int result) {
+    int64_t until = nowMillis() + 4;
+    while (nowMillis() < until) {
+    }
+}
+
+static int restored(void* cookie) {
+    const struct FakeDevice* device = (const struct FakeDevice*) cookie;
+    return device->periods[0] == MIN_PERIOD_US;
+}
+
+int main() {
+    struct FakeDevice* device;
+    int64_t deadline;
+    uint32_t sequence = 0;
+
+    fake_init();
+    device = fake_open();
+    device->periods[0] = MIN_PERIOD_US;
+    CHECK_RC(FREESPACE_SUCCESS, freespace_setRateControl(device->id, 0, MIN_PERIOD_US, MAX_PERIOD_US));
+    fake_forbidAllocations(1);
+
+    // Keep the device's queue full and read only part of it each time
+    deadline = nowMillis() + 3000;
+    while (device->periods[0] == MIN_PERIOD_US && nowMillis() < deadline) {
+        struct timespec ts = { 0, 1000000 };
+        int remaining = 0;
+        while (fake_sendMotion(device, sequence) == FREESPACE_SUCCESS) {
+            sequence++;
+        }
+        CHECK_RC(FREESPACE_SUCCESS, freespace_performBudget(8, 0, &remaining));
+        CHECK(remaining);
+        nanosleep(&ts, NULL);
+    }
+    CHECK(device->periods[0] == 2 * MIN_PERIOD_US);
+    CHECK(device->lastSensor == 0);
+
+    // Caught up, the device goes back to its full rate. The response to
+    // the period request is queued behind the reports, so they are read
+    // rather than flushed.
+    CHECK(fake_pump(restored, device, 4000));
+
+    // Slow callbacks count, even with one report at a time
+    CHECK_RC(FREESPACE_SUCCESS, freespace_setReceiveMessageCallback(device->id, onSlowReceive, NULL));
+    deadline = nowMillis() + 3000;
+    while (device->periods[0] == MIN_PERIOD_US && nowMillis() < deadline) {
+        CHECK_RC(FREESPACE_SUCCESS, fake_sendMotion(device, sequence++));
+        fake_run(0);
+    }
+    CHECK(device->periods[0] == 2 * MIN_PERIOD_US);
+    CHECK_RC(FREESPACE_SUCCESS, freespace_setReceiveMessageCallback(device->id, NULL, NULL));
+
+    // Turning rate control off puts the device back to its full rate, and
+    // leaves it there
+    CHECK_RC(FREESPACE_SUCCESS, freespace_setRateControl(device->id, 0, 0, 0));
+    CHECK(fake_pump(restored, device, 1000));
+    fake_run(300);
+    CHECK(device->periods[0] == MIN_PERIOD_US);
+
+    freespace_exit();
+    return 0;
+}
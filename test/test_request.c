@@ -0,0 +1,129 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/*
+ * freespace_request() against a device on the test backend: answered,
+ * timed out, refused once the device's pool is used up and failed by
+ * closing the device.
+ */
+
+#include "fake_device.h"
+
+#include <string.h>
+
+struct Result {
+    int calls;
+    int result;
+    uint8_t sensor;
+    uint32_t period;
+};
+
+static int received_ = 0;
+
+static void onResponse(FreespaceDeviceId id, struct freespace_message* response, void* cookie, int result) {
+    struct Result* r = (struct Result*) cookie;
+
+    r->calls++;
+    r->result = result;
+    if (result == FREESPACE_SUCCESS) {
+        CHECK(response != NULL);
+        CHECK(response->messageType == FREESPACE_MESSAGE_SENSORPERIODRESPONSE);
+        r->sensor = response->sensorPeriodResponse.sensor;
+        r->period = response->sensorPeriodResponse.period;
+    } else {
+        CHECK(response == NULL);
+    }
+}
+
+static void onReceive(FreespaceDeviceId id, struct freespace_message* message, void* cookie, int result) {
+    received_++;
+}
+
+static int called(void* cookie) {
+    return ((struct Result*) cookie)->calls > 0;
+}
+
+static int request(struct FakeDevice* device, uint8_t sensor, unsigned int timeoutMs, struct Result* r) {
+    struct freespace_message m;
+
+    memset(r, 0, sizeof(*r));
+    memset(&m, 0, sizeof(m));
+    m.messageType = FREESPACE_MESSAGE_SENSORPERIODREQUEST;
+    m.sensorPeriodRequest.get = 1;
+    m.sensorPeriodRequest.sensor = sensor;
+    return freespace_request(device->id, &m, FREESPACE_MESSAGE_SENSORPERIODRESPONSE,
+                             timeoutMs, onResponse, r);
+}
+
+int main() {
+    struct FakeDevice* device;
+    struct Result r;
+    struct Result second;
+    struct Result pool[FREESPACE_REQUEST_POOL_SIZE];
+    int i;
+
+    fake_init();
+    device = fake_open();
+    device->periods[3] = 10000;
+    CHECK_RC(FREESPACE_SUCCESS, freespace_setReceiveMessageCallback(device->id, onReceive, NULL));
+
+    // Answered, and the response is kept from the receive callback
+    CHECK_RC(FREESPACE_SUCCESS, request(device, 3, 1000, &r));
+    CHECK(r.calls == 0);
+    CHECK(fake_pump(called, &r, 1000));
+    CHECK_RC(FREESPACE_SUCCESS, r.result);
+    CHECK(r.sensor == 3 && r.period == 10000);
+    CHECK(received_ == 0);
+
+    // Two at once complete in order
+    device->periods[4] = 20000;
+    CHECK_RC(FREESPACE_SUCCESS, request(device, 3, 1000, &r));
+    CHECK_RC(FREESPACE_SUCCESS, request(device, 4, 1000, &second));
+    CHECK(fake_pump(called, &second, 1000));
+    CHECK(r.calls == 1 && r.sensor == 3);
+    CHECK(second.calls == 1 && second.sensor == 4 && second.period == 20000);
+
+    // Unanswered
+    device->answer = 0;
+    CHECK_RC(FREESPACE_SUCCESS, request(device, 3, 50, &r));
+    CHECK(fake_pump(called, &r, 1000));
+    CHECK_RC(FREESPACE_ERROR_TIMEOUT, r.result);
+    CHECK(device->periodRequests == 4);
+
+    // Only a pool's worth may wait at once, and they are reused
+    for (i = 0; i < FREESPACE_REQUEST_POOL_SIZE; i++) {
+        CHECK_RC(FREESPACE_SUCCESS, request(device, 3, 50, &pool[i]));
+    }
+    CHECK_RC(FREESPACE_ERROR_BUSY, request(device, 3, 50, &r));
+    CHECK(fake_pump(called, &pool[FREESPACE_REQUEST_POOL_SIZE - 1], 1000));
+    for (i = 0; i < FREESPACE_REQUEST_POOL_SIZE; i++) {
+        CHECK_RC(FREESPACE_ERROR_TIMEOUT, pool[i].result);
+    }
+
+    // Failed when the device is closed, and refused once it is
+    CHECK_RC(FREESPACE_SUCCESS, request(device, 3, 1000, &r));
+    fake_run(20);
+    CHECK(r.calls == 0);
+    freespace_closeDevice(device->id);
+    CHECK(r.calls == 1);
+    CHECK_RC(FREESPACE_ERROR_NO_DEVICE, r.result);
+    CHECK_RC(FREESPACE_ERROR_NO_DEVICE, request(device, 3, 1000, &r));
+
+    freespace_exit();
+    return 0;
+}
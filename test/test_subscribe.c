@@ -0,0 +1,106 @@
+/* * libfreespace - library for communicating with Freespace devices
+ *
+ * Copyright 2009-15 Hillcrest Laboratories, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/*
+ * freespace_subscribe() and freespace_subscribeMotionEngine() against a
+ * device on the test backend: delivery to the subscriber alone, and the
+ * MotionEngine Output format negotiated for the subscribed fields.
+ */
+
+#include "fake_device.h"
+#include "freespace/freespace_util.h"
+
+#include <string.h>
+
+static int subscribed_ = 0;
+static uint32_t lastSequence_ = 0;
+static int received_ = 0;
+
+static void onMotion(FreespaceDeviceId id, struct freespace_message* message, void* cookie, int result) {
+    CHECK_RC(FREESPACE_SUCCESS, result);
+    CHECK(message->messageType == FREESPACE_MESSAGE_MOTIONENGINEOUTPUT);
+    subscribed_++;
+    lastSequence_ = message->motionEngineOutput.sequenceNumber;
+}
+
+static void onReceive(FreespaceDeviceId id, struct freespace_message* message, void* cookie, int result) {
+    received_++;
+}
+
+static int gotMotion(void* cookie) {
+    return subscribed_ >= *(int*) cookie;
+}
+
+static int negotiated(void* cookie) {
+    const struct FakeDevice* device = (const struct FakeDevice*) cookie;
+    return device->modeRequests > 0 && device->packetSelect == 8;
+}
+
+static int turnedOff(void* cookie) {
+    const struct FakeDevice* device = (const struct FakeDevice*) cookie;
+    return device->formatFlags == 0;
+}
+
+int main() {
+    struct FakeDevice* device;
+    uint8_t format;
+    uint8_t flags;
+    int wanted;
+
+    fake_init();
+    device = fake_open();
+    CHECK_RC(FREESPACE_SUCCESS, freespace_setReceiveMessageCallback(device->id, onReceive, NULL));
+
+    // Reports of the type go to the subscriber and not the receive callback
+    CHECK_RC(FREESPACE_SUCCESS, freespace_subscribe(device->id, FREESPACE_MESSAGE_MOTIONENGINEOUTPUT,
+                                                    onMotion, NULL));
+    CHECK_RC(FREESPACE_SUCCESS, fake_sendMotion(device, 1));
+    CHECK_RC(FREESPACE_SUCCESS, fake_sendMotion(device, 2));
+    wanted = 2;
+    CHECK(fake_pump(gotMotion, &wanted, 1000));
+    CHECK(lastSequence_ == 2);
+    CHECK(received_ == 0);
+
+    // Unsubscribed, they go back to the receive callback
+    CHECK_RC(FREESPACE_SUCCESS, freespace_subscribe(device->id, FREESPACE_MESSAGE_MOTIONENGINEOUTPUT,
+                                                    NULL, NULL));
+    CHECK_RC(FREESPACE_SUCCESS, fake_sendMotion(device, 3));
+    fake_run(20);
+    CHECK(subscribed_ == 2);
+    CHECK(received_ == 1);
+
+    // The device is asked for the smallest format carrying the fields
+    CHECK(freespace_util_chooseFormat(FREESPACE_ME_ACCELERATION | FREESPACE_ME_ANGULAR_VELOCITY,
+                                      &format, &flags) == 0);
+    CHECK_RC(FREESPACE_SUCCESS, freespace_subscribeMotionEngine(
+            device->id, FREESPACE_ME_ACCELERATION | FREESPACE_ME_ANGULAR_VELOCITY, onMotion, NULL));
+    CHECK(fake_pump(negotiated, device, 1000));
+    CHECK(device->formatSelect == format && device->formatFlags == flags);
+    CHECK_RC(FREESPACE_SUCCESS, fake_sendMotion(device, 4));
+    wanted = 3;
+    CHECK(fake_pump(gotMotion, &wanted, 1000));
+    CHECK(lastSequence_ == 4);
+
+    // Unsubscribing turns the sections off again
+    CHECK_RC(FREESPACE_SUCCESS, freespace_subscribeMotionEngine(device->id, 0, NULL, NULL));
+    CHECK(fake_pump(turnedOff, device, 1000));
+    CHECK(device->modeRequests == 2);
+
+    freespace_exit();
+    return 0;
+}
@@ -18,6 +18,15 @@
 #include "freespace_device.h"
 #include "freespace_deviceMgr.h"
 #include "freespace_discovery.h"
+#include "freespace_mailbox.h"
+#include "freespace_rate.h"
+#include "freespace_subscribe.h"
+#include "freespace_frs.h"
+#include "freespace_request.h"
+#include "freespace_buffer.h"
+#include "freespace_alloc.h"
+#include "freespace_recorder.h"
+#include "freespace_publish.h"
 #include <strsafe.h>
 #include <malloc.h>
 
@@ -108,7 +117,7 @@ LIBFREESPACE_API int freespace_getDeviceInfo(FreespaceDeviceId id, struct Freesp
 }
 
 struct FreespaceDeviceStruct* freespace_private_createDevice(const char* name, const int hVer) {
-    struct FreespaceDeviceStruct* device = (struct FreespaceDeviceStruct*) malloc(sizeof(struct FreespaceDeviceStruct));
+    struct FreespaceDeviceStruct* device = (struct FreespaceDeviceStruct*) freespace_private_malloc(sizeof(struct FreespaceDeviceStruct));
     if (device == NULL) {
         return NULL;
     }
@@ -139,16 +148,16 @@ int freespace_private_freeDevice(struct FreespaceDeviceStruct* device) {
     for (idx = 0; idx < device->handleCount_; idx++) {
         struct FreespaceSubStruct* s = &device->handle_[idx];
         if (s->devicePath != NULL) {
-            free(s->devicePath);
+            freespace_private_free(s->devicePath);
         }
     }
 
     if (device->uniqueId_ != NULL) {
-        free(device->uniqueId_);
+        freespace_private_free(device->uniqueId_);
     }
 
     // Free up everything allocated by freespace_private_createDevice
-    free(device);
+    freespace_private_free(device);
     return FREESPACE_SUCCESS;
 }
 
@@ -189,14 +198,108 @@ struct FreespaceSendStruct* getNextSendBuffer(struct FreespaceDeviceStruct* devi
     return NULL;
 }
 
+static BOOL hasReceiveCallback(struct FreespaceDeviceStruct* device) {
+    return device->receiveCallback_ != NULL ||
+           device->receiveMessageCallback_ != NULL ||
+           device->receiveBufferCallback_ != NULL;
+}
+
+// Reads are kept going when there is an async callback, a request or
+// flash record transfer waiting for its response, a subscription or a
+// conflated message type to fill in.
+static BOOL isAsyncReceive(struct FreespaceDeviceStruct* device) {
+    return hasReceiveCallback(device) ||
+           freespace_private_requestActive(device->id_) ||
+           freespace_private_frsActive(device->id_) ||
+           freespace_private_mailboxActive(device->id_) ||
+           freespace_private_subscriptionActive(device->id_);
+}
+
+// Give a report to the requests, flash record reads, mailboxes and
+// subscriptions. Returns nonzero if one of them took it.
+static int interceptReceive(struct FreespaceDeviceStruct* device, const uint8_t* report, int length) {
+    return freespace_private_requestDeliver(device->id_, report, length, device->hVer_) ||
+           freespace_private_frsDeliver(device->id_, report, length, device->hVer_) ||
+           freespace_private_mailboxDeliver(device->id_, report, length, device->hVer_) ||
+           freespace_private_subscriptionDeliver(device->id_, report, length, device->hVer_);
+}
+
+// Pass a received report to the receive buffer callback. Overlapped reads
+// complete into the handle's own buffer, so the report is copied once into
+// a pooled buffer that the application can keep.
+static void lendReceiveBuffer(struct FreespaceDeviceStruct* device, const uint8_t* report, int length) {
+    struct FreespaceBuffer* buffer = freespace_private_bufferAcquire();
+
+    if (buffer == NULL) {
+        device->receiveBufferCallback_(device->id_, NULL, device->receiveBufferCookie_, FREESPACE_ERROR_OUT_OF_MEMORY);
+        return;
+    }
+    memcpy(buffer->data_, report, length);
+    buffer->length_ = length;
+    device->receiveBufferCallback_(device->id_, buffer, device->receiveBufferCookie_, FREESPACE_SUCCESS);
+    freespace_bufferRelease(buffer);
+}
+
+static void deliverReceive(struct FreespaceDeviceStruct* device, const uint8_t* report, int length) {
+    struct freespace_message m;
+    int rc;
+
+    if (device->receiveCallback_) {
+        device->receiveCallback_(device->id_, report, length, device->receiveCookie_, FREESPACE_SUCCESS);
+    }
+    if (device->receiveMessageCallback_) {
+        rc = freespace_decode_message(report, length, &m, device->hVer_);
+        if (rc == FREESPACE_SUCCESS) {
+            device->receiveMessageCallback_(device->id_, &m, device->receiveMessageCookie_, FREESPACE_SUCCESS);
+        } else {
+            device->receiveMessageCallback_(device->id_, NULL, device->receiveMessageCookie_, rc);
+            DEBUG_PRINTF("freespace_decode_message failed with code %d\n", rc);
+        }
+    }
+    if (device->receiveBufferCallback_) {
+        lendReceiveBuffer(device, report, length);
+    }
+}
+
+// Hand a report that an overlapped read completed with to whoever wants
+// it. Reports that only freespace_read wants are kept for it.
+static void dispatchReceive(struct FreespaceDeviceStruct* device, struct FreespaceSubStruct* s) {
+    const uint8_t* report = (const uint8_t*) s->readBuffer;
+    int length = (int) s->readBufferSize;
+    int64_t dispatchStart;
+
+    FREESPACE_RECORD(device->id_, device->hVer_, FREESPACE_RECORD_INBOUND, report, length);
+    FREESPACE_PUBLISH(device->id_, device->hVer_, report, length);
+    FREESPACE_RATE_RECEIVED(device->id_);
+    FREESPACE_RATE_DISPATCH_BEGIN(dispatchStart);
+    if (interceptReceive(device, report, length)) {
+        // Conflated or handled by a subscriber
+    } else if (hasReceiveCallback(device)) {
+        deliverReceive(device, report, length);
+    } else {
+        freespace_private_syncQueuePush(&device->syncQueue_, report, length, FREESPACE_SUCCESS);
+    }
+    FREESPACE_RATE_DISPATCH_END(dispatchStart);
+}
+
 static int initiateAsyncReceives(struct FreespaceDeviceStruct* device) {
     int idx;
     int funcRc = FREESPACE_SUCCESS;
     int rc;
-	struct freespace_message m;
+    int length;
+    uint8_t report[FREESPACE_MAX_INPUT_MESSAGE_SIZE];
 
     // If no callback or not opened, then don't need to request to receive anything.
-    if (!device->isOpened_ || (device->receiveCallback_ == NULL && device->receiveMessageCallback_ == NULL)) {
+    if (!device->isOpened_ || !isAsyncReceive(device)) {
+        return FREESPACE_SUCCESS;
+    }
+
+    // Reports kept for freespace_read before a callback was set
+    while (device->syncQueue_.count_ > 0 && hasReceiveCallback(device)) {
+        freespace_private_syncQueuePop(&device->syncQueue_, report, sizeof(report), &length);
+        deliverReceive(device, report, length);
+    }
+    if (!device->isOpened_ || !isAsyncReceive(device)) {
         return FREESPACE_SUCCESS;
     }
 
@@ -213,22 +316,10 @@ static int initiateAsyncReceives(struct FreespaceDeviceStruct* device) {
 					&s->readOverlapped_ );      /* long pointer to an OVERLAPPED structure */
                 if (bResult) {
                     // Got something, so report it.
-					if (device->receiveCallback_ || device->receiveMessageCallback_) {
-						if (device->receiveCallback_) {
-							device->receiveCallback_(device->id_, (char *) (s->readBuffer), s->readBufferSize, device->receiveCookie_, FREESPACE_SUCCESS);
-						}
-						if (device->receiveMessageCallback_) {
-							rc = freespace_decode_message((char *) (s->readBuffer), s->readBufferSize, &m, device->hVer_);
-							if (rc == FREESPACE_SUCCESS) {
-								device->receiveMessageCallback_(device->id_, &m, device->receiveMessageCookie_, FREESPACE_SUCCESS);
-							} else {
-								device->receiveMessageCallback_(device->id_, NULL, device->receiveMessageCookie_, rc);
-								DEBUG_PRINTF("freespace_decode_message failed with code %d\n", rc);
-							}
-						}
-					} else {
-                        // If no receiveCallback, then freespace_setReceiveCallback was called to stop
-                        // receives from within the receiveCallback. Bail out to let it do its thing.
+                    dispatchReceive(device, s);
+                    if (!device->isOpened_ || !isAsyncReceive(device)) {
+                        // The callbacks were removed or the device closed
+                        // from a callback. Bail out to let it do its thing.
                         return FREESPACE_SUCCESS;
                     }
                 } else {
@@ -262,8 +353,6 @@ int freespace_private_devicePerform(struct FreespaceDeviceStruct* device) {
     int idx;
     BOOL overlappedResult;
     struct FreespaceSendStruct* send;
-	int rc;
-	struct freespace_message m;
 
     // Handle the send messages
     for (idx = 0; idx < FREESPACE_MAXIMUM_SEND_MESSAGE_COUNT; idx++) {
@@ -313,21 +402,11 @@ int freespace_private_devicePerform(struct FreespaceDeviceStruct* device) {
             lastErr = GetLastError();
             if (bResult) {
                 // Got something, so report it.
-                if (device->receiveCallback_ || device->receiveMessageCallback_) {
-					if (device->receiveCallback_) {
-						device->receiveCallback_(device->id_, (char *) (s->readBuffer), s->readBufferSize, device->receiveCookie_, FREESPACE_SUCCESS);
-					}
-					if (device->receiveMessageCallback_) {
-						rc = freespace_decode_message((char *) (s->readBuffer), s->readBufferSize, &m, device->hVer_);
-						if (rc == FREESPACE_SUCCESS) {
-							device->receiveMessageCallback_(device->id_, &m, device->receiveMessageCookie_, FREESPACE_SUCCESS);
-						} else {
-							device->receiveMessageCallback_(device->id_, NULL, device->receiveMessageCookie_, rc);
-							DEBUG_PRINTF("freespace_decode_message failed with code %d\n", rc);
-						}
-					}
-				}
                 s->readStatus_ = FALSE;
+                dispatchReceive(device, s);
+                if (!device->isOpened_) {
+                    return FREESPACE_SUCCESS;
+                }
             } else if (lastErr != ERROR_IO_INCOMPLETE) {
                 // Something severe happened to our device!
 				DEBUG_PRINTF("freespace_private_devicePerform : Error on %d : %d\n", idx, lastErr);
@@ -388,6 +467,9 @@ void freespace_private_forceCloseDevice(struct FreespaceDeviceStruct* device) {
             s->readOverlapped_.hEvent = NULL;
         }
     }
+    if (device->isOpened_) {
+        freespace_private_bufferUnreserve(FREESPACE_BUFFER_LEND_SLACK);
+    }
     device->isOpened_ = FALSE;
 }
 
@@ -458,7 +540,18 @@ LIBFREESPACE_API int freespace_openDevice(FreespaceDeviceId id) {
         s->readStatus_ = FALSE;
     }
 
+    // Set aside the pool buffers lent to the receive buffer callback, so
+    // that receiving never grows the pool, and the device's requests
+    if (freespace_private_requestReserve(id) != FREESPACE_SUCCESS) {
+        freespace_private_forceCloseDevice(device);
+        return FREESPACE_ERROR_OUT_OF_MEMORY;
+    }
+    if (freespace_private_bufferReserve(FREESPACE_BUFFER_LEND_SLACK) != FREESPACE_SUCCESS) {
+        freespace_private_forceCloseDevice(device);
+        return FREESPACE_ERROR_OUT_OF_MEMORY;
+    }
     device->isOpened_ = TRUE;
+    freespace_private_syncQueueClear(&device->syncQueue_);
 
     // Enable send by initializing all send events.
     for (idx = 0; idx < FREESPACE_MAXIMUM_SEND_MESSAGE_COUNT; idx++) {
@@ -483,6 +576,46 @@ LIBFREESPACE_API int freespace_openDevice(FreespaceDeviceId id) {
     return FREESPACE_SUCCESS;
 }
 
+// Opening is already cheap on Windows, so the asynchronous variants
+// simply open synchronously and report the result right away.
+LIBFREESPACE_API int freespace_openDeviceAsync(FreespaceDeviceId id,
+                                               freespace_openCallback callback,
+                                               void* cookie) {
+    int rc = freespace_openDevice(id);
+    if (rc == FREESPACE_ERROR_BUSY && freespace_private_getDeviceById(id)->isOpened_) {
+        rc = FREESPACE_SUCCESS;
+    }
+    if (callback != NULL) {
+        callback(id, cookie, rc);
+    }
+    return FREESPACE_SUCCESS;
+}
+
+LIBFREESPACE_API int freespace_openAllDevicesAsync(freespace_openCallback callback,
+                                                   void* cookie) {
+    int idx;
+    int rc;
+    int numIds;
+    FreespaceDeviceId list[FREESPACE_MAXIMUM_DEVICE_COUNT];
+
+    rc = freespace_getDeviceList(list, FREESPACE_MAXIMUM_DEVICE_COUNT, &numIds);
+    if (rc != FREESPACE_SUCCESS) {
+        return rc;
+    }
+
+    for (idx = 0; idx < numIds; idx++) {
+        struct FreespaceDeviceStruct* device = freespace_private_getDeviceById(list[idx]);
+        if (device == NULL || device->isOpened_) {
+            continue;
+        }
+        rc = freespace_openDevice(list[idx]);
+        if (callback != NULL) {
+            callback(list[idx], cookie, rc);
+        }
+    }
+    return FREESPACE_SUCCESS;
+}
+
 LIBFREESPACE_API void freespace_closeDevice(FreespaceDeviceId id) {
     struct FreespaceDeviceStruct* device = freespace_private_getDeviceById(id);
     if (device == NULL) {
@@ -494,9 +627,31 @@ LIBFREESPACE_API void freespace_closeDevice(FreespaceDeviceId id) {
         return;
     }
 
+    freespace_private_requestReset(id);
+    freespace_private_frsReset(id);
+    freespace_private_mailboxReset(id);
+    freespace_private_rateReset(id);
+    freespace_private_subscriptionReset(id);
     freespace_private_forceCloseDevice(device);
 }
 
+int freespace_private_queueReports() {
+    return (int) HID_NUM_INPUT_BUFFERS;
+}
+
+int freespace_private_checkOpen(FreespaceDeviceId id) {
+    struct FreespaceDeviceStruct* device = freespace_private_getDeviceById(id);
+
+    if (device == NULL) {
+        return FREESPACE_ERROR_NO_DEVICE;
+    }
+    if (!device->isOpened_) {
+        // As prepareSend reports it
+        return FREESPACE_ERROR_IO;
+    }
+    return FREESPACE_SUCCESS;
+}
+
 static int prepareSend(FreespaceDeviceId id, struct FreespaceSendStruct** sendOut, const char* report, int length) {
     int idx;
     int retVal;
@@ -553,6 +708,7 @@ static int prepareSend(FreespaceDeviceId id, struct FreespaceSendStruct** sendOu
     for (idx = length; idx < s->info_.outputReportByteLength_; idx++) {
         send->report_[idx] = 0;
     }
+    FREESPACE_RECORD(id, device->hVer_, FREESPACE_RECORD_OUTBOUND, (const uint8_t*) report, length);
 
     send->rc_ = FREESPACE_SUCCESS;
     return send->rc_;
@@ -778,21 +934,15 @@ LIBFREESPACE_API int freespace_sendMessageAsync(FreespaceDeviceId id,
     return freespace_private_sendAsync(id, msgBuf, retVal, timeoutMs, callback, cookie);
 }
 
-int freespace_private_read(FreespaceDeviceId id,
-                           uint8_t* message,
-                           int maxLength,
-                           unsigned int timeoutMs,
-                           int* actualLength) {
-
+static int readReport(struct FreespaceDeviceStruct* device,
+                      uint8_t* message,
+                      int maxLength,
+                      unsigned int timeoutMs,
+                      int* actualLength) {
     HANDLE waitEvents[FREESPACE_HANDLE_COUNT_MAX];
     int idx;
     DWORD bResult;
 
-    struct FreespaceDeviceStruct* device = freespace_private_getDeviceById(id);
-    if (device == NULL) {
-        return FREESPACE_ERROR_NO_DEVICE;
-    }
-
     // Start the reads going.
     for (idx = 0; idx < device->handleCount_; idx++) {
         BOOL bResult;
@@ -859,6 +1009,43 @@ int freespace_private_read(FreespaceDeviceId id,
     return FREESPACE_ERROR_IO;
 }
 
+int freespace_private_read(FreespaceDeviceId id,
+                           uint8_t* message,
+                           int maxLength,
+                           unsigned int timeoutMs,
+                           int* actualLength) {
+    DWORD deadline;
+    DWORD now;
+    int rc;
+
+    struct FreespaceDeviceStruct* device = freespace_private_getDeviceById(id);
+    if (device == NULL) {
+        return FREESPACE_ERROR_NO_DEVICE;
+    }
+
+    // Reports that freespace_perform already read
+    rc = freespace_private_syncQueuePop(&device->syncQueue_, message, maxLength, actualLength);
+    if (rc != FREESPACE_ERROR_NO_DATA) {
+        return rc;
+    }
+
+    deadline = GetTickCount() + timeoutMs;
+    for (;;) {
+        rc = readReport(device, message, maxLength, timeoutMs, actualLength);
+        if (rc != FREESPACE_SUCCESS || !interceptReceive(device, message, *actualLength)) {
+            return rc;
+        }
+
+        // Taken by a request, flash record read, subscription or
+        // mailbox, so wait for the next one in the time left.
+        now = GetTickCount();
+        if ((LONG) (deadline - now) <= 0) {
+            return FREESPACE_ERROR_TIMEOUT;
+        }
+        timeoutMs = deadline - now;
+    }
+}
+
 LIBFREESPACE_API int freespace_readMessage(FreespaceDeviceId id,
                                            struct freespace_message* message,
                                            unsigned int timeoutMs) {
@@ -889,6 +1076,7 @@ LIBFREESPACE_API int freespace_flush(FreespaceDeviceId id) {
         return FREESPACE_ERROR_NO_DEVICE;
     }
 
+    freespace_private_syncQueueClear(&device->syncQueue_);
     for (idx = 0; idx < device->handleCount_; idx++) {
         struct FreespaceSubStruct* s = &device->handle_[idx];
         CancelIo(s->handle_);
@@ -911,7 +1099,7 @@ int freespace_private_setReceiveCallback(FreespaceDeviceId id,
             device->receiveCallback_ = NULL;
             device->receiveCookie_ = NULL;
 
-            if (device->receiveMessageCallback_ == NULL) {
+            if (device->receiveMessageCallback_ == NULL && device->receiveBufferCallback_ == NULL) {
                 return terminateAsyncReceives(device);
             } else {
                 return FREESPACE_SUCCESS;
@@ -921,7 +1109,7 @@ int freespace_private_setReceiveCallback(FreespaceDeviceId id,
             device->receiveCookie_ = cookie;
             device->receiveCallback_ = callback;
 
-            if (device->receiveMessageCallback_ == NULL) {
+            if (device->receiveMessageCallback_ == NULL && device->receiveBufferCallback_ == NULL) {
                 return initiateAsyncReceives(device);
             } else {
                 return FREESPACE_SUCCESS;
@@ -953,7 +1141,7 @@ LIBFREESPACE_API int freespace_setReceiveMessageCallback(FreespaceDeviceId id,
             device->receiveMessageCallback_ = NULL;
             device->receiveMessageCookie_ = NULL;
 
-            if (device->receiveCallback_ == NULL) {
+            if (device->receiveCallback_ == NULL && device->receiveBufferCallback_ == NULL) {
                 return terminateAsyncReceives(device);
             } else {
                 return FREESPACE_SUCCESS;
@@ -963,7 +1151,7 @@ LIBFREESPACE_API int freespace_setReceiveMessageCallback(FreespaceDeviceId id,
             device->receiveMessageCookie_ = cookie;
             device->receiveMessageCallback_ = callback;
 
-            if (device->receiveCallback_ == NULL) {
+            if (device->receiveCallback_ == NULL && device->receiveBufferCallback_ == NULL) {
                 return initiateAsyncReceives(device);
             } else {
                 return FREESPACE_SUCCESS;
@@ -981,3 +1169,31 @@ LIBFREESPACE_API int freespace_setReceiveMessageCallback(FreespaceDeviceId id,
     return FREESPACE_SUCCESS;
 }
 
+LIBFREESPACE_API int freespace_setReceiveBufferCallback(FreespaceDeviceId id,
+                                                        freespace_receiveBufferCallback callback,
+                                                        void* cookie) {
+    struct FreespaceDeviceStruct* device = freespace_private_getDeviceById(id);
+    int wasReceiving;
+    if (device == NULL) {
+        return FREESPACE_ERROR_NO_DEVICE;
+    }
+
+    wasReceiving = (device->receiveCallback_ != NULL || device->receiveMessageCallback_ != NULL ||
+                    device->receiveBufferCallback_ != NULL);
+    device->receiveBufferCallback_ = callback;
+    device->receiveBufferCookie_ = (callback != NULL) ? cookie : NULL;
+
+    if (device->isOpened_) {
+        if (!wasReceiving && callback != NULL) {
+            // Registering the only callback, so initiate a receive.
+            return initiateAsyncReceives(device);
+        } else if (wasReceiving && callback == NULL &&
+                   device->receiveCallback_ == NULL && device->receiveMessageCallback_ == NULL) {
+            // Deregistering the last callback, so stop any pending receives.
+            return terminateAsyncReceives(device);
+        }
+    }
+
+    return FREESPACE_SUCCESS;
+}
+
@@ -19,6 +19,14 @@
 #include "freespace_device.h"
 #include "freespace_discovery.h"
 #include "freespace_discoveryDetail.h"
+#include "freespace_mailbox.h"
+#include "freespace_rate.h"
+#include "freespace_subscribe.h"
+#include "freespace_frs.h"
+#include "freespace_request.h"
+#include "freespace_configure.h"
+#include "freespace_buffer.h"
+#include "freespace_alloc.h"
 #include <strsafe.h>
 #include <malloc.h>
 #include "freespace_config.h"
@@ -49,6 +57,11 @@ LIBFREESPACE_API const char* freespace_version() {
 	return LIBFREESPACE_VERSION;
 }
 
+LIBFREESPACE_API const char* freespace_backendName() {
+    // The only backend on Windows
+    return freespace_instance_ != NULL ? "win32" : NULL;
+}
+
 LIBFREESPACE_API int freespace_init() {
     int rc;
 
@@ -56,7 +69,7 @@ LIBFREESPACE_API int freespace_init() {
         return FREESPACE_ERROR_BUSY;
     }
 
-    freespace_instance_ = (struct LibfreespaceData*) malloc(sizeof(struct LibfreespaceData));
+    freespace_instance_ = (struct LibfreespaceData*) freespace_private_malloc(sizeof(struct LibfreespaceData));
     if (freespace_instance_ == NULL) {
         return FREESPACE_ERROR_OUT_OF_MEMORY;
     }
@@ -75,6 +88,21 @@ LIBFREESPACE_API int freespace_init() {
     return FREESPACE_SUCCESS;
 }
 
+LIBFREESPACE_API int freespace_initWithOptions(const struct FreespaceInitOptions* options) {
+    if (options != NULL && options->receiveThread) {
+        // Not supported on Windows yet.
+        return FREESPACE_ERROR_UINIMPLEMENTED;
+    }
+    return freespace_init();
+}
+
+LIBFREESPACE_API void freespace_lock() {
+    // No receive thread, so nothing to serialize with.
+}
+
+LIBFREESPACE_API void freespace_unlock() {
+}
+
 LIBFREESPACE_API void freespace_exit() {
     int i;
 
@@ -97,8 +125,18 @@ LIBFREESPACE_API void freespace_exit() {
     CloseHandle(freespace_instance_->performEvent_);
     freespace_instance_->performEvent_ = NULL;
 
-    free(freespace_instance_);
+    freespace_private_free(freespace_instance_);
     freespace_instance_ = NULL;
+
+    freespace_recorderStop();
+    freespace_publisherStop();
+    freespace_private_mailboxExit();
+    freespace_private_rateExit();
+    freespace_private_subscriptionExit();
+    freespace_private_configExit();
+    freespace_private_requestExit();
+    freespace_private_frsExit();
+    freespace_private_bufferExit();
 }
 
 LIBFREESPACE_API int freespace_setDeviceHotplugCallback(freespace_hotplugCallback callback,
@@ -129,10 +167,26 @@ LIBFREESPACE_API int freespace_perform() {
     // Service all of the devices.
     // NOTE: Servicing includes initiating
     freespace_private_filterDevices(NULL, 0, NULL, performHelper);
+    freespace_private_ratePerform();
+
+    // Send the flash record requests, configurations and other requests
+    // that are due
+    freespace_private_frsPerform();
+    freespace_private_configPerform();
+    freespace_private_requestPerform();
 
     return rc;
 }
 
+LIBFREESPACE_API int freespace_performBudget(int maxReports, int maxMicros, int* workRemaining) {
+    // Each interface already delivers at most one report per perform here,
+    // so there is nothing to budget.
+    if (workRemaining != NULL) {
+        *workRemaining = 0;
+    }
+    return freespace_perform();
+}
+
 LIBFREESPACE_API void freespace_setFileDescriptorCallbacks(freespace_pollfdAddedCallback addedCallback,
                                                            freespace_pollfdRemovedCallback removedCallback) {
     freespace_instance_->fdAddedCallback_ = addedCallback;
@@ -153,6 +207,9 @@ LIBFREESPACE_API int freespace_syncFileDescriptors() {
 LIBFREESPACE_API int freespace_getNextTimeout(int* timeoutMsOut) {
     // TODO
     *timeoutMsOut = 0xffffffff;
+    freespace_private_frsNextTimeout(timeoutMsOut);
+    freespace_private_requestNextTimeout(timeoutMsOut);
+    freespace_private_configNextTimeout(timeoutMsOut);
     return FREESPACE_SUCCESS;
 }
 
@@ -168,11 +225,11 @@ struct FreespaceDeviceStruct* freespace_private_getDeviceByRef(FreespaceDeviceRe
 
     for (i = 0; i < freespace_instance_->deviceCount_; i++) {
         if (lstrcmp(uniqueRef, freespace_instance_->devices_[i]->uniqueId_) == 0) {
-            free(uniqueRef);
+            freespace_private_free(uniqueRef);
             return freespace_instance_->devices_[i];
         }
     }
-    free(uniqueRef);
+    freespace_private_free(uniqueRef);
     return NULL;
 }
 
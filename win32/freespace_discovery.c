@@ -24,6 +24,7 @@
 
 #include "freespace_discovery.h"
 #include <stdio.h>
+#include "freespace_alloc.h"
 #include <malloc.h>
 
 static const LPWSTR szMainWndClass = L"FreespaceDiscoveryWindow";
@@ -189,7 +190,7 @@ DWORD WINAPI discoveryWindow(LPVOID lpParam) {
 
     // Register the hidden window class
     if (wndclass == NULL) {
-        wndclass = (WNDCLASSEX*) malloc(sizeof(WNDCLASSEX));
+        wndclass = (WNDCLASSEX*) freespace_private_malloc(sizeof(WNDCLASSEX));
         memset (wndclass, 0, sizeof(WNDCLASSEX));
         wndclass->cbSize = sizeof(WNDCLASSEX);
         wndclass->style = CS_HREDRAW | CS_VREDRAW;
@@ -272,7 +273,7 @@ DWORD WINAPI discoveryWindow(LPVOID lpParam) {
                          freespace_instance_->wndclass_->hInstance)) {
         DEBUG_PRINTF("Could not unregister window: %d\n", GetLastError());
     } else {
-        free(wndclass);
+        freespace_private_free(wndclass);
         freespace_instance_->wndclass_ = NULL;
     }
 
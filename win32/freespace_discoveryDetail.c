@@ -18,6 +18,7 @@
 #include "freespace_discoveryDetail.h"
 #include "freespace_deviceMgr.h"
 #include <strsafe.h>
+#include "freespace_alloc.h"
 #include <malloc.h>
 
 /*
@@ -27,7 +28,7 @@
  */
 static WCHAR* dupeWCharString(const WCHAR* input) {
     int mallocStrLen = lstrlen(input) + 1;
-    WCHAR* out = (WCHAR*) malloc(sizeof(WCHAR) * mallocStrLen);
+    WCHAR* out = (WCHAR*) freespace_private_malloc(sizeof(WCHAR) * mallocStrLen);
     if (out != NULL) {
         StringCchCopy(out, mallocStrLen, input);
     }
@@ -288,7 +289,7 @@ int freespace_private_scanAndAddDevices() {
     for (;;) {
         /* free the memory allocated for functionClassDeviceData */
         if (functionClassDeviceData != NULL) {
-            free(functionClassDeviceData);
+            freespace_private_free(functionClassDeviceData);
             functionClassDeviceData = NULL;
         }
 
@@ -326,7 +327,7 @@ int freespace_private_scanAndAddDevices() {
 
         /* 3C) allocate memory for the hardwareDeviceInfo structure */
         predictedLength = requiredLength;
-        functionClassDeviceData = (PSP_DEVICE_INTERFACE_DETAIL_DATA) malloc(predictedLength);
+        functionClassDeviceData = (PSP_DEVICE_INTERFACE_DETAIL_DATA) freespace_private_malloc(predictedLength);
         if (functionClassDeviceData) {
             /* set the size parameter of the structure */
             functionClassDeviceData->cbSize = sizeof(SP_DEVICE_INTERFACE_DETAIL_DATA);
@@ -374,7 +375,7 @@ int freespace_private_scanAndAddDevices() {
 
     /* 4) Free the allocated memory */
     if (functionClassDeviceData != NULL) {
-        free(functionClassDeviceData);
+        freespace_private_free(functionClassDeviceData);
     }
     if (hardwareDeviceInfo != INVALID_HANDLE_VALUE) {
         SetupDiDestroyDeviceInfoList(hardwareDeviceInfo);
@@ -21,6 +21,7 @@
 #include "freespace/freespace.h"
 #include "freespace/freespace_codecs.h"
 #include "freespace/freespace_deviceTable.h"
+#include "freespace_syncQueue.h"
 
 // Define our debug printf statements
 #ifdef DEBUG
@@ -241,6 +242,14 @@ struct FreespaceDeviceStruct {
     // The cookie passed to the receive struct callback.
     void*                             receiveMessageCookie_;
 
+    // The callback lent a buffer holding each received message.
+    freespace_receiveBufferCallback   receiveBufferCallback_;
+    // The cookie passed to the receive buffer callback.
+    void*                             receiveBufferCookie_;
+
+    // Reports read for nobody but freespace_read.
+    struct FreespaceSyncQueue         syncQueue_;
+
     // Send events outstanding
     struct FreespaceSendStruct  send_[FREESPACE_MAXIMUM_SEND_MESSAGE_COUNT];
 };